@@ -0,0 +1,1333 @@
+// Benchmarks for ewelbornUtil. Every benchmark is run at several input sizes,
+// once with a libc or naive baseline and once with each ewelbornUtil
+// implementation, and the results are printed as CSV so that they can be
+// saved and compared between releases:
+//
+//	benchmark,implementation,size,runs,median_ns,p99_ns,mb_per_s,ops_per_s,speedup
+//
+// speedup is how many times faster the implementation is than the baseline
+// for the same benchmark and size. Every run is timed on its own with a
+// monotonic clock after a few warmup runs, and median_ns and p99_ns are taken
+// from those times.
+//
+// On Linux, run "make benchmark" (or build with "make" and run build/bench).
+// On Windows, build this file instead of test.c. Passing an argument only
+// runs the benchmarks whose names contain it, ex. "bench split".
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "ewelbornUtil.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <time.h>
+#include <pthread.h>
+#endif
+
+#define WARMUP_RUNS 3
+#define MINIMUM_RUNS 15
+#define MAXIMUM_RUNS 1000
+#define MINIMUM_SECONDS 0.25
+
+static double nowSeconds()
+{
+#ifdef _WIN32
+	static LARGE_INTEGER frequency;
+	if (frequency.QuadPart == 0) { QueryPerformanceFrequency(&frequency); }
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+#endif
+}
+
+// Benchmarks store their results here, so that the compiler can't decide
+// that the work isn't needed and skip it.
+static volatile size_t sink;
+
+static const char* benchmarkFilter = NULL;
+static double baselineMedian;
+
+static int compareDoubles(const void* a, const void* b)
+{
+	double x = *(const double*)a;
+	double y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+// Times the given function and prints its row. isBaseline must be true for
+// the first implementation of every benchmark and size, which every other
+// implementation is compared against. bytes and operations are how much
+// work a single run does, and are used for the throughput columns.
+static void runBenchmark(const char* benchmark, const char* implementation, bool isBaseline,
+	size_t size, size_t bytes, size_t operations, void(*run)())
+{
+	if (benchmarkFilter != NULL && strstr(benchmark, benchmarkFilter) == NULL) { return; }
+
+	for (int i = 0; i < WARMUP_RUNS; i++) {
+		run();
+	}
+
+	double times[MAXIMUM_RUNS];
+	int runs = 0;
+	double started = nowSeconds();
+	while (runs < MAXIMUM_RUNS && (runs < MINIMUM_RUNS || nowSeconds() - started < MINIMUM_SECONDS)) {
+		double start = nowSeconds();
+		run();
+		times[runs++] = nowSeconds() - start;
+	}
+
+	qsort(times, runs, sizeof(double), compareDoubles);
+	double median = times[runs / 2];
+	double p99 = times[(int)((runs - 1) * 0.99)];
+	if (isBaseline) { baselineMedian = median; }
+
+	printf("%s,%s,%zu,%d,%.0f,%.0f,%.2f,%.0f,%.2f\n", benchmark, implementation, size, runs,
+		median * 1e9, p99 * 1e9, bytes / median / (1024.0 * 1024.0), operations / median, baselineMedian / median);
+	fflush(stdout);
+}
+
+// *** INPUTS
+
+// Input sizes, in bytes for the string benchmarks, and in elements for the
+// data structure benchmarks.
+static const size_t inputSizes[] = { 4 * 1024, 256 * 1024, 16 * 1024 * 1024 };
+
+static char* text; // Lines of random words, text[textSize] is '\0'
+static size_t textSize;
+static size_t textLines;
+static ewelborn_string* textString;
+static char** pieces; // text split on spaces, each piece still ending in its space
+static size_t pieceCount;
+static ewelborn_string* textPath;
+static size_t elementCount;
+static int element;
+
+static unsigned int randomState = 12345;
+
+static unsigned int nextRandom()
+{
+	randomState = randomState * 1103515245 + 12345;
+	return (randomState >> 16) & 0x7fff;
+}
+
+// Fills text with size bytes of lines that are made of short words, and ends
+// it with a '#' that appears nowhere else, for findChar to search for.
+static void createText(size_t size)
+{
+	free(text);
+	text = malloc(size + 1);
+	textSize = size;
+	textLines = 1;
+	size_t lineLength = 0;
+	for (size_t i = 0; i + 1 < size; i++) {
+		unsigned int r = nextRandom();
+		if (lineLength > 20 && r % 40 == 0) {
+			text[i] = '\n';
+			textLines++;
+			lineLength = 0;
+		}
+		else {
+			text[i] = r % 6 == 0 ? ' ' : 'a' + r % 26;
+			lineLength++;
+		}
+	}
+	text[size - 1] = '#';
+	text[size] = '\0';
+
+	if (textString != NULL) { ewelborn_string_free(textString); }
+	textString = ewelborn_string_initializeWithCString(text);
+
+	for (size_t i = 0; i < pieceCount; i++) {
+		free(pieces[i]);
+	}
+	free(pieces);
+	size_t spaces = 0;
+	for (size_t i = 0; i < size; i++) {
+		if (text[i] == ' ') { spaces++; }
+	}
+	pieces = malloc(sizeof(char*) * (spaces + 1));
+	pieceCount = 0;
+	size_t start = 0;
+	for (size_t i = 0; i <= size; i++) {
+		if (i == size || text[i] == ' ') {
+			size_t end = i < size ? i + 1 : size;
+			pieces[pieceCount] = malloc(end - start + 1);
+			memcpy(pieces[pieceCount], text + start, end - start);
+			pieces[pieceCount][end - start] = '\0';
+			pieceCount++;
+			start = end;
+		}
+	}
+
+	ewelborn_fileWriter* writer = ewelborn_fileWriter_open(textPath, EWELBORN_SYNC_NEVER);
+	ewelborn_fileWriter_writeString(writer, textString);
+	ewelborn_fileWriter_close(writer);
+}
+
+static void freeStrings(ewelborn_dynamicArray* strings)
+{
+	for (int i = 0; i < strings->elements; i++) {
+		ewelborn_string_free(strings->array[i]);
+	}
+	free(strings->array);
+	free(strings);
+}
+
+// *** SPLIT
+
+static void splitNaive()
+{
+	// A malloc'd copy of every line, the way most C code would do it
+	size_t maxLines = 16;
+	size_t lineCount = 0;
+	char** lines = malloc(sizeof(char*) * maxLines);
+	const char* start = text;
+	const char* end = text + textSize;
+	while (true) {
+		const char* newline = memchr(start, '\n', end - start);
+		const char* lineEnd = newline != NULL ? newline : end;
+		if (lineCount == maxLines) {
+			maxLines *= 2;
+			lines = realloc(lines, sizeof(char*) * maxLines);
+		}
+		lines[lineCount] = malloc(lineEnd - start + 1);
+		memcpy(lines[lineCount], start, lineEnd - start);
+		lines[lineCount][lineEnd - start] = '\0';
+		lineCount++;
+		if (newline == NULL) { break; }
+		start = newline + 1;
+	}
+
+	sink = lineCount;
+	for (size_t i = 0; i < lineCount; i++) {
+		free(lines[i]);
+	}
+	free(lines);
+}
+
+static void splitEwelborn()
+{
+	ewelborn_dynamicArray* lines = ewelborn_string_split(textString, '\n');
+	sink = lines->elements;
+	freeStrings(lines);
+}
+
+static void splitEwelbornParallel()
+{
+	ewelborn_dynamicArray* lines = ewelborn_string_splitParallel(textString, '\n', 0);
+	sink = lines->elements;
+	freeStrings(lines);
+}
+
+static void splitViews()
+{
+	ewelborn_stringView remaining = ewelborn_stringView_fromString(textString);
+	ewelborn_stringView line;
+	size_t lineCount = 0;
+	while (ewelborn_stringView_splitNext(&remaining, '\n', &line)) {
+		lineCount++;
+	}
+	sink = lineCount;
+}
+
+// *** INTERN
+
+// Lines of tokens picked from a small vocabulary, the way hostnames and
+// status codes repeat in logs, turned into something that can be compared.
+
+static ewelborn_string* tokenText;
+static size_t tokenCount;
+
+static void createTokens(size_t size)
+{
+	if (tokenText != NULL) { ewelborn_string_free(tokenText); }
+	tokenText = ewelborn_string_initializeEmpty();
+	tokenCount = 0;
+	char token[32];
+	while ((size_t)tokenText->length + sizeof(token) < size) {
+		snprintf(token, sizeof(token), "host-%u.example.com\n", nextRandom() % 500);
+		ewelborn_string_appendCString(tokenText, token);
+		tokenCount++;
+	}
+}
+
+static void internSplit()
+{
+	// What the tokens cost without a pool, an estring apiece
+	ewelborn_dynamicArray* tokens = ewelborn_string_split(tokenText, '\n');
+	sink = tokens->elements;
+	freeStrings(tokens);
+}
+
+static void internPool()
+{
+	ewelborn_stringPool* pool = ewelborn_stringPool_initialize();
+	ewelborn_typedArray* ids = EWELBORN_TYPED_ARRAY_INITIALIZE(int);
+	ewelborn_stringPool_internSplit(pool, ewelborn_stringView_fromString(tokenText), '\n', ids);
+	sink = (size_t)pool->count + ids->elements;
+	ewelborn_typedArray_free(ids);
+	ewelborn_stringPool_free(pool);
+}
+
+// *** TOKENIZE
+
+static const char* tokenDelimiters = " \n,;";
+
+static void tokenizeStrcspn()
+{
+	// The usual libc way, which doesn't have to modify the text like strtok
+	size_t tokenCount = 0;
+	const char* position = text;
+	while (*position != '\0') {
+		position += strspn(position, tokenDelimiters);
+		if (*position == '\0') { break; }
+		position += strcspn(position, tokenDelimiters);
+		tokenCount++;
+	}
+	sink = tokenCount;
+}
+
+static void tokenizeEwelborn()
+{
+	ewelborn_tokenizer tokenizer = ewelborn_tokenizer_fromString(textString, tokenDelimiters, EWELBORN_TOKENIZE_SKIP_EMPTY);
+	ewelborn_stringView token;
+	size_t tokenCount = 0;
+	while (ewelborn_tokenizer_next(&tokenizer, &token)) {
+		tokenCount++;
+	}
+	sink = tokenCount;
+}
+
+// *** PARSE NUMBERS
+
+static char* numberText; // Comma separated numbers, with a newline every 8
+static size_t numberTextSize;
+static size_t numberCount;
+
+// Fills numberText with about size bytes of integers (or doubles)
+static void createNumbers(size_t size, bool doubles)
+{
+	free(numberText);
+	numberText = malloc(size + 64);
+	numberTextSize = 0;
+	numberCount = 0;
+	while (numberTextSize < size) {
+		int written;
+		if (doubles) {
+			written = sprintf(numberText + numberTextSize, "%.17g", (double)nextRandom() / (nextRandom() + 1) * (nextRandom() % 2 ? 1e-5 : 1e5));
+		}
+		else {
+			written = sprintf(numberText + numberTextSize, "%lld", (long long)nextRandom() * (nextRandom() % 2 ? 1 : -1000));
+		}
+		numberTextSize += written;
+		numberCount++;
+		numberText[numberTextSize++] = numberCount % 8 == 0 ? '\n' : ',';
+	}
+	numberText[numberTextSize] = '\0';
+}
+
+static void parseIntsStrtoll()
+{
+	ewelborn_typedArray* numbers = EWELBORN_TYPED_ARRAY_INITIALIZE(int64_t);
+	char* position = numberText;
+	while (*position != '\0') {
+		char* end;
+		int64_t value = strtoll(position, &end, 10);
+		ewelborn_typedArray_push(numbers, &value);
+		position = *end == '\0' ? end : end + 1;
+	}
+	sink = numbers->elements;
+	ewelborn_typedArray_free(numbers);
+}
+
+static void parseIntsEwelborn()
+{
+	ewelborn_typedArray* numbers = EWELBORN_TYPED_ARRAY_INITIALIZE(int64_t);
+	ewelborn_parseIntsFromBuffer(numberText, numberTextSize, numbers, NULL);
+	sink = numbers->elements;
+	ewelborn_typedArray_free(numbers);
+}
+
+static void parseDoublesStrtod()
+{
+	ewelborn_typedArray* numbers = EWELBORN_TYPED_ARRAY_INITIALIZE(double);
+	char* position = numberText;
+	while (*position != '\0') {
+		char* end;
+		double value = strtod(position, &end);
+		ewelborn_typedArray_push(numbers, &value);
+		position = *end == '\0' ? end : end + 1;
+	}
+	sink = numbers->elements;
+	ewelborn_typedArray_free(numbers);
+}
+
+static void parseDoublesEwelborn()
+{
+	ewelborn_typedArray* numbers = EWELBORN_TYPED_ARRAY_INITIALIZE(double);
+	ewelborn_parseDoublesFromBuffer(numberText, numberTextSize, numbers, NULL);
+	sink = numbers->elements;
+	ewelborn_typedArray_free(numbers);
+}
+
+// *** FINDCHAR
+
+static void findCharNaive()
+{
+	size_t i = 0;
+	while (text[i] != '#') { i++; }
+	sink = i;
+}
+
+static void findCharMemchr()
+{
+	sink = (const char*)memchr(text, '#', textSize) - text;
+}
+
+static void findCharEwelborn()
+{
+	sink = ewelborn_string_findChar(textString, '#', 0);
+}
+
+// *** FIND
+
+// Words never contain a '#', so this is only found at the very end
+static const char* findNeedle = "lorem#";
+// A needle that matches almost all the way, everywhere in a haystack of 'a's
+static char hardNeedle[64];
+static char* hardText;
+
+static size_t naiveFind(const char* haystack, size_t length, const char* needle, size_t needleLength)
+{
+	for (size_t i = 0; i + needleLength <= length; i++) {
+		size_t j = 0;
+		while (j < needleLength && haystack[i + j] == needle[j]) { j++; }
+		if (j == needleLength) { return i; }
+	}
+	return length;
+}
+
+static void findNaive()
+{
+	sink = naiveFind(text, textSize, findNeedle, strlen(findNeedle));
+}
+
+static void findStrstr()
+{
+	sink = (size_t)(strstr(text, findNeedle) != NULL);
+}
+
+static void findEwelborn()
+{
+	sink = ewelborn_string_find(textString, ewelborn_stringView_fromCString(findNeedle), 0);
+}
+
+static void findHardNaive()
+{
+	sink = naiveFind(hardText, textSize, hardNeedle, sizeof(hardNeedle) - 1);
+}
+
+static void findHardStrstr()
+{
+	sink = (size_t)(strstr(hardText, hardNeedle) != NULL);
+}
+
+static void findHardEwelborn()
+{
+	sink = ewelborn_scan_find(hardText, textSize, hardNeedle, sizeof(hardNeedle) - 1);
+}
+
+// *** APPENDCSTRING
+
+static void appendNaive()
+{
+	// One character at a time, the way appendCString used to work
+	ewelborn_string* estring = ewelborn_string_initializeEmpty();
+	for (size_t i = 0; i < pieceCount; i++) {
+		for (const char* c = pieces[i]; *c != '\0'; c++) {
+			ewelborn_string_pushChar(estring, *c);
+		}
+	}
+	sink = estring->length;
+	ewelborn_string_free(estring);
+}
+
+static void appendLibc()
+{
+	size_t length = 0;
+	size_t capacity = 16;
+	char* buffer = malloc(capacity);
+	buffer[0] = '\0';
+	for (size_t i = 0; i < pieceCount; i++) {
+		size_t pieceLength = strlen(pieces[i]);
+		if (length + pieceLength + 1 > capacity) {
+			while (length + pieceLength + 1 > capacity) { capacity *= 2; }
+			buffer = realloc(buffer, capacity);
+		}
+		memcpy(buffer + length, pieces[i], pieceLength + 1);
+		length += pieceLength;
+	}
+	sink = length;
+	free(buffer);
+}
+
+static void appendEwelborn()
+{
+	ewelborn_string* estring = ewelborn_string_initializeEmpty();
+	for (size_t i = 0; i < pieceCount; i++) {
+		ewelborn_string_appendCString(estring, pieces[i]);
+	}
+	sink = estring->length;
+	ewelborn_string_free(estring);
+}
+
+// *** READCSV
+
+static ewelborn_string* csvPath;
+static size_t csvRows;
+
+// Writes about size bytes of CSV with an integer, a double, and a string column
+static void createCSV(size_t size)
+{
+	ewelborn_fileWriter* writer = ewelborn_fileWriter_open(csvPath, EWELBORN_SYNC_NEVER);
+	ewelborn_fileWriter_writeBuffer(writer, "id,value,word\n", 14);
+	size_t written = 14;
+	csvRows = 0;
+	while (written < size) {
+		char row[96];
+		int length = sprintf(row, "%u,%.6f,%c%c%c%c%c\n", nextRandom(), (double)nextRandom() / 1000,
+			'a' + nextRandom() % 26, 'a' + nextRandom() % 26, 'a' + nextRandom() % 26, 'a' + nextRandom() % 26, 'a' + nextRandom() % 26);
+		ewelborn_fileWriter_writeBuffer(writer, row, length);
+		written += length;
+		csvRows++;
+	}
+	ewelborn_fileWriter_close(writer);
+}
+
+static void readCSVSplit()
+{
+	// The way it's usually done: every line is split into estrings, and
+	// each row keeps its own fields
+	ewelborn_dynamicArray* lines = ewelborn_readLinesFromFile(csvPath);
+	ewelborn_dynamicArray* rows = ewelborn_dynamicArray_initialize();
+	int64_t idSum = 0;
+	double valueSum = 0;
+	for (int i = 1; i < lines->elements; i++) {
+		ewelborn_string* line = lines->array[i];
+		if (line->length == 0) { continue; }
+		ewelborn_dynamicArray* fields = ewelborn_string_split(line, ',');
+		idSum += strtoll(((ewelborn_string*)fields->array[0])->cstring, NULL, 10);
+		valueSum += strtod(((ewelborn_string*)fields->array[1])->cstring, NULL);
+		ewelborn_dynamicArray_push(rows, fields);
+	}
+	sink = rows->elements + (size_t)idSum + (size_t)valueSum;
+	for (int i = 0; i < rows->elements; i++) {
+		freeStrings(rows->array[i]);
+	}
+	free(rows->array);
+	free(rows);
+	freeStrings(lines);
+}
+
+static void readCSVEwelborn()
+{
+	ewelborn_csvReader* reader = ewelborn_readCSVFromFile(csvPath, ewelborn_csvReader_defaultOptions());
+	int64_t idSum = 0;
+	double valueSum = 0;
+	for (int i = 0; i < reader->rowCount; i++) {
+		idSum += EWELBORN_TYPED_ARRAY_AT(reader->columns[0].values, int64_t, i);
+		valueSum += EWELBORN_TYPED_ARRAY_AT(reader->columns[1].values, double, i);
+	}
+	sink = reader->rowCount + (size_t)idSum + (size_t)valueSum;
+	ewelborn_csvReader_free(reader);
+}
+
+// *** READLINESFROMFILE
+
+static void readLinesFgets()
+{
+	FILE* file = NULL;
+#ifdef _MSC_VER
+	fopen_s(&file, textPath->cstring, "r");
+#else
+	file = fopen(textPath->cstring, "r");
+#endif
+	size_t maxLines = 16;
+	size_t lineCount = 0;
+	char** lines = malloc(sizeof(char*) * maxLines);
+	char line[4096];
+	while (fgets(line, sizeof(line), file) != NULL) {
+		size_t length = strlen(line);
+		if (length > 0 && line[length - 1] == '\n') { line[--length] = '\0'; }
+		if (lineCount == maxLines) {
+			maxLines *= 2;
+			lines = realloc(lines, sizeof(char*) * maxLines);
+		}
+		lines[lineCount] = malloc(length + 1);
+		memcpy(lines[lineCount], line, length + 1);
+		lineCount++;
+	}
+	fclose(file);
+
+	sink = lineCount;
+	for (size_t i = 0; i < lineCount; i++) {
+		free(lines[i]);
+	}
+	free(lines);
+}
+
+static void readLinesEwelborn()
+{
+	ewelborn_dynamicArray* lines = ewelborn_readLinesFromFile(textPath);
+	sink = lines->elements;
+	freeStrings(lines);
+}
+
+static void readLinesEwelbornParallel()
+{
+	ewelborn_dynamicArray* lines = ewelborn_readLinesFromFileParallel(textPath, 0);
+	sink = lines->elements;
+	freeStrings(lines);
+}
+
+static void readLinesLineReader()
+{
+	ewelborn_lineReader* reader = ewelborn_lineReader_open(textPath);
+	ewelborn_stringView line;
+	size_t lineCount = 0;
+	while (ewelborn_lineReader_nextView(reader, &line)) {
+		lineCount++;
+	}
+	ewelborn_lineReader_free(reader);
+	sink = lineCount;
+}
+
+// *** SORT
+
+// Every run copies the same unsorted input into place and then sorts it.
+
+static int64_t* unsortedNumbers;
+static ewelborn_typedArray* sortNumbers;
+static ewelborn_dynamicArray* unsortedStrings; // One estring per piece of text
+static ewelborn_dynamicArray* sortStrings;
+
+static int compareInt64(const void* a, const void* b)
+{
+	int64_t x = *(const int64_t*)a;
+	int64_t y = *(const int64_t*)b;
+	return (x > y) - (x < y);
+}
+
+static int compareStrings(const void* a, const void* b)
+{
+	// A fair baseline, since it also knows each string's length
+	const ewelborn_string* x = *(ewelborn_string* const*)a;
+	const ewelborn_string* y = *(ewelborn_string* const*)b;
+	int result = memcmp(x->cstring, y->cstring, x->length < y->length ? x->length : y->length);
+	return result != 0 ? result : (x->length > y->length) - (x->length < y->length);
+}
+
+#define INT64_LESS_THAN(a, b) ((a) < (b))
+EWELBORN_DEFINE_SORT(sortInt64s, int64_t, INT64_LESS_THAN)
+
+static void createSortInputs()
+{
+	sortNumbers = EWELBORN_TYPED_ARRAY_INITIALIZE(int64_t);
+	unsortedNumbers = malloc(sizeof(int64_t) * elementCount);
+	for (size_t i = 0; i < elementCount; i++) {
+		unsortedNumbers[i] = ((int64_t)nextRandom() << 33) ^ ((int64_t)nextRandom() << 17) ^ nextRandom();
+		ewelborn_typedArray_push(sortNumbers, &unsortedNumbers[i]);
+	}
+
+	unsortedStrings = ewelborn_dynamicArray_initialize();
+	sortStrings = ewelborn_dynamicArray_initialize();
+	for (size_t i = 0; i < pieceCount; i++) {
+		ewelborn_string* piece = ewelborn_string_initializeWithCString(pieces[i]);
+		ewelborn_dynamicArray_push(unsortedStrings, piece);
+		ewelborn_dynamicArray_push(sortStrings, piece);
+	}
+}
+
+static void freeSortInputs()
+{
+	free(unsortedNumbers);
+	ewelborn_typedArray_free(sortNumbers);
+	freeStrings(unsortedStrings);
+	free(sortStrings->array);
+	free(sortStrings);
+}
+
+static void sortIntsQsort()
+{
+	memcpy(sortNumbers->data, unsortedNumbers, sizeof(int64_t) * elementCount);
+	qsort(sortNumbers->data, elementCount, sizeof(int64_t), compareInt64);
+	sink = (size_t)EWELBORN_TYPED_ARRAY_AT(sortNumbers, int64_t, 0);
+}
+
+static void sortIntsIntrosort()
+{
+	memcpy(sortNumbers->data, unsortedNumbers, sizeof(int64_t) * elementCount);
+	sortInt64s(sortNumbers->data, elementCount);
+	sink = (size_t)EWELBORN_TYPED_ARRAY_AT(sortNumbers, int64_t, 0);
+}
+
+static void sortIntsRadix()
+{
+	memcpy(sortNumbers->data, unsortedNumbers, sizeof(int64_t) * elementCount);
+	ewelborn_typedArray_sortInt64(sortNumbers);
+	sink = (size_t)EWELBORN_TYPED_ARRAY_AT(sortNumbers, int64_t, 0);
+}
+
+static void sortStringsQsort()
+{
+	memcpy(sortStrings->array, unsortedStrings->array, sizeof(void*) * pieceCount);
+	qsort(sortStrings->array, pieceCount, sizeof(void*), compareStrings);
+	sink = (size_t)sortStrings->array[0];
+}
+
+static void sortStringsEwelborn()
+{
+	memcpy(sortStrings->array, unsortedStrings->array, sizeof(void*) * pieceCount);
+	ewelborn_dynamicArray_sortStrings(sortStrings);
+	sink = (size_t)sortStrings->array[0];
+}
+
+static void sortStringsEwelbornParallel()
+{
+	memcpy(sortStrings->array, unsortedStrings->array, sizeof(void*) * pieceCount);
+	ewelborn_dynamicArray_sortStringsParallel(sortStrings, 0);
+	sink = (size_t)sortStrings->array[0];
+}
+
+// *** DYNAMICARRAY_PUSH
+
+static void pushNaive()
+{
+	// Growing the array by one element every push
+	void** array = NULL;
+	for (size_t i = 0; i < elementCount; i++) {
+		array = realloc(array, sizeof(void*) * (i + 1));
+		array[i] = &element;
+	}
+	sink = (size_t)array[elementCount - 1];
+	free(array);
+}
+
+static void pushEwelborn()
+{
+	ewelborn_dynamicArray* array = ewelborn_dynamicArray_initialize();
+	for (size_t i = 0; i < elementCount; i++) {
+		ewelborn_dynamicArray_push(array, &element);
+	}
+	sink = array->elements;
+	free(array->array);
+	free(array);
+}
+
+static void pushTypedArray()
+{
+	ewelborn_typedArray* array = EWELBORN_TYPED_ARRAY_INITIALIZE(int);
+	for (size_t i = 0; i < elementCount; i++) {
+		int value = (int)i;
+		ewelborn_typedArray_push(array, &value);
+	}
+	sink = array->elements;
+	ewelborn_typedArray_free(array);
+}
+
+// *** PRIORITY QUEUE
+
+// Pushes elementCount random priorities, and then pops all of them.
+
+static uint64_t* queuePriorities;
+
+static void createQueuePriorities()
+{
+	free(queuePriorities);
+	queuePriorities = malloc(sizeof(uint64_t) * elementCount);
+	for (size_t i = 0; i < elementCount; i++) {
+		queuePriorities[i] = ((uint64_t)nextRandom() << 15) | nextRandom();
+	}
+}
+
+struct naiveHeapEntry {
+	double priority;
+	void* element;
+};
+
+static void queueNaive()
+{
+	// A textbook binary heap that swaps its way up and down
+	struct naiveHeapEntry* heap = malloc(sizeof(struct naiveHeapEntry) * elementCount);
+	size_t size = 0;
+	for (size_t i = 0; i < elementCount; i++) {
+		size_t position = size++;
+		heap[position] = (struct naiveHeapEntry){ (double)queuePriorities[i], &element };
+		while (position > 0 && heap[(position - 1) / 2].priority > heap[position].priority) {
+			struct naiveHeapEntry swap = heap[position];
+			heap[position] = heap[(position - 1) / 2];
+			heap[(position - 1) / 2] = swap;
+			position = (position - 1) / 2;
+		}
+	}
+
+	double total = 0;
+	while (size > 0) {
+		total += heap[0].priority;
+		heap[0] = heap[--size];
+		size_t position = 0;
+		while (true) {
+			size_t smallest = position;
+			size_t left = 2 * position + 1;
+			size_t right = left + 1;
+			if (left < size && heap[left].priority < heap[smallest].priority) { smallest = left; }
+			if (right < size && heap[right].priority < heap[smallest].priority) { smallest = right; }
+			if (smallest == position) { break; }
+			struct naiveHeapEntry swap = heap[position];
+			heap[position] = heap[smallest];
+			heap[smallest] = swap;
+			position = smallest;
+		}
+	}
+	sink = (size_t)total;
+	free(heap);
+}
+
+static void queueEwelborn()
+{
+	ewelborn_priorityQueue* queue = ewelborn_priorityQueue_initialize();
+	for (size_t i = 0; i < elementCount; i++) {
+		ewelborn_priorityQueue_push(queue, &element, (double)queuePriorities[i]);
+	}
+	double total = 0;
+	double priority;
+	while (ewelborn_priorityQueue_pop(queue, NULL, &priority)) {
+		total += priority;
+	}
+	sink = (size_t)total;
+	ewelborn_priorityQueue_free(queue);
+}
+
+static void queueRadixHeap()
+{
+	ewelborn_radixHeap* heap = ewelborn_radixHeap_initialize();
+	for (size_t i = 0; i < elementCount; i++) {
+		ewelborn_radixHeap_push(heap, &element, queuePriorities[i]);
+	}
+	uint64_t total = 0;
+	uint64_t key;
+	while (ewelborn_radixHeap_pop(heap, NULL, &key)) {
+		total += key;
+	}
+	sink = (size_t)total;
+	ewelborn_radixHeap_free(heap);
+}
+
+// *** LINKED LIST
+
+// Pushes elementCount elements to the back of a list, visits all of them, and
+// then frees the list.
+
+static size_t visited;
+
+static void visit(void* element)
+{
+	(void)element;
+	visited++;
+}
+
+struct naiveNode {
+	void* element;
+	struct naiveNode* next;
+};
+
+static void listNaive()
+{
+	struct naiveNode* head = NULL;
+	struct naiveNode* tail = NULL;
+	for (size_t i = 0; i < elementCount; i++) {
+		struct naiveNode* node = malloc(sizeof(struct naiveNode));
+		node->element = &element;
+		node->next = NULL;
+		if (tail != NULL) { tail->next = node; } else { head = node; }
+		tail = node;
+	}
+
+	visited = 0;
+	for (struct naiveNode* node = head; node != NULL; node = node->next) {
+		visit(node->element);
+	}
+	sink = visited;
+
+	while (head != NULL) {
+		struct naiveNode* next = head->next;
+		free(head);
+		head = next;
+	}
+}
+
+static void listLinkedList()
+{
+	// Inserting after the tail, since pushToBack walks the whole list
+	ewelborn_linkedList* head = ewelborn_linkedList_initializeEmpty();
+	head->element = &element;
+	ewelborn_linkedList* tail = head;
+	for (size_t i = 1; i < elementCount; i++) {
+		ewelborn_linkedList_insert(tail, &element);
+		tail = tail->next;
+	}
+
+	visited = 0;
+	ewelborn_linkedList_traverse(head, visit);
+	sink = visited;
+
+	while (head != NULL) {
+		ewelborn_linkedList* next = head->next;
+		free(head);
+		head = next;
+	}
+}
+
+static void listPooled()
+{
+	ewelborn_list* list = ewelborn_list_initialize();
+	for (size_t i = 0; i < elementCount; i++) {
+		ewelborn_list_pushToBack(list, &element);
+	}
+
+	visited = 0;
+	ewelborn_list_traverse(list, visit);
+	sink = visited;
+
+	// Take the elements back out first, since free would free them
+	while (list->size > 0) {
+		ewelborn_list_popFront(list);
+	}
+	ewelborn_list_free(list);
+}
+
+// *** NUMBER FORMATTING
+
+// Writes elementCount numbers into an estring, separated by commas.
+
+static int64_t* formatInts;
+static double* formatDoubles;
+
+static void createFormatInputs()
+{
+	formatInts = malloc(sizeof(int64_t) * elementCount);
+	formatDoubles = malloc(sizeof(double) * elementCount);
+	for (size_t i = 0; i < elementCount; i++) {
+		// Numbers of every length, and prices and measurements with a few decimals
+		uint64_t bits = ((uint64_t)nextRandom() << 45) | ((uint64_t)nextRandom() << 30) | ((uint64_t)nextRandom() << 15) | nextRandom();
+		formatInts[i] = (int64_t)(bits >> (nextRandom() % 60)) * (nextRandom() % 2 == 0 ? 1 : -1);
+		formatDoubles[i] = (double)(int64_t)(bits >> (nextRandom() % 40 + 20)) / (double)(1 + nextRandom() % 1000);
+	}
+}
+
+static void freeFormatInputs()
+{
+	free(formatInts);
+	free(formatDoubles);
+}
+
+static void formatIntsSnprintf()
+{
+	ewelborn_string* estring = ewelborn_string_initializeEmpty();
+	char buffer[32];
+	for (size_t i = 0; i < elementCount; i++) {
+		int length = snprintf(buffer, sizeof(buffer), "%lld,", (long long)formatInts[i]);
+		ewelborn_string_appendN(estring, buffer, length);
+	}
+	sink = estring->length;
+	ewelborn_string_free(estring);
+}
+
+static void formatIntsAppendf()
+{
+	ewelborn_string* estring = ewelborn_string_initializeEmpty();
+	for (size_t i = 0; i < elementCount; i++) {
+		ewelborn_string_appendf(estring, "%lld,", (long long)formatInts[i]);
+	}
+	sink = estring->length;
+	ewelborn_string_free(estring);
+}
+
+static void formatIntsEwelborn()
+{
+	ewelborn_string* estring = ewelborn_string_initializeEmpty();
+	for (size_t i = 0; i < elementCount; i++) {
+		ewelborn_string_appendInt(estring, formatInts[i]);
+		ewelborn_string_pushChar(estring, ',');
+	}
+	sink = estring->length;
+	ewelborn_string_free(estring);
+}
+
+static void formatDoublesSnprintf()
+{
+	// %.17g is the shortest printf format that always reads back the same
+	ewelborn_string* estring = ewelborn_string_initializeEmpty();
+	char buffer[64];
+	for (size_t i = 0; i < elementCount; i++) {
+		int length = snprintf(buffer, sizeof(buffer), "%.17g,", formatDoubles[i]);
+		ewelborn_string_appendN(estring, buffer, length);
+	}
+	sink = estring->length;
+	ewelborn_string_free(estring);
+}
+
+static void formatDoublesEwelborn()
+{
+	ewelborn_string* estring = ewelborn_string_initializeEmpty();
+	for (size_t i = 0; i < elementCount; i++) {
+		ewelborn_string_appendDouble(estring, formatDoubles[i]);
+		ewelborn_string_pushChar(estring, ',');
+	}
+	sink = estring->length;
+	ewelborn_string_free(estring);
+}
+
+// *** PIPELINE
+
+// Passes elementCount items from a producer on a worker thread to a consumer
+// on this thread through a queue with PIPELINE_CAPACITY slots, so ops_per_s
+// is items per second. The pingPong benchmark bounces one item back and forth
+// between two threads through two queues instead: ops_per_s is round trips
+// per second, and 1e9 / ops_per_s is the round trip latency in nanoseconds.
+
+#define PIPELINE_CAPACITY 1024
+#define PIPELINE_BATCH 32
+#define PING_PONG_ROUNDS 2000
+
+static ewelborn_threadPool* pipelinePool;
+
+// The naive queue is a ring of slots behind a lock, with a condition
+// variable to wait on when the ring is full or empty.
+struct lockedQueue {
+#ifdef _WIN32
+	CRITICAL_SECTION lock;
+	CONDITION_VARIABLE changed;
+#else
+	pthread_mutex_t lock;
+	pthread_cond_t changed;
+#endif
+	void* slots[PIPELINE_CAPACITY];
+	size_t head;
+	size_t tail;
+	bool closed;
+};
+
+static struct lockedQueue lockedQueues[2];
+
+#ifdef _WIN32
+#define LOCKED_QUEUE_LOCK(queue) EnterCriticalSection(&(queue)->lock)
+#define LOCKED_QUEUE_UNLOCK(queue) LeaveCriticalSection(&(queue)->lock)
+#define LOCKED_QUEUE_WAIT(queue) SleepConditionVariableCS(&(queue)->changed, &(queue)->lock, INFINITE)
+#define LOCKED_QUEUE_BROADCAST(queue) WakeAllConditionVariable(&(queue)->changed)
+#else
+#define LOCKED_QUEUE_LOCK(queue) pthread_mutex_lock(&(queue)->lock)
+#define LOCKED_QUEUE_UNLOCK(queue) pthread_mutex_unlock(&(queue)->lock)
+#define LOCKED_QUEUE_WAIT(queue) pthread_cond_wait(&(queue)->changed, &(queue)->lock)
+#define LOCKED_QUEUE_BROADCAST(queue) pthread_cond_broadcast(&(queue)->changed)
+#endif
+
+static void lockedQueueInitialize(struct lockedQueue* queue)
+{
+#ifdef _WIN32
+	InitializeCriticalSection(&queue->lock);
+	InitializeConditionVariable(&queue->changed);
+#else
+	pthread_mutex_init(&queue->lock, NULL);
+	pthread_cond_init(&queue->changed, NULL);
+#endif
+	queue->head = 0;
+	queue->tail = 0;
+	queue->closed = false;
+}
+
+static void lockedQueueFree(struct lockedQueue* queue)
+{
+#ifdef _WIN32
+	DeleteCriticalSection(&queue->lock);
+#else
+	pthread_mutex_destroy(&queue->lock);
+	pthread_cond_destroy(&queue->changed);
+#endif
+}
+
+static void lockedQueuePush(struct lockedQueue* queue, void* item)
+{
+	LOCKED_QUEUE_LOCK(queue);
+	while (queue->tail - queue->head == PIPELINE_CAPACITY) { LOCKED_QUEUE_WAIT(queue); }
+	queue->slots[queue->tail++ % PIPELINE_CAPACITY] = item;
+	LOCKED_QUEUE_BROADCAST(queue);
+	LOCKED_QUEUE_UNLOCK(queue);
+}
+
+static bool lockedQueuePop(struct lockedQueue* queue, void** item)
+{
+	LOCKED_QUEUE_LOCK(queue);
+	while (queue->tail == queue->head && queue->closed == false) { LOCKED_QUEUE_WAIT(queue); }
+	bool found = queue->tail != queue->head;
+	if (found) {
+		*item = queue->slots[queue->head++ % PIPELINE_CAPACITY];
+		LOCKED_QUEUE_BROADCAST(queue);
+	}
+	LOCKED_QUEUE_UNLOCK(queue);
+	return found;
+}
+
+static void lockedQueueClose(struct lockedQueue* queue)
+{
+	LOCKED_QUEUE_LOCK(queue);
+	queue->closed = true;
+	LOCKED_QUEUE_BROADCAST(queue);
+	LOCKED_QUEUE_UNLOCK(queue);
+}
+
+static void produceLocked(void* argument)
+{
+	(void)argument;
+	for (size_t i = 0; i < elementCount; i++) {
+		lockedQueuePush(&lockedQueues[0], (void*)(i + 1));
+	}
+	lockedQueueClose(&lockedQueues[0]);
+}
+
+static void pipelineNaive()
+{
+	lockedQueueInitialize(&lockedQueues[0]);
+	ewelborn_threadPool_submit(pipelinePool, produceLocked, NULL);
+	size_t total = 0;
+	void* item;
+	while (lockedQueuePop(&lockedQueues[0], &item)) {
+		total += (size_t)item;
+	}
+	ewelborn_threadPool_wait(pipelinePool);
+	lockedQueueFree(&lockedQueues[0]);
+	sink = total;
+}
+
+static ewelborn_ringBuffer* ringBuffers[2];
+static int ringBatch; // How many items are pushed and popped at once
+
+static void produceRing(void* argument)
+{
+	(void)argument;
+	void* batch[PIPELINE_BATCH];
+	for (size_t i = 0; i < elementCount; i += ringBatch) {
+		int count = elementCount - i < (size_t)ringBatch ? (int)(elementCount - i) : ringBatch;
+		for (int j = 0; j < count; j++) {
+			batch[j] = (void*)(i + j + 1);
+		}
+		ewelborn_ringBuffer_pushMany(ringBuffers[0], batch, count, EWELBORN_RING_BUFFER_BLOCK);
+	}
+	ewelborn_ringBuffer_close(ringBuffers[0]);
+}
+
+static void pipelineRing(ewelborn_ringBufferKind kind, int batchSize)
+{
+	ringBuffers[0] = ewelborn_ringBuffer_initialize(PIPELINE_CAPACITY, kind);
+	ringBatch = batchSize;
+	ewelborn_threadPool_submit(pipelinePool, produceRing, NULL);
+	size_t total = 0;
+	void* batch[PIPELINE_BATCH];
+	int popped;
+	while ((popped = ewelborn_ringBuffer_popMany(ringBuffers[0], batch, ringBatch, EWELBORN_RING_BUFFER_BLOCK)) > 0) {
+		for (int i = 0; i < popped; i++) {
+			total += (size_t)batch[i];
+		}
+	}
+	ewelborn_threadPool_wait(pipelinePool);
+	ewelborn_ringBuffer_free(ringBuffers[0]);
+	sink = total;
+}
+
+static void pipelineSPSC()
+{
+	pipelineRing(EWELBORN_RING_BUFFER_SPSC, 1);
+}
+
+static void pipelineSPSCBatched()
+{
+	pipelineRing(EWELBORN_RING_BUFFER_SPSC, PIPELINE_BATCH);
+}
+
+static void pipelineMPMC()
+{
+	pipelineRing(EWELBORN_RING_BUFFER_MPMC, 1);
+}
+
+static void echoLocked(void* argument)
+{
+	(void)argument;
+	void* item;
+	while (lockedQueuePop(&lockedQueues[0], &item)) {
+		lockedQueuePush(&lockedQueues[1], item);
+	}
+}
+
+static void pingPongNaive()
+{
+	lockedQueueInitialize(&lockedQueues[0]);
+	lockedQueueInitialize(&lockedQueues[1]);
+	ewelborn_threadPool_submit(pipelinePool, echoLocked, NULL);
+	void* item = &element;
+	for (int i = 0; i < PING_PONG_ROUNDS; i++) {
+		lockedQueuePush(&lockedQueues[0], item);
+		lockedQueuePop(&lockedQueues[1], &item);
+	}
+	lockedQueueClose(&lockedQueues[0]);
+	ewelborn_threadPool_wait(pipelinePool);
+	lockedQueueFree(&lockedQueues[0]);
+	lockedQueueFree(&lockedQueues[1]);
+	sink = (size_t)item;
+}
+
+static void echoRing(void* argument)
+{
+	(void)argument;
+	void* item;
+	while (ewelborn_ringBuffer_pop(ringBuffers[0], &item, EWELBORN_RING_BUFFER_BLOCK)) {
+		ewelborn_ringBuffer_push(ringBuffers[1], item, EWELBORN_RING_BUFFER_BLOCK);
+	}
+}
+
+static void pingPongRing()
+{
+	ringBuffers[0] = ewelborn_ringBuffer_initialize(PIPELINE_CAPACITY, EWELBORN_RING_BUFFER_SPSC);
+	ringBuffers[1] = ewelborn_ringBuffer_initialize(PIPELINE_CAPACITY, EWELBORN_RING_BUFFER_SPSC);
+	ewelborn_threadPool_submit(pipelinePool, echoRing, NULL);
+	void* item = &element;
+	for (int i = 0; i < PING_PONG_ROUNDS; i++) {
+		ewelborn_ringBuffer_push(ringBuffers[0], item, EWELBORN_RING_BUFFER_BLOCK);
+		ewelborn_ringBuffer_pop(ringBuffers[1], &item, EWELBORN_RING_BUFFER_BLOCK);
+	}
+	ewelborn_ringBuffer_close(ringBuffers[0]);
+	ewelborn_threadPool_wait(pipelinePool);
+	ewelborn_ringBuffer_free(ringBuffers[0]);
+	ewelborn_ringBuffer_free(ringBuffers[1]);
+	sink = (size_t)item;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1) { benchmarkFilter = argv[1]; }
+	textPath = ewelborn_string_initializeWithCString("bench_lines.txt");
+	csvPath = ewelborn_string_initializeWithCString("bench_table.csv");
+	// The producer side of the pipelines runs on here
+	pipelinePool = ewelborn_threadPool_initialize(1);
+
+	printf("benchmark,implementation,size,runs,median_ns,p99_ns,mb_per_s,ops_per_s,speedup\n");
+	for (size_t i = 0; i < sizeof(inputSizes) / sizeof(inputSizes[0]); i++) {
+		size_t size = inputSizes[i];
+		createText(size);
+
+		runBenchmark("split", "naive", true, size, size, textLines, splitNaive);
+		runBenchmark("split", "ewelborn", false, size, size, textLines, splitEwelborn);
+		runBenchmark("split", "ewelbornParallel", false, size, size, textLines, splitEwelbornParallel);
+		runBenchmark("split", "ewelbornViews", false, size, size, textLines, splitViews);
+
+		createTokens(size);
+		runBenchmark("intern", "split", true, size, (size_t)tokenText->length, tokenCount, internSplit);
+		runBenchmark("intern", "ewelborn", false, size, (size_t)tokenText->length, tokenCount, internPool);
+
+		runBenchmark("tokenize", "strcspn", true, size, size, pieceCount, tokenizeStrcspn);
+		runBenchmark("tokenize", "ewelborn", false, size, size, pieceCount, tokenizeEwelborn);
+
+		createNumbers(size, false);
+		runBenchmark("parseInts", "strtoll", true, size, numberTextSize, numberCount, parseIntsStrtoll);
+		runBenchmark("parseInts", "ewelborn", false, size, numberTextSize, numberCount, parseIntsEwelborn);
+		createNumbers(size, true);
+		runBenchmark("parseDoubles", "strtod", true, size, numberTextSize, numberCount, parseDoublesStrtod);
+		runBenchmark("parseDoubles", "ewelborn", false, size, numberTextSize, numberCount, parseDoublesEwelborn);
+
+		runBenchmark("findChar", "naive", true, size, size, 1, findCharNaive);
+		runBenchmark("findChar", "memchr", false, size, size, 1, findCharMemchr);
+		runBenchmark("findChar", "ewelborn", false, size, size, 1, findCharEwelborn);
+
+		runBenchmark("find", "naive", true, size, size, 1, findNaive);
+		runBenchmark("find", "strstr", false, size, size, 1, findStrstr);
+		runBenchmark("find", "ewelborn", false, size, size, 1, findEwelborn);
+
+		hardText = malloc(size + 1);
+		memset(hardText, 'a', size);
+		hardText[size] = '\0';
+		memset(hardNeedle, 'a', sizeof(hardNeedle) - 1);
+		hardNeedle[sizeof(hardNeedle) - 2] = 'b';
+		runBenchmark("findPathological", "naive", true, size, size, 1, findHardNaive);
+		runBenchmark("findPathological", "strstr", false, size, size, 1, findHardStrstr);
+		runBenchmark("findPathological", "ewelborn", false, size, size, 1, findHardEwelborn);
+		free(hardText);
+
+		runBenchmark("appendCString", "naive", true, size, size, pieceCount, appendNaive);
+		runBenchmark("appendCString", "libc", false, size, size, pieceCount, appendLibc);
+		runBenchmark("appendCString", "ewelborn", false, size, size, pieceCount, appendEwelborn);
+
+		createCSV(size);
+		runBenchmark("readCSV", "split", true, size, size, csvRows, readCSVSplit);
+		runBenchmark("readCSV", "ewelborn", false, size, size, csvRows, readCSVEwelborn);
+
+		runBenchmark("readLinesFromFile", "fgets", true, size, size, textLines, readLinesFgets);
+		runBenchmark("readLinesFromFile", "ewelborn", false, size, size, textLines, readLinesEwelborn);
+		runBenchmark("readLinesFromFile", "ewelbornParallel", false, size, size, textLines, readLinesEwelbornParallel);
+		runBenchmark("readLinesFromFile", "lineReader", false, size, size, textLines, readLinesLineReader);
+
+		// The data structures are measured in elements instead of bytes
+		elementCount = size / 4;
+		size_t bytes = elementCount * sizeof(void*);
+		createSortInputs();
+		runBenchmark("sortStrings", "qsort", true, size, size, pieceCount, sortStringsQsort);
+		runBenchmark("sortStrings", "ewelborn", false, size, size, pieceCount, sortStringsEwelborn);
+		runBenchmark("sortStrings", "ewelbornParallel", false, size, size, pieceCount, sortStringsEwelbornParallel);
+		runBenchmark("sortInts", "qsort", true, elementCount, elementCount * sizeof(int64_t), elementCount, sortIntsQsort);
+		runBenchmark("sortInts", "introsort", false, elementCount, elementCount * sizeof(int64_t), elementCount, sortIntsIntrosort);
+		runBenchmark("sortInts", "radix", false, elementCount, elementCount * sizeof(int64_t), elementCount, sortIntsRadix);
+		freeSortInputs();
+
+		runBenchmark("dynamicArray_push", "naive", true, elementCount, bytes, elementCount, pushNaive);
+		runBenchmark("dynamicArray_push", "ewelborn", false, elementCount, bytes, elementCount, pushEwelborn);
+		runBenchmark("dynamicArray_push", "typedArray", false, elementCount, bytes, elementCount, pushTypedArray);
+
+		createQueuePriorities();
+		runBenchmark("priorityQueue", "naive", true, elementCount, bytes, elementCount, queueNaive);
+		runBenchmark("priorityQueue", "ewelborn", false, elementCount, bytes, elementCount, queueEwelborn);
+		runBenchmark("priorityQueue", "radixHeap", false, elementCount, bytes, elementCount, queueRadixHeap);
+
+		runBenchmark("linkedList", "naive", true, elementCount, bytes, elementCount, listNaive);
+		runBenchmark("linkedList", "linkedList", false, elementCount, bytes, elementCount, listLinkedList);
+		runBenchmark("linkedList", "list", false, elementCount, bytes, elementCount, listPooled);
+
+		createFormatInputs();
+		runBenchmark("formatInts", "snprintf", true, elementCount, elementCount * sizeof(int64_t), elementCount, formatIntsSnprintf);
+		runBenchmark("formatInts", "appendf", false, elementCount, elementCount * sizeof(int64_t), elementCount, formatIntsAppendf);
+		runBenchmark("formatInts", "ewelborn", false, elementCount, elementCount * sizeof(int64_t), elementCount, formatIntsEwelborn);
+		runBenchmark("formatDoubles", "snprintf", true, elementCount, elementCount * sizeof(double), elementCount, formatDoublesSnprintf);
+		runBenchmark("formatDoubles", "ewelborn", false, elementCount, elementCount * sizeof(double), elementCount, formatDoublesEwelborn);
+		freeFormatInputs();
+
+		runBenchmark("pipeline", "naive", true, elementCount, bytes, elementCount, pipelineNaive);
+		runBenchmark("pipeline", "ringBufferSPSC", false, elementCount, bytes, elementCount, pipelineSPSC);
+		runBenchmark("pipeline", "ringBufferSPSCBatched", false, elementCount, bytes, elementCount, pipelineSPSCBatched);
+		runBenchmark("pipeline", "ringBufferMPMC", false, elementCount, bytes, elementCount, pipelineMPMC);
+	}
+
+	runBenchmark("pingPong", "naive", true, PING_PONG_ROUNDS, PING_PONG_ROUNDS * sizeof(void*), PING_PONG_ROUNDS, pingPongNaive);
+	runBenchmark("pingPong", "ringBufferSPSC", false, PING_PONG_ROUNDS, PING_PONG_ROUNDS * sizeof(void*), PING_PONG_ROUNDS, pingPongRing);
+
+	ewelborn_threadPool_free(pipelinePool);
+	free(queuePriorities);
+	ewelborn_string_free(tokenText);
+	remove(textPath->cstring);
+	remove(csvPath->cstring);
+	return 0;
+}
@@ -1,406 +1,8109 @@
+// Makes the POSIX functions (mmap, madvise, etc.) visible on glibc even
+// when compiling in strict standard C mode.
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include "ewelbornUtil.h"
 
-ewelborn_dynamicArray* ewelborn_dynamicArray_initialize()
+#include <errno.h>
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define EWELBORN_X86
+#ifndef _MSC_VER
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+#endif
+
+static void* heapAllocate(void* context, size_t size, ewelborn_allocationCategory category)
 {
-	ewelborn_dynamicArray* dynamicArray = malloc(sizeof(ewelborn_dynamicArray));
-	if (dynamicArray == NULL) { return NULL; }
-	dynamicArray->elements = 0;
-	dynamicArray->maxElements = EWELBORN_DYNAMIC_ARRAY_STARTING_SIZE;
-	dynamicArray->array = malloc(sizeof(void*) * dynamicArray->maxElements);
-	if (dynamicArray->array == NULL) {
-		free(dynamicArray);
+	(void)context;
+	(void)category;
+	return malloc(size);
+}
+
+static void* heapReallocate(void* context, void* pointer, size_t oldSize, size_t newSize, ewelborn_allocationCategory category)
+{
+	(void)context;
+	(void)oldSize;
+	(void)category;
+	return realloc(pointer, newSize);
+}
+
+static void heapRelease(void* context, void* pointer, ewelborn_allocationCategory category)
+{
+	(void)context;
+	(void)category;
+	free(pointer);
+}
+
+static ewelborn_allocator heapAllocator = { heapAllocate, heapReallocate, heapRelease, NULL };
+static ewelborn_allocator* globalAllocator = &heapAllocator;
+
+ewelborn_allocator* ewelborn_getHeapAllocator()
+{
+	return &heapAllocator;
+}
+
+ewelborn_allocator* ewelborn_getAllocator()
+{
+	return globalAllocator;
+}
+
+void ewelborn_setAllocator(ewelborn_allocator* allocator)
+{
+	globalAllocator = allocator != NULL ? allocator : &heapAllocator;
+}
+
+// Datastructures use these to manage their memory, which will use the global
+// allocator when allocator is null.
+
+static void* allocateFrom(ewelborn_allocator* allocator, size_t size, ewelborn_allocationCategory category)
+{
+	if (allocator == NULL) { allocator = globalAllocator; }
+	return allocator->allocate(allocator->context, size, category);
+}
+
+static void* reallocateFrom(ewelborn_allocator* allocator, void* pointer, size_t oldSize, size_t newSize, ewelborn_allocationCategory category)
+{
+	if (allocator == NULL) { allocator = globalAllocator; }
+	return allocator->reallocate(allocator->context, pointer, oldSize, newSize, category);
+}
+
+static void releaseTo(ewelborn_allocator* allocator, void* pointer, ewelborn_allocationCategory category)
+{
+	if (allocator == NULL) { allocator = globalAllocator; }
+	allocator->release(allocator->context, pointer, category);
+}
+
+void* ewelborn_allocator_allocate(ewelborn_allocator* allocator, size_t size, ewelborn_allocationCategory category)
+{
+	return allocateFrom(allocator, size, category);
+}
+
+void* ewelborn_allocator_reallocate(ewelborn_allocator* allocator, void* pointer, size_t oldSize, size_t newSize, ewelborn_allocationCategory category)
+{
+	return reallocateFrom(allocator, pointer, oldSize, newSize, category);
+}
+
+void ewelborn_allocator_release(ewelborn_allocator* allocator, void* pointer, ewelborn_allocationCategory category)
+{
+	releaseTo(allocator, pointer, category);
+}
+
+// Chunks store their memory directly after the chunk itself. The header is
+// padded so that the memory starts out aligned.
+#define ARENA_CHUNK_HEADER_SIZE ((sizeof(ewelborn_arenaChunk) + EWELBORN_ARENA_ALIGNMENT - 1) & ~(size_t)(EWELBORN_ARENA_ALIGNMENT - 1))
+
+static char* arenaChunkData(ewelborn_arenaChunk* chunk)
+{
+	return (char*)chunk + ARENA_CHUNK_HEADER_SIZE;
+}
+
+static size_t arenaAlign(size_t size)
+{
+	return (size + EWELBORN_ARENA_ALIGNMENT - 1) & ~(size_t)(EWELBORN_ARENA_ALIGNMENT - 1);
+}
+
+static ewelborn_arenaChunk* arenaCreateChunk(ewelborn_arena* arena, size_t size)
+{
+	if (size > (size_t)-1 - ARENA_CHUNK_HEADER_SIZE) { return NULL; }
+	ewelborn_arenaChunk* chunk = allocateFrom(arena->backing, ARENA_CHUNK_HEADER_SIZE + size, EWELBORN_ALLOCATION_OTHER);
+	if (chunk == NULL) { return NULL; }
+	chunk->next = NULL;
+	chunk->size = size;
+	chunk->used = 0;
+	return chunk;
+}
+
+static void* arenaAllocate(void* context, size_t size, ewelborn_allocationCategory category)
+{
+	(void)category;
+	return ewelborn_arena_allocate(context, size);
+}
+
+static void* arenaReallocate(void* context, void* pointer, size_t oldSize, size_t newSize, ewelborn_allocationCategory category)
+{
+	(void)category;
+	return ewelborn_arena_reallocate(context, pointer, oldSize, newSize);
+}
+
+static void arenaRelease(void* context, void* pointer, ewelborn_allocationCategory category)
+{
+	// Memory from an arena is released all at once when the arena is reset
+	(void)context;
+	(void)pointer;
+	(void)category;
+}
+
+// Returns true if the allocator hands out memory from an arena, in which case
+// there's no point in giving memory back to it.
+static bool allocatorIsArena(ewelborn_allocator* allocator)
+{
+	return allocator != NULL && allocator->release == arenaRelease;
+}
+
+ewelborn_arena* ewelborn_arena_initialize(size_t chunkSize)
+{
+	return ewelborn_arena_initializeWithAllocator(chunkSize, NULL);
+}
+
+ewelborn_arena* ewelborn_arena_initializeWithAllocator(size_t chunkSize, ewelborn_allocator* backing)
+{
+	if (backing == NULL) { backing = globalAllocator; }
+	ewelborn_arena* arena = allocateFrom(backing, sizeof(ewelborn_arena), EWELBORN_ALLOCATION_OTHER);
+	if (arena == NULL) { return NULL; }
+	arena->backing = backing;
+	arena->allocator.allocate = arenaAllocate;
+	arena->allocator.reallocate = arenaReallocate;
+	arena->allocator.release = arenaRelease;
+	arena->allocator.context = arena;
+	arena->chunkSize = chunkSize > 0 ? arenaAlign(chunkSize) : EWELBORN_ARENA_DEFAULT_CHUNK_SIZE;
+	arena->first = arenaCreateChunk(arena, arena->chunkSize);
+	if (arena->first == NULL) {
+		releaseTo(backing, arena, EWELBORN_ALLOCATION_OTHER);
 		return NULL;
 	}
-	return dynamicArray;
+	arena->current = arena->first;
+	return arena;
+}
+
+void* ewelborn_arena_allocate(ewelborn_arena* arena, size_t size)
+{
+	if (size > (size_t)-1 - EWELBORN_ARENA_ALIGNMENT) { return NULL; }
+	size = arenaAlign(size);
+
+	ewelborn_arenaChunk* chunk = arena->current;
+	if (chunk->size - chunk->used < size) {
+		// Every chunk after the current chunk is unused, since the arena only
+		// moves forward through its chunks. Reuse the next chunk if it's large
+		// enough, otherwise, chain a new chunk in right after the current one.
+		if (chunk->next != NULL && chunk->next->size >= size) {
+			chunk = chunk->next;
+			chunk->used = 0;
+		}
+		else {
+			ewelborn_arenaChunk* newChunk = arenaCreateChunk(arena, size > arena->chunkSize ? size : arena->chunkSize);
+			if (newChunk == NULL) { return NULL; }
+			newChunk->next = chunk->next;
+			chunk->next = newChunk;
+			chunk = newChunk;
+		}
+		arena->current = chunk;
+	}
+
+	void* pointer = arenaChunkData(chunk) + chunk->used;
+	chunk->used += size;
+	return pointer;
+}
+
+void* ewelborn_arena_reallocate(ewelborn_arena* arena, void* pointer, size_t oldSize, size_t newSize)
+{
+	if (pointer == NULL) { return ewelborn_arena_allocate(arena, newSize); }
+
+	// If this was the last allocation, then it can be resized in place
+	// by moving the end of the chunk, as long as the chunk has room.
+	ewelborn_arenaChunk* chunk = arena->current;
+	char* chunkEnd = arenaChunkData(chunk) + chunk->used;
+	if ((char*)pointer + arenaAlign(oldSize) == chunkEnd && newSize <= (size_t)-1 - EWELBORN_ARENA_ALIGNMENT) {
+		size_t offset = (char*)pointer - arenaChunkData(chunk);
+		if (arenaAlign(newSize) <= chunk->size - offset) {
+			chunk->used = offset + arenaAlign(newSize);
+			return pointer;
+		}
+	}
+
+	void* newPointer = ewelborn_arena_allocate(arena, newSize);
+	if (newPointer == NULL) { return NULL; }
+	memcpy(newPointer, pointer, oldSize < newSize ? oldSize : newSize);
+	return newPointer;
+}
+
+ewelborn_arenaMark ewelborn_arena_mark(ewelborn_arena* arena)
+{
+	ewelborn_arenaMark mark = { arena->current, arena->current->used };
+	return mark;
+}
+
+void ewelborn_arena_resetToMark(ewelborn_arena* arena, ewelborn_arenaMark mark)
+{
+	arena->current = mark.chunk;
+	arena->current->used = mark.used;
+}
+
+void ewelborn_arena_reset(ewelborn_arena* arena)
+{
+	arena->current = arena->first;
+	arena->current->used = 0;
+}
+
+void ewelborn_arena_free(ewelborn_arena* arena)
+{
+	ewelborn_arenaChunk* chunk = arena->first;
+	while (chunk != NULL) {
+		ewelborn_arenaChunk* next = chunk->next;
+		releaseTo(arena->backing, chunk, EWELBORN_ALLOCATION_OTHER);
+		chunk = next;
+	}
+	releaseTo(arena->backing, arena, EWELBORN_ALLOCATION_OTHER);
+}
+
+// Returns the arena's allocator, or null (the global allocator) if arena is null.
+static ewelborn_allocator* arenaAllocator(ewelborn_arena* arena)
+{
+	return arena != NULL ? &arena->allocator : NULL;
+}
+
+// A thread that calls function(argument), on top of whichever threads the
+// platform provides.
+struct thread {
+#ifdef _WIN32
+	HANDLE handle;
+#else
+	pthread_t handle;
+#endif
+	void(*function)(void*);
+	void* argument;
+};
+
+#ifdef _WIN32
+static DWORD WINAPI threadEntry(LPVOID parameter)
+#else
+static void* threadEntry(void* parameter)
+#endif
+{
+	struct thread* thread = parameter;
+	thread->function(thread->argument);
+	return 0;
+}
+
+// Starts a thread that calls function(argument). The thread struct must stay
+// alive until the thread is joined. Returns true if successful, false otherwise.
+static bool threadStart(struct thread* thread, void(*function)(void*), void* argument)
+{
+	thread->function = function;
+	thread->argument = argument;
+#ifdef _WIN32
+	thread->handle = CreateThread(NULL, 0, threadEntry, thread, 0, NULL);
+	return thread->handle != NULL;
+#else
+	return pthread_create(&thread->handle, NULL, threadEntry, thread) == 0;
+#endif
+}
+
+// Waits for the thread to finish.
+static void threadJoin(struct thread* thread)
+{
+#ifdef _WIN32
+	WaitForSingleObject(thread->handle, INFINITE);
+	CloseHandle(thread->handle);
+#else
+	pthread_join(thread->handle, NULL);
+#endif
+}
+
+// Gives up the rest of the calling thread's time slice.
+static void threadYield()
+{
+#ifdef _WIN32
+	SwitchToThread();
+#else
+	sched_yield();
+#endif
+}
+
+// Tells the CPU that the calling thread is spinning while it waits for
+// another thread, which saves power and lets the other hyperthread on the
+// same core run faster.
+static void cpuRelax()
+{
+#if defined(EWELBORN_X86) && defined(_MSC_VER)
+	_mm_pause();
+#elif defined(EWELBORN_X86)
+	__builtin_ia32_pause();
+#endif
+}
+
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
+// Mutexes and condition variables, on top of whichever ones the platform
+// provides.
+struct mutex {
+#ifdef _WIN32
+	SRWLOCK lock;
+#else
+	pthread_mutex_t lock;
+#endif
+};
+
+struct condition {
+#ifdef _WIN32
+	CONDITION_VARIABLE variable;
+#else
+	pthread_cond_t variable;
+#endif
+};
+
+static bool mutexInitialize(struct mutex* mutex)
+{
+#ifdef _WIN32
+	InitializeSRWLock(&mutex->lock);
+	return true;
+#else
+	return pthread_mutex_init(&mutex->lock, NULL) == 0;
+#endif
+}
+
+static void mutexLock(struct mutex* mutex)
+{
+#ifdef _WIN32
+	AcquireSRWLockExclusive(&mutex->lock);
+#else
+	pthread_mutex_lock(&mutex->lock);
+#endif
+}
+
+static void mutexUnlock(struct mutex* mutex)
+{
+#ifdef _WIN32
+	ReleaseSRWLockExclusive(&mutex->lock);
+#else
+	pthread_mutex_unlock(&mutex->lock);
+#endif
+}
+
+static void mutexFree(struct mutex* mutex)
+{
+#ifndef _WIN32
+	pthread_mutex_destroy(&mutex->lock);
+#endif
+}
+
+static bool conditionInitialize(struct condition* condition)
+{
+#ifdef _WIN32
+	InitializeConditionVariable(&condition->variable);
+	return true;
+#else
+	return pthread_cond_init(&condition->variable, NULL) == 0;
+#endif
+}
+
+// Releases the mutex, waits for the condition to be signaled, and then
+// takes the mutex back. This may return without being signaled.
+static void conditionWait(struct condition* condition, struct mutex* mutex)
+{
+#ifdef _WIN32
+	SleepConditionVariableSRW(&condition->variable, &mutex->lock, INFINITE, 0);
+#else
+	pthread_cond_wait(&condition->variable, &mutex->lock);
+#endif
+}
+
+static void conditionSignal(struct condition* condition)
+{
+#ifdef _WIN32
+	WakeConditionVariable(&condition->variable);
+#else
+	pthread_cond_signal(&condition->variable);
+#endif
+}
+
+static void conditionBroadcast(struct condition* condition)
+{
+#ifdef _WIN32
+	WakeAllConditionVariable(&condition->variable);
+#else
+	pthread_cond_broadcast(&condition->variable);
+#endif
+}
+
+static void conditionFree(struct condition* condition)
+{
+#ifndef _WIN32
+	pthread_cond_destroy(&condition->variable);
+#endif
+}
+
+// Atomic operations on longs that are shared between threads. Every one of
+// these is sequentially consistent.
+static long atomicIncrement(volatile long* value)
+{
+#ifdef _WIN32
+	return InterlockedIncrement(value);
+#else
+	return __atomic_add_fetch(value, 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static long atomicDecrement(volatile long* value)
+{
+#ifdef _WIN32
+	return InterlockedDecrement(value);
+#else
+	return __atomic_sub_fetch(value, 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static long atomicLoad(volatile long* value)
+{
+#ifdef _WIN32
+	return InterlockedCompareExchange(value, 0, 0);
+#else
+	return __atomic_load_n(value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static void atomicStore(volatile long* value, long newValue)
+{
+#ifdef _WIN32
+	InterlockedExchange(value, newValue);
+#else
+	__atomic_store_n(value, newValue, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Atomic operations on 64-bit counters, which are used for the allocation
+// statistics. Every one of these is sequentially consistent.
+static long long atomicAdd64(volatile long long* value, long long amount)
+{
+#ifdef _WIN32
+	return InterlockedExchangeAdd64(value, amount) + amount;
+#else
+	return __atomic_add_fetch(value, amount, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static long long atomicLoad64(volatile long long* value)
+{
+#ifdef _WIN32
+	return InterlockedCompareExchange64(value, 0, 0);
+#else
+	return __atomic_load_n(value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static void atomicStore64(volatile long long* value, long long newValue)
+{
+#ifdef _WIN32
+	InterlockedExchange64(value, newValue);
+#else
+	__atomic_store_n(value, newValue, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Atomic operations on 64-bit values with weaker ordering than the ones
+// above, for the ring buffers, where a sequentially consistent store on
+// every push would cost more than the rest of the push put together. An
+// acquire load sees everything that the thread did before its matching
+// release store. Windows only has full barriers, so it uses those.
+static long long atomicLoadRelaxed64(volatile long long* value)
+{
+#ifdef _WIN32
+	return InterlockedCompareExchange64(value, 0, 0);
+#else
+	return __atomic_load_n(value, __ATOMIC_RELAXED);
+#endif
+}
+
+static long long atomicLoadAcquire64(volatile long long* value)
+{
+#ifdef _WIN32
+	return InterlockedCompareExchange64(value, 0, 0);
+#else
+	return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void atomicStoreRelease64(volatile long long* value, long long newValue)
+{
+#ifdef _WIN32
+	InterlockedExchange64(value, newValue);
+#else
+	__atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+#endif
+}
+
+// Sets value to newValue if it's still equal to *expected, and returns true.
+// Otherwise, stores what value was in *expected, and returns false.
+static bool atomicCompareExchange64(volatile long long* value, long long* expected, long long newValue)
+{
+#ifdef _WIN32
+	long long previous = InterlockedCompareExchange64(value, newValue, *expected);
+	if (previous == *expected) { return true; }
+	*expected = previous;
+	return false;
+#else
+	return __atomic_compare_exchange_n(value, expected, newValue, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+#endif
+}
+
+// Keeps every load and store before this point from being reordered with
+// any load or store after it.
+static void atomicFence()
+{
+#ifdef _WIN32
+	MemoryBarrier();
+#else
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+}
+
+// Raises value to newValue, unless it's already at least that large.
+static void atomicMax64(volatile long long* value, long long newValue)
+{
+	long long current = atomicLoad64(value);
+	while (current < newValue) {
+#ifdef _WIN32
+		long long previous = InterlockedCompareExchange64(value, newValue, current);
+		if (previous == current) { return; }
+		current = previous;
+#else
+		if (__atomic_compare_exchange_n(value, &current, newValue, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) { return; }
+#endif
+	}
+}
+
+// Every allocation from a stats allocator starts with this header, padded so
+// that the memory after it keeps the backing allocator's alignment.
+#define STATS_ALLOCATOR_HEADER_SIZE 16
+struct statsAllocationHeader {
+	size_t size;
+	ewelborn_allocationCategory category;
+};
+
+static void statsRecord(ewelborn_allocationStats* stats, long long allocations, long long reallocations,
+	long long releases, long long bytes)
+{
+	if (allocations != 0) { atomicAdd64(&stats->allocations, allocations); }
+	if (reallocations != 0) { atomicAdd64(&stats->reallocations, reallocations); }
+	if (releases != 0) { atomicAdd64(&stats->releases, releases); }
+	long long liveBytes = atomicAdd64(&stats->liveBytes, bytes);
+	if (bytes > 0) { atomicMax64(&stats->peakBytes, liveBytes); }
+}
+
+// Counts an allocation in the totals, and in its category.
+static void statsCount(ewelborn_statsAllocator* stats, ewelborn_allocationCategory category,
+	long long allocations, long long reallocations, long long releases, long long bytes)
+{
+	statsRecord(&stats->total, allocations, reallocations, releases, bytes);
+	statsRecord(&stats->categories[category], allocations, reallocations, releases, bytes);
+}
+
+static ewelborn_allocationCategory statsCheckCategory(ewelborn_allocationCategory category)
+{
+	return category >= 0 && category < EWELBORN_ALLOCATION_CATEGORY_COUNT ? category : EWELBORN_ALLOCATION_OTHER;
+}
+
+static void* statsAllocate(void* context, size_t size, ewelborn_allocationCategory category)
+{
+	ewelborn_statsAllocator* stats = context;
+	if (size > (size_t)LLONG_MAX - STATS_ALLOCATOR_HEADER_SIZE) { return NULL; }
+	category = statsCheckCategory(category);
+
+	struct statsAllocationHeader* header = allocateFrom(stats->backing, STATS_ALLOCATOR_HEADER_SIZE + size, category);
+	if (header == NULL) { return NULL; }
+	header->size = size;
+	header->category = category;
+	statsCount(stats, category, 1, 0, 0, (long long)size);
+	return (char*)header + STATS_ALLOCATOR_HEADER_SIZE;
+}
+
+static void* statsReallocate(void* context, void* pointer, size_t oldSize, size_t newSize, ewelborn_allocationCategory category)
+{
+	ewelborn_statsAllocator* stats = context;
+	if (pointer == NULL) { return statsAllocate(context, newSize, category); }
+	if (newSize > (size_t)LLONG_MAX - STATS_ALLOCATOR_HEADER_SIZE) { return NULL; }
+
+	// The header knows the real size and category, whatever the caller says
+	struct statsAllocationHeader* header = (struct statsAllocationHeader*)((char*)pointer - STATS_ALLOCATOR_HEADER_SIZE);
+	oldSize = header->size;
+	category = header->category;
+	header = reallocateFrom(stats->backing, header, STATS_ALLOCATOR_HEADER_SIZE + oldSize,
+		STATS_ALLOCATOR_HEADER_SIZE + newSize, category);
+	if (header == NULL) { return NULL; }
+	header->size = newSize;
+	statsCount(stats, category, 0, 1, 0, (long long)newSize - (long long)oldSize);
+	return (char*)header + STATS_ALLOCATOR_HEADER_SIZE;
+}
+
+static void statsRelease(void* context, void* pointer, ewelborn_allocationCategory category)
+{
+	// The header remembers the category that the memory was allocated with
+	(void)category;
+	ewelborn_statsAllocator* stats = context;
+	if (pointer == NULL) { return; }
+
+	struct statsAllocationHeader* header = (struct statsAllocationHeader*)((char*)pointer - STATS_ALLOCATOR_HEADER_SIZE);
+	statsCount(stats, header->category, 0, 0, 1, -(long long)header->size);
+	releaseTo(stats->backing, header, header->category);
+}
+
+ewelborn_statsAllocator* ewelborn_statsAllocator_initialize(ewelborn_allocator* backing)
+{
+	// The heap is used by default (instead of the global allocator) so that
+	// the stats allocator can be made the global allocator itself.
+	if (backing == NULL) { backing = &heapAllocator; }
+	ewelborn_statsAllocator* stats = allocateFrom(backing, sizeof(ewelborn_statsAllocator), EWELBORN_ALLOCATION_OTHER);
+	if (stats == NULL) { return NULL; }
+	memset(stats, 0, sizeof(ewelborn_statsAllocator));
+	stats->allocator.allocate = statsAllocate;
+	stats->allocator.reallocate = statsReallocate;
+	stats->allocator.release = statsRelease;
+	stats->allocator.context = stats;
+	stats->backing = backing;
+	return stats;
+}
+
+static ewelborn_allocationStats statsLoad(ewelborn_allocationStats* stats)
+{
+	ewelborn_allocationStats result;
+	result.allocations = atomicLoad64(&stats->allocations);
+	result.reallocations = atomicLoad64(&stats->reallocations);
+	result.releases = atomicLoad64(&stats->releases);
+	result.liveBytes = atomicLoad64(&stats->liveBytes);
+	result.peakBytes = atomicLoad64(&stats->peakBytes);
+	return result;
+}
+
+ewelborn_allocationStats ewelborn_statsAllocator_getTotal(ewelborn_statsAllocator* stats)
+{
+	return statsLoad(&stats->total);
+}
+
+ewelborn_allocationStats ewelborn_statsAllocator_getCategory(ewelborn_statsAllocator* stats, ewelborn_allocationCategory category)
+{
+	return statsLoad(&stats->categories[statsCheckCategory(category)]);
+}
+
+static void statsReset(ewelborn_allocationStats* stats)
+{
+	atomicStore64(&stats->allocations, 0);
+	atomicStore64(&stats->reallocations, 0);
+	atomicStore64(&stats->releases, 0);
+	atomicStore64(&stats->peakBytes, atomicLoad64(&stats->liveBytes));
+}
+
+void ewelborn_statsAllocator_resetCounts(ewelborn_statsAllocator* stats)
+{
+	statsReset(&stats->total);
+	for (int i = 0; i < EWELBORN_ALLOCATION_CATEGORY_COUNT; i++) {
+		statsReset(&stats->categories[i]);
+	}
+}
+
+static void statsPrintRow(FILE* file, const char* name, ewelborn_allocationStats stats)
+{
+	fprintf(file, "%-10s %12lld %12lld %12lld %14lld %14lld\n", name,
+		stats.allocations, stats.reallocations, stats.releases, stats.liveBytes, stats.peakBytes);
+}
+
+void ewelborn_statsAllocator_print(ewelborn_statsAllocator* stats, FILE* file)
+{
+	static const char* categoryNames[EWELBORN_ALLOCATION_CATEGORY_COUNT] = {
+		"other", "string", "array", "list", "hashMap", "file", "threading"
+	};
+
+	fprintf(file, "%-10s %12s %12s %12s %14s %14s\n", "category",
+		"allocations", "reallocs", "releases", "liveBytes", "peakBytes");
+	for (int i = 0; i < EWELBORN_ALLOCATION_CATEGORY_COUNT; i++) {
+		ewelborn_allocationStats category = ewelborn_statsAllocator_getCategory(stats, i);
+		// Skip the categories that were never used
+		if (category.allocations == 0 && category.releases == 0 && category.liveBytes == 0) { continue; }
+		statsPrintRow(file, categoryNames[i], category);
+	}
+	statsPrintRow(file, "total", ewelborn_statsAllocator_getTotal(stats));
+}
+
+void ewelborn_statsAllocator_free(ewelborn_statsAllocator* stats)
+{
+	releaseTo(stats->backing, stats, EWELBORN_ALLOCATION_OTHER);
+}
+
+int ewelborn_getProcessorCount()
+{
+#ifdef _WIN32
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo(&systemInfo);
+	return systemInfo.dwNumberOfProcessors > 0 ? (int)systemInfo.dwNumberOfProcessors : 1;
+#else
+	long processors = sysconf(_SC_NPROCESSORS_ONLN);
+	return processors > 0 ? (int)processors : 1;
+#endif
+}
+
+// Picks how many threads to split work of the given size between, so that
+// each thread gets at least minimumWork of it. threadCount <= 0 means one
+// thread per processor.
+static int pickThreadCount(int threadCount, size_t work, size_t minimumWork)
+{
+	if (threadCount <= 0) { threadCount = ewelborn_getProcessorCount(); }
+	size_t maxThreads = minimumWork > 0 ? work / minimumWork : work;
+	if (maxThreads < (size_t)threadCount) { threadCount = (int)maxThreads; }
+	return threadCount > 0 ? threadCount : 1;
+}
+
+// Calls function on every task in tasks, an array of count tasks that are
+// each taskSize bytes, with every task running on its own thread. The calling
+// thread runs the first task itself, and also runs any task whose thread
+// couldn't be started, so every task is always run. Returns once every task
+// has finished.
+static void runTasksInParallel(void* tasks, size_t taskSize, int count, void(*function)(void*))
+{
+	struct thread* threads = count > 1 ? allocateFrom(NULL, sizeof(struct thread) * count, EWELBORN_ALLOCATION_THREADING) : NULL;
+	bool* started = count > 1 ? allocateFrom(NULL, sizeof(bool) * count, EWELBORN_ALLOCATION_THREADING) : NULL;
+	if (threads == NULL || started == NULL) {
+		for (int i = 0; i < count; i++) {
+			function((char*)tasks + taskSize * i);
+		}
+		releaseTo(NULL, threads, EWELBORN_ALLOCATION_THREADING);
+		releaseTo(NULL, started, EWELBORN_ALLOCATION_THREADING);
+		return;
+	}
+
+	for (int i = 1; i < count; i++) {
+		started[i] = threadStart(&threads[i], function, (char*)tasks + taskSize * i);
+	}
+	function(tasks);
+	for (int i = 1; i < count; i++) {
+		if (started[i]) {
+			threadJoin(&threads[i]);
+		}
+		else {
+			function((char*)tasks + taskSize * i);
+		}
+	}
+
+	releaseTo(NULL, threads, EWELBORN_ALLOCATION_THREADING);
+	releaseTo(NULL, started, EWELBORN_ALLOCATION_THREADING);
+}
+
+ewelborn_dynamicArray* ewelborn_dynamicArray_initialize()
+{
+	return ewelborn_dynamicArray_initializeInArena(NULL);
+}
+
+ewelborn_dynamicArray* ewelborn_dynamicArray_initializeInArena(ewelborn_arena* arena)
+{
+	return ewelborn_dynamicArray_initializeWithAllocator(arenaAllocator(arena));
+}
+
+ewelborn_dynamicArray* ewelborn_dynamicArray_initializeWithAllocator(ewelborn_allocator* allocator)
+{
+	if (allocator == NULL) { allocator = globalAllocator; }
+	ewelborn_dynamicArray* dynamicArray = allocateFrom(allocator, sizeof(ewelborn_dynamicArray), EWELBORN_ALLOCATION_ARRAY);
+	if (dynamicArray == NULL) { return NULL; }
+	dynamicArray->elements = 0;
+	dynamicArray->maxElements = EWELBORN_DYNAMIC_ARRAY_STARTING_SIZE;
+	dynamicArray->allocator = allocator;
+	// Arena arrays usually hold arena memory as well, which can't be freed
+	dynamicArray->freeElement = allocatorIsArena(allocator) ? NULL : free;
+	dynamicArray->array = allocateFrom(allocator, sizeof(void*) * dynamicArray->maxElements, EWELBORN_ALLOCATION_ARRAY);
+	if (dynamicArray->array == NULL) {
+		releaseTo(allocator, dynamicArray, EWELBORN_ALLOCATION_ARRAY);
+		return NULL;
+	}
+	return dynamicArray;
+}
+
+bool ewelborn_dynamicArray_push(ewelborn_dynamicArray* dynamicArray, void* element)
+{
+	if (dynamicArray->elements >= dynamicArray->maxElements) {
+		int maxElements = dynamicArray->maxElements * EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT;
+		void** newArray = reallocateFrom(dynamicArray->allocator, dynamicArray->array,
+			sizeof(void*) * dynamicArray->maxElements, sizeof(void*) * maxElements, EWELBORN_ALLOCATION_ARRAY);
+		if (newArray == NULL) { return false; }
+		dynamicArray->array = newArray;
+		dynamicArray->maxElements = maxElements;
+	}
+
+	dynamicArray->array[dynamicArray->elements++] = element;
+	return true;
+}
+
+void ewelborn_dynamicArray_free(ewelborn_dynamicArray* dynamicArray)
+{
+	// The elements belong to the caller, not to the array's allocator
+	if (dynamicArray->freeElement != NULL) {
+		for (int i = 0; i < dynamicArray->elements; i++) {
+			dynamicArray->freeElement(dynamicArray->array[i]);
+		}
+	}
+	if (allocatorIsArena(dynamicArray->allocator)) { return; }
+	releaseTo(dynamicArray->allocator, dynamicArray->array, EWELBORN_ALLOCATION_ARRAY);
+	releaseTo(dynamicArray->allocator, dynamicArray, EWELBORN_ALLOCATION_ARRAY);
+}
+
+void ewelborn_dynamicArray_traverse(ewelborn_dynamicArray* dynamicArray, void(*f)(void*))
+{
+	for (int i = 0; i < dynamicArray->elements; i++) {
+		f(dynamicArray->array[i]);
+	}
+}
+
+struct traverseTask {
+	void** elements;
+	int count;
+	void(*f)(void*);
+};
+
+static void traverseTaskRun(void* parameter)
+{
+	struct traverseTask* task = parameter;
+	for (int i = 0; i < task->count; i++) {
+		task->f(task->elements[i]);
+	}
+}
+
+void ewelborn_dynamicArray_traverseParallel(ewelborn_dynamicArray* dynamicArray, void(*f)(void*), int threadCount)
+{
+	threadCount = pickThreadCount(threadCount, dynamicArray->elements, 1);
+	struct traverseTask* tasks = threadCount > 1 ? allocateFrom(NULL, sizeof(struct traverseTask) * threadCount, EWELBORN_ALLOCATION_THREADING) : NULL;
+	if (tasks == NULL) {
+		ewelborn_dynamicArray_traverse(dynamicArray, f);
+		return;
+	}
+
+	// Give every thread an equal, contiguous share of the elements
+	int start = 0;
+	for (int i = 0; i < threadCount; i++) {
+		int end = (int)((long long)dynamicArray->elements * (i + 1) / threadCount);
+		tasks[i].elements = dynamicArray->array + start;
+		tasks[i].count = end - start;
+		tasks[i].f = f;
+		start = end;
+	}
+
+	runTasksInParallel(tasks, sizeof(struct traverseTask), threadCount, traverseTaskRun);
+	releaseTo(NULL, tasks, EWELBORN_ALLOCATION_THREADING);
+}
+
+// Grows the dynamic array (if necessary) so that it can hold at least
+// n elements without resizing. Returns true if successful, false otherwise.
+static bool dynamicArrayReserve(ewelborn_dynamicArray* dynamicArray, int n)
+{
+	if (n <= dynamicArray->maxElements) { return true; }
+	void** newArray = reallocateFrom(dynamicArray->allocator, dynamicArray->array,
+		sizeof(void*) * dynamicArray->maxElements, sizeof(void*) * n, EWELBORN_ALLOCATION_ARRAY);
+	if (newArray == NULL) { return false; }
+	dynamicArray->array = newArray;
+	dynamicArray->maxElements = n;
+	return true;
+}
+
+ewelborn_typedArray* ewelborn_typedArray_initialize(size_t elementSize)
+{
+	return ewelborn_typedArray_initializeInArena(elementSize, NULL);
+}
+
+ewelborn_typedArray* ewelborn_typedArray_initializeInArena(size_t elementSize, ewelborn_arena* arena)
+{
+	return ewelborn_typedArray_initializeWithAllocator(elementSize, arenaAllocator(arena));
+}
+
+ewelborn_typedArray* ewelborn_typedArray_initializeWithAllocator(size_t elementSize, ewelborn_allocator* allocator)
+{
+	if (elementSize == 0) { return NULL; }
+	if (allocator == NULL) { allocator = globalAllocator; }
+	ewelborn_typedArray* typedArray = allocateFrom(allocator, sizeof(ewelborn_typedArray), EWELBORN_ALLOCATION_ARRAY);
+	if (typedArray == NULL) { return NULL; }
+	typedArray->elementSize = elementSize;
+	typedArray->elements = 0;
+	typedArray->maxElements = EWELBORN_DYNAMIC_ARRAY_STARTING_SIZE;
+	typedArray->allocator = allocator;
+	typedArray->data = allocateFrom(allocator, elementSize * typedArray->maxElements, EWELBORN_ALLOCATION_ARRAY);
+	if (typedArray->data == NULL) {
+		releaseTo(allocator, typedArray, EWELBORN_ALLOCATION_ARRAY);
+		return NULL;
+	}
+	return typedArray;
+}
+
+// Returns a pointer to the nth element slot, whether or not it's in use.
+static char* typedArraySlot(ewelborn_typedArray* typedArray, int n)
+{
+	return (char*)typedArray->data + typedArray->elementSize * (size_t)n;
+}
+
+// Resizes the typed array's memory to hold exactly maxElements elements.
+static bool typedArrayResize(ewelborn_typedArray* typedArray, int maxElements)
+{
+	if ((size_t)maxElements > (size_t)-1 / typedArray->elementSize) { return false; }
+	void* newData = reallocateFrom(typedArray->allocator, typedArray->data,
+		typedArray->elementSize * typedArray->maxElements, typedArray->elementSize * maxElements, EWELBORN_ALLOCATION_ARRAY);
+	if (newData == NULL) { return false; }
+	typedArray->data = newData;
+	typedArray->maxElements = maxElements;
+	return true;
+}
+
+// Makes sure that count more elements fit in the typed array, growing it
+// geometrically if they don't. Returns true if successful, false otherwise.
+static bool typedArrayMakeRoom(ewelborn_typedArray* typedArray, int count)
+{
+	if (count > INT_MAX - typedArray->elements) { return false; }
+	int needed = typedArray->elements + count;
+	if (needed <= typedArray->maxElements) { return true; }
+
+	int maxElements = typedArray->maxElements;
+	while (maxElements < needed) {
+		maxElements = maxElements > INT_MAX / EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT ?
+			INT_MAX : maxElements * EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT;
+	}
+	return typedArrayResize(typedArray, maxElements);
+}
+
+// Returns how far into the typed array's memory the pointer is, or SIZE_MAX
+// if it points somewhere else. Elements that are being added may come from
+// the typed array itself, and growing the typed array would move them.
+static size_t typedArrayOffsetOf(ewelborn_typedArray* typedArray, const void* pointer)
+{
+	uintptr_t start = (uintptr_t)typedArray->data;
+	uintptr_t offset = (uintptr_t)pointer - start;
+	bool isSelf = (uintptr_t)pointer >= start && offset < typedArray->elementSize * (uintptr_t)typedArray->maxElements;
+	return isSelf ? (size_t)offset : SIZE_MAX;
+}
+
+void* ewelborn_typedArray_get(ewelborn_typedArray* typedArray, int n)
+{
+	if (n < 0 || n >= typedArray->elements) { return NULL; }
+	return typedArraySlot(typedArray, n);
+}
+
+bool ewelborn_typedArray_push(ewelborn_typedArray* typedArray, const void* element)
+{
+	size_t selfOffset = typedArrayOffsetOf(typedArray, element);
+	if (typedArrayMakeRoom(typedArray, 1) == false) { return false; }
+	if (selfOffset != SIZE_MAX) { element = (char*)typedArray->data + selfOffset; }
+	memmove(typedArraySlot(typedArray, typedArray->elements++), element, typedArray->elementSize);
+	return true;
+}
+
+bool ewelborn_typedArray_appendMany(ewelborn_typedArray* typedArray, const void* elements, int count)
+{
+	if (count <= 0) { return count == 0; }
+	size_t selfOffset = typedArrayOffsetOf(typedArray, elements);
+	if (typedArrayMakeRoom(typedArray, count) == false) { return false; }
+	if (selfOffset != SIZE_MAX) { elements = (char*)typedArray->data + selfOffset; }
+	memmove(typedArraySlot(typedArray, typedArray->elements), elements, typedArray->elementSize * count);
+	typedArray->elements += count;
+	return true;
+}
+
+bool ewelborn_typedArray_pop(ewelborn_typedArray* typedArray, void* element)
+{
+	if (typedArray->elements == 0) { return false; }
+	typedArray->elements--;
+	if (element != NULL) {
+		memcpy(element, typedArraySlot(typedArray, typedArray->elements), typedArray->elementSize);
+	}
+	return true;
+}
+
+bool ewelborn_typedArray_insert(ewelborn_typedArray* typedArray, int n, const void* element)
+{
+	if (n < 0 || n > typedArray->elements) { return false; }
+	size_t selfOffset = typedArrayOffsetOf(typedArray, element);
+	if (typedArrayMakeRoom(typedArray, 1) == false) { return false; }
+
+	// Move every element from n onwards one slot to the right to make room.
+	// If the new element is one of them, it moves along with them.
+	memmove(typedArraySlot(typedArray, n + 1), typedArraySlot(typedArray, n),
+		typedArray->elementSize * (typedArray->elements - n));
+	if (selfOffset != SIZE_MAX) {
+		if (selfOffset >= typedArray->elementSize * (size_t)n) { selfOffset += typedArray->elementSize; }
+		element = (char*)typedArray->data + selfOffset;
+	}
+	memcpy(typedArraySlot(typedArray, n), element, typedArray->elementSize);
+	typedArray->elements++;
+	return true;
+}
+
+bool ewelborn_typedArray_remove(ewelborn_typedArray* typedArray, int n)
+{
+	if (n < 0 || n >= typedArray->elements) { return false; }
+	memmove(typedArraySlot(typedArray, n), typedArraySlot(typedArray, n + 1),
+		typedArray->elementSize * (typedArray->elements - n - 1));
+	typedArray->elements--;
+	return true;
+}
+
+void ewelborn_typedArray_clear(ewelborn_typedArray* typedArray)
+{
+	typedArray->elements = 0;
+}
+
+bool ewelborn_typedArray_reserve(ewelborn_typedArray* typedArray, int n)
+{
+	if (n <= typedArray->maxElements) { return true; }
+	return typedArrayResize(typedArray, n);
+}
+
+bool ewelborn_typedArray_shrinkToFit(ewelborn_typedArray* typedArray)
+{
+	// Memory can't be given back to an arena, so there's no point in moving it
+	if (allocatorIsArena(typedArray->allocator)) { return true; }
+
+	// Keep room for at least one element, since resizing to 0 bytes
+	// may free the memory entirely.
+	int maxElements = typedArray->elements > 0 ? typedArray->elements : 1;
+	if (maxElements == typedArray->maxElements) { return true; }
+	return typedArrayResize(typedArray, maxElements);
+}
+
+void ewelborn_typedArray_free(ewelborn_typedArray* typedArray)
+{
+	if (allocatorIsArena(typedArray->allocator)) { return; }
+	releaseTo(typedArray->allocator, typedArray->data, EWELBORN_ALLOCATION_ARRAY);
+	releaseTo(typedArray->allocator, typedArray, EWELBORN_ALLOCATION_ARRAY);
+}
+
+ewelborn_linkedList* ewelborn_linkedList_initializeEmpty()
+{
+	ewelborn_linkedList* list = allocateFrom(NULL, sizeof(ewelborn_linkedList), EWELBORN_ALLOCATION_LIST);
+	if (list == NULL) { return NULL; }
+	list->element = NULL;
+	list->next = NULL;
+	return list;
+}
+
+bool ewelborn_linkedList_insert(ewelborn_linkedList* list, void* newElement)
+{
+	ewelborn_linkedList* newList = ewelborn_linkedList_initializeEmpty();
+	if (newList == NULL) { return false; }
+	newList->element = newElement;
+
+	if (list->next == NULL) {
+		list->next = newList;
+	}
+	else {
+		newList->next = list->next;
+		list->next = newList;
+	}
+
+	return true;
+}
+
+bool ewelborn_linkedList_pushToBack(ewelborn_linkedList* list, void* newElement)
+{
+	while (list->next) { list = list->next; }
+	return ewelborn_linkedList_insert(list, newElement);
+}
+
+void ewelborn_linkedList_traverse(ewelborn_linkedList* list, void(*f)(void*))
+{
+	while (true) {
+		f(list->element);
+		if (list->next) {
+			list = list->next;
+		}
+		else {
+			break;
+		}
+	}
+}
+
+ewelborn_linkedList* ewelborn_linkedList_reverse(ewelborn_linkedList* list)
+{
+	ewelborn_linkedList* previousList = NULL;
+	while (true) {
+		//printf("v. %s\n", list->element);
+		ewelborn_linkedList* nextList = NULL;
+		if (list->next != NULL) {
+			nextList = list->next;
+		}
+		if (previousList == NULL) {
+			// We were the head of the list.. now we're the tail
+			list->next = NULL;
+		}
+		else {
+			list->next = previousList;
+		}
+		previousList = list;
+		if (nextList != NULL) {
+			list = nextList;
+		}
+		else {
+			//printf("ret. %s\n", list->element);
+			return list;
+		}
+	}
+}
+
+// Slabs start with a pointer to the next slab, padded so that the nodes
+// after it stay aligned.
+#define NODE_POOL_SLAB_HEADER_SIZE 16
+
+ewelborn_nodePool* ewelborn_nodePool_initialize(size_t nodeSize, int nodesPerSlab)
+{
+	return ewelborn_nodePool_initializeWithAllocator(nodeSize, nodesPerSlab, NULL);
+}
+
+ewelborn_nodePool* ewelborn_nodePool_initializeWithAllocator(size_t nodeSize, int nodesPerSlab, ewelborn_allocator* allocator)
+{
+	if (nodesPerSlab < 0) { return NULL; }
+	if (allocator == NULL) { allocator = globalAllocator; }
+	ewelborn_nodePool* pool = allocateFrom(allocator, sizeof(ewelborn_nodePool), EWELBORN_ALLOCATION_LIST);
+	if (pool == NULL) { return NULL; }
+	pool->allocator = allocator;
+
+	// Released nodes store the free list inside of themselves, so every node
+	// needs room for a pointer. Nodes are also rounded up to 8 bytes so that
+	// every node in a slab stays aligned.
+	if (nodeSize < sizeof(void*)) { nodeSize = sizeof(void*); }
+	pool->nodeSize = (nodeSize + 7) & ~(size_t)7;
+	pool->nodesPerSlab = nodesPerSlab > 0 ? nodesPerSlab : EWELBORN_NODE_POOL_DEFAULT_NODES_PER_SLAB;
+	pool->freeNodes = NULL;
+	pool->slabs = NULL;
+	pool->unusedNodes = NULL;
+	pool->unusedNodeCount = 0;
+	return pool;
+}
+
+void* ewelborn_nodePool_allocate(ewelborn_nodePool* pool)
+{
+	// Reuse released nodes first
+	if (pool->freeNodes != NULL) {
+		void* node = pool->freeNodes;
+		pool->freeNodes = *(void**)node;
+		return node;
+	}
+
+	if (pool->unusedNodeCount == 0) {
+		char* slab = allocateFrom(pool->allocator, NODE_POOL_SLAB_HEADER_SIZE + pool->nodeSize * pool->nodesPerSlab, EWELBORN_ALLOCATION_LIST);
+		if (slab == NULL) { return NULL; }
+		*(void**)slab = pool->slabs;
+		pool->slabs = slab;
+		pool->unusedNodes = slab + NODE_POOL_SLAB_HEADER_SIZE;
+		pool->unusedNodeCount = pool->nodesPerSlab;
+	}
+
+	void* node = pool->unusedNodes;
+	pool->unusedNodes += pool->nodeSize;
+	pool->unusedNodeCount--;
+	return node;
+}
+
+void ewelborn_nodePool_release(ewelborn_nodePool* pool, void* node)
+{
+	*(void**)node = pool->freeNodes;
+	pool->freeNodes = node;
+}
+
+void ewelborn_nodePool_free(ewelborn_nodePool* pool)
+{
+	void* slab = pool->slabs;
+	while (slab != NULL) {
+		void* next = *(void**)slab;
+		releaseTo(pool->allocator, slab, EWELBORN_ALLOCATION_LIST);
+		slab = next;
+	}
+	releaseTo(pool->allocator, pool, EWELBORN_ALLOCATION_LIST);
+}
+
+ewelborn_list* ewelborn_list_initialize()
+{
+	ewelborn_nodePool* pool = ewelborn_nodePool_initialize(sizeof(ewelborn_listNode), 0);
+	if (pool == NULL) { return NULL; }
+	ewelborn_list* list = ewelborn_list_initializeWithPool(pool);
+	if (list == NULL) {
+		ewelborn_nodePool_free(pool);
+		return NULL;
+	}
+	list->ownsPool = true;
+	return list;
+}
+
+ewelborn_list* ewelborn_list_initializeWithPool(ewelborn_nodePool* pool)
+{
+	if (pool->nodeSize < sizeof(ewelborn_listNode)) { return NULL; }
+	ewelborn_list* list = allocateFrom(pool->allocator, sizeof(ewelborn_list), EWELBORN_ALLOCATION_LIST);
+	if (list == NULL) { return NULL; }
+	list->head = NULL;
+	list->tail = NULL;
+	list->size = 0;
+	list->pool = pool;
+	list->ownsPool = false;
+	return list;
+}
+
+bool ewelborn_list_pushToFront(ewelborn_list* list, void* element)
+{
+	ewelborn_listNode* node = ewelborn_nodePool_allocate(list->pool);
+	if (node == NULL) { return false; }
+	node->element = element;
+	node->previous = NULL;
+	node->next = list->head;
+
+	if (list->head != NULL) {
+		list->head->previous = node;
+	}
+	else {
+		list->tail = node;
+	}
+	list->head = node;
+	list->size++;
+	return true;
+}
+
+bool ewelborn_list_pushToBack(ewelborn_list* list, void* element)
+{
+	ewelborn_listNode* node = ewelborn_nodePool_allocate(list->pool);
+	if (node == NULL) { return false; }
+	node->element = element;
+	node->next = NULL;
+	node->previous = list->tail;
+
+	if (list->tail != NULL) {
+		list->tail->next = node;
+	}
+	else {
+		list->head = node;
+	}
+	list->tail = node;
+	list->size++;
+	return true;
+}
+
+void* ewelborn_list_popFront(ewelborn_list* list)
+{
+	ewelborn_listNode* node = list->head;
+	if (node == NULL) { return NULL; }
+
+	list->head = node->next;
+	if (list->head != NULL) {
+		list->head->previous = NULL;
+	}
+	else {
+		list->tail = NULL;
+	}
+	list->size--;
+
+	void* element = node->element;
+	ewelborn_nodePool_release(list->pool, node);
+	return element;
+}
+
+void* ewelborn_list_popBack(ewelborn_list* list)
+{
+	ewelborn_listNode* node = list->tail;
+	if (node == NULL) { return NULL; }
+
+	list->tail = node->previous;
+	if (list->tail != NULL) {
+		list->tail->next = NULL;
+	}
+	else {
+		list->head = NULL;
+	}
+	list->size--;
+
+	void* element = node->element;
+	ewelborn_nodePool_release(list->pool, node);
+	return element;
+}
+
+void* ewelborn_list_peekFront(ewelborn_list* list)
+{
+	return list->head != NULL ? list->head->element : NULL;
+}
+
+void* ewelborn_list_peekBack(ewelborn_list* list)
+{
+	return list->tail != NULL ? list->tail->element : NULL;
+}
+
+bool ewelborn_list_splice(ewelborn_list* list, ewelborn_list* other)
+{
+	// The nodes are handed over as-is, so they have to be able to go
+	// back to the same pool when they're popped.
+	if (list->pool != other->pool) { return false; }
+	if (other->head == NULL) { return true; }
+
+	if (list->tail != NULL) {
+		list->tail->next = other->head;
+		other->head->previous = list->tail;
+	}
+	else {
+		list->head = other->head;
+	}
+	list->tail = other->tail;
+	list->size += other->size;
+
+	other->head = NULL;
+	other->tail = NULL;
+	other->size = 0;
+	return true;
+}
+
+void ewelborn_list_traverse(ewelborn_list* list, void(*f)(void*))
+{
+	for (ewelborn_listNode* node = list->head; node != NULL; node = node->next) {
+		f(node->element);
+	}
+}
+
+void ewelborn_list_free(ewelborn_list* list)
+{
+	ewelborn_listNode* node = list->head;
+	while (node != NULL) {
+		ewelborn_listNode* next = node->next;
+		// The elements belong to the caller, not to the pool's allocator
+		free(node->element);
+		// A pool of our own is freed all at once below
+		if (list->ownsPool == false) { ewelborn_nodePool_release(list->pool, node); }
+		node = next;
+	}
+	ewelborn_allocator* allocator = list->pool->allocator;
+	if (list->ownsPool) { ewelborn_nodePool_free(list->pool); }
+	releaseTo(allocator, list, EWELBORN_ALLOCATION_LIST);
+}
+
+ewelborn_unrolledList* ewelborn_unrolledList_initialize()
+{
+	ewelborn_nodePool* pool = ewelborn_nodePool_initialize(sizeof(ewelborn_unrolledListNode), 64);
+	if (pool == NULL) { return NULL; }
+	ewelborn_unrolledList* list = ewelborn_unrolledList_initializeWithPool(pool);
+	if (list == NULL) {
+		ewelborn_nodePool_free(pool);
+		return NULL;
+	}
+	list->ownsPool = true;
+	return list;
+}
+
+ewelborn_unrolledList* ewelborn_unrolledList_initializeWithPool(ewelborn_nodePool* pool)
+{
+	if (pool->nodeSize < sizeof(ewelborn_unrolledListNode)) { return NULL; }
+	ewelborn_unrolledList* list = allocateFrom(pool->allocator, sizeof(ewelborn_unrolledList), EWELBORN_ALLOCATION_LIST);
+	if (list == NULL) { return NULL; }
+	list->head = NULL;
+	list->tail = NULL;
+	list->size = 0;
+	list->pool = pool;
+	list->ownsPool = false;
+	return list;
+}
+
+static ewelborn_unrolledListNode* unrolledListCreateNode(ewelborn_unrolledList* list, int start)
+{
+	ewelborn_unrolledListNode* node = ewelborn_nodePool_allocate(list->pool);
+	if (node == NULL) { return NULL; }
+	node->next = NULL;
+	node->previous = NULL;
+	node->start = start;
+	node->count = 0;
+	return node;
+}
+
+// Unlinks an empty node from the list and gives it back to the pool.
+static void unrolledListRemoveNode(ewelborn_unrolledList* list, ewelborn_unrolledListNode* node)
+{
+	if (node->previous != NULL) { node->previous->next = node->next; }
+	else { list->head = node->next; }
+	if (node->next != NULL) { node->next->previous = node->previous; }
+	else { list->tail = node->previous; }
+	ewelborn_nodePool_release(list->pool, node);
+}
+
+bool ewelborn_unrolledList_pushToFront(ewelborn_unrolledList* list, void* element)
+{
+	ewelborn_unrolledListNode* node = list->head;
+
+	// If the head has room, but not in front of its first element, then
+	// move its elements to the back of the node to make room.
+	if (node != NULL && node->start == 0 && node->count < EWELBORN_UNROLLED_LIST_NODE_CAPACITY) {
+		int newStart = EWELBORN_UNROLLED_LIST_NODE_CAPACITY - node->count;
+		memmove(&node->elements[newStart], &node->elements[0], sizeof(void*) * node->count);
+		node->start = newStart;
+	}
+
+	if (node == NULL || node->start == 0) {
+		// Fill new nodes from the back, since more elements are likely
+		// to be pushed in front of this one.
+		node = unrolledListCreateNode(list, EWELBORN_UNROLLED_LIST_NODE_CAPACITY);
+		if (node == NULL) { return false; }
+		node->next = list->head;
+		if (list->head != NULL) { list->head->previous = node; }
+		else { list->tail = node; }
+		list->head = node;
+	}
+
+	node->elements[--node->start] = element;
+	node->count++;
+	list->size++;
+	return true;
+}
+
+bool ewelborn_unrolledList_pushToBack(ewelborn_unrolledList* list, void* element)
+{
+	ewelborn_unrolledListNode* node = list->tail;
+
+	// If the tail has room, but not after its last element, then move its
+	// elements to the front of the node to make room.
+	if (node != NULL && node->start + node->count == EWELBORN_UNROLLED_LIST_NODE_CAPACITY &&
+		node->count < EWELBORN_UNROLLED_LIST_NODE_CAPACITY) {
+		memmove(&node->elements[0], &node->elements[node->start], sizeof(void*) * node->count);
+		node->start = 0;
+	}
+
+	if (node == NULL || node->start + node->count == EWELBORN_UNROLLED_LIST_NODE_CAPACITY) {
+		node = unrolledListCreateNode(list, 0);
+		if (node == NULL) { return false; }
+		node->previous = list->tail;
+		if (list->tail != NULL) { list->tail->next = node; }
+		else { list->head = node; }
+		list->tail = node;
+	}
+
+	node->elements[node->start + node->count++] = element;
+	list->size++;
+	return true;
+}
+
+void* ewelborn_unrolledList_popFront(ewelborn_unrolledList* list)
+{
+	ewelborn_unrolledListNode* node = list->head;
+	if (node == NULL) { return NULL; }
+
+	void* element = node->elements[node->start++];
+	list->size--;
+	if (--node->count == 0) { unrolledListRemoveNode(list, node); }
+	return element;
+}
+
+void* ewelborn_unrolledList_popBack(ewelborn_unrolledList* list)
+{
+	ewelborn_unrolledListNode* node = list->tail;
+	if (node == NULL) { return NULL; }
+
+	void* element = node->elements[node->start + node->count - 1];
+	list->size--;
+	if (--node->count == 0) { unrolledListRemoveNode(list, node); }
+	return element;
+}
+
+void* ewelborn_unrolledList_peekFront(ewelborn_unrolledList* list)
+{
+	return list->head != NULL ? list->head->elements[list->head->start] : NULL;
+}
+
+void* ewelborn_unrolledList_peekBack(ewelborn_unrolledList* list)
+{
+	return list->tail != NULL ? list->tail->elements[list->tail->start + list->tail->count - 1] : NULL;
+}
+
+bool ewelborn_unrolledList_splice(ewelborn_unrolledList* list, ewelborn_unrolledList* other)
+{
+	if (list->pool != other->pool) { return false; }
+	if (other->head == NULL) { return true; }
+
+	if (list->tail != NULL) {
+		list->tail->next = other->head;
+		other->head->previous = list->tail;
+	}
+	else {
+		list->head = other->head;
+	}
+	list->tail = other->tail;
+	list->size += other->size;
+
+	other->head = NULL;
+	other->tail = NULL;
+	other->size = 0;
+	return true;
+}
+
+void ewelborn_unrolledList_traverse(ewelborn_unrolledList* list, void(*f)(void*))
+{
+	for (ewelborn_unrolledListNode* node = list->head; node != NULL; node = node->next) {
+		for (int i = node->start; i < node->start + node->count; i++) {
+			f(node->elements[i]);
+		}
+	}
+}
+
+void ewelborn_unrolledList_free(ewelborn_unrolledList* list)
+{
+	ewelborn_unrolledListNode* node = list->head;
+	while (node != NULL) {
+		ewelborn_unrolledListNode* next = node->next;
+		for (int i = node->start; i < node->start + node->count; i++) {
+			free(node->elements[i]);
+		}
+		if (list->ownsPool == false) { ewelborn_nodePool_release(list->pool, node); }
+		node = next;
+	}
+	ewelborn_allocator* allocator = list->pool->allocator;
+	if (list->ownsPool) { ewelborn_nodePool_free(list->pool); }
+	releaseTo(allocator, list, EWELBORN_ALLOCATION_LIST);
+}
+
+// Number of children each priority queue entry has
+#define PRIORITY_QUEUE_ARITY 4
+
+ewelborn_priorityQueue* ewelborn_priorityQueue_initialize()
+{
+	return ewelborn_priorityQueue_initializeWithAllocator(NULL);
+}
+
+ewelborn_priorityQueue* ewelborn_priorityQueue_initializeWithAllocator(ewelborn_allocator* allocator)
+{
+	if (allocator == NULL) { allocator = globalAllocator; }
+	ewelborn_priorityQueue* queue = allocateFrom(allocator, sizeof(ewelborn_priorityQueue), EWELBORN_ALLOCATION_ARRAY);
+	if (queue == NULL) { return NULL; }
+	queue->size = 0;
+	queue->maxSize = EWELBORN_DYNAMIC_ARRAY_STARTING_SIZE;
+	queue->allocator = allocator;
+	queue->entries = allocateFrom(allocator, sizeof(ewelborn_priorityQueueEntry) * queue->maxSize, EWELBORN_ALLOCATION_ARRAY);
+	if (queue->entries == NULL) {
+		releaseTo(allocator, queue, EWELBORN_ALLOCATION_ARRAY);
+		return NULL;
+	}
+	return queue;
+}
+
+// Grows the queue (if necessary) so that it can hold at least n entries
+// without resizing. Returns true if successful, false otherwise.
+static bool priorityQueueReserve(ewelborn_priorityQueue* queue, int n)
+{
+	if (n <= queue->maxSize) { return true; }
+	int maxSize = queue->maxSize;
+	while (maxSize < n) {
+		if (maxSize > INT_MAX / EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT) {
+			maxSize = n;
+			break;
+		}
+		maxSize *= EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT;
+	}
+	ewelborn_priorityQueueEntry* entries = reallocateFrom(queue->allocator, queue->entries,
+		sizeof(ewelborn_priorityQueueEntry) * queue->maxSize, sizeof(ewelborn_priorityQueueEntry) * maxSize, EWELBORN_ALLOCATION_ARRAY);
+	if (entries == NULL) { return false; }
+	queue->entries = entries;
+	queue->maxSize = maxSize;
+	return true;
+}
+
+// The sift functions move an entry into its place by moving the entries in
+// its way into the hole it leaves behind, and then writing the entry once at
+// the end, instead of swapping it every step of the way.
+
+static void priorityQueueSiftUp(ewelborn_priorityQueueEntry* entries, int position, ewelborn_priorityQueueEntry entry)
+{
+	while (position > 0) {
+		int parent = (position - 1) / PRIORITY_QUEUE_ARITY;
+		if (entries[parent].priority <= entry.priority) { break; }
+		entries[position] = entries[parent];
+		position = parent;
+	}
+	entries[position] = entry;
+}
+
+// Finds the position of the smallest of the (up to four) children that start
+// at firstChild. When all four children are there, they're compared as two
+// pairs, which compiles to conditional moves instead of branches that are
+// mispredicted half of the time, and the priorities are carried along so
+// they don't have to be loaded again.
+#define PRIORITY_QUEUE_SMALLEST_CHILD(entries, size, firstChild, smallest) \
+	do { \
+		if ((firstChild) + PRIORITY_QUEUE_ARITY <= (size)) { \
+			double p0 = entries[(firstChild)].priority, p1 = entries[(firstChild) + 1].priority; \
+			double p2 = entries[(firstChild) + 2].priority, p3 = entries[(firstChild) + 3].priority; \
+			int a = p1 < p0 ? (firstChild) + 1 : (firstChild); \
+			double pa = p1 < p0 ? p1 : p0; \
+			int b = p3 < p2 ? (firstChild) + 3 : (firstChild) + 2; \
+			double pb = p3 < p2 ? p3 : p2; \
+			smallest = pb < pa ? b : a; \
+		} \
+		else { \
+			smallest = (firstChild); \
+			for (int child = (firstChild) + 1; child < (size); child++) { \
+				if (entries[child].priority < entries[smallest].priority) { smallest = child; } \
+			} \
+		} \
+	} while (0)
+
+static void priorityQueueSiftDown(ewelborn_priorityQueueEntry* entries, int size, int position, ewelborn_priorityQueueEntry entry)
+{
+	while (true) {
+		int firstChild = position * PRIORITY_QUEUE_ARITY + 1;
+		if (firstChild >= size) { break; }
+		int smallest;
+		PRIORITY_QUEUE_SMALLEST_CHILD(entries, size, firstChild, smallest);
+		if (entry.priority <= entries[smallest].priority) { break; }
+		entries[position] = entries[smallest];
+		position = smallest;
+	}
+	entries[position] = entry;
+}
+
+// Turns every entry in the queue into a heap in O(n) time, by sifting down
+// every entry that has children, starting from the last one.
+static void priorityQueueHeapify(ewelborn_priorityQueue* queue)
+{
+	for (int i = (queue->size - 2) / PRIORITY_QUEUE_ARITY; i >= 0; i--) {
+		priorityQueueSiftDown(queue->entries, queue->size, i, queue->entries[i]);
+	}
+}
+
+ewelborn_priorityQueue* ewelborn_priorityQueue_initializeFromEntries(const ewelborn_priorityQueueEntry* entries, int count)
+{
+	ewelborn_priorityQueue* queue = ewelborn_priorityQueue_initialize();
+	if (queue == NULL) { return NULL; }
+	if (count < 0 || priorityQueueReserve(queue, count) == false) {
+		ewelborn_priorityQueue_free(queue);
+		return NULL;
+	}
+	memcpy(queue->entries, entries, sizeof(ewelborn_priorityQueueEntry) * (size_t)count);
+	queue->size = count;
+	priorityQueueHeapify(queue);
+	return queue;
+}
+
+bool ewelborn_priorityQueue_push(ewelborn_priorityQueue* queue, void* element, double priority)
+{
+	if (queue->size == INT_MAX || priorityQueueReserve(queue, queue->size + 1) == false) { return false; }
+	priorityQueueSiftUp(queue->entries, queue->size, (ewelborn_priorityQueueEntry){ priority, element });
+	queue->size++;
+	return true;
+}
+
+bool ewelborn_priorityQueue_pushMany(ewelborn_priorityQueue* queue, const ewelborn_priorityQueueEntry* entries, int count)
+{
+	if (count < 0 || count > INT_MAX - queue->size) { return false; }
+	if (priorityQueueReserve(queue, queue->size + count) == false) { return false; }
+
+	// Sifting each new entry up costs O(k log n), and rebuilding the whole
+	// heap costs O(n + k), so rebuild when there are more new entries
+	if (count > queue->size) {
+		memcpy(queue->entries + queue->size, entries, sizeof(ewelborn_priorityQueueEntry) * (size_t)count);
+		queue->size += count;
+		priorityQueueHeapify(queue);
+	}
+	else {
+		for (int i = 0; i < count; i++) {
+			priorityQueueSiftUp(queue->entries, queue->size, entries[i]);
+			queue->size++;
+		}
+	}
+	return true;
+}
+
+bool ewelborn_priorityQueue_pop(ewelborn_priorityQueue* queue, void** element, double* priority)
+{
+	if (queue->size == 0) { return false; }
+	ewelborn_priorityQueueEntry top = queue->entries[0];
+	queue->size--;
+	if (queue->size > 0) {
+		priorityQueueSiftDown(queue->entries, queue->size, 0, queue->entries[queue->size]);
+	}
+	if (element != NULL) { *element = top.element; }
+	if (priority != NULL) { *priority = top.priority; }
+	return true;
+}
+
+bool ewelborn_priorityQueue_peek(ewelborn_priorityQueue* queue, void** element, double* priority)
+{
+	if (queue->size == 0) { return false; }
+	if (element != NULL) { *element = queue->entries[0].element; }
+	if (priority != NULL) { *priority = queue->entries[0].priority; }
+	return true;
+}
+
+void ewelborn_priorityQueue_clear(ewelborn_priorityQueue* queue)
+{
+	queue->size = 0;
+}
+
+void ewelborn_priorityQueue_free(ewelborn_priorityQueue* queue)
+{
+	if (allocatorIsArena(queue->allocator)) { return; }
+	releaseTo(queue->allocator, queue->entries, EWELBORN_ALLOCATION_ARRAY);
+	releaseTo(queue->allocator, queue, EWELBORN_ALLOCATION_ARRAY);
+}
+
+ewelborn_indexedPriorityQueue* ewelborn_indexedPriorityQueue_initialize(int capacity)
+{
+	return ewelborn_indexedPriorityQueue_initializeWithAllocator(capacity, NULL);
+}
+
+ewelborn_indexedPriorityQueue* ewelborn_indexedPriorityQueue_initializeWithAllocator(int capacity, ewelborn_allocator* allocator)
+{
+	if (capacity < 0) { return NULL; }
+	if (allocator == NULL) { allocator = globalAllocator; }
+	ewelborn_indexedPriorityQueue* queue = allocateFrom(allocator, sizeof(ewelborn_indexedPriorityQueue), EWELBORN_ALLOCATION_ARRAY);
+	if (queue == NULL) { return NULL; }
+	queue->size = 0;
+	queue->capacity = capacity;
+	queue->allocator = allocator;
+
+	// Every handle can be in the queue at once, so the heap never has to grow
+	size_t slots = capacity > 0 ? (size_t)capacity : 1;
+	queue->entries = allocateFrom(allocator, sizeof(ewelborn_indexedPriorityQueueEntry) * slots, EWELBORN_ALLOCATION_ARRAY);
+	queue->positions = allocateFrom(allocator, sizeof(int) * slots, EWELBORN_ALLOCATION_ARRAY);
+	if (queue->entries == NULL || queue->positions == NULL) {
+		releaseTo(allocator, queue->entries, EWELBORN_ALLOCATION_ARRAY);
+		releaseTo(allocator, queue->positions, EWELBORN_ALLOCATION_ARRAY);
+		releaseTo(allocator, queue, EWELBORN_ALLOCATION_ARRAY);
+		return NULL;
+	}
+	for (int i = 0; i < capacity; i++) {
+		queue->positions[i] = -1;
+	}
+	return queue;
+}
+
+// These work the same way as the priority queue's sift functions, but also
+// keep positions up to date for every entry that moves.
+
+static void indexedPriorityQueueSiftUp(ewelborn_indexedPriorityQueue* queue, int position, ewelborn_indexedPriorityQueueEntry entry)
+{
+	ewelborn_indexedPriorityQueueEntry* entries = queue->entries;
+	while (position > 0) {
+		int parent = (position - 1) / PRIORITY_QUEUE_ARITY;
+		if (entries[parent].priority <= entry.priority) { break; }
+		entries[position] = entries[parent];
+		queue->positions[entries[position].handle] = position;
+		position = parent;
+	}
+	entries[position] = entry;
+	queue->positions[entry.handle] = position;
+}
+
+static void indexedPriorityQueueSiftDown(ewelborn_indexedPriorityQueue* queue, int position, ewelborn_indexedPriorityQueueEntry entry)
+{
+	ewelborn_indexedPriorityQueueEntry* entries = queue->entries;
+	int size = queue->size;
+	while (true) {
+		int firstChild = position * PRIORITY_QUEUE_ARITY + 1;
+		if (firstChild >= size) { break; }
+		int smallest;
+		PRIORITY_QUEUE_SMALLEST_CHILD(entries, size, firstChild, smallest);
+		if (entry.priority <= entries[smallest].priority) { break; }
+		entries[position] = entries[smallest];
+		queue->positions[entries[position].handle] = position;
+		position = smallest;
+	}
+	entries[position] = entry;
+	queue->positions[entry.handle] = position;
+}
+
+// Moves the entry at position to wherever its priority now belongs, whether
+// that's up or down the heap.
+static void indexedPriorityQueueRestore(ewelborn_indexedPriorityQueue* queue, int position)
+{
+	ewelborn_indexedPriorityQueueEntry entry = queue->entries[position];
+	if (position > 0 && entry.priority < queue->entries[(position - 1) / PRIORITY_QUEUE_ARITY].priority) {
+		indexedPriorityQueueSiftUp(queue, position, entry);
+	}
+	else {
+		indexedPriorityQueueSiftDown(queue, position, entry);
+	}
+}
+
+bool ewelborn_indexedPriorityQueue_contains(ewelborn_indexedPriorityQueue* queue, int handle)
+{
+	return handle >= 0 && handle < queue->capacity && queue->positions[handle] >= 0;
+}
+
+bool ewelborn_indexedPriorityQueue_push(ewelborn_indexedPriorityQueue* queue, int handle, double priority)
+{
+	if (handle < 0 || handle >= queue->capacity || queue->positions[handle] >= 0) { return false; }
+	indexedPriorityQueueSiftUp(queue, queue->size, (ewelborn_indexedPriorityQueueEntry){ priority, handle });
+	queue->size++;
+	return true;
+}
+
+bool ewelborn_indexedPriorityQueue_decreasePriority(ewelborn_indexedPriorityQueue* queue, int handle, double priority)
+{
+	if (ewelborn_indexedPriorityQueue_contains(queue, handle) == false) { return false; }
+	int position = queue->positions[handle];
+	if ((priority < queue->entries[position].priority) == false) { return false; }
+	indexedPriorityQueueSiftUp(queue, position, (ewelborn_indexedPriorityQueueEntry){ priority, handle });
+	return true;
+}
+
+bool ewelborn_indexedPriorityQueue_update(ewelborn_indexedPriorityQueue* queue, int handle, double priority)
+{
+	if (handle < 0 || handle >= queue->capacity) { return false; }
+	int position = queue->positions[handle];
+	if (position < 0) { return ewelborn_indexedPriorityQueue_push(queue, handle, priority); }
+	queue->entries[position].priority = priority;
+	indexedPriorityQueueRestore(queue, position);
+	return true;
+}
+
+// Removes the entry at position, and fills the hole with the last entry.
+static void indexedPriorityQueueRemoveAt(ewelborn_indexedPriorityQueue* queue, int position)
+{
+	queue->positions[queue->entries[position].handle] = -1;
+	queue->size--;
+	if (position == queue->size) { return; }
+	queue->entries[position] = queue->entries[queue->size];
+	indexedPriorityQueueRestore(queue, position);
+}
+
+bool ewelborn_indexedPriorityQueue_pop(ewelborn_indexedPriorityQueue* queue, int* handle, double* priority)
+{
+	if (queue->size == 0) { return false; }
+	if (handle != NULL) { *handle = queue->entries[0].handle; }
+	if (priority != NULL) { *priority = queue->entries[0].priority; }
+	indexedPriorityQueueRemoveAt(queue, 0);
+	return true;
+}
+
+bool ewelborn_indexedPriorityQueue_peek(ewelborn_indexedPriorityQueue* queue, int* handle, double* priority)
+{
+	if (queue->size == 0) { return false; }
+	if (handle != NULL) { *handle = queue->entries[0].handle; }
+	if (priority != NULL) { *priority = queue->entries[0].priority; }
+	return true;
+}
+
+bool ewelborn_indexedPriorityQueue_remove(ewelborn_indexedPriorityQueue* queue, int handle)
+{
+	if (ewelborn_indexedPriorityQueue_contains(queue, handle) == false) { return false; }
+	indexedPriorityQueueRemoveAt(queue, queue->positions[handle]);
+	return true;
+}
+
+bool ewelborn_indexedPriorityQueue_getPriority(ewelborn_indexedPriorityQueue* queue, int handle, double* priority)
+{
+	if (ewelborn_indexedPriorityQueue_contains(queue, handle) == false) { return false; }
+	*priority = queue->entries[queue->positions[handle]].priority;
+	return true;
+}
+
+void ewelborn_indexedPriorityQueue_clear(ewelborn_indexedPriorityQueue* queue)
+{
+	for (int i = 0; i < queue->size; i++) {
+		queue->positions[queue->entries[i].handle] = -1;
+	}
+	queue->size = 0;
+}
+
+void ewelborn_indexedPriorityQueue_free(ewelborn_indexedPriorityQueue* queue)
+{
+	if (allocatorIsArena(queue->allocator)) { return; }
+	releaseTo(queue->allocator, queue->entries, EWELBORN_ALLOCATION_ARRAY);
+	releaseTo(queue->allocator, queue->positions, EWELBORN_ALLOCATION_ARRAY);
+	releaseTo(queue->allocator, queue, EWELBORN_ALLOCATION_ARRAY);
+}
+
+static int countLeadingZeros64(uint64_t x);
+
+// Returns the bucket that a key belongs in, given the last key popped: 0 if
+// they're equal, otherwise one more than the highest bit where they differ.
+static int radixHeapBucket(uint64_t key, uint64_t last)
+{
+	return key == last ? 0 : 64 - countLeadingZeros64(key ^ last);
+}
+
+ewelborn_radixHeap* ewelborn_radixHeap_initialize()
+{
+	return ewelborn_radixHeap_initializeWithAllocator(NULL);
+}
+
+ewelborn_radixHeap* ewelborn_radixHeap_initializeWithAllocator(ewelborn_allocator* allocator)
+{
+	if (allocator == NULL) { allocator = globalAllocator; }
+	ewelborn_radixHeap* heap = allocateFrom(allocator, sizeof(ewelborn_radixHeap), EWELBORN_ALLOCATION_ARRAY);
+	if (heap == NULL) { return NULL; }
+	heap->last = 0;
+	heap->size = 0;
+	heap->allocator = allocator;
+	for (int i = 0; i < 65; i++) {
+		heap->buckets[i] = ewelborn_typedArray_initializeWithAllocator(sizeof(ewelborn_radixHeapEntry), allocator);
+		if (heap->buckets[i] == NULL) {
+			while (i-- > 0) { ewelborn_typedArray_free(heap->buckets[i]); }
+			releaseTo(allocator, heap, EWELBORN_ALLOCATION_ARRAY);
+			return NULL;
+		}
+	}
+	return heap;
+}
+
+bool ewelborn_radixHeap_push(ewelborn_radixHeap* heap, void* element, uint64_t key)
+{
+	if (key < heap->last || heap->size == INT_MAX) { return false; }
+	ewelborn_radixHeapEntry entry = { key, element };
+	if (ewelborn_typedArray_push(heap->buckets[radixHeapBucket(key, heap->last)], &entry) == false) { return false; }
+	heap->size++;
+	return true;
+}
+
+// Makes sure that bucket 0 has an entry with the smallest key in it (unless
+// the heap is empty). When bucket 0 is empty, the smallest key is in the
+// first bucket that isn't, so that key becomes the new last key, and every
+// entry in that bucket moves to a lower bucket. Returns true if successful,
+// or false if the entries couldn't be moved.
+static bool radixHeapRefill(ewelborn_radixHeap* heap)
+{
+	if (heap->buckets[0]->elements > 0 || heap->size == 0) { return true; }
+
+	int i = 1;
+	while (heap->buckets[i]->elements == 0) { i++; }
+	ewelborn_typedArray* bucket = heap->buckets[i];
+	ewelborn_radixHeapEntry* entries = bucket->data;
+
+	uint64_t smallest = entries[0].key;
+	for (int j = 1; j < bucket->elements; j++) {
+		if (entries[j].key < smallest) { smallest = entries[j].key; }
+	}
+
+	// Every entry in bucket i shares the bits above bit i - 1 with the new
+	// last key, so they all move to buckets lower than i
+	uint64_t last = heap->last;
+	heap->last = smallest;
+	for (int j = 0; j < bucket->elements; j++) {
+		if (ewelborn_typedArray_push(heap->buckets[radixHeapBucket(entries[j].key, smallest)], &entries[j]) == false) {
+			// Put back the entries that were already moved
+			for (int k = 0; k < i; k++) {
+				ewelborn_typedArray_clear(heap->buckets[k]);
+			}
+			heap->last = last;
+			return false;
+		}
+	}
+	ewelborn_typedArray_clear(bucket);
+	return true;
+}
+
+bool ewelborn_radixHeap_pop(ewelborn_radixHeap* heap, void** element, uint64_t* key)
+{
+	if (heap->size == 0 || radixHeapRefill(heap) == false) { return false; }
+	ewelborn_radixHeapEntry entry;
+	ewelborn_typedArray_pop(heap->buckets[0], &entry);
+	heap->size--;
+	if (element != NULL) { *element = entry.element; }
+	if (key != NULL) { *key = entry.key; }
+	return true;
+}
+
+bool ewelborn_radixHeap_peek(ewelborn_radixHeap* heap, void** element, uint64_t* key)
+{
+	if (heap->size == 0) { return false; }
+
+	// Peeking doesn't move any entries, so that keys between the last key
+	// popped and the smallest key can still be pushed afterwards
+	int i = 0;
+	while (heap->buckets[i]->elements == 0) { i++; }
+	ewelborn_typedArray* bucket = heap->buckets[i];
+	ewelborn_radixHeapEntry* entries = bucket->data;
+	int smallest = 0;
+	for (int j = 1; j < bucket->elements; j++) {
+		if (entries[j].key < entries[smallest].key) { smallest = j; }
+	}
+	if (element != NULL) { *element = entries[smallest].element; }
+	if (key != NULL) { *key = entries[smallest].key; }
+	return true;
+}
+
+void ewelborn_radixHeap_free(ewelborn_radixHeap* heap)
+{
+	if (allocatorIsArena(heap->allocator)) { return; }
+	for (int i = 0; i < 65; i++) {
+		ewelborn_typedArray_free(heap->buckets[i]);
+	}
+	releaseTo(heap->allocator, heap, EWELBORN_ALLOCATION_ARRAY);
+}
+
+// Returns the start of the estring's buffer, which is in front of the
+// characters that have been deleted from the front.
+static char* stringBuffer(ewelborn_string* eString)
+{
+	return eString->cstring - eString->start;
+}
+
+// Returns true if the estring's characters are stored inside of the
+// estring itself, instead of in memory of their own.
+static bool stringIsInline(ewelborn_string* eString)
+{
+	return stringBuffer(eString) == eString->inlineBuffer;
+}
+
+// Moves the estring's characters back to the start of its buffer, which
+// makes the room that deleted characters took up usable again.
+static void stringCompact(ewelborn_string* eString)
+{
+	if (eString->start == 0) { return; }
+	char* buffer = stringBuffer(eString);
+	memmove(buffer, eString->cstring, eString->length + 1);
+	eString->cstring = buffer;
+	eString->maxLength += eString->start;
+	eString->start = 0;
+}
+
+// Gives a new estring a buffer that can hold maxLength characters (including
+// the null terminator), which will be the inline buffer if it's large enough.
+// Returns true if successful, false otherwise.
+static bool stringAllocateBuffer(ewelborn_string* eString, int maxLength)
+{
+	eString->start = 0;
+	if (maxLength <= EWELBORN_STRING_INLINE_SIZE) {
+		eString->cstring = eString->inlineBuffer;
+		eString->maxLength = EWELBORN_STRING_INLINE_SIZE;
+		return true;
+	}
+
+	eString->cstring = allocateFrom(eString->allocator, sizeof(char) * maxLength, EWELBORN_ALLOCATION_STRING);
+	if (eString->cstring == NULL) { return false; }
+	eString->maxLength = maxLength;
+	return true;
+}
+
+// Moves the estring's characters into a larger buffer that can hold
+// maxLength characters (including the null terminator). Returns true if
+// successful, false otherwise (the estring is left unmodified).
+static bool stringResizeBuffer(ewelborn_string* eString, int maxLength)
+{
+	stringCompact(eString);
+	char* newString;
+	if (stringIsInline(eString)) {
+		newString = allocateFrom(eString->allocator, sizeof(char) * maxLength, EWELBORN_ALLOCATION_STRING);
+		if (newString == NULL) { return false; }
+		memcpy(newString, eString->cstring, eString->length + 1);
+	}
+	else {
+		newString = reallocateFrom(eString->allocator, eString->cstring,
+			sizeof(char) * eString->maxLength, sizeof(char) * maxLength, EWELBORN_ALLOCATION_STRING);
+		if (newString == NULL) { return false; }
+	}
+	eString->cstring = newString;
+	eString->maxLength = maxLength;
+	return true;
+}
+
+// Makes sure that the estring can hold maxLength characters (including the
+// null terminator), growing it geometrically so that repeated appends stay
+// cheap. Returns true if successful, false otherwise (the estring is left
+// unmodified).
+static bool stringEnsureCapacity(ewelborn_string* eString, int maxLength)
+{
+	if (maxLength <= eString->maxLength) { return true; }
+
+	// Reuse the room in front of the characters before growing
+	if (maxLength <= eString->maxLength + eString->start) {
+		stringCompact(eString);
+		return true;
+	}
+
+	int newMaxLength = maxLength;
+	if (eString->maxLength <= INT_MAX / EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT
+		&& eString->maxLength * EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT > maxLength) {
+		newMaxLength = eString->maxLength * EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT;
+	}
+
+	return stringResizeBuffer(eString, newMaxLength);
+}
+
+// Frees the estring's characters, unless they're stored inline.
+static void stringReleaseBuffer(ewelborn_string* eString)
+{
+	if (stringIsInline(eString) == false) { releaseTo(eString->allocator, stringBuffer(eString), EWELBORN_ALLOCATION_STRING); }
+}
+
+// Creates an estring that holds a copy of the given buffer, allocating
+// exactly as much room as the buffer needs.
+static ewelborn_string* stringFromBuffer(const char* buffer, int length, ewelborn_allocator* allocator)
+{
+	if (allocator == NULL) { allocator = globalAllocator; }
+	ewelborn_string* eString = allocateFrom(allocator, sizeof(ewelborn_string), EWELBORN_ALLOCATION_STRING);
+	if (eString == NULL) { return NULL; }
+	eString->length = 0;
+	eString->allocator = allocator;
+	if (stringAllocateBuffer(eString, length + 1) == false) {
+		releaseTo(allocator, eString, EWELBORN_ALLOCATION_STRING);
+		return NULL;
+	}
+	eString->cstring[0] = '\0';
+
+	// There's already enough room, so this can't fail
+	ewelborn_string_appendN(eString, buffer, length);
+	return eString;
+}
+
+bool ewelborn_string_pushChar(ewelborn_string* eString, char c)
+{
+	// Add 1 to length to include null terminator
+	if (eString->length + 1 >= eString->maxLength) {
+		if (stringEnsureCapacity(eString, eString->length + 2) == false) { return false; }
+	}
+
+	eString->cstring[eString->length++] = c;
+	eString->cstring[eString->length] = '\0';
+	return true;
+}
+
+char ewelborn_string_getChar(ewelborn_string* eString, int n)
+{
+	if (n < 0 || n >= eString->length) {
+		return '\0';
+	}
+	else {
+		return eString->cstring[n];
+	}
+}
+
+ewelborn_string* ewelborn_string_initializeEmpty()
+{
+	return ewelborn_string_initializeInArena(NULL);
+}
+
+ewelborn_string* ewelborn_string_initializeInArena(ewelborn_arena* arena)
+{
+	return ewelborn_string_initializeWithAllocator(arenaAllocator(arena));
+}
+
+ewelborn_string* ewelborn_string_initializeWithAllocator(ewelborn_allocator* allocator)
+{
+	if (allocator == NULL) { allocator = globalAllocator; }
+	ewelborn_string* eString = allocateFrom(allocator, sizeof(ewelborn_string), EWELBORN_ALLOCATION_STRING);
+	if (eString == NULL) { return NULL; }
+	eString->length = 0;
+	eString->allocator = allocator;
+	// Empty estrings always fit inline, so this can't fail
+	stringAllocateBuffer(eString, 1);
+	eString->cstring[0] = '\0';
+	return eString;
+}
+
+bool ewelborn_string_reserve(ewelborn_string* estring, int length)
+{
+	if (length < 0 || length == INT_MAX) { return false; }
+	return stringEnsureCapacity(estring, length + 1);
+}
+
+bool ewelborn_string_appendN(ewelborn_string* estring, const char* buffer, int length)
+{
+	if (length <= 0) { return length == 0; }
+	if (length > INT_MAX - 1 - estring->length) { return false; }
+
+	// The buffer may be part of the estring itself (ex. appending an estring
+	// to itself), in which case growing the estring would move it.
+	uintptr_t start = (uintptr_t)estring->cstring;
+	uintptr_t offset = (uintptr_t)buffer - start;
+	bool isSelf = (uintptr_t)buffer >= start && offset < (uintptr_t)estring->maxLength;
+
+	if (stringEnsureCapacity(estring, estring->length + length + 1) == false) { return false; }
+	if (isSelf) { buffer = estring->cstring + offset; }
+
+	memmove(estring->cstring + estring->length, buffer, length);
+	estring->length += length;
+	estring->cstring[estring->length] = '\0';
+	return true;
+}
+
+bool ewelborn_string_appendCString(ewelborn_string* estring, char* cstring)
+{
+	size_t length = strlen(cstring);
+	if (length > INT_MAX) { return false; }
+	return ewelborn_string_appendN(estring, cstring, (int)length);
+}
+
+bool ewelborn_string_append(ewelborn_string* estring, ewelborn_string* appendString)
+{
+	return ewelborn_string_appendN(estring, appendString->cstring, appendString->length);
+}
+
+bool ewelborn_string_appendMany(ewelborn_string* estring, ewelborn_dynamicArray* appendStrings)
+{
+	// Add up everything first so that the estring only has to grow once
+	int originalLength = estring->length;
+	size_t totalLength = estring->length;
+	for (int i = 0; i < appendStrings->elements; i++) {
+		totalLength += ((ewelborn_string*)appendStrings->array[i])->length;
+	}
+	if (totalLength > INT_MAX - 1) { return false; }
+	if (stringEnsureCapacity(estring, (int)totalLength + 1) == false) { return false; }
+
+	for (int i = 0; i < appendStrings->elements; i++) {
+		ewelborn_string* appendString = appendStrings->array[i];
+		// If the estring is appended to itself, only its original characters
+		// should be copied, not the ones that have been appended since.
+		int length = appendString == estring ? originalLength : appendString->length;
+		memcpy(estring->cstring + estring->length, appendString->cstring, length);
+		estring->length += length;
+	}
+
+	estring->cstring[estring->length] = '\0';
+	return true;
+}
+
+ewelborn_string* ewelborn_string_initializeWithCString(char* cstring)
+{
+	return ewelborn_string_initializeWithCStringInArena(cstring, NULL);
+}
+
+ewelborn_string* ewelborn_string_initializeWithCStringInArena(char* cstring, ewelborn_arena* arena)
+{
+	size_t length = strlen(cstring);
+	if (length > INT_MAX - 1) { return NULL; }
+	return stringFromBuffer(cstring, (int)length, arenaAllocator(arena));
+}
+
+char* ewelborn_string_getCString(ewelborn_string* eString)
+{
+	return eString->cstring;
+}
+
+void ewelborn_string_free(ewelborn_string* eString) {
+	stringReleaseBuffer(eString);
+	releaseTo(eString->allocator, eString, EWELBORN_ALLOCATION_STRING);
+}
+
+// Frees an estring that's stored in a dynamic array (see freeElement)
+static void freeStringElement(void* element)
+{
+	ewelborn_string_free(element);
+}
+
+ewelborn_string* ewelborn_string_clone(ewelborn_string* estring)
+{
+	ewelborn_string* clonedString = allocateFrom(estring->allocator, sizeof(ewelborn_string), EWELBORN_ALLOCATION_STRING);
+	if (clonedString == NULL) { return NULL; }
+	clonedString->length = estring->length;
+	clonedString->allocator = estring->allocator;
+	if (stringAllocateBuffer(clonedString, estring->maxLength) == false) {
+		releaseTo(estring->allocator, clonedString, EWELBORN_ALLOCATION_STRING);
+		return NULL;
+	}
+
+	// Copy the cstring from given estring
+	memcpy(clonedString->cstring, estring->cstring, estring->length + 1);
+
+	return clonedString;
+}
+
+// Once the characters deleted from the front take up at least this much
+// room, and more room than the characters that are left, they're moved out
+// of the way. Moving the characters costs less than deleting them did, so
+// front deletion stays O(1) on average.
+#define STRING_MINIMUM_COMPACTION 4096
+
+void ewelborn_string_deleteLeft(ewelborn_string* estring, int n)
+{
+	if (n <= 0) { return; }
+	if (n > estring->length) { n = estring->length; }
+
+	// The characters aren't moved, the estring just starts further along
+	estring->cstring += n;
+	estring->start += n;
+	estring->maxLength -= n;
+	estring->length -= n;
+
+	if (estring->length == 0 || (estring->start >= STRING_MINIMUM_COMPACTION && estring->start > estring->length)) {
+		stringCompact(estring);
+	}
+}
+
+void ewelborn_string_deleteRight(ewelborn_string* estring, int n)
+{
+	if (n <= 0) { return; }
+	if (n > estring->length) { n = estring->length; }
+	// We don't actually need to delete anything, we can simply reduce
+	// the length of the estring and add the null terminator in.
+	estring->length -= n;
+	estring->cstring[estring->length] = '\0';
+}
+
+void ewelborn_string_trimLeft(ewelborn_string* estring)
+{
+	// Count how many whitespaces ' ' and tabs '\t' the estring starts with
+	int shiftLeftBy = (int)ewelborn_scan_skipWhitespaceLeft(estring->cstring, estring->length);
+
+	ewelborn_string_deleteLeft(estring, shiftLeftBy);
+}
+
+void ewelborn_string_trimRight(ewelborn_string* estring)
+{
+	// Count how many whitespaces ' ' and tabs '\t' the estring ends with
+	int shiftRightBy = estring->length - (int)ewelborn_scan_skipWhitespaceRight(estring->cstring, estring->length);
+
+	ewelborn_string_deleteRight(estring, shiftRightBy);
+}
+
+void ewelborn_string_trim(ewelborn_string* estring)
+{
+	ewelborn_string_trimLeft(estring);
+	ewelborn_string_trimRight(estring);
+}
+
+int ewelborn_string_findChar(ewelborn_string* estring, char c, int offset)
+{
+	return ewelborn_stringView_findChar(ewelborn_stringView_fromString(estring), c, offset);
+}
+
+void ewelborn_string_slice(ewelborn_string* estring, int start, int end)
+{
+	ewelborn_string_deleteRight(estring, estring->length - end);
+	ewelborn_string_deleteLeft(estring, start);
+}
+
+bool ewelborn_string_appendView(ewelborn_string* estring, ewelborn_stringView view)
+{
+	return ewelborn_string_appendN(estring, view.data, view.length);
+}
+
+bool ewelborn_string_appendViews(ewelborn_string* estring, const ewelborn_stringView* views, int count)
+{
+	size_t totalLength = estring->length;
+	for (int i = 0; i < count; i++) {
+		totalLength += views[i].length;
+	}
+	if (totalLength > INT_MAX - 1) { return false; }
+
+	// Growing the estring moves its characters, so views into the estring
+	// itself have to be moved along with them.
+	uintptr_t oldStart = (uintptr_t)estring->cstring;
+	uintptr_t oldEnd = oldStart + estring->maxLength;
+	if (stringEnsureCapacity(estring, (int)totalLength + 1) == false) { return false; }
+
+	for (int i = 0; i < count; i++) {
+		const char* data = views[i].data;
+		if ((uintptr_t)data >= oldStart && (uintptr_t)data < oldEnd) {
+			data = estring->cstring + ((uintptr_t)data - oldStart);
+		}
+		memcpy(estring->cstring + estring->length, data, views[i].length);
+		estring->length += views[i].length;
+	}
+
+	estring->cstring[estring->length] = '\0';
+	return true;
+}
+
+ewelborn_stringView ewelborn_stringView_fromString(ewelborn_string* estring)
+{
+	ewelborn_stringView view = { estring->cstring, estring->length };
+	return view;
+}
+
+ewelborn_stringView ewelborn_stringView_fromCString(const char* cstring)
+{
+	ewelborn_stringView view = { cstring, (int)strlen(cstring) };
+	return view;
+}
+
+ewelborn_stringView ewelborn_stringView_fromBuffer(const char* buffer, int length)
+{
+	ewelborn_stringView view = { buffer, length };
+	return view;
+}
+
+ewelborn_string* ewelborn_stringView_toString(ewelborn_stringView view)
+{
+	return stringFromBuffer(view.data, view.length, NULL);
+}
+
+ewelborn_string* ewelborn_stringView_toStringInArena(ewelborn_stringView view, ewelborn_arena* arena)
+{
+	return stringFromBuffer(view.data, view.length, arenaAllocator(arena));
+}
+
+char ewelborn_stringView_getChar(ewelborn_stringView view, int n)
+{
+	if (n < 0 || n >= view.length) {
+		return '\0';
+	}
+	else {
+		return view.data[n];
+	}
+}
+
+int ewelborn_stringView_findChar(ewelborn_stringView view, char c, int offset)
+{
+	if (offset < 0 || offset >= view.length) { return -1; }
+
+	size_t i = ewelborn_scan_findChar(view.data + offset, view.length - offset, c);
+	return i < (size_t)(view.length - offset) ? offset + (int)i : -1;
+}
+
+// Returns the first position in the buffer where first appears, and last
+// appears distance characters later, or length if there isn't one. This uses
+// the scanning kernels, which are further down.
+static size_t scanFindPair(const char* buffer, size_t length, char first, char last, size_t distance);
+
+// A needle that has been prepared for the Two-Way string matching algorithm
+// (Crochemore and Perrin), so that it can be searched for over and over
+// without being prepared again. Two-Way only ever moves forward through the
+// haystack, and never compares a character more than twice, so searches take
+// linear time even for needles like "aaaab" in haystacks like "aaaaaaaaa...".
+//
+// The needle is split at its critical position. The right half is compared
+// first, and a mismatch there skips ahead by however far the right half
+// matched. If the right half matches, the left half is compared, and a
+// mismatch there skips ahead by the needle's period. For periodic needles,
+// the part of the needle that is known to match after that skip is
+// remembered, so it isn't compared again.
+//
+// On top of that, the last character of the window is checked before
+// anything else, and the window jumps straight past it if it doesn't line up
+// with the needle (as in Horspool's algorithm), which skips most of the
+// haystack without comparing anything.
+struct substringSearch {
+	const unsigned char* needle;
+	size_t length;
+	size_t split; // The critical position, where the right half starts
+	size_t period;
+	size_t periodicMemory; // How much of the needle is remembered after a period skip, 0 if the needle isn't periodic
+	bool twoWayReady; // False until the fields above (and shift) have been worked out
+	size_t shift[256]; // 1 + the last position of each character in the needle, or 0 if it isn't in the needle
+};
+
+// Finds the maximal suffix of the needle, with the alphabet in normal order
+// if reversed is false, or in reverse order otherwise. Returns the position
+// right before the suffix starts (which may be (size_t)-1), and its period.
+static size_t substringSearchMaximalSuffix(const unsigned char* needle, size_t length, bool reversed, size_t* period)
+{
+	size_t i = (size_t)-1;
+	size_t j = 0;
+	size_t k = 1;
+	size_t p = 1;
+	while (j + k < length) {
+		unsigned char a = needle[i + k];
+		unsigned char b = needle[j + k];
+		if (a == b) {
+			if (k == p) {
+				j += p;
+				k = 1;
+			}
+			else {
+				k++;
+			}
+		}
+		else if (reversed ? a < b : a > b) {
+			j += k;
+			k = 1;
+			p = j - i;
+		}
+		else {
+			i = j++;
+			k = p = 1;
+		}
+	}
+	*period = p;
+	return i;
+}
+
+static void substringSearchPrepare(struct substringSearch* search, const char* needle, size_t length)
+{
+	search->needle = (const unsigned char*)needle;
+	search->length = length;
+	// Most searches never need Two-Way, so it's only prepared once it's needed
+	search->twoWayReady = false;
+}
+
+static void substringSearchPrepareTwoWay(struct substringSearch* search)
+{
+	const unsigned char* n = search->needle;
+	size_t length = search->length;
+	search->twoWayReady = true;
+
+	memset(search->shift, 0, sizeof(search->shift));
+	for (size_t i = 0; i < length; i++) {
+		search->shift[n[i]] = i + 1;
+	}
+
+	// The critical position comes from whichever maximal suffix is longer
+	size_t period;
+	size_t reversedPeriod;
+	size_t suffix = substringSearchMaximalSuffix(n, length, false, &period);
+	size_t reversedSuffix = substringSearchMaximalSuffix(n, length, true, &reversedPeriod);
+	if (reversedSuffix + 1 > suffix + 1) {
+		suffix = reversedSuffix;
+		period = reversedPeriod;
+	}
+	search->split = suffix + 1;
+
+	if (memcmp(n, n + period, search->split) == 0) {
+		search->period = period;
+		search->periodicMemory = length - period;
+	}
+	else {
+		// Not periodic, so the needle can always skip ahead by at least
+		// the length of its longer half.
+		size_t left = search->split - 1;
+		size_t right = length - search->split;
+		search->period = (left > right ? left : right) + 1;
+		search->periodicMemory = 0;
+	}
+}
+
+// Returns the position of the first match in the haystack, or length if
+// there isn't one. The needle must be at least 2 characters long.
+static size_t substringSearchRun(const struct substringSearch* search, const char* haystack, size_t length)
+{
+	const unsigned char* n = search->needle;
+	size_t l = search->length;
+	const unsigned char* h = (const unsigned char*)haystack;
+	const unsigned char* end = h + length;
+	size_t memory = 0;
+
+	while ((size_t)(end - h) >= l) {
+		// Line the last character of the window up with its last appearance
+		// in the needle, or skip the window entirely if it doesn't appear.
+		size_t k = l - search->shift[h[l - 1]];
+		if (k != 0) {
+			if (k < memory) { k = memory; }
+			h += k;
+			memory = 0;
+			continue;
+		}
+
+		// Compare the right half
+		for (k = search->split > memory ? search->split : memory; k < l && n[k] == h[k]; k++);
+		if (k < l) {
+			h += k - search->split + 1;
+			memory = 0;
+			continue;
+		}
+
+		// Compare the left half, minus whatever is remembered
+		for (k = search->split; k > memory && n[k - 1] == h[k - 1]; k--);
+		if (k <= memory) { return (size_t)((const char*)h - haystack); }
+		h += search->period;
+		memory = search->periodicMemory;
+	}
+
+	return length;
+}
+
+// Searches for a prepared needle, which may be any length. Returns the
+// position of the first match in the haystack, or length if there isn't one.
+//
+// Most of the time, the fastest way to search is to let the scanning kernels
+// find places where the first and last characters of the needle both line up
+// (which they can check 16 or 32 positions at a time), and only compare the
+// rest of the needle there. That can take quadratic time when those places
+// are common and the needle almost matches at each one, so once comparing
+// gets too far ahead of the search, the rest of the haystack is left to
+// Two-Way instead.
+static size_t substringSearchFind(struct substringSearch* search, const char* haystack, size_t length)
+{
+	size_t l = search->length;
+	if (l == 0) { return 0; }
+	if (l > length) { return length; }
+	if (l == 1) { return ewelborn_scan_findChar(haystack, length, (char)search->needle[0]); }
+
+	const char* needle = (const char*)search->needle;
+	size_t position = 0;
+	size_t compared = 0;
+	while (position + l <= length) {
+		size_t i = scanFindPair(haystack + position, length - position, needle[0], needle[l - 1], l - 1);
+		if (i >= length - position) { return length; }
+		position += i;
+		if (memcmp(haystack + position + 1, needle + 1, l - 2) == 0) { return position; }
+
+		compared += l;
+		position++;
+		if (compared > 2 * position + 1024) {
+			if (search->twoWayReady == false) { substringSearchPrepareTwoWay(search); }
+			return position + substringSearchRun(search, haystack + position, length - position);
+		}
+	}
+	return length;
+}
+
+int ewelborn_stringView_find(ewelborn_stringView view, ewelborn_stringView needle, int offset)
+{
+	if (offset < 0 || offset > view.length || needle.length < 0) { return -1; }
+
+	struct substringSearch search;
+	substringSearchPrepare(&search, needle.data, needle.length);
+	size_t remaining = view.length - offset;
+	size_t i = substringSearchFind(&search, view.data + offset, remaining);
+	return i < remaining || needle.length == 0 ? offset + (int)i : -1;
+}
+
+// Calls found(context, position) for every match of the needle in the view,
+// from left to right, without matches overlapping. Stops early if found
+// returns false. Returns the number of matches. Empty needles never match.
+static int substringSearchEach(ewelborn_stringView view, ewelborn_stringView needle,
+	bool(*found)(void* context, int position), void* context)
+{
+	if (needle.length <= 0 || needle.length > view.length) { return 0; }
+
+	struct substringSearch search;
+	substringSearchPrepare(&search, needle.data, needle.length);
+	int matches = 0;
+	size_t offset = 0;
+	while (offset + needle.length <= (size_t)view.length) {
+		size_t i = substringSearchFind(&search, view.data + offset, view.length - offset);
+		if (i >= view.length - offset) { break; }
+		matches++;
+		if (found != NULL && found(context, (int)(offset + i)) == false) { break; }
+		offset += i + needle.length;
+	}
+	return matches;
+}
+
+static bool findAllPush(void* context, int position)
+{
+	return EWELBORN_TYPED_ARRAY_PUSH((ewelborn_typedArray*)context, int, position);
+}
+
+ewelborn_typedArray* ewelborn_stringView_findAll(ewelborn_stringView view, ewelborn_stringView needle)
+{
+	ewelborn_typedArray* positions = EWELBORN_TYPED_ARRAY_INITIALIZE(int);
+	if (positions == NULL) { return NULL; }
+	int matches = substringSearchEach(view, needle, findAllPush, positions);
+	if (matches != positions->elements) {
+		ewelborn_typedArray_free(positions);
+		return NULL;
+	}
+	return positions;
+}
+
+int ewelborn_stringView_count(ewelborn_stringView view, ewelborn_stringView needle)
+{
+	return substringSearchEach(view, needle, NULL, NULL);
+}
+
+int ewelborn_string_find(ewelborn_string* estring, ewelborn_stringView needle, int offset)
+{
+	return ewelborn_stringView_find(ewelborn_stringView_fromString(estring), needle, offset);
+}
+
+ewelborn_typedArray* ewelborn_string_findAll(ewelborn_string* estring, ewelborn_stringView needle)
+{
+	return ewelborn_stringView_findAll(ewelborn_stringView_fromString(estring), needle);
+}
+
+int ewelborn_string_count(ewelborn_string* estring, ewelborn_stringView needle)
+{
+	return ewelborn_stringView_count(ewelborn_stringView_fromString(estring), needle);
+}
+
+// Returns true if the view points anywhere into the estring's characters.
+static bool stringOverlapsView(ewelborn_string* estring, ewelborn_stringView view)
+{
+	uintptr_t start = (uintptr_t)estring->cstring;
+	uintptr_t data = (uintptr_t)view.data;
+	return view.length > 0 && data < start + (uintptr_t)estring->maxLength && data + (uintptr_t)view.length > start;
+}
+
+bool ewelborn_string_replaceAll(ewelborn_string* estring, ewelborn_stringView needle, ewelborn_stringView replacement)
+{
+	if (needle.length < 0 || replacement.length < 0) { return false; }
+
+	// Count the matches first, so that the new length is known up front
+	int matches = ewelborn_string_count(estring, needle);
+	if (matches == 0) { return true; }
+	long long newLength = estring->length + (long long)matches * ((long long)replacement.length - needle.length);
+	if (newLength > INT_MAX - 1) { return false; }
+
+	// When the estring doesn't grow, the result can be written over the
+	// estring itself, since writing never catches up with searching. That
+	// doesn't work if the needle or the replacement are part of the estring.
+	bool inPlace = replacement.length <= needle.length
+		&& stringOverlapsView(estring, needle) == false && stringOverlapsView(estring, replacement) == false;
+
+	// Otherwise, the result is built in a buffer of exactly the right size.
+	// Short results are built on the stack and then moved inline.
+	char shortBuffer[EWELBORN_STRING_INLINE_SIZE];
+	char* output = estring->cstring;
+	if (inPlace == false) {
+		output = newLength + 1 <= EWELBORN_STRING_INLINE_SIZE ? shortBuffer :
+			allocateFrom(estring->allocator, (size_t)newLength + 1, EWELBORN_ALLOCATION_STRING);
+		if (output == NULL) { return false; }
+	}
+
+	struct substringSearch search;
+	substringSearchPrepare(&search, needle.data, needle.length);
+	const char* input = estring->cstring;
+	size_t remaining = estring->length;
+	char* write = output;
+	for (int i = 0; i < matches; i++) {
+		size_t position = substringSearchFind(&search, input, remaining);
+		memmove(write, input, position);
+		write += position;
+		memcpy(write, replacement.data, replacement.length);
+		write += replacement.length;
+		input += position + needle.length;
+		remaining -= position + needle.length;
+	}
+	memmove(write, input, remaining);
+	write[remaining] = '\0';
+
+	if (inPlace == false) {
+		stringReleaseBuffer(estring);
+		if (output == shortBuffer) {
+			memcpy(estring->inlineBuffer, shortBuffer, (size_t)newLength + 1);
+			estring->cstring = estring->inlineBuffer;
+			estring->start = 0;
+			estring->maxLength = EWELBORN_STRING_INLINE_SIZE;
+		}
+		else {
+			estring->cstring = output;
+			estring->maxLength = (int)newLength + 1;
+			estring->start = 0;
+		}
+	}
+	estring->length = (int)newLength;
+	return true;
+}
+
+ewelborn_stringView ewelborn_stringView_slice(ewelborn_stringView view, int start, int end)
+{
+	if (end > view.length) { end = view.length; }
+	if (end < 0) { end = 0; }
+	if (start > end) { start = end; }
+	if (start < 0) { start = 0; }
+
+	view.data += start;
+	view.length = end - start;
+	return view;
+}
+
+ewelborn_stringView ewelborn_stringView_trimLeft(ewelborn_stringView view)
+{
+	int start = (int)ewelborn_scan_skipWhitespaceLeft(view.data, view.length);
+	return ewelborn_stringView_slice(view, start, view.length);
+}
+
+ewelborn_stringView ewelborn_stringView_trimRight(ewelborn_stringView view)
+{
+	int end = (int)ewelborn_scan_skipWhitespaceRight(view.data, view.length);
+	return ewelborn_stringView_slice(view, 0, end);
+}
+
+ewelborn_stringView ewelborn_stringView_trim(ewelborn_stringView view)
+{
+	return ewelborn_stringView_trimRight(ewelborn_stringView_trimLeft(view));
+}
+
+int ewelborn_stringView_compare(ewelborn_stringView a, ewelborn_stringView b)
+{
+	// Compare the characters that both views have, and if those are all
+	// equal, then the shorter view comes first.
+	int result = memcmp(a.data, b.data, a.length < b.length ? a.length : b.length);
+	if (result != 0) { return result; }
+	return (a.length > b.length) - (a.length < b.length);
+}
+
+bool ewelborn_stringView_equals(ewelborn_stringView a, ewelborn_stringView b)
+{
+	return a.length == b.length && memcmp(a.data, b.data, a.length) == 0;
+}
+
+bool ewelborn_stringView_splitNext(ewelborn_stringView* remaining, char c, ewelborn_stringView* field)
+{
+	// Once the final field has been taken, remaining is marked as finished by
+	// setting its data to null. This is different from an empty remaining
+	// view, because "a," still has one more (empty) field after "a".
+	if (remaining->data == NULL) { return false; }
+
+	int i = ewelborn_stringView_findChar(*remaining, c, 0);
+	if (i >= 0) {
+		*field = ewelborn_stringView_slice(*remaining, 0, i);
+		*remaining = ewelborn_stringView_slice(*remaining, i + 1, remaining->length);
+	}
+	else {
+		*field = *remaining;
+		remaining->data = NULL;
+		remaining->length = 0;
+	}
+
+	return true;
+}
+
+int ewelborn_stringView_split(ewelborn_stringView view, char c, ewelborn_stringView* fields, int maxFields)
+{
+	int totalFields = 0;
+	ewelborn_stringView field;
+	while (ewelborn_stringView_splitNext(&view, c, &field)) {
+		if (totalFields < maxFields) { fields[totalFields] = field; }
+		totalFields++;
+	}
+	return totalFields;
+}
+
+static bool tokenizerIsDelimiter(const ewelborn_tokenizer* tokenizer, unsigned char c)
+{
+	return (tokenizer->delimiters[c >> 6] >> (c & 63)) & 1;
+}
+
+ewelborn_tokenizer ewelborn_tokenizer_fromView(ewelborn_stringView view, const char* delimiters, int flags)
+{
+	ewelborn_tokenizer tokenizer;
+	tokenizer.remaining = view;
+	// An empty view still has one (empty) token in it, which would be
+	// mistaken for being finished if its data was null.
+	if (tokenizer.remaining.data == NULL) { tokenizer.remaining.data = ""; }
+	memset(tokenizer.delimiters, 0, sizeof(tokenizer.delimiters));
+	tokenizer.delimiterCount = 0;
+	for (const unsigned char* c = (const unsigned char*)delimiters; *c != '\0'; c++) {
+		if (tokenizerIsDelimiter(&tokenizer, *c)) { continue; }
+		tokenizer.delimiters[*c >> 6] |= (uint64_t)1 << (*c & 63);
+		if (tokenizer.delimiterCount < (int)sizeof(tokenizer.delimiterList)) {
+			tokenizer.delimiterList[tokenizer.delimiterCount] = (char)*c;
+		}
+		tokenizer.delimiterCount++;
+	}
+	tokenizer.flags = flags;
+	tokenizer.quote = '"';
+	tokenizer.block = NULL;
+	tokenizer.blockMask = 0;
+	return tokenizer;
+}
+
+ewelborn_tokenizer ewelborn_tokenizer_fromString(ewelborn_string* estring, const char* delimiters, int flags)
+{
+	return ewelborn_tokenizer_fromView(ewelborn_stringView_fromString(estring), delimiters, flags);
+}
+
+static uint64_t scanMaskAnyOf(const char* buffer, int length, const char* set, int setLength);
+
+// Returns the position of the lowest set bit in a non-zero mask.
+static int lowestSetBit64(uint64_t mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	if (_BitScanForward(&index, (unsigned long)mask)) { return (int)index; }
+	_BitScanForward(&index, (unsigned long)(mask >> 32));
+	return 32 + (int)index;
+#else
+	return __builtin_ctzll(mask);
+#endif
+}
+
+// Returns the position of the first delimiter in the tokenizer's remaining
+// view, or its length if there isn't one.
+static int tokenizerFindDelimiter(ewelborn_tokenizer* tokenizer)
+{
+	const char* data = tokenizer->remaining.data;
+	const char* end = data + tokenizer->remaining.length;
+
+	if (tokenizer->flags & EWELBORN_TOKENIZE_QUOTES) {
+		// A doubled quote toggles twice, so it leaves the quoted section as it was
+		bool quoted = false;
+		for (const char* c = data; c < end; c++) {
+			if (*c == tokenizer->quote) {
+				quoted = !quoted;
+			}
+			else if (quoted == false && tokenizerIsDelimiter(tokenizer, (unsigned char)*c)) {
+				return (int)(c - data);
+			}
+		}
+		return (int)(end - data);
+	}
+
+	// Tokens are usually short, so instead of checking one character at a
+	// time and guessing wrong at the end of every token, every character in
+	// a block of 64 is checked at once (with SIMD, when the set is small
+	// enough), and the mask of delimiters is kept for the next few tokens in
+	// the same block.
+	const char* position = data;
+	while (true) {
+		if (tokenizer->block != NULL && position >= tokenizer->block && position < tokenizer->block + 64) {
+			uint64_t mask = tokenizer->blockMask >> (position - tokenizer->block);
+			if (mask != 0) { return (int)(position - data) + lowestSetBit64(mask); }
+			position = tokenizer->block + 64;
+		}
+		if (position >= end) { return (int)(end - data); }
+
+		int blockLength = end - position < 64 ? (int)(end - position) : 64;
+		uint64_t mask = 0;
+		if (tokenizer->delimiterCount <= (int)sizeof(tokenizer->delimiterList)) {
+			mask = scanMaskAnyOf(position, blockLength, tokenizer->delimiterList, tokenizer->delimiterCount);
+		}
+		else {
+			const unsigned char* b = (const unsigned char*)position;
+			for (int i = 0; i < blockLength; i++) {
+				mask |= (uint64_t)tokenizerIsDelimiter(tokenizer, b[i]) << i;
+			}
+		}
+		tokenizer->block = position;
+		tokenizer->blockMask = mask;
+	}
+}
+
+bool ewelborn_tokenizer_next(ewelborn_tokenizer* tokenizer, ewelborn_stringView* token)
+{
+	ewelborn_stringView* remaining = &tokenizer->remaining;
+	while (remaining->data != NULL) {
+		int i = tokenizerFindDelimiter(tokenizer);
+		token->data = remaining->data;
+		token->length = i;
+
+		if (i < remaining->length) {
+			int next = i + 1;
+			if (tokenizer->flags & EWELBORN_TOKENIZE_COLLAPSE_DELIMITERS) {
+				while (next < remaining->length && tokenizerIsDelimiter(tokenizer, (unsigned char)remaining->data[next])) { next++; }
+			}
+			remaining->data += next;
+			remaining->length -= next;
+		}
+		else {
+			// Same as ewelborn_stringView_splitNext, null data marks the end
+			remaining->data = NULL;
+			remaining->length = 0;
+		}
+
+		if ((tokenizer->flags & EWELBORN_TOKENIZE_SKIP_EMPTY) && i == 0) { continue; }
+
+		if ((tokenizer->flags & EWELBORN_TOKENIZE_QUOTES) && i >= 2
+			&& token->data[0] == tokenizer->quote && token->data[i - 1] == tokenizer->quote) {
+			token->data++;
+			token->length -= 2;
+		}
+		return true;
+	}
+	return false;
+}
+
+ewelborn_dynamicArray* ewelborn_string_split(ewelborn_string* estring, char c)
+{
+	return ewelborn_string_splitInArena(estring, c, NULL);
+}
+
+ewelborn_dynamicArray* ewelborn_string_splitInArena(ewelborn_string* estring, char c, ewelborn_arena* arena)
+{
+	ewelborn_dynamicArray* results = ewelborn_dynamicArray_initializeInArena(arena);
+	if (results == NULL) { return NULL; }
+	if (arena == NULL) { results->freeElement = freeStringElement; }
+
+	// Walk through the estring one field at a time, and copy each field
+	// straight into its own estring. Only the field itself is copied,
+	// not the rest of the estring.
+	ewelborn_stringView remaining = ewelborn_stringView_fromString(estring);
+	ewelborn_stringView field;
+	while (ewelborn_stringView_splitNext(&remaining, c, &field)) {
+		ewelborn_string* slice = ewelborn_stringView_toStringInArena(field, arena);
+		if (slice == NULL || ewelborn_dynamicArray_push(results, slice) == false) {
+			if (slice != NULL) { ewelborn_string_free(slice); }
+			ewelborn_dynamicArray_free(results);
+			return NULL;
+		}
+	}
+
+	return results;
+}
+
+// Splitting less than this many bytes on a thread, or copying less than this
+// many lines on a thread, costs less than starting the thread does.
+#define PARALLEL_MINIMUM_CHUNK_SIZE (256 * 1024)
+#define PARALLEL_MINIMUM_LINES 4096
+
+// One thread's share of the lines being found by indexLinesParallel
+struct lineIndexTask {
+	const char* data;
+	size_t start;
+	size_t end;
+	char delimiter;
+	bool stripCarriageReturns;
+	ewelborn_line* lines;
+	size_t lineCount;
+	size_t maxLines;
+	size_t remainder; // Start of whatever follows the chunk's last delimiter
+	bool failed;
+};
+
+static bool lineIndexTaskPush(struct lineIndexTask* task, size_t offset, size_t length)
+{
+	if (task->lineCount >= task->maxLines) {
+		size_t maxLines = task->maxLines * EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT;
+		ewelborn_line* newLines = reallocateFrom(NULL, task->lines,
+			sizeof(ewelborn_line) * task->maxLines, sizeof(ewelborn_line) * maxLines, EWELBORN_ALLOCATION_STRING);
+		if (newLines == NULL) { return false; }
+		task->lines = newLines;
+		task->maxLines = maxLines;
+	}
+	task->lines[task->lineCount].offset = offset;
+	task->lines[task->lineCount].length = length;
+	task->lineCount++;
+	return true;
+}
+
+// Finds every line in the task's chunk that ends with a delimiter. Whatever
+// follows the last delimiter is left for the next chunk, or is the final line.
+static void lineIndexTaskRun(void* parameter)
+{
+	struct lineIndexTask* task = parameter;
+	task->lineCount = 0;
+	task->maxLines = 1024;
+	task->lines = allocateFrom(NULL, sizeof(ewelborn_line) * task->maxLines, EWELBORN_ALLOCATION_STRING);
+	task->remainder = task->start;
+	task->failed = task->lines == NULL;
+	if (task->failed) { return; }
+
+	size_t offset = task->start;
+	while (offset < task->end) {
+		size_t end = offset + ewelborn_scan_findChar(task->data + offset, task->end - offset, task->delimiter);
+		if (end >= task->end) { break; }
+
+		size_t length = end - offset;
+		if (task->stripCarriageReturns && length > 0 && task->data[end - 1] == '\r') { length--; }
+		if (lineIndexTaskPush(task, offset, length) == false) {
+			task->failed = true;
+			return;
+		}
+		offset = end + 1;
+	}
+	task->remainder = offset;
+}
+
+// Finds every line in data that's separated by the delimiter, the same way
+// that ewelborn_stringView_splitNext would, and stores them in lines. The data
+// is cut into one chunk per thread, with each chunk ending just after a
+// delimiter so that no line is shared between two threads. The chunks' lines
+// are then merged in order. Returns true if successful, false otherwise.
+static bool indexLinesParallel(const char* data, size_t size, char delimiter, bool stripCarriageReturns,
+	int threadCount, ewelborn_line** lines, size_t* lineCount)
+{
+	threadCount = pickThreadCount(threadCount, size, PARALLEL_MINIMUM_CHUNK_SIZE);
+	struct lineIndexTask* tasks = allocateFrom(NULL, sizeof(struct lineIndexTask) * threadCount, EWELBORN_ALLOCATION_THREADING);
+	if (tasks == NULL) { return false; }
+
+	// Pick the scanning kernels up front, instead of on every thread at once
+	ewelborn_scan_getImplementation();
+
+	size_t chunkStart = 0;
+	for (int i = 0; i < threadCount; i++) {
+		size_t chunkEnd = size;
+		if (i < threadCount - 1) {
+			size_t guess = size / threadCount * (i + 1);
+			if (guess < chunkStart) { guess = chunkStart; }
+			if (guess < size) {
+				size_t delimiterAt = guess + ewelborn_scan_findChar(data + guess, size - guess, delimiter);
+				chunkEnd = delimiterAt < size ? delimiterAt + 1 : size;
+			}
+		}
+
+		tasks[i].data = data;
+		tasks[i].start = chunkStart;
+		tasks[i].end = chunkEnd;
+		tasks[i].delimiter = delimiter;
+		tasks[i].stripCarriageReturns = stripCarriageReturns;
+		chunkStart = chunkEnd;
+	}
+
+	runTasksInParallel(tasks, sizeof(struct lineIndexTask), threadCount, lineIndexTaskRun);
+
+	// The final line is whatever follows the last delimiter, even if it's
+	// empty, which is the remainder of the last chunk that isn't empty.
+	bool failed = false;
+	size_t totalLines = 1;
+	size_t finalLineStart = 0;
+	for (int i = 0; i < threadCount; i++) {
+		failed = failed || tasks[i].failed;
+		totalLines += tasks[i].lineCount;
+		if (tasks[i].start < tasks[i].end) { finalLineStart = tasks[i].remainder; }
+	}
+
+	if (failed == false) {
+		if (threadCount == 1) {
+			// Nothing to merge, so the thread's lines can be used directly
+			failed = lineIndexTaskPush(&tasks[0], finalLineStart, size - finalLineStart) == false;
+			if (failed == false) {
+				*lines = tasks[0].lines;
+				*lineCount = tasks[0].lineCount;
+				tasks[0].lines = NULL;
+			}
+		}
+		else {
+			*lines = allocateFrom(NULL, sizeof(ewelborn_line) * totalLines, EWELBORN_ALLOCATION_STRING);
+			failed = *lines == NULL;
+			if (failed == false) {
+				size_t merged = 0;
+				for (int i = 0; i < threadCount; i++) {
+					memcpy(*lines + merged, tasks[i].lines, sizeof(ewelborn_line) * tasks[i].lineCount);
+					merged += tasks[i].lineCount;
+				}
+				(*lines)[merged].offset = finalLineStart;
+				(*lines)[merged].length = size - finalLineStart;
+				*lineCount = totalLines;
+			}
+		}
+	}
+
+	for (int i = 0; i < threadCount; i++) {
+		releaseTo(NULL, tasks[i].lines, EWELBORN_ALLOCATION_STRING);
+	}
+	releaseTo(NULL, tasks, EWELBORN_ALLOCATION_THREADING);
+	return failed == false;
+}
+
+// One thread's share of the lines being copied by copyLinesParallel
+struct lineCopyTask {
+	const char* data;
+	const ewelborn_line* lines;
+	ewelborn_string** strings;
+	size_t count;
+	bool failed;
+};
+
+static void lineCopyTaskRun(void* parameter)
+{
+	struct lineCopyTask* task = parameter;
+	task->failed = false;
+	for (size_t i = 0; i < task->count; i++) {
+		// Lines that are too long for an estring can't be copied
+		const ewelborn_line* line = &task->lines[i];
+		task->strings[i] = task->failed || line->length > INT_MAX ? NULL :
+			stringFromBuffer(task->data + line->offset, (int)line->length, NULL);
+		task->failed = task->failed || task->strings[i] == NULL;
+	}
+}
+
+// Copies every line into its own estring, using up to threadCount threads.
+// Returns a dynamic array of the estrings if successful, returns null otherwise.
+static ewelborn_dynamicArray* copyLinesParallel(const char* data, const ewelborn_line* lines, size_t lineCount, int threadCount)
+{
+	if (lineCount > INT_MAX) { return NULL; }
+	ewelborn_dynamicArray* strings = ewelborn_dynamicArray_initialize();
+	if (strings == NULL) { return NULL; }
+	strings->freeElement = freeStringElement;
+	threadCount = pickThreadCount(threadCount, lineCount, PARALLEL_MINIMUM_LINES);
+	struct lineCopyTask* tasks = allocateFrom(NULL, sizeof(struct lineCopyTask) * threadCount, EWELBORN_ALLOCATION_THREADING);
+	if (tasks == NULL || dynamicArrayReserve(strings, (int)lineCount) == false) {
+		releaseTo(NULL, tasks, EWELBORN_ALLOCATION_THREADING);
+		ewelborn_dynamicArray_free(strings);
+		return NULL;
+	}
+
+	size_t start = 0;
+	for (int i = 0; i < threadCount; i++) {
+		size_t end = lineCount / threadCount * (i + 1) + (i == threadCount - 1 ? lineCount % threadCount : 0);
+		tasks[i].data = data;
+		tasks[i].lines = lines + start;
+		tasks[i].strings = (ewelborn_string**)strings->array + start;
+		tasks[i].count = end - start;
+		start = end;
+	}
+
+	runTasksInParallel(tasks, sizeof(struct lineCopyTask), threadCount, lineCopyTaskRun);
+
+	bool failed = false;
+	for (int i = 0; i < threadCount; i++) {
+		failed = failed || tasks[i].failed;
+	}
+	releaseTo(NULL, tasks, EWELBORN_ALLOCATION_THREADING);
+
+	strings->elements = (int)lineCount;
+	if (failed) {
+		for (int i = 0; i < strings->elements; i++) {
+			if (strings->array[i] != NULL) { ewelborn_string_free(strings->array[i]); }
+		}
+		strings->elements = 0;
+		ewelborn_dynamicArray_free(strings);
+		return NULL;
+	}
+
+	return strings;
+}
+
+ewelborn_dynamicArray* ewelborn_string_splitParallel(ewelborn_string* estring, char c, int threadCount)
+{
+	ewelborn_line* fields;
+	size_t fieldCount;
+	if (indexLinesParallel(estring->cstring, estring->length, c, false, threadCount, &fields, &fieldCount) == false) {
+		return NULL;
+	}
+
+	ewelborn_dynamicArray* results = copyLinesParallel(estring->cstring, fields, fieldCount, threadCount);
+	releaseTo(NULL, fields, EWELBORN_ALLOCATION_STRING);
+	return results;
+}
+
+void ewelborn_string_deleteChar(ewelborn_string* estring, int n)
+{
+	if (n < 0 || n >= estring->length) {
+		return;
+	}
+
+	// Close the gap from whichever side has fewer characters to move
+	if (n < estring->length - n - 1) {
+		memmove(estring->cstring + 1, estring->cstring, n);
+		ewelborn_string_deleteLeft(estring, 1);
+	}
+	else {
+		memmove(estring->cstring + n, estring->cstring + n + 1, estring->length - n);
+		estring->length--;
+	}
+}
+
+bool ewelborn_string_consumeChar(ewelborn_string* eString, char c, int n)
+{
+	if (n < 0 || n >= eString->length) {
+		return false;
+	}
+
+	if (eString->cstring[n] == c) {
+		ewelborn_string_deleteChar(eString, n);
+		return true;
+	}
+	else {
+		return false;
+	}
+}
+
+bool ewelborn_string_sprintf(ewelborn_string* estring, ...)
+{
+	va_list args;
+	va_start(args, estring);
+	// The arguments are read twice, once to measure and once to format, and
+	// a va_list can only be read once
+	va_list retryArgs;
+	va_copy(retryArgs, args);
+
+	// Thank you! https://stackoverflow.com/questions/3919995/determining-sprintf-buffer-size-whats-the-standard
+	int len = vsnprintf(NULL, 0, estring->cstring, args);
+	va_end(args);
+	char* buffer = len < 0 ? NULL : allocateFrom(estring->allocator, len + 1, EWELBORN_ALLOCATION_STRING);
+	if (buffer == NULL) {
+		va_end(retryArgs);
+		return false;
+	}
+	int written = vsnprintf(buffer, len + 1, estring->cstring, retryArgs);
+	va_end(retryArgs);
+	if (written < 0) {
+		goto CLEAN_UP_AND_CRASH;
+	}
+
+	// Free the original cstring and replace it with the new one, moving
+	// the new one inline if it's short enough.
+	stringReleaseBuffer(estring);
+	estring->length = len;
+	estring->start = 0;
+	if (len + 1 <= EWELBORN_STRING_INLINE_SIZE) {
+		memcpy(estring->inlineBuffer, buffer, len + 1);
+		releaseTo(estring->allocator, buffer, EWELBORN_ALLOCATION_STRING);
+		estring->cstring = estring->inlineBuffer;
+		estring->maxLength = EWELBORN_STRING_INLINE_SIZE;
+	}
+	else {
+		estring->cstring = buffer;
+		estring->maxLength = len + 1;
+	}
+	return true;
+
+CLEAN_UP_AND_CRASH:
+	releaseTo(estring->allocator, buffer, EWELBORN_ALLOCATION_STRING);
+	return false;
+}
+
+// appendf formats into a buffer on the stack first, and only allocates one
+// for text longer than this
+#define STRING_APPENDF_BUFFER_SIZE 256
+
+bool ewelborn_string_appendf(ewelborn_string* estring, const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	va_list retryArgs;
+	va_copy(retryArgs, args);
+
+	// The arguments may point into the estring itself, so the text can't be
+	// formatted straight into the estring: vsnprintf would be writing over
+	// the characters that it's reading, and growing the estring could free
+	// them. It's formatted into a separate buffer and appended from there.
+	char stackBuffer[STRING_APPENDF_BUFFER_SIZE];
+	char* buffer = stackBuffer;
+	bool success = false;
+	int length = vsnprintf(stackBuffer, sizeof(stackBuffer), format, args);
+	if (length < 0 || length == INT_MAX) { goto CLEAN_UP; }
+	if (length >= (int)sizeof(stackBuffer)) {
+		buffer = allocateFrom(estring->allocator, (size_t)length + 1, EWELBORN_ALLOCATION_STRING);
+		if (buffer == NULL || vsnprintf(buffer, (size_t)length + 1, format, retryArgs) != length) { goto CLEAN_UP; }
+	}
+	success = ewelborn_string_appendN(estring, buffer, length);
+
+CLEAN_UP:
+	if (buffer != stackBuffer) { releaseTo(estring->allocator, buffer, EWELBORN_ALLOCATION_STRING); }
+	va_end(args);
+	va_end(retryArgs);
+	return success;
+}
+
+// Multiplies two 64-bit numbers into a full 128-bit result.
+static void multiply128(uint64_t a, uint64_t b, uint64_t* low, uint64_t* high)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 result = (unsigned __int128)a * b;
+	*low = (uint64_t)result;
+	*high = (uint64_t)(result >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	*low = _umul128(a, b, high);
+#else
+	// Multiply each 32-bit half by each other 32-bit half, then add
+	// the pieces back together, carrying into the high half.
+	uint64_t aLow = (uint32_t)a, aHigh = a >> 32;
+	uint64_t bLow = (uint32_t)b, bHigh = b >> 32;
+	uint64_t lowLow = aLow * bLow;
+	uint64_t highLow = aHigh * bLow;
+	uint64_t lowHigh = aLow * bHigh;
+	uint64_t highHigh = aHigh * bHigh;
+	uint64_t middle = (lowLow >> 32) + (uint32_t)highLow + (uint32_t)lowHigh;
+	*low = (middle << 32) | (uint32_t)lowLow;
+	*high = highHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32);
+#endif
+}
+
+// Multiplies a and b, and folds the 128-bit result back into 64 bits
+static uint64_t hashMix(uint64_t a, uint64_t b)
+{
+	uint64_t low, high;
+	multiply128(a, b, &low, &high);
+	return low ^ high;
+}
+
+static uint64_t read64(const unsigned char* p)
+{
+	uint64_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+static uint64_t read32(const unsigned char* p)
+{
+	uint32_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+// The same secret constants that wyhash uses
+static const uint64_t hashSecret[4] = {
+	0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+uint64_t ewelborn_hash(const void* data, size_t length, uint64_t seed)
+{
+	const unsigned char* p = data;
+	uint64_t a, b;
+	seed ^= hashMix(seed ^ hashSecret[0], hashSecret[1]);
+
+	if (length <= 16) {
+		// Short keys are read with (possibly overlapping) reads from the
+		// front and the back, so there are no loops or branches per byte.
+		if (length >= 4) {
+			size_t middle = (length >> 3) << 2;
+			a = (read32(p) << 32) | read32(p + middle);
+			b = (read32(p + length - 4) << 32) | read32(p + length - 4 - middle);
+		}
+		else if (length > 0) {
+			a = ((uint64_t)p[0] << 16) | ((uint64_t)p[length >> 1] << 8) | p[length - 1];
+			b = 0;
+		}
+		else {
+			a = b = 0;
+		}
+	}
+	else {
+		size_t i = length;
+		if (i > 48) {
+			// Mix three independent lanes at a time so the multiplications
+			// can run in parallel.
+			uint64_t seed1 = seed, seed2 = seed;
+			do {
+				seed = hashMix(read64(p) ^ hashSecret[1], read64(p + 8) ^ seed);
+				seed1 = hashMix(read64(p + 16) ^ hashSecret[2], read64(p + 24) ^ seed1);
+				seed2 = hashMix(read64(p + 32) ^ hashSecret[3], read64(p + 40) ^ seed2);
+				p += 48;
+				i -= 48;
+			} while (i > 48);
+			seed ^= seed1 ^ seed2;
+		}
+		while (i > 16) {
+			seed = hashMix(read64(p) ^ hashSecret[1], read64(p + 8) ^ seed);
+			p += 16;
+			i -= 16;
+		}
+		a = read64(p + i - 16);
+		b = read64(p + i - 8);
+	}
+
+	a ^= hashSecret[1];
+	b ^= seed;
+	multiply128(a, b, &a, &b);
+	return hashMix(a ^ hashSecret[0] ^ length, b ^ hashSecret[1]);
+}
+
+uint64_t ewelborn_string_hash(ewelborn_string* estring)
+{
+	return ewelborn_hash(estring->cstring, estring->length, 0);
+}
+
+uint64_t ewelborn_stringView_hash(ewelborn_stringView view)
+{
+	return ewelborn_hash(view.data, view.length, 0);
+}
+
+// The map grows once it's more than 7/8ths full. Robin Hood probing keeps
+// the probe lengths short even at high load.
+#define HASH_MAP_MAX_LOAD(capacity) ((capacity) - (capacity) / 8)
+
+// Allocates an array of capacity empty entries. Returns null if it fails.
+static ewelborn_hashMapEntry* hashMapAllocateEntries(ewelborn_hashMap* map, size_t capacity)
+{
+	if (capacity > (size_t)-1 / sizeof(ewelborn_hashMapEntry)) { return NULL; }
+	ewelborn_hashMapEntry* entries = allocateFrom(map->allocator, sizeof(ewelborn_hashMapEntry) * capacity, EWELBORN_ALLOCATION_HASH_MAP);
+	if (entries == NULL) { return NULL; }
+	memset(entries, 0, sizeof(ewelborn_hashMapEntry) * capacity);
+	return entries;
+}
+
+ewelborn_hashMap* ewelborn_hashMap_initialize()
+{
+	return ewelborn_hashMap_initializeWithAllocator(NULL);
+}
+
+ewelborn_hashMap* ewelborn_hashMap_initializeWithAllocator(ewelborn_allocator* allocator)
+{
+	if (allocator == NULL) { allocator = globalAllocator; }
+	ewelborn_hashMap* map = allocateFrom(allocator, sizeof(ewelborn_hashMap), EWELBORN_ALLOCATION_HASH_MAP);
+	if (map == NULL) { return NULL; }
+	map->allocator = allocator;
+	map->capacity = EWELBORN_HASH_MAP_STARTING_SIZE;
+	map->size = 0;
+	map->entries = hashMapAllocateEntries(map, map->capacity);
+	map->keys = ewelborn_arena_initializeWithAllocator(0, allocator);
+	if (map->entries == NULL || map->keys == NULL) {
+		releaseTo(allocator, map->entries, EWELBORN_ALLOCATION_HASH_MAP);
+		if (map->keys != NULL) { ewelborn_arena_free(map->keys); }
+		releaseTo(allocator, map, EWELBORN_ALLOCATION_HASH_MAP);
+		return NULL;
+	}
+	return map;
+}
+
+// Moves every entry into a new array with the given capacity. The stored
+// hashes are reused, so no keys are hashed or compared.
+static bool hashMapResize(ewelborn_hashMap* map, size_t capacity)
+{
+	ewelborn_hashMapEntry* newEntries = hashMapAllocateEntries(map, capacity);
+	if (newEntries == NULL) { return false; }
+
+	size_t mask = capacity - 1;
+	for (size_t i = 0; i < map->capacity; i++) {
+		if (map->entries[i].distance == 0) { continue; }
+
+		ewelborn_hashMapEntry entry = map->entries[i];
+		entry.distance = 1;
+		size_t slot = entry.hash & mask;
+		while (true) {
+			if (newEntries[slot].distance == 0) {
+				newEntries[slot] = entry;
+				break;
+			}
+			if (newEntries[slot].distance < entry.distance) {
+				ewelborn_hashMapEntry displaced = newEntries[slot];
+				newEntries[slot] = entry;
+				entry = displaced;
+			}
+			slot = (slot + 1) & mask;
+			entry.distance++;
+		}
+	}
+
+	releaseTo(map->allocator, map->entries, EWELBORN_ALLOCATION_HASH_MAP);
+	map->entries = newEntries;
+	map->capacity = capacity;
+	return true;
+}
+
+// Returns the slot that holds the given key, or -1 if the key isn't in the map.
+static ptrdiff_t hashMapFindSlot(ewelborn_hashMap* map, ewelborn_stringView key, uint64_t hash)
+{
+	size_t mask = map->capacity - 1;
+	size_t slot = hash & mask;
+	for (int distance = 1; ; distance++) {
+		ewelborn_hashMapEntry* entry = &map->entries[slot];
+		// Robin Hood probing keeps entries sorted by distance, so once we
+		// reach an entry that's closer to home than we would be, the key
+		// can't be any further along.
+		if (entry->distance < distance) { return -1; }
+		if (entry->hash == hash && entry->keyLength == key.length &&
+			memcmp(entry->key, key.data, key.length) == 0) {
+			return (ptrdiff_t)slot;
+		}
+		slot = (slot + 1) & mask;
+	}
+}
+
+bool ewelborn_hashMap_insert(ewelborn_hashMap* map, ewelborn_string* key, void* value)
+{
+	return ewelborn_hashMap_insertView(map, ewelborn_stringView_fromString(key), value);
+}
+
+bool ewelborn_hashMap_insertView(ewelborn_hashMap* map, ewelborn_stringView key, void* value)
+{
+	if (map->size + 1 > HASH_MAP_MAX_LOAD(map->capacity)) {
+		if (hashMapResize(map, map->capacity * 2) == false) { return false; }
+	}
+
+	uint64_t hash = ewelborn_stringView_hash(key);
+	size_t mask = map->capacity - 1;
+	size_t slot = hash & mask;
+	int distance = 1;
+
+	// Probe for the key first. If we reach an empty slot, or an entry that's
+	// closer to home than we are, then the key isn't in the map, and this
+	// is where it belongs.
+	while (true) {
+		ewelborn_hashMapEntry* entry = &map->entries[slot];
+		if (entry->distance < distance) { break; }
+		if (entry->hash == hash && entry->keyLength == key.length &&
+			memcmp(entry->key, key.data, key.length) == 0) {
+			entry->value = value;
+			return true;
+		}
+		slot = (slot + 1) & mask;
+		distance++;
+	}
+
+	char* keyCopy = ewelborn_arena_allocate(map->keys, (size_t)key.length + 1);
+	if (keyCopy == NULL) { return false; }
+	memcpy(keyCopy, key.data, key.length);
+	keyCopy[key.length] = '\0';
+
+	// Place the new entry, and keep pushing along whichever entry it
+	// displaces until one of them lands in an empty slot.
+	ewelborn_hashMapEntry newEntry = { hash, keyCopy, key.length, distance, value };
+	while (true) {
+		ewelborn_hashMapEntry* entry = &map->entries[slot];
+		if (entry->distance == 0) {
+			*entry = newEntry;
+			break;
+		}
+		if (entry->distance < newEntry.distance) {
+			ewelborn_hashMapEntry displaced = *entry;
+			*entry = newEntry;
+			newEntry = displaced;
+		}
+		slot = (slot + 1) & mask;
+		newEntry.distance++;
+	}
+
+	map->size++;
+	return true;
+}
+
+void** ewelborn_hashMap_find(ewelborn_hashMap* map, ewelborn_string* key)
+{
+	return ewelborn_hashMap_findView(map, ewelborn_stringView_fromString(key));
+}
+
+void** ewelborn_hashMap_findView(ewelborn_hashMap* map, ewelborn_stringView key)
+{
+	ptrdiff_t slot = hashMapFindSlot(map, key, ewelborn_stringView_hash(key));
+	return slot >= 0 ? &map->entries[slot].value : NULL;
+}
+
+bool ewelborn_hashMap_erase(ewelborn_hashMap* map, ewelborn_string* key)
+{
+	return ewelborn_hashMap_eraseView(map, ewelborn_stringView_fromString(key));
+}
+
+bool ewelborn_hashMap_eraseView(ewelborn_hashMap* map, ewelborn_stringView key)
+{
+	ptrdiff_t found = hashMapFindSlot(map, key, ewelborn_stringView_hash(key));
+	if (found < 0) { return false; }
+
+	// Instead of leaving a tombstone behind, shift every entry after this one
+	// back by a slot, until we reach an entry that's already in its ideal
+	// slot (or an empty slot).
+	size_t mask = map->capacity - 1;
+	size_t slot = (size_t)found;
+	size_t next = (slot + 1) & mask;
+	while (map->entries[next].distance > 1) {
+		map->entries[slot] = map->entries[next];
+		map->entries[slot].distance--;
+		slot = next;
+		next = (next + 1) & mask;
+	}
+	memset(&map->entries[slot], 0, sizeof(ewelborn_hashMapEntry));
+
+	map->size--;
+	return true;
+}
+
+bool ewelborn_hashMap_reserve(ewelborn_hashMap* map, size_t count)
+{
+	size_t capacity = map->capacity;
+	while (HASH_MAP_MAX_LOAD(capacity) < count) {
+		if (capacity > (size_t)-1 / 2 / sizeof(ewelborn_hashMapEntry)) { return false; }
+		capacity *= 2;
+	}
+	if (capacity == map->capacity) { return true; }
+	return hashMapResize(map, capacity);
+}
+
+bool ewelborn_hashMap_next(ewelborn_hashMap* map, size_t* iterator, ewelborn_stringView* key, void** value)
+{
+	for (; *iterator < map->capacity; (*iterator)++) {
+		ewelborn_hashMapEntry* entry = &map->entries[*iterator];
+		if (entry->distance == 0) { continue; }
+
+		if (key != NULL) { *key = ewelborn_stringView_fromBuffer(entry->key, entry->keyLength); }
+		if (value != NULL) { *value = entry->value; }
+		(*iterator)++;
+		return true;
+	}
+	return false;
+}
+
+void ewelborn_hashMap_clear(ewelborn_hashMap* map)
+{
+	memset(map->entries, 0, sizeof(ewelborn_hashMapEntry) * map->capacity);
+	map->size = 0;
+	ewelborn_arena_reset(map->keys);
+}
+
+void ewelborn_hashMap_free(ewelborn_hashMap* map)
+{
+	releaseTo(map->allocator, map->entries, EWELBORN_ALLOCATION_HASH_MAP);
+	ewelborn_arena_free(map->keys);
+	releaseTo(map->allocator, map, EWELBORN_ALLOCATION_HASH_MAP);
+}
+
+// The pool's table grows once it's more than 3/4ths full. It only ever holds
+// 8 byte slots, so keeping it sparse is cheap.
+#define STRING_POOL_STARTING_CAPACITY 64
+#define STRING_POOL_MAX_LOAD(capacity) ((capacity) - (capacity) / 4)
+// Characters are packed into blocks of this size, instead of giving every
+// string its own (16 byte aligned) arena allocation. Longer strings get an
+// allocation of their own.
+#define STRING_POOL_BLOCK_SIZE 4096
+// The bulk functions hash this many strings at a time
+#define STRING_POOL_BATCH_SIZE 64
+
+ewelborn_stringPool* ewelborn_stringPool_initialize()
+{
+	return ewelborn_stringPool_initializeWithAllocator(NULL);
+}
+
+ewelborn_stringPool* ewelborn_stringPool_initializeWithAllocator(ewelborn_allocator* allocator)
+{
+	if (allocator == NULL) { allocator = globalAllocator; }
+	ewelborn_stringPool* pool = allocateFrom(allocator, sizeof(ewelborn_stringPool), EWELBORN_ALLOCATION_HASH_MAP);
+	if (pool == NULL) { return NULL; }
+	pool->allocator = allocator;
+	pool->count = 0;
+	pool->maxCount = STRING_POOL_STARTING_CAPACITY;
+	pool->capacity = STRING_POOL_STARTING_CAPACITY;
+	pool->block = NULL;
+	pool->blockRemaining = 0;
+	pool->strings = allocateFrom(allocator, sizeof(ewelborn_internedString) * pool->maxCount, EWELBORN_ALLOCATION_HASH_MAP);
+	pool->slots = allocateFrom(allocator, sizeof(uint64_t) * pool->capacity, EWELBORN_ALLOCATION_HASH_MAP);
+	pool->arena = ewelborn_arena_initializeWithAllocator(0, allocator);
+	if (pool->strings == NULL || pool->slots == NULL || pool->arena == NULL) {
+		releaseTo(allocator, pool->strings, EWELBORN_ALLOCATION_HASH_MAP);
+		releaseTo(allocator, pool->slots, EWELBORN_ALLOCATION_HASH_MAP);
+		if (pool->arena != NULL) { ewelborn_arena_free(pool->arena); }
+		releaseTo(allocator, pool, EWELBORN_ALLOCATION_HASH_MAP);
+		return NULL;
+	}
+	memset(pool->slots, 0, sizeof(uint64_t) * pool->capacity);
+	return pool;
+}
+
+// Returns the ID of the string if it's in the pool. Otherwise, returns -1,
+// and stores the empty slot where it belongs in emptySlot.
+static int stringPoolProbe(ewelborn_stringPool* pool, ewelborn_stringView view, uint64_t hash, size_t* emptySlot)
+{
+	size_t mask = pool->capacity - 1;
+	size_t slot = hash & mask;
+	uint64_t tag = hash >> 32;
+	while (true) {
+		uint64_t entry = pool->slots[slot];
+		if (entry == 0) {
+			*emptySlot = slot;
+			return -1;
+		}
+		// Compare the stored part of the hash first, so that the characters
+		// of other strings almost never have to be looked at
+		if ((entry >> 32) == tag) {
+			int id = (int)(uint32_t)entry - 1;
+			ewelborn_internedString* string = &pool->strings[id];
+			if (string->length == view.length && memcmp(string->data, view.data, view.length) == 0) {
+				return id;
+			}
+		}
+		slot = (slot + 1) & mask;
+	}
+}
+
+// Moves every ID into a table with the given capacity, using the stored
+// hashes, so no strings are hashed or compared.
+static bool stringPoolResize(ewelborn_stringPool* pool, size_t capacity)
+{
+	if (capacity > (size_t)-1 / sizeof(uint64_t)) { return false; }
+	uint64_t* slots = allocateFrom(pool->allocator, sizeof(uint64_t) * capacity, EWELBORN_ALLOCATION_HASH_MAP);
+	if (slots == NULL) { return false; }
+	memset(slots, 0, sizeof(uint64_t) * capacity);
+
+	size_t mask = capacity - 1;
+	for (int id = 0; id < pool->count; id++) {
+		uint64_t hash = pool->strings[id].hash;
+		size_t slot = hash & mask;
+		while (slots[slot] != 0) { slot = (slot + 1) & mask; }
+		slots[slot] = ((hash >> 32) << 32) | (uint64_t)(id + 1);
+	}
+
+	releaseTo(pool->allocator, pool->slots, EWELBORN_ALLOCATION_HASH_MAP);
+	pool->slots = slots;
+	pool->capacity = capacity;
+	return true;
+}
+
+// Copies the characters into the pool, followed by a null terminator.
+// Returns the copy if successful, returns null otherwise.
+static char* stringPoolCopy(ewelborn_stringPool* pool, ewelborn_stringView view)
+{
+	size_t size = (size_t)view.length + 1;
+	char* copy;
+	if (size > STRING_POOL_BLOCK_SIZE / 4) {
+		copy = ewelborn_arena_allocate(pool->arena, size);
+	}
+	else {
+		if (size > pool->blockRemaining) {
+			pool->block = ewelborn_arena_allocate(pool->arena, STRING_POOL_BLOCK_SIZE);
+			pool->blockRemaining = pool->block != NULL ? STRING_POOL_BLOCK_SIZE : 0;
+		}
+		copy = pool->block;
+		if (copy != NULL) {
+			pool->block += size;
+			pool->blockRemaining -= size;
+		}
+	}
+	if (copy == NULL) { return NULL; }
+	memcpy(copy, view.data, view.length);
+	copy[view.length] = '\0';
+	return copy;
+}
+
+// Interns a view whose hash has already been found.
+static int stringPoolIntern(ewelborn_stringPool* pool, ewelborn_stringView view, uint64_t hash)
+{
+	size_t slot;
+	int id = stringPoolProbe(pool, view, hash, &slot);
+	if (id >= 0) { return id; }
+	if (pool->count == INT_MAX - 1) { return -1; }
+
+	// Make room for the new string first, so that nothing has to be undone
+	// if memory runs out
+	if ((size_t)pool->count + 1 > STRING_POOL_MAX_LOAD(pool->capacity)) {
+		if (stringPoolResize(pool, pool->capacity * 2) == false) { return -1; }
+		stringPoolProbe(pool, view, hash, &slot);
+	}
+	if (pool->count == pool->maxCount) {
+		int maxCount = pool->maxCount <= INT_MAX / 2 ? pool->maxCount * 2 : INT_MAX;
+		ewelborn_internedString* strings = reallocateFrom(pool->allocator, pool->strings,
+			sizeof(ewelborn_internedString) * pool->maxCount, sizeof(ewelborn_internedString) * maxCount, EWELBORN_ALLOCATION_HASH_MAP);
+		if (strings == NULL) { return -1; }
+		pool->strings = strings;
+		pool->maxCount = maxCount;
+	}
+	char* copy = stringPoolCopy(pool, view);
+	if (copy == NULL) { return -1; }
+
+	id = pool->count++;
+	pool->strings[id] = (ewelborn_internedString){ copy, view.length, hash };
+	pool->slots[slot] = ((hash >> 32) << 32) | (uint64_t)(id + 1);
+	return id;
+}
+
+int ewelborn_stringPool_internView(ewelborn_stringPool* pool, ewelborn_stringView view)
+{
+	return stringPoolIntern(pool, view, ewelborn_stringView_hash(view));
+}
+
+int ewelborn_stringPool_intern(ewelborn_stringPool* pool, ewelborn_string* estring)
+{
+	return ewelborn_stringPool_internView(pool, ewelborn_stringView_fromString(estring));
+}
+
+// Interns a batch of views, and pushes their IDs onto ids. The views are
+// all hashed before any of them are looked up, which lets the CPU hash
+// several of them at once instead of waiting on each lookup in turn.
+static bool stringPoolInternBatch(ewelborn_stringPool* pool, const ewelborn_stringView* views, int count, ewelborn_typedArray* ids)
+{
+	uint64_t hashes[STRING_POOL_BATCH_SIZE];
+	int batchIds[STRING_POOL_BATCH_SIZE];
+	for (int i = 0; i < count; i++) {
+		hashes[i] = ewelborn_stringView_hash(views[i]);
+	}
+	for (int i = 0; i < count; i++) {
+		batchIds[i] = stringPoolIntern(pool, views[i], hashes[i]);
+		if (batchIds[i] < 0) {
+			ewelborn_typedArray_appendMany(ids, batchIds, i);
+			return false;
+		}
+	}
+	return ewelborn_typedArray_appendMany(ids, batchIds, count);
+}
+
+bool ewelborn_stringPool_internAll(ewelborn_stringPool* pool, ewelborn_dynamicArray* estrings, ewelborn_typedArray* ids)
+{
+	if (ids->elementSize != sizeof(int)) { return false; }
+	if (ewelborn_typedArray_reserve(ids, ids->elements + estrings->elements) == false) { return false; }
+
+	ewelborn_stringView views[STRING_POOL_BATCH_SIZE];
+	int batchSize = 0;
+	for (int i = 0; i < estrings->elements; i++) {
+		views[batchSize++] = ewelborn_stringView_fromString(estrings->array[i]);
+		if (batchSize == STRING_POOL_BATCH_SIZE) {
+			if (stringPoolInternBatch(pool, views, batchSize, ids) == false) { return false; }
+			batchSize = 0;
+		}
+	}
+	return stringPoolInternBatch(pool, views, batchSize, ids);
+}
+
+bool ewelborn_stringPool_internSplit(ewelborn_stringPool* pool, ewelborn_stringView view, char c, ewelborn_typedArray* ids)
+{
+	if (ids->elementSize != sizeof(int)) { return false; }
+
+	ewelborn_stringView views[STRING_POOL_BATCH_SIZE];
+	int batchSize = 0;
+	while (ewelborn_stringView_splitNext(&view, c, &views[batchSize])) {
+		if (++batchSize == STRING_POOL_BATCH_SIZE) {
+			if (stringPoolInternBatch(pool, views, batchSize, ids) == false) { return false; }
+			batchSize = 0;
+		}
+	}
+	return stringPoolInternBatch(pool, views, batchSize, ids);
+}
+
+int ewelborn_stringPool_find(ewelborn_stringPool* pool, ewelborn_stringView view)
+{
+	size_t slot;
+	return stringPoolProbe(pool, view, ewelborn_stringView_hash(view), &slot);
+}
+
+ewelborn_stringView ewelborn_stringPool_get(ewelborn_stringPool* pool, int id)
+{
+	if (id < 0 || id >= pool->count) { return ewelborn_stringView_fromBuffer(NULL, 0); }
+	return ewelborn_stringView_fromBuffer(pool->strings[id].data, pool->strings[id].length);
+}
+
+uint64_t ewelborn_stringPool_hash(ewelborn_stringPool* pool, int id)
+{
+	if (id < 0 || id >= pool->count) { return 0; }
+	return pool->strings[id].hash;
+}
+
+void ewelborn_stringPool_clear(ewelborn_stringPool* pool)
+{
+	memset(pool->slots, 0, sizeof(uint64_t) * pool->capacity);
+	pool->count = 0;
+	pool->block = NULL;
+	pool->blockRemaining = 0;
+	ewelborn_arena_reset(pool->arena);
+}
+
+void ewelborn_stringPool_free(ewelborn_stringPool* pool)
+{
+	releaseTo(pool->allocator, pool->strings, EWELBORN_ALLOCATION_HASH_MAP);
+	releaseTo(pool->allocator, pool->slots, EWELBORN_ALLOCATION_HASH_MAP);
+	ewelborn_arena_free(pool->arena);
+	releaseTo(pool->allocator, pool, EWELBORN_ALLOCATION_HASH_MAP);
+}
+
+// Reads 8 characters as a little endian number, no matter what the CPU's
+// byte order is, so the first character is always in the lowest byte.
+static uint64_t readDigits8(const char* p)
+{
+	uint64_t value;
+	memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	value = __builtin_bswap64(value);
+#endif
+	return value;
+}
+
+// Returns true if all 8 characters in the chunk are '0' through '9'
+static bool isEightDigits(uint64_t chunk)
+{
+	return (((chunk & 0xF0F0F0F0F0F0F0F0ull) | (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4))
+		== 0x3333333333333333ull);
+}
+
+// Turns 8 digits into their value with three multiplications, combining
+// neighboring digits into pairs, then pairs into fours, then fours into the
+// full 8 digits, instead of going through them one at a time.
+static uint32_t parseEightDigits(uint64_t chunk)
+{
+	chunk -= 0x3030303030303030ull;
+	chunk = (chunk * 10) + (chunk >> 8);
+	chunk = (((chunk & 0x000000FF000000FFull) * (100 + (1000000ull << 32)))
+		+ (((chunk >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+	return (uint32_t)chunk;
+}
+
+// Returns how many of the 8 characters in the chunk are digits before the
+// first one that isn't, without looking at them one at a time.
+static int leadingDigitCount(uint64_t chunk)
+{
+	// The high half of each byte is non-zero if the byte isn't a digit.
+	// Adding 6 can carry into the next byte, but only from a byte that isn't
+	// a digit, so the bytes before the first non-digit are never affected.
+	uint64_t nonDigits = ((chunk & 0xF0F0F0F0F0F0F0F0ull) ^ 0x3030303030303030ull)
+		| (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) ^ 0x3030303030303030ull);
+	if (nonDigits == 0) { return 8; }
+	return lowestSetBit64(nonDigits) / 8;
+}
+
+// Turns the first count (1 to 8) digits of the chunk into their value
+static uint32_t parseLeadingDigits(uint64_t chunk, int count)
+{
+	if (count < 8) {
+		// Move the digits to the end, and fill in the start with '0's
+		chunk = (chunk << (8 * (8 - count))) | (0x3030303030303030ull >> (8 * count));
+	}
+	return parseEightDigits(chunk);
+}
+
+static const uint64_t integerPowersOfTen[] = {
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+};
+
+static bool isDigit(char c)
+{
+	return (unsigned char)(c - '0') < 10;
+}
+
+// Parses an integer from the start of the buffer, and stores where the
+// integer ended in stop (or the start of the buffer if there wasn't one).
+static ewelborn_parseResult parseInt64Prefix(const char* p, const char* end, int64_t* value, const char** stop)
+{
+	const char* start = p;
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+')) {
+		negative = *p == '-';
+		p++;
+	}
+
+	const char* digits = p;
+	while (p < end && *p == '0') { p++; }
+	const char* significant = p;
+	uint64_t magnitude = 0;
+	// Up to 8 digits at a time, so most numbers are parsed without
+	// branching on each digit
+	while (end - p >= 8) {
+		uint64_t chunk = readDigits8(p);
+		int count = leadingDigitCount(chunk);
+		if (count == 0) { break; }
+		magnitude = magnitude * integerPowersOfTen[count] + parseLeadingDigits(chunk, count);
+		p += count;
+		if (count < 8) { break; }
+	}
+	while (p < end && isDigit(*p)) {
+		magnitude = magnitude * 10 + (uint64_t)(*p - '0');
+		p++;
+	}
+
+	if (p == digits) {
+		*stop = start;
+		return EWELBORN_PARSE_INVALID;
+	}
+	*stop = p;
+
+	// Every number with 19 digits or less fits in a uint64_t without wrapping
+	// around, so magnitude can be trusted as long as there weren't more.
+	uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+	if (p - significant > 19 || magnitude > limit) {
+		*value = negative ? INT64_MIN : INT64_MAX;
+		return EWELBORN_PARSE_OVERFLOW;
+	}
+	if (negative) {
+		*value = magnitude == (uint64_t)INT64_MAX + 1 ? INT64_MIN : -(int64_t)magnitude;
+	}
+	else {
+		*value = (int64_t)magnitude;
+	}
+	return EWELBORN_PARSE_SUCCESS;
+}
+
+// The smallest and largest powers of 10 that the Eisel-Lemire algorithm
+// needs to handle. Anything smaller is always zero, and anything larger is
+// always infinity.
+#define SMALLEST_POWER_OF_TEN -342
+#define LARGEST_POWER_OF_TEN 308
+
+// 5^q for every q from SMALLEST_POWER_OF_TEN to LARGEST_POWER_OF_FIVE, as
+// the 128 most significant bits (high 64 bits first), shifted so that the
+// highest bit is set. The negative powers are rounded up. Multiplying by
+// 10^q is the same as multiplying by 5^q and adding q to the binary
+// exponent, which is what makes the algorithm work. The table goes a little
+// past LARGEST_POWER_OF_TEN, since formatting the smallest doubles needs
+// 10^-324 (see ewelborn_string_appendDouble).
+#define LARGEST_POWER_OF_FIVE 324
+static const uint64_t powersOfFive[] = {
+	0xeef453d6923bd65aull, 0x113faa2906a13b3full,
+	0x9558b4661b6565f8ull, 0x4ac7ca59a424c507ull,
+	0xbaaee17fa23ebf76ull, 0x5d79bcf00d2df649ull,
+	0xe95a99df8ace6f53ull, 0xf4d82c2c107973dcull,
+	0x91d8a02bb6c10594ull, 0x79071b9b8a4be869ull,
+	0xb64ec836a47146f9ull, 0x9748e2826cdee284ull,
+	0xe3e27a444d8d98b7ull, 0xfd1b1b2308169b25ull,
+	0x8e6d8c6ab0787f72ull, 0xfe30f0f5e50e20f7ull,
+	0xb208ef855c969f4full, 0xbdbd2d335e51a935ull,
+	0xde8b2b66b3bc4723ull, 0xad2c788035e61382ull,
+	0x8b16fb203055ac76ull, 0x4c3bcb5021afcc31ull,
+	0xaddcb9e83c6b1793ull, 0xdf4abe242a1bbf3dull,
+	0xd953e8624b85dd78ull, 0xd71d6dad34a2af0dull,
+	0x87d4713d6f33aa6bull, 0x8672648c40e5ad68ull,
+	0xa9c98d8ccb009506ull, 0x680efdaf511f18c2ull,
+	0xd43bf0effdc0ba48ull, 0x0212bd1b2566def2ull,
+	0x84a57695fe98746dull, 0x014bb630f7604b57ull,
+	0xa5ced43b7e3e9188ull, 0x419ea3bd35385e2dull,
+	0xcf42894a5dce35eaull, 0x52064cac828675b9ull,
+	0x818995ce7aa0e1b2ull, 0x7343efebd1940993ull,
+	0xa1ebfb4219491a1full, 0x1014ebe6c5f90bf8ull,
+	0xca66fa129f9b60a6ull, 0xd41a26e077774ef6ull,
+	0xfd00b897478238d0ull, 0x8920b098955522b4ull,
+	0x9e20735e8cb16382ull, 0x55b46e5f5d5535b0ull,
+	0xc5a890362fddbc62ull, 0xeb2189f734aa831dull,
+	0xf712b443bbd52b7bull, 0xa5e9ec7501d523e4ull,
+	0x9a6bb0aa55653b2dull, 0x47b233c92125366eull,
+	0xc1069cd4eabe89f8ull, 0x999ec0bb696e840aull,
+	0xf148440a256e2c76ull, 0xc00670ea43ca250dull,
+	0x96cd2a865764dbcaull, 0x380406926a5e5728ull,
+	0xbc807527ed3e12bcull, 0xc605083704f5ecf2ull,
+	0xeba09271e88d976bull, 0xf7864a44c633682eull,
+	0x93445b8731587ea3ull, 0x7ab3ee6afbe0211dull,
+	0xb8157268fdae9e4cull, 0x5960ea05bad82964ull,
+	0xe61acf033d1a45dfull, 0x6fb92487298e33bdull,
+	0x8fd0c16206306babull, 0xa5d3b6d479f8e056ull,
+	0xb3c4f1ba87bc8696ull, 0x8f48a4899877186cull,
+	0xe0b62e2929aba83cull, 0x331acdabfe94de87ull,
+	0x8c71dcd9ba0b4925ull, 0x9ff0c08b7f1d0b14ull,
+	0xaf8e5410288e1b6full, 0x07ecf0ae5ee44dd9ull,
+	0xdb71e91432b1a24aull, 0xc9e82cd9f69d6150ull,
+	0x892731ac9faf056eull, 0xbe311c083a225cd2ull,
+	0xab70fe17c79ac6caull, 0x6dbd630a48aaf406ull,
+	0xd64d3d9db981787dull, 0x092cbbccdad5b108ull,
+	0x85f0468293f0eb4eull, 0x25bbf56008c58ea5ull,
+	0xa76c582338ed2621ull, 0xaf2af2b80af6f24eull,
+	0xd1476e2c07286faaull, 0x1af5af660db4aee1ull,
+	0x82cca4db847945caull, 0x50d98d9fc890ed4dull,
+	0xa37fce126597973cull, 0xe50ff107bab528a0ull,
+	0xcc5fc196fefd7d0cull, 0x1e53ed49a96272c8ull,
+	0xff77b1fcbebcdc4full, 0x25e8e89c13bb0f7aull,
+	0x9faacf3df73609b1ull, 0x77b191618c54e9acull,
+	0xc795830d75038c1dull, 0xd59df5b9ef6a2417ull,
+	0xf97ae3d0d2446f25ull, 0x4b0573286b44ad1dull,
+	0x9becce62836ac577ull, 0x4ee367f9430aec32ull,
+	0xc2e801fb244576d5ull, 0x229c41f793cda73full,
+	0xf3a20279ed56d48aull, 0x6b43527578c1110full,
+	0x9845418c345644d6ull, 0x830a13896b78aaa9ull,
+	0xbe5691ef416bd60cull, 0x23cc986bc656d553ull,
+	0xedec366b11c6cb8full, 0x2cbfbe86b7ec8aa8ull,
+	0x94b3a202eb1c3f39ull, 0x7bf7d71432f3d6a9ull,
+	0xb9e08a83a5e34f07ull, 0xdaf5ccd93fb0cc53ull,
+	0xe858ad248f5c22c9ull, 0xd1b3400f8f9cff68ull,
+	0x91376c36d99995beull, 0x23100809b9c21fa1ull,
+	0xb58547448ffffb2dull, 0xabd40a0c2832a78aull,
+	0xe2e69915b3fff9f9ull, 0x16c90c8f323f516cull,
+	0x8dd01fad907ffc3bull, 0xae3da7d97f6792e3ull,
+	0xb1442798f49ffb4aull, 0x99cd11cfdf41779cull,
+	0xdd95317f31c7fa1dull, 0x40405643d711d583ull,
+	0x8a7d3eef7f1cfc52ull, 0x482835ea666b2572ull,
+	0xad1c8eab5ee43b66ull, 0xda3243650005eecfull,
+	0xd863b256369d4a40ull, 0x90bed43e40076a82ull,
+	0x873e4f75e2224e68ull, 0x5a7744a6e804a291ull,
+	0xa90de3535aaae202ull, 0x711515d0a205cb36ull,
+	0xd3515c2831559a83ull, 0x0d5a5b44ca873e03ull,
+	0x8412d9991ed58091ull, 0xe858790afe9486c2ull,
+	0xa5178fff668ae0b6ull, 0x626e974dbe39a872ull,
+	0xce5d73ff402d98e3ull, 0xfb0a3d212dc8128full,
+	0x80fa687f881c7f8eull, 0x7ce66634bc9d0b99ull,
+	0xa139029f6a239f72ull, 0x1c1fffc1ebc44e80ull,
+	0xc987434744ac874eull, 0xa327ffb266b56220ull,
+	0xfbe9141915d7a922ull, 0x4bf1ff9f0062baa8ull,
+	0x9d71ac8fada6c9b5ull, 0x6f773fc3603db4a9ull,
+	0xc4ce17b399107c22ull, 0xcb550fb4384d21d3ull,
+	0xf6019da07f549b2bull, 0x7e2a53a146606a48ull,
+	0x99c102844f94e0fbull, 0x2eda7444cbfc426dull,
+	0xc0314325637a1939ull, 0xfa911155fefb5308ull,
+	0xf03d93eebc589f88ull, 0x793555ab7eba27caull,
+	0x96267c7535b763b5ull, 0x4bc1558b2f3458deull,
+	0xbbb01b9283253ca2ull, 0x9eb1aaedfb016f16ull,
+	0xea9c227723ee8bcbull, 0x465e15a979c1cadcull,
+	0x92a1958a7675175full, 0x0bfacd89ec191ec9ull,
+	0xb749faed14125d36ull, 0xcef980ec671f667bull,
+	0xe51c79a85916f484ull, 0x82b7e12780e7401aull,
+	0x8f31cc0937ae58d2ull, 0xd1b2ecb8b0908810ull,
+	0xb2fe3f0b8599ef07ull, 0x861fa7e6dcb4aa15ull,
+	0xdfbdcece67006ac9ull, 0x67a791e093e1d49aull,
+	0x8bd6a141006042bdull, 0xe0c8bb2c5c6d24e0ull,
+	0xaecc49914078536dull, 0x58fae9f773886e18ull,
+	0xda7f5bf590966848ull, 0xaf39a475506a899eull,
+	0x888f99797a5e012dull, 0x6d8406c952429603ull,
+	0xaab37fd7d8f58178ull, 0xc8e5087ba6d33b83ull,
+	0xd5605fcdcf32e1d6ull, 0xfb1e4a9a90880a64ull,
+	0x855c3be0a17fcd26ull, 0x5cf2eea09a55067full,
+	0xa6b34ad8c9dfc06full, 0xf42faa48c0ea481eull,
+	0xd0601d8efc57b08bull, 0xf13b94daf124da26ull,
+	0x823c12795db6ce57ull, 0x76c53d08d6b70858ull,
+	0xa2cb1717b52481edull, 0x54768c4b0c64ca6eull,
+	0xcb7ddcdda26da268ull, 0xa9942f5dcf7dfd09ull,
+	0xfe5d54150b090b02ull, 0xd3f93b35435d7c4cull,
+	0x9efa548d26e5a6e1ull, 0xc47bc5014a1a6dafull,
+	0xc6b8e9b0709f109aull, 0x359ab6419ca1091bull,
+	0xf867241c8cc6d4c0ull, 0xc30163d203c94b62ull,
+	0x9b407691d7fc44f8ull, 0x79e0de63425dcf1dull,
+	0xc21094364dfb5636ull, 0x985915fc12f542e4ull,
+	0xf294b943e17a2bc4ull, 0x3e6f5b7b17b2939dull,
+	0x979cf3ca6cec5b5aull, 0xa705992ceecf9c42ull,
+	0xbd8430bd08277231ull, 0x50c6ff782a838353ull,
+	0xece53cec4a314ebdull, 0xa4f8bf5635246428ull,
+	0x940f4613ae5ed136ull, 0x871b7795e136be99ull,
+	0xb913179899f68584ull, 0x28e2557b59846e3full,
+	0xe757dd7ec07426e5ull, 0x331aeada2fe589cfull,
+	0x9096ea6f3848984full, 0x3ff0d2c85def7621ull,
+	0xb4bca50b065abe63ull, 0x0fed077a756b53a9ull,
+	0xe1ebce4dc7f16dfbull, 0xd3e8495912c62894ull,
+	0x8d3360f09cf6e4bdull, 0x64712dd7abbbd95cull,
+	0xb080392cc4349decull, 0xbd8d794d96aacfb3ull,
+	0xdca04777f541c567ull, 0xecf0d7a0fc5583a0ull,
+	0x89e42caaf9491b60ull, 0xf41686c49db57244ull,
+	0xac5d37d5b79b6239ull, 0x311c2875c522ced5ull,
+	0xd77485cb25823ac7ull, 0x7d633293366b828bull,
+	0x86a8d39ef77164bcull, 0xae5dff9c02033197ull,
+	0xa8530886b54dbdebull, 0xd9f57f830283fdfcull,
+	0xd267caa862a12d66ull, 0xd072df63c324fd7bull,
+	0x8380dea93da4bc60ull, 0x4247cb9e59f71e6dull,
+	0xa46116538d0deb78ull, 0x52d9be85f074e608ull,
+	0xcd795be870516656ull, 0x67902e276c921f8bull,
+	0x806bd9714632dff6ull, 0x00ba1cd8a3db53b6ull,
+	0xa086cfcd97bf97f3ull, 0x80e8a40eccd228a4ull,
+	0xc8a883c0fdaf7df0ull, 0x6122cd128006b2cdull,
+	0xfad2a4b13d1b5d6cull, 0x796b805720085f81ull,
+	0x9cc3a6eec6311a63ull, 0xcbe3303674053bb0ull,
+	0xc3f490aa77bd60fcull, 0xbedbfc4411068a9cull,
+	0xf4f1b4d515acb93bull, 0xee92fb5515482d44ull,
+	0x991711052d8bf3c5ull, 0x751bdd152d4d1c4aull,
+	0xbf5cd54678eef0b6ull, 0xd262d45a78a0635dull,
+	0xef340a98172aace4ull, 0x86fb897116c87c34ull,
+	0x9580869f0e7aac0eull, 0xd45d35e6ae3d4da0ull,
+	0xbae0a846d2195712ull, 0x8974836059cca109ull,
+	0xe998d258869facd7ull, 0x2bd1a438703fc94bull,
+	0x91ff83775423cc06ull, 0x7b6306a34627ddcfull,
+	0xb67f6455292cbf08ull, 0x1a3bc84c17b1d542ull,
+	0xe41f3d6a7377eecaull, 0x20caba5f1d9e4a93ull,
+	0x8e938662882af53eull, 0x547eb47b7282ee9cull,
+	0xb23867fb2a35b28dull, 0xe99e619a4f23aa43ull,
+	0xdec681f9f4c31f31ull, 0x6405fa00e2ec94d4ull,
+	0x8b3c113c38f9f37eull, 0xde83bc408dd3dd04ull,
+	0xae0b158b4738705eull, 0x9624ab50b148d445ull,
+	0xd98ddaee19068c76ull, 0x3badd624dd9b0957ull,
+	0x87f8a8d4cfa417c9ull, 0xe54ca5d70a80e5d6ull,
+	0xa9f6d30a038d1dbcull, 0x5e9fcf4ccd211f4cull,
+	0xd47487cc8470652bull, 0x7647c3200069671full,
+	0x84c8d4dfd2c63f3bull, 0x29ecd9f40041e073ull,
+	0xa5fb0a17c777cf09ull, 0xf468107100525890ull,
+	0xcf79cc9db955c2ccull, 0x7182148d4066eeb4ull,
+	0x81ac1fe293d599bfull, 0xc6f14cd848405530ull,
+	0xa21727db38cb002full, 0xb8ada00e5a506a7cull,
+	0xca9cf1d206fdc03bull, 0xa6d90811f0e4851cull,
+	0xfd442e4688bd304aull, 0x908f4a166d1da663ull,
+	0x9e4a9cec15763e2eull, 0x9a598e4e043287feull,
+	0xc5dd44271ad3cdbaull, 0x40eff1e1853f29fdull,
+	0xf7549530e188c128ull, 0xd12bee59e68ef47cull,
+	0x9a94dd3e8cf578b9ull, 0x82bb74f8301958ceull,
+	0xc13a148e3032d6e7ull, 0xe36a52363c1faf01ull,
+	0xf18899b1bc3f8ca1ull, 0xdc44e6c3cb279ac1ull,
+	0x96f5600f15a7b7e5ull, 0x29ab103a5ef8c0b9ull,
+	0xbcb2b812db11a5deull, 0x7415d448f6b6f0e7ull,
+	0xebdf661791d60f56ull, 0x111b495b3464ad21ull,
+	0x936b9fcebb25c995ull, 0xcab10dd900beec34ull,
+	0xb84687c269ef3bfbull, 0x3d5d514f40eea742ull,
+	0xe65829b3046b0afaull, 0x0cb4a5a3112a5112ull,
+	0x8ff71a0fe2c2e6dcull, 0x47f0e785eaba72abull,
+	0xb3f4e093db73a093ull, 0x59ed216765690f56ull,
+	0xe0f218b8d25088b8ull, 0x306869c13ec3532cull,
+	0x8c974f7383725573ull, 0x1e414218c73a13fbull,
+	0xafbd2350644eeacfull, 0xe5d1929ef90898faull,
+	0xdbac6c247d62a583ull, 0xdf45f746b74abf39ull,
+	0x894bc396ce5da772ull, 0x6b8bba8c328eb783ull,
+	0xab9eb47c81f5114full, 0x066ea92f3f326564ull,
+	0xd686619ba27255a2ull, 0xc80a537b0efefebdull,
+	0x8613fd0145877585ull, 0xbd06742ce95f5f36ull,
+	0xa798fc4196e952e7ull, 0x2c48113823b73704ull,
+	0xd17f3b51fca3a7a0ull, 0xf75a15862ca504c5ull,
+	0x82ef85133de648c4ull, 0x9a984d73dbe722fbull,
+	0xa3ab66580d5fdaf5ull, 0xc13e60d0d2e0ebbaull,
+	0xcc963fee10b7d1b3ull, 0x318df905079926a8ull,
+	0xffbbcfe994e5c61full, 0xfdf17746497f7052ull,
+	0x9fd561f1fd0f9bd3ull, 0xfeb6ea8bedefa633ull,
+	0xc7caba6e7c5382c8ull, 0xfe64a52ee96b8fc0ull,
+	0xf9bd690a1b68637bull, 0x3dfdce7aa3c673b0ull,
+	0x9c1661a651213e2dull, 0x06bea10ca65c084eull,
+	0xc31bfa0fe5698db8ull, 0x486e494fcff30a62ull,
+	0xf3e2f893dec3f126ull, 0x5a89dba3c3efccfaull,
+	0x986ddb5c6b3a76b7ull, 0xf89629465a75e01cull,
+	0xbe89523386091465ull, 0xf6bbb397f1135823ull,
+	0xee2ba6c0678b597full, 0x746aa07ded582e2cull,
+	0x94db483840b717efull, 0xa8c2a44eb4571cdcull,
+	0xba121a4650e4ddebull, 0x92f34d62616ce413ull,
+	0xe896a0d7e51e1566ull, 0x77b020baf9c81d17ull,
+	0x915e2486ef32cd60ull, 0x0ace1474dc1d122eull,
+	0xb5b5ada8aaff80b8ull, 0x0d819992132456baull,
+	0xe3231912d5bf60e6ull, 0x10e1fff697ed6c69ull,
+	0x8df5efabc5979c8full, 0xca8d3ffa1ef463c1ull,
+	0xb1736b96b6fd83b3ull, 0xbd308ff8a6b17cb2ull,
+	0xddd0467c64bce4a0ull, 0xac7cb3f6d05ddbdeull,
+	0x8aa22c0dbef60ee4ull, 0x6bcdf07a423aa96bull,
+	0xad4ab7112eb3929dull, 0x86c16c98d2c953c6ull,
+	0xd89d64d57a607744ull, 0xe871c7bf077ba8b7ull,
+	0x87625f056c7c4a8bull, 0x11471cd764ad4972ull,
+	0xa93af6c6c79b5d2dull, 0xd598e40d3dd89bcfull,
+	0xd389b47879823479ull, 0x4aff1d108d4ec2c3ull,
+	0x843610cb4bf160cbull, 0xcedf722a585139baull,
+	0xa54394fe1eedb8feull, 0xc2974eb4ee658828ull,
+	0xce947a3da6a9273eull, 0x733d226229feea32ull,
+	0x811ccc668829b887ull, 0x0806357d5a3f525full,
+	0xa163ff802a3426a8ull, 0xca07c2dcb0cf26f7ull,
+	0xc9bcff6034c13052ull, 0xfc89b393dd02f0b5ull,
+	0xfc2c3f3841f17c67ull, 0xbbac2078d443ace2ull,
+	0x9d9ba7832936edc0ull, 0xd54b944b84aa4c0dull,
+	0xc5029163f384a931ull, 0x0a9e795e65d4df11ull,
+	0xf64335bcf065d37dull, 0x4d4617b5ff4a16d5ull,
+	0x99ea0196163fa42eull, 0x504bced1bf8e4e45ull,
+	0xc06481fb9bcf8d39ull, 0xe45ec2862f71e1d6ull,
+	0xf07da27a82c37088ull, 0x5d767327bb4e5a4cull,
+	0x964e858c91ba2655ull, 0x3a6a07f8d510f86full,
+	0xbbe226efb628afeaull, 0x890489f70a55368bull,
+	0xeadab0aba3b2dbe5ull, 0x2b45ac74ccea842eull,
+	0x92c8ae6b464fc96full, 0x3b0b8bc90012929dull,
+	0xb77ada0617e3bbcbull, 0x09ce6ebb40173744ull,
+	0xe55990879ddcaabdull, 0xcc420a6a101d0515ull,
+	0x8f57fa54c2a9eab6ull, 0x9fa946824a12232dull,
+	0xb32df8e9f3546564ull, 0x47939822dc96abf9ull,
+	0xdff9772470297ebdull, 0x59787e2b93bc56f7ull,
+	0x8bfbea76c619ef36ull, 0x57eb4edb3c55b65aull,
+	0xaefae51477a06b03ull, 0xede622920b6b23f1ull,
+	0xdab99e59958885c4ull, 0xe95fab368e45ecedull,
+	0x88b402f7fd75539bull, 0x11dbcb0218ebb414ull,
+	0xaae103b5fcd2a881ull, 0xd652bdc29f26a119ull,
+	0xd59944a37c0752a2ull, 0x4be76d3346f0495full,
+	0x857fcae62d8493a5ull, 0x6f70a4400c562ddbull,
+	0xa6dfbd9fb8e5b88eull, 0xcb4ccd500f6bb952ull,
+	0xd097ad07a71f26b2ull, 0x7e2000a41346a7a7ull,
+	0x825ecc24c873782full, 0x8ed400668c0c28c8ull,
+	0xa2f67f2dfa90563bull, 0x728900802f0f32faull,
+	0xcbb41ef979346bcaull, 0x4f2b40a03ad2ffb9ull,
+	0xfea126b7d78186bcull, 0xe2f610c84987bfa8ull,
+	0x9f24b832e6b0f436ull, 0x0dd9ca7d2df4d7c9ull,
+	0xc6ede63fa05d3143ull, 0x91503d1c79720dbbull,
+	0xf8a95fcf88747d94ull, 0x75a44c6397ce912aull,
+	0x9b69dbe1b548ce7cull, 0xc986afbe3ee11abaull,
+	0xc24452da229b021bull, 0xfbe85badce996168ull,
+	0xf2d56790ab41c2a2ull, 0xfae27299423fb9c3ull,
+	0x97c560ba6b0919a5ull, 0xdccd879fc967d41aull,
+	0xbdb6b8e905cb600full, 0x5400e987bbc1c920ull,
+	0xed246723473e3813ull, 0x290123e9aab23b68ull,
+	0x9436c0760c86e30bull, 0xf9a0b6720aaf6521ull,
+	0xb94470938fa89bceull, 0xf808e40e8d5b3e69ull,
+	0xe7958cb87392c2c2ull, 0xb60b1d1230b20e04ull,
+	0x90bd77f3483bb9b9ull, 0xb1c6f22b5e6f48c2ull,
+	0xb4ecd5f01a4aa828ull, 0x1e38aeb6360b1af3ull,
+	0xe2280b6c20dd5232ull, 0x25c6da63c38de1b0ull,
+	0x8d590723948a535full, 0x579c487e5a38ad0eull,
+	0xb0af48ec79ace837ull, 0x2d835a9df0c6d851ull,
+	0xdcdb1b2798182244ull, 0xf8e431456cf88e65ull,
+	0x8a08f0f8bf0f156bull, 0x1b8e9ecb641b58ffull,
+	0xac8b2d36eed2dac5ull, 0xe272467e3d222f3full,
+	0xd7adf884aa879177ull, 0x5b0ed81dcc6abb0full,
+	0x86ccbb52ea94baeaull, 0x98e947129fc2b4e9ull,
+	0xa87fea27a539e9a5ull, 0x3f2398d747b36224ull,
+	0xd29fe4b18e88640eull, 0x8eec7f0d19a03aadull,
+	0x83a3eeeef9153e89ull, 0x1953cf68300424acull,
+	0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd7ull,
+	0xcdb02555653131b6ull, 0x3792f412cb06794dull,
+	0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd0ull,
+	0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec4ull,
+	0xc8de047564d20a8bull, 0xf245825a5a445275ull,
+	0xfb158592be068d2eull, 0xeed6e2f0f0d56712ull,
+	0x9ced737bb6c4183dull, 0x55464dd69685606bull,
+	0xc428d05aa4751e4cull, 0xaa97e14c3c26b886ull,
+	0xf53304714d9265dfull, 0xd53dd99f4b3066a8ull,
+	0x993fe2c6d07b7fabull, 0xe546a8038efe4029ull,
+	0xbf8fdb78849a5f96ull, 0xde98520472bdd033ull,
+	0xef73d256a5c0f77cull, 0x963e66858f6d4440ull,
+	0x95a8637627989aadull, 0xdde7001379a44aa8ull,
+	0xbb127c53b17ec159ull, 0x5560c018580d5d52ull,
+	0xe9d71b689dde71afull, 0xaab8f01e6e10b4a6ull,
+	0x9226712162ab070dull, 0xcab3961304ca70e8ull,
+	0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d22ull,
+	0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506aull,
+	0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb242ull,
+	0xb267ed1940f1c61cull, 0x55f038b237591ed3ull,
+	0xdf01e85f912e37a3ull, 0x6b6c46dec52f6688ull,
+	0x8b61313bbabce2c6ull, 0x2323ac4b3b3da015ull,
+	0xae397d8aa96c1b77ull, 0xabec975e0a0d081aull,
+	0xd9c7dced53c72255ull, 0x96e7bd358c904a21ull,
+	0x881cea14545c7575ull, 0x7e50d64177da2e54ull,
+	0xaa242499697392d2ull, 0xdde50bd1d5d0b9e9ull,
+	0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e864ull,
+	0x84ec3c97da624ab4ull, 0xbd5af13bef0b113eull,
+	0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58eull,
+	0xcfb11ead453994baull, 0x67de18eda5814af2ull,
+	0x81ceb32c4b43fcf4ull, 0x80eacf948770ced7ull,
+	0xa2425ff75e14fc31ull, 0xa1258379a94d028dull,
+	0xcad2f7f5359a3b3eull, 0x096ee45813a04330ull,
+	0xfd87b5f28300ca0dull, 0x8bca9d6e188853fcull,
+	0x9e74d1b791e07e48ull, 0x775ea264cf55347eull,
+	0xc612062576589ddaull, 0x95364afe032a819eull,
+	0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull,
+	0x9abe14cd44753b52ull, 0xc4926a9672793543ull,
+	0xc16d9a0095928a27ull, 0x75b7053c0f178294ull,
+	0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull,
+	0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull,
+	0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull,
+	0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull,
+	0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull,
+	0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull,
+	0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull,
+	0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull,
+	0xb424dc35095cd80full, 0x538484c19ef38c95ull,
+	0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull,
+	0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull,
+	0xafebff0bcb24aafeull, 0xf78f69a51539d749ull,
+	0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull,
+	0x89705f4136b4a597ull, 0x31680a88f8953031ull,
+	0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull,
+	0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull,
+	0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull,
+	0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull,
+	0xd1b71758e219652bull, 0xd3c36113404ea4a9ull,
+	0x83126e978d4fdf3bull, 0x645a1cac083126eaull,
+	0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull,
+	0xccccccccccccccccull, 0xcccccccccccccccdull,
+	0x8000000000000000ull, 0x0000000000000000ull,
+	0xa000000000000000ull, 0x0000000000000000ull,
+	0xc800000000000000ull, 0x0000000000000000ull,
+	0xfa00000000000000ull, 0x0000000000000000ull,
+	0x9c40000000000000ull, 0x0000000000000000ull,
+	0xc350000000000000ull, 0x0000000000000000ull,
+	0xf424000000000000ull, 0x0000000000000000ull,
+	0x9896800000000000ull, 0x0000000000000000ull,
+	0xbebc200000000000ull, 0x0000000000000000ull,
+	0xee6b280000000000ull, 0x0000000000000000ull,
+	0x9502f90000000000ull, 0x0000000000000000ull,
+	0xba43b74000000000ull, 0x0000000000000000ull,
+	0xe8d4a51000000000ull, 0x0000000000000000ull,
+	0x9184e72a00000000ull, 0x0000000000000000ull,
+	0xb5e620f480000000ull, 0x0000000000000000ull,
+	0xe35fa931a0000000ull, 0x0000000000000000ull,
+	0x8e1bc9bf04000000ull, 0x0000000000000000ull,
+	0xb1a2bc2ec5000000ull, 0x0000000000000000ull,
+	0xde0b6b3a76400000ull, 0x0000000000000000ull,
+	0x8ac7230489e80000ull, 0x0000000000000000ull,
+	0xad78ebc5ac620000ull, 0x0000000000000000ull,
+	0xd8d726b7177a8000ull, 0x0000000000000000ull,
+	0x878678326eac9000ull, 0x0000000000000000ull,
+	0xa968163f0a57b400ull, 0x0000000000000000ull,
+	0xd3c21bcecceda100ull, 0x0000000000000000ull,
+	0x84595161401484a0ull, 0x0000000000000000ull,
+	0xa56fa5b99019a5c8ull, 0x0000000000000000ull,
+	0xcecb8f27f4200f3aull, 0x0000000000000000ull,
+	0x813f3978f8940984ull, 0x4000000000000000ull,
+	0xa18f07d736b90be5ull, 0x5000000000000000ull,
+	0xc9f2c9cd04674edeull, 0xa400000000000000ull,
+	0xfc6f7c4045812296ull, 0x4d00000000000000ull,
+	0x9dc5ada82b70b59dull, 0xf020000000000000ull,
+	0xc5371912364ce305ull, 0x6c28000000000000ull,
+	0xf684df56c3e01bc6ull, 0xc732000000000000ull,
+	0x9a130b963a6c115cull, 0x3c7f400000000000ull,
+	0xc097ce7bc90715b3ull, 0x4b9f100000000000ull,
+	0xf0bdc21abb48db20ull, 0x1e86d40000000000ull,
+	0x96769950b50d88f4ull, 0x1314448000000000ull,
+	0xbc143fa4e250eb31ull, 0x17d955a000000000ull,
+	0xeb194f8e1ae525fdull, 0x5dcfab0800000000ull,
+	0x92efd1b8d0cf37beull, 0x5aa1cae500000000ull,
+	0xb7abc627050305adull, 0xf14a3d9e40000000ull,
+	0xe596b7b0c643c719ull, 0x6d9ccd05d0000000ull,
+	0x8f7e32ce7bea5c6full, 0xe4820023a2000000ull,
+	0xb35dbf821ae4f38bull, 0xdda2802c8a800000ull,
+	0xe0352f62a19e306eull, 0xd50b2037ad200000ull,
+	0x8c213d9da502de45ull, 0x4526f422cc340000ull,
+	0xaf298d050e4395d6ull, 0x9670b12b7f410000ull,
+	0xdaf3f04651d47b4cull, 0x3c0cdd765f114000ull,
+	0x88d8762bf324cd0full, 0xa5880a69fb6ac800ull,
+	0xab0e93b6efee0053ull, 0x8eea0d047a457a00ull,
+	0xd5d238a4abe98068ull, 0x72a4904598d6d880ull,
+	0x85a36366eb71f041ull, 0x47a6da2b7f864750ull,
+	0xa70c3c40a64e6c51ull, 0x999090b65f67d924ull,
+	0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6dull,
+	0x82818f1281ed449full, 0xbff8f10e7a8921a4ull,
+	0xa321f2d7226895c7ull, 0xaff72d52192b6a0dull,
+	0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764490ull,
+	0xfee50b7025c36a08ull, 0x02f236d04753d5b4ull,
+	0x9f4f2726179a2245ull, 0x01d762422c946590ull,
+	0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef5ull,
+	0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb2ull,
+	0x9b934c3b330c8577ull, 0x63cc55f49f88eb2full,
+	0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fbull,
+	0xf316271c7fc3908aull, 0x8bef464e3945ef7aull,
+	0x97edd871cfda3a56ull, 0x97758bf0e3cbb5acull,
+	0xbde94e8e43d0c8ecull, 0x3d52eeed1cbea317ull,
+	0xed63a231d4c4fb27ull, 0x4ca7aaa863ee4bddull,
+	0x945e455f24fb1cf8ull, 0x8fe8caa93e74ef6aull,
+	0xb975d6b6ee39e436ull, 0xb3e2fd538e122b44ull,
+	0xe7d34c64a9c85d44ull, 0x60dbbca87196b616ull,
+	0x90e40fbeea1d3a4aull, 0xbc8955e946fe31cdull,
+	0xb51d13aea4a488ddull, 0x6babab6398bdbe41ull,
+	0xe264589a4dcdab14ull, 0xc696963c7eed2dd1ull,
+	0x8d7eb76070a08aecull, 0xfc1e1de5cf543ca2ull,
+	0xb0de65388cc8ada8ull, 0x3b25a55f43294bcbull,
+	0xdd15fe86affad912ull, 0x49ef0eb713f39ebeull,
+	0x8a2dbf142dfcc7abull, 0x6e3569326c784337ull,
+	0xacb92ed9397bf996ull, 0x49c2c37f07965404ull,
+	0xd7e77a8f87daf7fbull, 0xdc33745ec97be906ull,
+	0x86f0ac99b4e8dafdull, 0x69a028bb3ded71a3ull,
+	0xa8acd7c0222311bcull, 0xc40832ea0d68ce0cull,
+	0xd2d80db02aabd62bull, 0xf50a3fa490c30190ull,
+	0x83c7088e1aab65dbull, 0x792667c6da79e0faull,
+	0xa4b8cab1a1563f52ull, 0x577001b891185938ull,
+	0xcde6fd5e09abcf26ull, 0xed4c0226b55e6f86ull,
+	0x80b05e5ac60b6178ull, 0x544f8158315b05b4ull,
+	0xa0dc75f1778e39d6ull, 0x696361ae3db1c721ull,
+	0xc913936dd571c84cull, 0x03bc3a19cd1e38e9ull,
+	0xfb5878494ace3a5full, 0x04ab48a04065c723ull,
+	0x9d174b2dcec0e47bull, 0x62eb0d64283f9c76ull,
+	0xc45d1df942711d9aull, 0x3ba5d0bd324f8394ull,
+	0xf5746577930d6500ull, 0xca8f44ec7ee36479ull,
+	0x9968bf6abbe85f20ull, 0x7e998b13cf4e1ecbull,
+	0xbfc2ef456ae276e8ull, 0x9e3fedd8c321a67eull,
+	0xefb3ab16c59b14a2ull, 0xc5cfe94ef3ea101eull,
+	0x95d04aee3b80ece5ull, 0xbba1f1d158724a12ull,
+	0xbb445da9ca61281full, 0x2a8a6e45ae8edc97ull,
+	0xea1575143cf97226ull, 0xf52d09d71a3293bdull,
+	0x924d692ca61be758ull, 0x593c2626705f9c56ull,
+	0xb6e0c377cfa2e12eull, 0x6f8b2fb00c77836cull,
+	0xe498f455c38b997aull, 0x0b6dfb9c0f956447ull,
+	0x8edf98b59a373fecull, 0x4724bd4189bd5eacull,
+	0xb2977ee300c50fe7ull, 0x58edec91ec2cb657ull,
+	0xdf3d5e9bc0f653e1ull, 0x2f2967b66737e3edull,
+	0x8b865b215899f46cull, 0xbd79e0d20082ee74ull,
+	0xae67f1e9aec07187ull, 0xecd8590680a3aa11ull,
+	0xda01ee641a708de9ull, 0xe80e6f4820cc9495ull,
+	0x884134fe908658b2ull, 0x3109058d147fdcddull,
+	0xaa51823e34a7eedeull, 0xbd4b46f0599fd415ull,
+	0xd4e5e2cdc1d1ea96ull, 0x6c9e18ac7007c91aull,
+	0x850fadc09923329eull, 0x03e2cf6bc604ddb0ull,
+	0xa6539930bf6bff45ull, 0x84db8346b786151cull,
+	0xcfe87f7cef46ff16ull, 0xe612641865679a63ull,
+	0x81f14fae158c5f6eull, 0x4fcb7e8f3f60c07eull,
+	0xa26da3999aef7749ull, 0xe3be5e330f38f09dull,
+	0xcb090c8001ab551cull, 0x5cadf5bfd3072cc5ull,
+	0xfdcb4fa002162a63ull, 0x73d9732fc7c8f7f6ull,
+	0x9e9f11c4014dda7eull, 0x2867e7fddcdd9afaull,
+	0xc646d63501a1511dull, 0xb281e1fd541501b8ull,
+	0xf7d88bc24209a565ull, 0x1f225a7ca91a4226ull,
+	0x9ae757596946075full, 0x3375788de9b06958ull,
+	0xc1a12d2fc3978937ull, 0x0052d6b1641c83aeull,
+	0xf209787bb47d6b84ull, 0xc0678c5dbd23a49aull,
+	0x9745eb4d50ce6332ull, 0xf840b7ba963646e0ull,
+	0xbd176620a501fbffull, 0xb650e5a93bc3d898ull,
+	0xec5d3fa8ce427affull, 0xa3e51f138ab4cebeull,
+	0x93ba47c980e98cdfull, 0xc66f336c36b10137ull,
+	0xb8a8d9bbe123f017ull, 0xb80b0047445d4184ull,
+	0xe6d3102ad96cec1dull, 0xa60dc059157491e5ull,
+	0x9043ea1ac7e41392ull, 0x87c89837ad68db2full,
+	0xb454e4a179dd1877ull, 0x29babe4598c311fbull,
+	0xe16a1dc9d8545e94ull, 0xf4296dd6fef3d67aull,
+	0x8ce2529e2734bb1dull, 0x1899e4a65f58660cull,
+	0xb01ae745b101e9e4ull, 0x5ec05dcff72e7f8full,
+	0xdc21a1171d42645dull, 0x76707543f4fa1f73ull,
+	0x899504ae72497ebaull, 0x6a06494a791c53a8ull,
+	0xabfa45da0edbde69ull, 0x0487db9d17636892ull,
+	0xd6f8d7509292d603ull, 0x45a9d2845d3c42b6ull,
+	0x865b86925b9bc5c2ull, 0x0b8a2392ba45a9b2ull,
+	0xa7f26836f282b732ull, 0x8e6cac7768d7141eull,
+	0xd1ef0244af2364ffull, 0x3207d795430cd926ull,
+	0x8335616aed761f1full, 0x7f44e6bd49e807b8ull,
+	0xa402b9c5a8d3a6e7ull, 0x5f16206c9c6209a6ull,
+	0xcd036837130890a1ull, 0x36dba887c37a8c0full,
+	0x802221226be55a64ull, 0xc2494954da2c9789ull,
+	0xa02aa96b06deb0fdull, 0xf2db9baa10b7bd6cull,
+	0xc83553c5c8965d3dull, 0x6f92829494e5acc7ull,
+	0xfa42a8b73abbf48cull, 0xcb772339ba1f17f9ull,
+	0x9c69a97284b578d7ull, 0xff2a760414536efbull,
+	0xc38413cf25e2d70dull, 0xfef5138519684abaull,
+	0xf46518c2ef5b8cd1ull, 0x7eb258665fc25d69ull,
+	0x98bf2f79d5993802ull, 0xef2f773ffbd97a61ull,
+	0xbeeefb584aff8603ull, 0xaafb550ffacfd8faull,
+	0xeeaaba2e5dbf6784ull, 0x95ba2a53f983cf38ull,
+	0x952ab45cfa97a0b2ull, 0xdd945a747bf26183ull,
+	0xba756174393d88dfull, 0x94f971119aeef9e4ull,
+	0xe912b9d1478ceb17ull, 0x7a37cd5601aab85dull,
+	0x91abb422ccb812eeull, 0xac62e055c10ab33aull,
+	0xb616a12b7fe617aaull, 0x577b986b314d6009ull,
+	0xe39c49765fdf9d94ull, 0xed5a7e85fda0b80bull,
+	0x8e41ade9fbebc27dull, 0x14588f13be847307ull,
+	0xb1d219647ae6b31cull, 0x596eb2d8ae258fc8ull,
+	0xde469fbd99a05fe3ull, 0x6fca5f8ed9aef3bbull,
+	0x8aec23d680043beeull, 0x25de7bb9480d5854ull,
+	0xada72ccc20054ae9ull, 0xaf561aa79a10ae6aull,
+	0xd910f7ff28069da4ull, 0x1b2ba1518094da04ull,
+	0x87aa9aff79042286ull, 0x90fb44d2f05d0842ull,
+	0xa99541bf57452b28ull, 0x353a1607ac744a53ull,
+	0xd3fa922f2d1675f2ull, 0x42889b8997915ce8ull,
+	0x847c9b5d7c2e09b7ull, 0x69956135febada11ull,
+	0xa59bc234db398c25ull, 0x43fab9837e699095ull,
+	0xcf02b2c21207ef2eull, 0x94f967e45e03f4bbull,
+	0x8161afb94b44f57dull, 0x1d1be0eebac278f5ull,
+	0xa1ba1ba79e1632dcull, 0x6462d92a69731732ull,
+	0xca28a291859bbf93ull, 0x7d7b8f7503cfdcfeull,
+	0xfcb2cb35e702af78ull, 0x5cda735244c3d43eull,
+	0x9defbf01b061adabull, 0x3a0888136afa64a7ull,
+	0xc56baec21c7a1916ull, 0x088aaa1845b8fdd0ull,
+	0xf6c69a72a3989f5bull, 0x8aad549e57273d45ull,
+	0x9a3c2087a63f6399ull, 0x36ac54e2f678864bull,
+	0xc0cb28a98fcf3c7full, 0x84576a1bb416a7ddull,
+	0xf0fdf2d3f3c30b9full, 0x656d44a2a11c51d5ull,
+	0x969eb7c47859e743ull, 0x9f644ae5a4b1b325ull,
+	0xbc4665b596706114ull, 0x873d5d9f0dde1feeull,
+	0xeb57ff22fc0c7959ull, 0xa90cb506d155a7eaull,
+	0x9316ff75dd87cbd8ull, 0x09a7f12442d588f2ull,
+	0xb7dcbf5354e9beceull, 0x0c11ed6d538aeb2full,
+	0xe5d3ef282a242e81ull, 0x8f1668c8a86da5faull,
+	0x8fa475791a569d10ull, 0xf96e017d694487bcull,
+	0xb38d92d760ec4455ull, 0x37c981dcc395a9acull,
+	0xe070f78d3927556aull, 0x85bbe253f47b1417ull,
+	0x8c469ab843b89562ull, 0x93956d7478ccec8eull,
+	0xaf58416654a6babbull, 0x387ac8d1970027b2ull,
+	0xdb2e51bfe9d0696aull, 0x06997b05fcc0319eull,
+	0x88fcf317f22241e2ull, 0x441fece3bdf81f03ull,
+	0xab3c2fddeeaad25aull, 0xd527e81cad7626c3ull,
+	0xd60b3bd56a5586f1ull, 0x8a71e223d8d3b074ull,
+	0x85c7056562757456ull, 0xf6872d5667844e49ull,
+	0xa738c6bebb12d16cull, 0xb428f8ac016561dbull,
+	0xd106f86e69d785c7ull, 0xe13336d701beba52ull,
+	0x82a45b450226b39cull, 0xecc0024661173473ull,
+	0xa34d721642b06084ull, 0x27f002d7f95d0190ull,
+	0xcc20ce9bd35c78a5ull, 0x31ec038df7b441f4ull,
+	0xff290242c83396ceull, 0x7e67047175a15271ull,
+	0x9f79a169bd203e41ull, 0x0f0062c6e984d386ull,
+	0xc75809c42c684dd1ull, 0x52c07b78a3e60868ull,
+	0xf92e0c3537826145ull, 0xa7709a56ccdf8a82ull,
+	0x9bbcc7a142b17ccbull, 0x88a66076400bb691ull,
+	0xc2abf989935ddbfeull, 0x6acff893d00ea435ull,
+	0xf356f7ebf83552feull, 0x0583f6b8c4124d43ull,
+	0x98165af37b2153deull, 0xc3727a337a8b704aull,
+	0xbe1bf1b059e9a8d6ull, 0x744f18c0592e4c5cull,
+	0xeda2ee1c7064130cull, 0x1162def06f79df73ull,
+	0x9485d4d1c63e8be7ull, 0x8addcb5645ac2ba8ull,
+	0xb9a74a0637ce2ee1ull, 0x6d953e2bd7173692ull,
+	0xe8111c87c5c1ba99ull, 0xc8fa8db6ccdd0437ull,
+	0x910ab1d4db9914a0ull, 0x1d9c9892400a22a2ull,
+	0xb54d5e4a127f59c8ull, 0x2503beb6d00cab4bull,
+	0xe2a0b5dc971f303aull, 0x2e44ae64840fd61dull,
+	0x8da471a9de737e24ull, 0x5ceaecfed289e5d2ull,
+	0xb10d8e1456105dadull, 0x7425a83e872c5f47ull,
+	0xdd50f1996b947518ull, 0xd12f124e28f77719ull,
+	0x8a5296ffe33cc92full, 0x82bd6b70d99aaa6full,
+	0xace73cbfdc0bfb7bull, 0x636cc64d1001550bull,
+	0xd8210befd30efa5aull, 0x3c47f7e05401aa4eull,
+	0x8714a775e3e95c78ull, 0x65acfaec34810a71ull,
+	0xa8d9d1535ce3b396ull, 0x7f1839a741a14d0dull,
+	0xd31045a8341ca07cull, 0x1ede48111209a050ull,
+	0x83ea2b892091e44dull, 0x934aed0aab460432ull,
+	0xa4e4b66b68b65d60ull, 0xf81da84d5617853full,
+	0xce1de40642e3f4b9ull, 0x36251260ab9d668eull,
+	0x80d2ae83e9ce78f3ull, 0xc1d72b7c6b426019ull,
+	0xa1075a24e4421730ull, 0xb24cf65b8612f81full,
+	0xc94930ae1d529cfcull, 0xdee033f26797b627ull,
+	0xfb9b7cd9a4a7443cull, 0x169840ef017da3b1ull,
+	0x9d412e0806e88aa5ull, 0x8e1f289560ee864eull,
+	0xc491798a08a2ad4eull, 0xf1a6f2bab92a27e2ull,
+	0xf5b5d7ec8acb58a2ull, 0xae10af696774b1dbull,
+	0x9991a6f3d6bf1765ull, 0xacca6da1e0a8ef29ull,
+	0xbff610b0cc6edd3full, 0x17fd090a58d32af3ull,
+	0xeff394dcff8a948eull, 0xddfc4b4cef07f5b0ull,
+	0x95f83d0a1fb69cd9ull, 0x4abdaf101564f98eull,
+	0xbb764c4ca7a4440full, 0x9d6d1ad41abe37f1ull,
+	0xea53df5fd18d5513ull, 0x84c86189216dc5edull,
+	0x92746b9be2f8552cull, 0x32fd3cf5b4e49bb4ull,
+	0xb7118682dbb66a77ull, 0x3fbc8c33221dc2a1ull,
+	0xe4d5e82392a40515ull, 0x0fabaf3feaa5334aull,
+	0x8f05b1163ba6832dull, 0x29cb4d87f2a7400eull,
+	0xb2c71d5bca9023f8ull, 0x743e20e9ef511012ull,
+	0xdf78e4b2bd342cf6ull, 0x914da9246b255416ull,
+	0x8bab8eefb6409c1aull, 0x1ad089b6c2f7548eull,
+	0xae9672aba3d0c320ull, 0xa184ac2473b529b1ull,
+	0xda3c0f568cc4f3e8ull, 0xc9e5d72d90a2741eull,
+	0x8865899617fb1871ull, 0x7e2fa67c7a658892ull,
+	0xaa7eebfb9df9de8dull, 0xddbb901b98feeab7ull,
+	0xd51ea6fa85785631ull, 0x552a74227f3ea565ull,
+	0x8533285c936b35deull, 0xd53a88958f87275full,
+	0xa67ff273b8460356ull, 0x8a892abaf368f137ull,
+	0xd01fef10a657842cull, 0x2d2b7569b0432d85ull,
+	0x8213f56a67f6b29bull, 0x9c3b29620e29fc73ull,
+	0xa298f2c501f45f42ull, 0x8349f3ba91b47b8full,
+	0xcb3f2f7642717713ull, 0x241c70a936219a73ull,
+	0xfe0efb53d30dd4d7ull, 0xed238cd383aa0110ull,
+	0x9ec95d1463e8a506ull, 0xf4363804324a40aaull,
+	0xc67bb4597ce2ce48ull, 0xb143c6053edcd0d5ull,
+	0xf81aa16fdc1b81daull, 0xdd94b7868e94050aull,
+	0x9b10a4e5e9913128ull, 0xca7cf2b4191c8326ull,
+	0xc1d4ce1f63f57d72ull, 0xfd1c2f611f63a3f0ull,
+	0xf24a01a73cf2dccfull, 0xbc633b39673c8cecull,
+	0x976e41088617ca01ull, 0xd5be0503e085d813ull,
+	0xbd49d14aa79dbc82ull, 0x4b2d8644d8a74e18ull,
+	0xec9c459d51852ba2ull, 0xddf8e7d60ed1219eull,
+	0x93e1ab8252f33b45ull, 0xcabb90e5c942b503ull,
+	0xb8da1662e7b00a17ull, 0x3d6a751f3b936243ull,
+	0xe7109bfba19c0c9dull, 0x0cc512670a783ad4ull,
+	0x906a617d450187e2ull, 0x27fb2b80668b24c5ull,
+	0xb484f9dc9641e9daull, 0xb1f9f660802dedf6ull,
+	0xe1a63853bbd26451ull, 0x5e7873f8a0396973ull,
+	0x8d07e33455637eb2ull, 0xdb0b487b6423e1e8ull,
+	0xb049dc016abc5e5full, 0x91ce1a9a3d2cda62ull,
+	0xdc5c5301c56b75f7ull, 0x7641a140cc7810fbull,
+	0x89b9b3e11b6329baull, 0xa9e904c87fcb0a9dull,
+	0xac2820d9623bf429ull, 0x546345fa9fbdcd44ull,
+	0xd732290fbacaf133ull, 0xa97c177947ad4095ull,
+	0x867f59a9d4bed6c0ull, 0x49ed8eabcccc485dull,
+	0xa81f301449ee8c70ull, 0x5c68f256bfff5a74ull,
+	0xd226fc195c6a2f8cull, 0x73832eec6fff3111ull,
+	0x83585d8fd9c25db7ull, 0xc831fd53c5ff7eabull,
+	0xa42e74f3d032f525ull, 0xba3e7ca8b77f5e55ull,
+	0xcd3a1230c43fb26full, 0x28ce1bd2e55f35ebull,
+	0x80444b5e7aa7cf85ull, 0x7980d163cf5b81b3ull,
+	0xa0555e361951c366ull, 0xd7e105bcc332621full,
+	0xc86ab5c39fa63440ull, 0x8dd9472bf3fefaa7ull,
+	0xfa856334878fc150ull, 0xb14f98f6f0feb951ull,
+	0x9c935e00d4b9d8d2ull, 0x6ed1bf9a569f33d3ull,
+	0xc3b8358109e84f07ull, 0x0a862f80ec4700c8ull,
+	0xf4a642e14c6262c8ull, 0xcd27bb612758c0faull,
+	0x98e7e9cccfbd7dbdull, 0x8038d51cb897789cull,
+	0xbf21e44003acdd2cull, 0xe0470a63e6bd56c3ull,
+	0xeeea5d5004981478ull, 0x1858ccfce06cac74ull,
+	0x95527a5202df0ccbull, 0x0f37801e0c43ebc8ull,
+	0xbaa718e68396cffdull, 0xd30560258f54e6baull,
+	0xe950df20247c83fdull, 0x47c6b82ef32a2069ull,
+	0x91d28b7416cdd27eull, 0x4cdc331d57fa5441ull,
+	0xb6472e511c81471dull, 0xe0133fe4adf8e952ull,
+	0xe3d8f9e563a198e5ull, 0x58180fddd97723a6ull,
+	0x8e679c2f5e44ff8full, 0x570f09eaa7ea7648ull,
+	0xb201833b35d63f73ull, 0x2cd2cc6551e513daull,
+	0xde81e40a034bcf4full, 0xf8077f7ea65e58d1ull,
+	0x8b112e86420f6191ull, 0xfb04afaf27faf782ull,
+	0xadd57a27d29339f6ull, 0x79c5db9af1f9b563ull,
+	0xd94ad8b1c7380874ull, 0x18375281ae7822bcull,
+	0x87cec76f1c830548ull, 0x8f2293910d0b15b5ull,
+	0xa9c2794ae3a3c69aull, 0xb2eb3875504ddb22ull,
+	0xd433179d9c8cb841ull, 0x5fa60692a46151ebull,
+	0x849feec281d7f328ull, 0xdbc7c41ba6bcd333ull,
+	0xa5c7ea73224deff3ull, 0x12b9b522906c0800ull,
+	0xcf39e50feae16befull, 0xd768226b34870a00ull,
+	0x81842f29f2cce375ull, 0xe6a1158300d46640ull,
+	0xa1e53af46f801c53ull, 0x60495ae3c1097fd0ull,
+	0xca5e89b18b602368ull, 0x385bb19cb14bdfc4ull,
+	0xfcf62c1dee382c42ull, 0x46729e03dd9ed7b5ull,
+	0x9e19db92b4e31ba9ull, 0x6c07a2c26a8346d1ull
+};
+
+// Powers of 10 that can be stored in a double exactly
+static const double exactPowersOfTen[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static int countLeadingZeros64(uint64_t x)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	if (_BitScanReverse(&index, (unsigned long)(x >> 32))) { return 31 - (int)index; }
+	_BitScanReverse(&index, (unsigned long)x);
+	return 63 - (int)index;
+#else
+	return __builtin_clzll(x);
+#endif
+}
+
+// Returns the bits of the double closest to w * 10^q, using the algorithm
+// from Daniel Lemire's "Number Parsing at a Gigabyte per Second" (with the
+// proof from Mushtak and Lemire that no fallback is needed when w is exact).
+// w must be non-zero.
+static uint64_t eiselLemire(uint64_t w, int64_t q)
+{
+	if (q < SMALLEST_POWER_OF_TEN) { return 0; }
+	if (q > LARGEST_POWER_OF_TEN) { return 0x7FFull << 52; }
+
+	int leadingZeros = countLeadingZeros64(w);
+	w <<= leadingZeros;
+
+	// Only the high 64 bits of the product matter, unless the bits below the
+	// 55 that are kept are all ones, where the rest of 5^q could carry into them.
+	const uint64_t* power = &powersOfFive[2 * (q - SMALLEST_POWER_OF_TEN)];
+	uint64_t low, high;
+	multiply128(w, power[0], &low, &high);
+	if ((high & 0x1FF) == 0x1FF) {
+		uint64_t secondLow, secondHigh;
+		multiply128(w, power[1], &secondLow, &secondHigh);
+		low += secondHigh;
+		if (secondHigh > low) { high++; }
+	}
+
+	int upperBit = (int)(high >> 63);
+	uint64_t mantissa = high >> (upperBit + 9);
+	// floor(log2(10^q)) + 63, then moved into the double's exponent range
+	int64_t exponent = (((152170 + 65536) * q) >> 16) + 63 + upperBit - leadingZeros + 1023;
+
+	if (exponent <= 0) {
+		// Subnormal, so the mantissa loses bits to the fixed minimum exponent
+		if (-exponent + 1 >= 64) { return 0; }
+		mantissa >>= -exponent + 1;
+		mantissa += mantissa & 1;
+		mantissa >>= 1;
+		// Rounding can carry the mantissa back up into a normal number
+		exponent = mantissa < (1ull << 52) ? 0 : 1;
+		return (mantissa & ((1ull << 52) - 1)) | ((uint64_t)exponent << 52);
+	}
+
+	// Exactly halfway between two doubles rounds to the even one, which can
+	// only happen for a small range of powers where the product is exact.
+	if (low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1
+		&& (mantissa << (upperBit + 9)) == high) {
+		mantissa &= ~1ull;
+	}
+	mantissa += mantissa & 1;
+	mantissa >>= 1;
+	if (mantissa >= (2ull << 52)) {
+		mantissa = 1ull << 52;
+		exponent++;
+	}
+	if (exponent >= 0x7FF) { return 0x7FFull << 52; }
+	return (mantissa & ((1ull << 52) - 1)) | ((uint64_t)exponent << 52);
+}
+
+static double doubleFromBits(uint64_t bits)
+{
+	double value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+// Returns true if the buffer starts with word, ignoring case. word has to
+// be lowercase.
+static bool startsWithWord(const char* p, const char* end, const char* word)
+{
+	for (; *word != '\0'; p++, word++) {
+		if (p == end || (*p | 0x20) != *word) { return false; }
+	}
+	return true;
+}
+
+// Parses a double from the start of the buffer, and stores where the double
+// ended in stop (or the start of the buffer if there wasn't one).
+static ewelborn_parseResult parseDoublePrefix(const char* p, const char* end, double* value, const char** stop)
+{
+	const char* start = p;
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+')) {
+		negative = *p == '-';
+		p++;
+	}
+
+	if (p < end && ((*p | 0x20) == 'i' || (*p | 0x20) == 'n')) {
+		if (startsWithWord(p, end, "nan")) {
+			*value = negative ? -NAN : NAN;
+			*stop = p + 3;
+			return EWELBORN_PARSE_SUCCESS;
+		}
+		if (startsWithWord(p, end, "inf")) {
+			*value = negative ? -HUGE_VAL : HUGE_VAL;
+			*stop = startsWithWord(p, end, "infinity") ? p + 8 : p + 3;
+			return EWELBORN_PARSE_SUCCESS;
+		}
+		*stop = start;
+		return EWELBORN_PARSE_INVALID;
+	}
+
+	// The first 19 significant digits go into w, and any more than that are
+	// only kept track of in the exponent, and whether any of them weren't 0.
+	uint64_t w = 0;
+	int significantDigits = 0;
+	int64_t exponent = 0;
+	bool truncated = false;
+
+	const char* integerStart = p;
+	while (p < end && *p == '0') { p++; }
+	while (end - p >= 8 && significantDigits + 8 <= 19) {
+		uint64_t chunk = readDigits8(p);
+		if (isEightDigits(chunk) == false) { break; }
+		w = w * 100000000 + parseEightDigits(chunk);
+		significantDigits += 8;
+		p += 8;
+	}
+	for (; p < end && isDigit(*p); p++) {
+		if (significantDigits < 19) {
+			w = w * 10 + (uint64_t)(*p - '0');
+			significantDigits++;
+		}
+		else {
+			exponent++;
+			truncated |= *p != '0';
+		}
+	}
+	int digits = (int)(p - integerStart);
+
+	if (p < end && *p == '.') {
+		p++;
+		const char* fractionStart = p;
+		if (w == 0) {
+			// Zeros right after the point only move the exponent
+			for (; p < end && *p == '0'; p++) { exponent--; }
+		}
+		while (end - p >= 8 && significantDigits + 8 <= 19) {
+			uint64_t chunk = readDigits8(p);
+			if (isEightDigits(chunk) == false) { break; }
+			w = w * 100000000 + parseEightDigits(chunk);
+			significantDigits += 8;
+			exponent -= 8;
+			p += 8;
+		}
+		for (; p < end && isDigit(*p); p++) {
+			if (significantDigits < 19) {
+				w = w * 10 + (uint64_t)(*p - '0');
+				significantDigits++;
+				exponent--;
+			}
+			else {
+				truncated |= *p != '0';
+			}
+		}
+		digits += (int)(p - fractionStart);
+	}
+
+	if (digits == 0) {
+		*stop = start;
+		return EWELBORN_PARSE_INVALID;
+	}
+
+	// The exponent is only used if it has digits, like strtod
+	if (p < end && (*p | 0x20) == 'e') {
+		const char* e = p + 1;
+		bool negativeExponent = false;
+		if (e < end && (*e == '-' || *e == '+')) {
+			negativeExponent = *e == '-';
+			e++;
+		}
+		if (e < end && isDigit(*e)) {
+			int64_t explicitExponent = 0;
+			for (; e < end && isDigit(*e); e++) {
+				// Anything this large is zero or infinity anyway
+				if (explicitExponent < 100000) { explicitExponent = explicitExponent * 10 + (*e - '0'); }
+			}
+			exponent += negativeExponent ? -explicitExponent : explicitExponent;
+			p = e;
+		}
+	}
+	*stop = p;
+
+	uint64_t bits;
+	if (w == 0) {
+		bits = 0;
+	}
+#if FLT_EVAL_METHOD == 0
+	// Clinger's fast path: both w and 10^exponent are exact doubles, so one
+	// correctly rounded multiplication or division gives the right answer.
+	else if (truncated == false && w <= (1ull << 53) && exponent >= -22 && exponent <= 22) {
+		double result = (double)w;
+		result = exponent < 0 ? result / exactPowersOfTen[-exponent] : result * exactPowersOfTen[exponent];
+		*value = negative ? -result : result;
+		return EWELBORN_PARSE_SUCCESS;
+	}
+#endif
+	else {
+		bits = eiselLemire(w, exponent);
+		// If digits were dropped, the real number is somewhere between w and
+		// w + 1, so the answer is only known if both round to the same double.
+		// Otherwise, strtod has to work through every digit.
+		if (truncated && eiselLemire(w + 1, exponent) != bits) {
+			char smallCopy[128];
+			size_t length = (size_t)(p - start);
+			char* copy = length < sizeof(smallCopy) ? smallCopy : allocateFrom(NULL, length + 1, EWELBORN_ALLOCATION_OTHER);
+			if (copy == NULL) { return EWELBORN_PARSE_OUT_OF_MEMORY; }
+			memcpy(copy, start, length);
+			copy[length] = '\0';
+			double result = strtod(copy, NULL);
+			if (copy != smallCopy) { releaseTo(NULL, copy, EWELBORN_ALLOCATION_OTHER); }
+			bits = 0;
+			memcpy(&bits, &result, sizeof(result));
+			bits &= ~(1ull << 63);
+		}
+	}
+
+	*value = doubleFromBits(bits | ((uint64_t)negative << 63));
+	if (bits == 0x7FFull << 52) { return EWELBORN_PARSE_OVERFLOW; }
+	return EWELBORN_PARSE_SUCCESS;
+}
+
+// Removes the spaces and tabs around a number. Numbers are short, so this is
+// quicker than going through the scan kernels.
+static ewelborn_stringView trimNumber(ewelborn_stringView view)
+{
+	while (view.length > 0 && (view.data[0] == ' ' || view.data[0] == '\t')) {
+		view.data++;
+		view.length--;
+	}
+	while (view.length > 0 && (view.data[view.length - 1] == ' ' || view.data[view.length - 1] == '\t')) {
+		view.length--;
+	}
+	return view;
+}
+
+ewelborn_parseResult ewelborn_stringView_parseInt64(ewelborn_stringView view, int64_t* value)
+{
+	view = trimNumber(view);
+	int64_t result;
+	const char* stop;
+	ewelborn_parseResult status = parseInt64Prefix(view.data, view.data + view.length, &result, &stop);
+	if (status == EWELBORN_PARSE_INVALID || stop != view.data + view.length) { return EWELBORN_PARSE_INVALID; }
+	*value = result;
+	return status;
+}
+
+ewelborn_parseResult ewelborn_stringView_parseDouble(ewelborn_stringView view, double* value)
+{
+	view = trimNumber(view);
+	double result;
+	const char* stop;
+	ewelborn_parseResult status = parseDoublePrefix(view.data, view.data + view.length, &result, &stop);
+	if (status == EWELBORN_PARSE_OUT_OF_MEMORY) { return status; }
+	if (status == EWELBORN_PARSE_INVALID || stop != view.data + view.length) { return EWELBORN_PARSE_INVALID; }
+	*value = result;
+	return status;
+}
+
+ewelborn_parseResult ewelborn_string_parseInt64(ewelborn_string* estring, int64_t* value)
+{
+	return ewelborn_stringView_parseInt64(ewelborn_stringView_fromString(estring), value);
+}
+
+ewelborn_parseResult ewelborn_string_parseDouble(ewelborn_string* estring, double* value)
+{
+	return ewelborn_stringView_parseDouble(ewelborn_stringView_fromString(estring), value);
+}
+
+static bool isNumberSeparator(char c)
+{
+	return c == ' ' || c == ',' || c == '\n' || c == '\t' || c == '\r';
+}
+
+// Numbers are parsed into a small batch on the stack, then appended to the
+// array all at once, so the array only has to check its size once per batch.
+#define PARSE_BATCH_SIZE 256
+
+ewelborn_parseResult ewelborn_parseIntsFromBuffer(const char* buffer, size_t length, ewelborn_typedArray* numbers, size_t* errorOffset)
+{
+	const char* p = buffer;
+	const char* end = buffer + length;
+	ewelborn_parseResult status = EWELBORN_PARSE_SUCCESS;
+	int64_t batch[PARSE_BATCH_SIZE];
+	int batchSize = 0;
+
+	if (numbers->elementSize != sizeof(int64_t)) {
+		status = EWELBORN_PARSE_INVALID;
+		goto FINISH;
+	}
+
+	while (true) {
+		while (p < end && isNumberSeparator(*p)) { p++; }
+		if (p == end) { break; }
+
+		const char* stop;
+		status = parseInt64Prefix(p, end, &batch[batchSize], &stop);
+		if (status != EWELBORN_PARSE_SUCCESS) { goto FINISH; }
+		// The number has to be followed by a separator, so "12ab" isn't 12
+		if (stop < end && isNumberSeparator(*stop) == false) {
+			p = stop;
+			status = EWELBORN_PARSE_INVALID;
+			goto FINISH;
+		}
+		p = stop;
+
+		if (++batchSize == PARSE_BATCH_SIZE) {
+			if (ewelborn_typedArray_appendMany(numbers, batch, batchSize) == false) {
+				batchSize = 0;
+				status = EWELBORN_PARSE_OUT_OF_MEMORY;
+				goto FINISH;
+			}
+			batchSize = 0;
+		}
+	}
+
+FINISH:
+	if (batchSize > 0 && ewelborn_typedArray_appendMany(numbers, batch, batchSize) == false) {
+		status = EWELBORN_PARSE_OUT_OF_MEMORY;
+	}
+	if (status != EWELBORN_PARSE_SUCCESS && errorOffset != NULL) { *errorOffset = (size_t)(p - buffer); }
+	return status;
+}
+
+ewelborn_parseResult ewelborn_parseDoublesFromBuffer(const char* buffer, size_t length, ewelborn_typedArray* numbers, size_t* errorOffset)
+{
+	const char* p = buffer;
+	const char* end = buffer + length;
+	ewelborn_parseResult status = EWELBORN_PARSE_SUCCESS;
+	double batch[PARSE_BATCH_SIZE];
+	int batchSize = 0;
+
+	if (numbers->elementSize != sizeof(double)) {
+		status = EWELBORN_PARSE_INVALID;
+		goto FINISH;
+	}
+
+	while (true) {
+		while (p < end && isNumberSeparator(*p)) { p++; }
+		if (p == end) { break; }
+
+		const char* stop;
+		status = parseDoublePrefix(p, end, &batch[batchSize], &stop);
+		if (status != EWELBORN_PARSE_SUCCESS) { goto FINISH; }
+		if (stop < end && isNumberSeparator(*stop) == false) {
+			p = stop;
+			status = EWELBORN_PARSE_INVALID;
+			goto FINISH;
+		}
+		p = stop;
+
+		if (++batchSize == PARSE_BATCH_SIZE) {
+			if (ewelborn_typedArray_appendMany(numbers, batch, batchSize) == false) {
+				batchSize = 0;
+				status = EWELBORN_PARSE_OUT_OF_MEMORY;
+				goto FINISH;
+			}
+			batchSize = 0;
+		}
+	}
+
+FINISH:
+	if (batchSize > 0 && ewelborn_typedArray_appendMany(numbers, batch, batchSize) == false) {
+		status = EWELBORN_PARSE_OUT_OF_MEMORY;
+	}
+	if (status != EWELBORN_PARSE_SUCCESS && errorOffset != NULL) { *errorOffset = (size_t)(p - buffer); }
+	return status;
+}
+
+// "00" through "99", so integers can be written two digits at a time
+static const char digitPairs[201] =
+	"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+static const uint64_t digitCountPowersOfTen[] = {
+	1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+	1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+	100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+	1000000000000000000ull, 10000000000000000000ull
+};
+
+// Returns how many digits value has in base 10 (0 has one digit). The number
+// of bits gives a guess (1233 / 4096 is just over log10(2)) that's at most
+// one digit too large.
+static int countDigits(uint64_t value)
+{
+	int guess = ((64 - countLeadingZeros64(value | 1)) * 1233) >> 12;
+	return guess + 1 - ((value | 1) < digitCountPowersOfTen[guess]);
+}
+
+// Writes the digits of value so that the last one ends right before end.
+static void writeDigits(char* end, uint64_t value)
+{
+	while (value >= 100) {
+		uint64_t pair = value % 100;
+		value /= 100;
+		end -= 2;
+		memcpy(end, digitPairs + 2 * pair, 2);
+	}
+	if (value >= 10) {
+		memcpy(end - 2, digitPairs + 2 * value, 2);
+	} else {
+		end[-1] = (char)('0' + value);
+	}
+}
+
+// Appends the digits of value, with a minus sign in front if isNegative.
+static bool stringAppendInteger(ewelborn_string* estring, uint64_t value, bool isNegative)
+{
+	int length = countDigits(value) + isNegative;
+	if (estring->length > INT_MAX - 1 - length) { return false; }
+	if (stringEnsureCapacity(estring, estring->length + length + 1) == false) { return false; }
+
+	char* start = estring->cstring + estring->length;
+	if (isNegative) { start[0] = '-'; }
+	writeDigits(start + length, value);
+	estring->length += length;
+	estring->cstring[estring->length] = '\0';
+	return true;
+}
+
+bool ewelborn_string_appendInt(ewelborn_string* estring, int64_t value)
+{
+	// Negating in unsigned math, so that INT64_MIN doesn't overflow
+	return value < 0 ? stringAppendInteger(estring, 0 - (uint64_t)value, true) : stringAppendInteger(estring, (uint64_t)value, false);
+}
+
+bool ewelborn_string_appendUInt(ewelborn_string* estring, uint64_t value)
+{
+	return stringAppendInteger(estring, value, false);
+}
+
+// floor(log10(2^e)), floor(log10(3/4 * 2^e)), and floor(log2(10^e)), for
+// the exponents that doubles can have.
+static int floorLog10Pow2(int e)
+{
+	return (e * 315653) >> 20;
+}
+
+static int floorLog10ThreeQuartersPow2(int e)
+{
+	return (e * 315653 - 131237) >> 20;
+}
+
+static int floorLog2Pow10(int e)
+{
+	return (e * 1741647) >> 19;
+}
+
+// Returns g * x / 2^128, rounded down, but with the lowest bit set if there
+// was anything left over ("rounding to odd"), which keeps enough information
+// to round the result correctly later.
+static uint64_t multiplyRoundToOdd(const uint64_t* g, uint64_t x)
+{
+	uint64_t lowLow, lowHigh, highLow, highHigh;
+	multiply128(g[1], x, &lowLow, &lowHigh);
+	multiply128(g[0], x, &highLow, &highHigh);
+	uint64_t middle = highLow + lowHigh;
+	highHigh += middle < highLow;
+	return highHigh | (middle != 0);
+}
+
+// Finds the shortest decimal significand * 10^exponent that reads back as
+// the given finite, positive double, using Raffaello Giulietti's Schubfach
+// algorithm ("The Schubfach way to render doubles"). When there are several
+// equally short ones, picks the closest to the double. The significand may
+// end in zeros.
+static void shortestDecimal(uint64_t bits, uint64_t* significand, int* exponent)
+{
+	uint64_t fraction = bits & ((1ull << 52) - 1);
+	int biasedExponent = (int)(bits >> 52);
+
+	// The double is c * 2^q
+	uint64_t c;
+	int q;
+	if (biasedExponent != 0) {
+		c = fraction | (1ull << 52);
+		q = biasedExponent - 1075;
+		// Small integers are already as short as they can be
+		if (q <= 0 && q > -53 && (c & ((1ull << -q) - 1)) == 0) {
+			*significand = c >> -q;
+			*exponent = 0;
+			return;
+		}
+	} else {
+		c = fraction;
+		q = -1074;
+	}
+
+	// Every number strictly between the middle points to the doubles on
+	// either side reads back as this double, and so do the middle points
+	// themselves when c is even (since ties round to even). Everything is
+	// scaled by 4 to keep the middle points whole. The double below a power
+	// of 2 is closer than the double above it.
+	bool includeMiddles = (c & 1) == 0;
+	bool lowerIsCloser = fraction == 0 && biasedExponent > 1;
+	uint64_t lowerMiddle = 4 * c - 2 + lowerIsCloser;
+	uint64_t upperMiddle = 4 * c + 2;
+
+	// Pick k so that there's exactly one or two multiples of 10^k between
+	// the middle points, and scale everything by 10^-k.
+	int k = lowerIsCloser ? floorLog10ThreeQuartersPow2(q) : floorLog10Pow2(q);
+	int shift = q + floorLog2Pow10(-k) + 1;
+	uint64_t g[2];
+	const uint64_t* power = &powersOfFive[2 * (-k - SMALLEST_POWER_OF_TEN)];
+	g[0] = power[0];
+	g[1] = power[1];
+	if (-k > 55) {
+		// The table rounds large powers down, but this needs them rounded up
+		g[1]++;
+		g[0] += g[1] == 0;
+	}
+	uint64_t lower = multiplyRoundToOdd(g, lowerMiddle << shift) + (includeMiddles == false);
+	uint64_t middle = multiplyRoundToOdd(g, (4 * c) << shift);
+	uint64_t upper = multiplyRoundToOdd(g, upperMiddle << shift) - (includeMiddles == false);
+
+	// A multiple of 10^(k+1) between the middle points is one digit shorter
+	// than anything else. There can't be two of them.
+	uint64_t s = middle / 4;
+	if (s >= 10) {
+		uint64_t shorter = s / 10;
+		bool shorterFits = lower <= shorter * 40;
+		bool longerFits = shorter * 40 + 40 <= upper;
+		if (shorterFits != longerFits) {
+			*significand = longerFits ? shorter + 1 : shorter;
+			*exponent = k + 1;
+			return;
+		}
+	}
+
+	// Otherwise, take whichever of s and s + 1 fits, or the closest one if
+	// both do
+	bool sFits = lower <= 4 * s;
+	bool nextFits = 4 * s + 4 <= upper;
+	if (sFits != nextFits) {
+		*significand = nextFits ? s + 1 : s;
+	} else {
+		bool roundUp = middle > 4 * s + 2 || (middle == 4 * s + 2 && (s & 1) != 0);
+		*significand = roundUp ? s + 1 : s;
+	}
+	*exponent = k;
+}
+
+bool ewelborn_string_appendDouble(ewelborn_string* estring, double value)
+{
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	bool isNegative = (bits >> 63) != 0;
+	bits &= ~(1ull << 63);
+
+	// Long enough for a sign, 17 digits, "0.", 6 more zeros, or an exponent
+	char buffer[32];
+	char* p = buffer;
+	if (isNegative && bits <= (0x7FFull << 52)) { *p++ = '-'; }
+
+	if (bits >= (0x7FFull << 52)) {
+		memcpy(p, bits == (0x7FFull << 52) ? "inf" : "nan", 3);
+		p += 3;
+	} else if (bits == 0) {
+		*p++ = '0';
+	} else {
+		uint64_t significand;
+		int exponent;
+		shortestDecimal(bits, &significand, &exponent);
+		while (significand % 10 == 0) {
+			significand /= 10;
+			exponent++;
+		}
+
+		// Written the same way that JavaScript writes numbers: without an
+		// exponent from 1e-6 up to (but not including) 1e21, and with one
+		// otherwise.
+		int digitCount = countDigits(significand);
+		int point = digitCount + exponent; // Digits in front of the decimal point
+		if (exponent >= 0 && point <= 21) {
+			writeDigits(p + digitCount, significand);
+			p += digitCount;
+			memset(p, '0', exponent);
+			p += exponent;
+		} else if (point > 0 && point <= 21) {
+			writeDigits(p + digitCount + 1, significand);
+			memmove(p, p + 1, point);
+			p[point] = '.';
+			p += digitCount + 1;
+		} else if (point > -6 && point <= 0) {
+			memcpy(p, "0.", 2);
+			memset(p + 2, '0', -point);
+			p += 2 - point;
+			writeDigits(p + digitCount, significand);
+			p += digitCount;
+		} else {
+			writeDigits(p + digitCount + 1, significand);
+			p[0] = p[1];
+			if (digitCount > 1) {
+				p[1] = '.';
+				p += digitCount + 1;
+			} else {
+				p++;
+			}
+			int scientificExponent = point - 1;
+			*p++ = 'e';
+			*p++ = scientificExponent < 0 ? '-' : '+';
+			if (scientificExponent < 0) { scientificExponent = -scientificExponent; }
+			int exponentDigits = countDigits((uint64_t)scientificExponent);
+			writeDigits(p + exponentDigits, (uint64_t)scientificExponent);
+			p += exponentDigits;
+		}
+	}
+
+	return ewelborn_string_appendN(estring, buffer, (int)(p - buffer));
+}
+
+// Arrays with fewer elements than these are sorted with introsort instead of
+// a radix sort, since counting and moving the elements through a scratch
+// buffer costs more than it saves on small arrays. Numbers need a pass per
+// byte, so they need a larger array than strings before radix sort wins.
+#define NUMBER_RADIX_SORT_MINIMUM_ELEMENTS 2048
+#define STRING_RADIX_SORT_MINIMUM_ELEMENTS 256
+// Buckets of strings with this many strings or fewer are finished with
+// insertion sort, instead of being split into buckets again
+#define STRING_RADIX_SORT_CUTOFF 32
+// The parallel sorts don't give any thread less than this many elements
+#define PARALLEL_MINIMUM_SORT_ELEMENTS 16384
+
+// The comparison function for the generic sorts is passed through
+// sortContext, so one copy of each sort works for every comparison function.
+struct sortComparison {
+	int(*compare)(const void* a, const void* b);
+};
+
+// Used for elements that are 16 bytes, so they can be moved as one value
+struct sortBlock16 {
+	uint64_t words[2];
+};
+
+#define COMPARISON_LESS_THAN_BY_ADDRESS(a, b) (((struct sortComparison*)sortContext)->compare(&(a), &(b)) < 0)
+#define KEY_LESS_THAN(a, b) ((a) < (b))
+#define VIEW_LESS_THAN(a, b) (ewelborn_stringView_compare((a), (b)) < 0)
+
+EWELBORN_DEFINE_SORT_WITH_CONTEXT(sortPointers, void*, COMPARISON_LESS_THAN_BY_ADDRESS)
+EWELBORN_DEFINE_SORT_WITH_CONTEXT(sortElements32, uint32_t, COMPARISON_LESS_THAN_BY_ADDRESS)
+EWELBORN_DEFINE_SORT_WITH_CONTEXT(sortElements64, uint64_t, COMPARISON_LESS_THAN_BY_ADDRESS)
+EWELBORN_DEFINE_SORT_WITH_CONTEXT(sortElements128, struct sortBlock16, COMPARISON_LESS_THAN_BY_ADDRESS)
+EWELBORN_DEFINE_SORT(sortKeys32, uint32_t, KEY_LESS_THAN)
+EWELBORN_DEFINE_SORT(sortKeys64, uint64_t, KEY_LESS_THAN)
+EWELBORN_DEFINE_SORT(sortViewsByComparison, ewelborn_stringView, VIEW_LESS_THAN)
+
+void ewelborn_dynamicArray_sort(ewelborn_dynamicArray* dynamicArray, int(*compare)(const void* a, const void* b))
+{
+	struct sortComparison comparison = { compare };
+	sortPointers(dynamicArray->array, (size_t)dynamicArray->elements, &comparison);
+}
+
+void ewelborn_typedArray_sort(ewelborn_typedArray* typedArray, int(*compare)(const void* a, const void* b))
+{
+	struct sortComparison comparison = { compare };
+	size_t count = (size_t)typedArray->elements;
+
+	// The common element sizes get their own introsort, which moves elements
+	// as single values, and everything else goes to qsort
+	switch (typedArray->elementSize) {
+	case sizeof(uint32_t):
+		sortElements32(typedArray->data, count, &comparison);
+		break;
+	case sizeof(uint64_t):
+		sortElements64(typedArray->data, count, &comparison);
+		break;
+	case sizeof(struct sortBlock16):
+		sortElements128(typedArray->data, count, &comparison);
+		break;
+	default:
+		if (count > 1) { qsort(typedArray->data, count, typedArray->elementSize, compare); }
+		break;
+	}
+}
+
+// LSD radix sort of unsigned keys, one byte at a time starting from the
+// least significant byte, using scratch (which must have room for count
+// keys) to move the keys between passes. The counts for every byte are found
+// in a single pass over the keys, and any byte that is the same in every key
+// is skipped, so small numbers only take a pass or two. The sorted keys end
+// up back in keys.
+#define DEFINE_RADIX_SORT(name, keyType) \
+	static void name(keyType* keys, keyType* scratch, size_t count) \
+	{ \
+		size_t counts[sizeof(keyType)][256] = { 0 }; \
+		for (size_t i = 0; i < count; i++) { \
+			keyType key = keys[i]; \
+			for (size_t byte = 0; byte < sizeof(keyType); byte++) { \
+				counts[byte][(key >> (8 * byte)) & 0xFF]++; \
+			} \
+		} \
+		keyType* from = keys; \
+		keyType* to = scratch; \
+		for (size_t byte = 0; byte < sizeof(keyType); byte++) { \
+			size_t* offsets = counts[byte]; \
+			if (offsets[(from[0] >> (8 * byte)) & 0xFF] == count) { continue; } \
+			size_t offset = 0; \
+			for (int digit = 0; digit < 256; digit++) { \
+				size_t digitCount = offsets[digit]; \
+				offsets[digit] = offset; \
+				offset += digitCount; \
+			} \
+			for (size_t i = 0; i < count; i++) { \
+				keyType key = from[i]; \
+				to[offsets[(key >> (8 * byte)) & 0xFF]++] = key; \
+			} \
+			keyType* swap = from; \
+			from = to; \
+			to = swap; \
+		} \
+		if (from != keys) { memcpy(keys, from, sizeof(keyType) * count); } \
+	}
+
+DEFINE_RADIX_SORT(radixSort32, uint32_t)
+DEFINE_RADIX_SORT(radixSort64, uint64_t)
+
+static void sortUnsigned32(uint32_t* keys, size_t count)
+{
+	uint32_t* scratch = count >= NUMBER_RADIX_SORT_MINIMUM_ELEMENTS ? allocateFrom(NULL, sizeof(uint32_t) * count, EWELBORN_ALLOCATION_ARRAY) : NULL;
+	if (scratch == NULL) {
+		sortKeys32(keys, count);
+		return;
+	}
+	radixSort32(keys, scratch, count);
+	releaseTo(NULL, scratch, EWELBORN_ALLOCATION_ARRAY);
+}
+
+static void sortUnsigned64(uint64_t* keys, size_t count)
+{
+	uint64_t* scratch = count >= NUMBER_RADIX_SORT_MINIMUM_ELEMENTS ? allocateFrom(NULL, sizeof(uint64_t) * count, EWELBORN_ALLOCATION_ARRAY) : NULL;
+	if (scratch == NULL) {
+		sortKeys64(keys, count);
+		return;
+	}
+	radixSort64(keys, scratch, count);
+	releaseTo(NULL, scratch, EWELBORN_ALLOCATION_ARRAY);
+}
+
+// The signed sorts flip each number's sign bit, which makes the numbers
+// sort correctly as unsigned numbers, and then flip it back afterwards.
+
+bool ewelborn_typedArray_sortInt32(ewelborn_typedArray* typedArray)
+{
+	if (typedArray->elementSize != sizeof(int32_t)) { return false; }
+	uint32_t* keys = typedArray->data;
+	size_t count = (size_t)typedArray->elements;
+	for (size_t i = 0; i < count; i++) { keys[i] ^= (uint32_t)1 << 31; }
+	sortUnsigned32(keys, count);
+	for (size_t i = 0; i < count; i++) { keys[i] ^= (uint32_t)1 << 31; }
+	return true;
+}
+
+bool ewelborn_typedArray_sortInt64(ewelborn_typedArray* typedArray)
+{
+	if (typedArray->elementSize != sizeof(int64_t)) { return false; }
+	uint64_t* keys = typedArray->data;
+	size_t count = (size_t)typedArray->elements;
+	for (size_t i = 0; i < count; i++) { keys[i] ^= (uint64_t)1 << 63; }
+	sortUnsigned64(keys, count);
+	for (size_t i = 0; i < count; i++) { keys[i] ^= (uint64_t)1 << 63; }
+	return true;
+}
+
+bool ewelborn_typedArray_sortDouble(ewelborn_typedArray* typedArray)
+{
+	if (typedArray->elementSize != sizeof(double)) { return false; }
+	uint64_t* keys = typedArray->data;
+	size_t count = (size_t)typedArray->elements;
+	const uint64_t signBit = (uint64_t)1 << 63;
+
+	// Positive doubles already sort correctly as unsigned numbers once their
+	// sign bit is set, and negative doubles sort correctly once every bit
+	// is flipped (so larger magnitudes come first)
+	for (size_t i = 0; i < count; i++) {
+		keys[i] = (keys[i] & signBit) ? ~keys[i] : keys[i] | signBit;
+	}
+	sortUnsigned64(keys, count);
+	for (size_t i = 0; i < count; i++) {
+		keys[i] = (keys[i] & signBit) ? keys[i] & ~signBit : ~keys[i];
+	}
+	return true;
+}
+
+// An estring (or view) being sorted by the string radix sort. Its data and
+// length are copied here so that sorting doesn't have to keep going back to
+// the estring for them.
+struct sortString {
+	const char* data;
+	size_t length;
+	void* element; // The estring, or null when sorting views
+};
+
+struct stringSortJob {
+	size_t start;
+	size_t count;
+	size_t depth; // Every string in the job has the same first depth characters
+};
+
+// Compares two strings that have the same first depth characters, the same
+// way ewelborn_stringView_compare does.
+static int compareSortStrings(const struct sortString* a, const struct sortString* b, size_t depth)
+{
+	size_t length = a->length < b->length ? a->length : b->length;
+	int result = memcmp(a->data + depth, b->data + depth, length - depth);
+	if (result != 0) { return result; }
+	return (a->length > b->length) - (a->length < b->length);
+}
+
+#define SORT_STRING_LESS_THAN(a, b) (compareSortStrings(&(a), &(b), 0) < 0)
+
+EWELBORN_DEFINE_SORT(sortStringsByComparison, struct sortString, SORT_STRING_LESS_THAN)
+
+static void insertionSortStrings(struct sortString* strings, size_t count, size_t depth)
+{
+	for (size_t i = 1; i < count; i++) {
+		struct sortString string = strings[i];
+		size_t j = i;
+		for (; j > 0 && compareSortStrings(&string, &strings[j - 1], depth) < 0; j--) {
+			strings[j] = strings[j - 1];
+		}
+		strings[j] = string;
+	}
+}
+
+// MSD radix sort of strings. The strings are split into 257 buckets by their
+// first character (with one bucket for strings that have no more characters,
+// which always comes first), and then each bucket is split by its second
+// character, and so on, until the buckets are small enough for insertion
+// sort. Jobs are kept on a stack instead of recursing, since a long shared
+// prefix would otherwise recurse once per character. scratch and characters
+// must each have room for count elements.
+static void radixSortStrings(struct sortString* strings, struct sortString* scratch, uint16_t* characters, size_t count)
+{
+	size_t maxJobs = 64;
+	size_t jobCount = 0;
+	struct stringSortJob* jobs = allocateFrom(NULL, sizeof(struct stringSortJob) * maxJobs, EWELBORN_ALLOCATION_ARRAY);
+	if (jobs == NULL) {
+		sortStringsByComparison(strings, count);
+		return;
+	}
+	jobs[jobCount++] = (struct stringSortJob){ 0, count, 0 };
+
+	size_t counts[257];
+	size_t offsets[257];
+	while (jobCount > 0) {
+		struct stringSortJob job = jobs[--jobCount];
+		struct sortString* bucket = strings + job.start;
+		uint16_t* bucketCharacters = characters + job.start;
+
+		// Read every string's character at this depth only once, since it's
+		// needed for both counting and moving the strings
+		memset(counts, 0, sizeof(counts));
+		for (size_t i = 0; i < job.count; i++) {
+			uint16_t c = job.depth < bucket[i].length ? (uint16_t)((unsigned char)bucket[i].data[job.depth] + 1) : 0;
+			bucketCharacters[i] = c;
+			counts[c]++;
+		}
+
+		// When every string has the same character here, there's nothing to
+		// move, so just look at the next character
+		if (counts[bucketCharacters[0]] == job.count) {
+			if (bucketCharacters[0] != 0) {
+				job.depth++;
+				jobs[jobCount++] = job;
+			}
+			continue;
+		}
+
+		size_t offset = job.start;
+		for (int c = 0; c < 257; c++) {
+			offsets[c] = offset;
+			offset += counts[c];
+		}
+		for (size_t i = 0; i < job.count; i++) {
+			scratch[offsets[bucketCharacters[i]]++] = bucket[i];
+		}
+		memcpy(bucket, scratch + job.start, sizeof(struct sortString) * job.count);
+
+		// The strings that ended are all equal, so only the other buckets
+		// need to be sorted
+		size_t start = job.start + counts[0];
+		for (int c = 1; c < 257; c++) {
+			if (counts[c] > STRING_RADIX_SORT_CUTOFF) {
+				if (jobCount == maxJobs) {
+					struct stringSortJob* newJobs = reallocateFrom(NULL, jobs, sizeof(struct stringSortJob) * maxJobs,
+						sizeof(struct stringSortJob) * maxJobs * 2, EWELBORN_ALLOCATION_ARRAY);
+					if (newJobs == NULL) {
+						sortStringsByComparison(strings + start, counts[c]);
+						start += counts[c];
+						continue;
+					}
+					jobs = newJobs;
+					maxJobs *= 2;
+				}
+				jobs[jobCount++] = (struct stringSortJob){ start, counts[c], job.depth + 1 };
+			}
+			else if (counts[c] > 1) {
+				insertionSortStrings(strings + start, counts[c], job.depth + 1);
+			}
+			start += counts[c];
+		}
+	}
+
+	releaseTo(NULL, jobs, EWELBORN_ALLOCATION_ARRAY);
+}
+
+// Sorts the strings with a radix sort if there are enough of them (and
+// enough memory for one), or with introsort otherwise.
+static void sortStringEntries(struct sortString* strings, size_t count)
+{
+	if (count >= STRING_RADIX_SORT_MINIMUM_ELEMENTS) {
+		struct sortString* scratch = allocateFrom(NULL, sizeof(struct sortString) * count, EWELBORN_ALLOCATION_ARRAY);
+		uint16_t* characters = allocateFrom(NULL, sizeof(uint16_t) * count, EWELBORN_ALLOCATION_ARRAY);
+		if (scratch != NULL && characters != NULL) {
+			radixSortStrings(strings, scratch, characters, count);
+			releaseTo(NULL, scratch, EWELBORN_ALLOCATION_ARRAY);
+			releaseTo(NULL, characters, EWELBORN_ALLOCATION_ARRAY);
+			return;
+		}
+		releaseTo(NULL, scratch, EWELBORN_ALLOCATION_ARRAY);
+		releaseTo(NULL, characters, EWELBORN_ALLOCATION_ARRAY);
+	}
+	sortStringsByComparison(strings, count);
+}
+
+static int compareStringElements(const void* a, const void* b)
+{
+	const ewelborn_string* stringA = *(ewelborn_string* const*)a;
+	const ewelborn_string* stringB = *(ewelborn_string* const*)b;
+	return ewelborn_stringView_compare((ewelborn_stringView){ stringA->cstring, stringA->length },
+		(ewelborn_stringView){ stringB->cstring, stringB->length });
+}
+
+// Sorts an array of count estring pointers.
+static void sortStringPointers(void** elements, size_t count)
+{
+	struct sortString* strings = count > 1 ? allocateFrom(NULL, sizeof(struct sortString) * count, EWELBORN_ALLOCATION_ARRAY) : NULL;
+	if (strings == NULL) {
+		struct sortComparison comparison = { compareStringElements };
+		sortPointers(elements, count, &comparison);
+		return;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		ewelborn_string* estring = elements[i];
+		strings[i] = (struct sortString){ estring->cstring, (size_t)estring->length, estring };
+	}
+	sortStringEntries(strings, count);
+	for (size_t i = 0; i < count; i++) {
+		elements[i] = strings[i].element;
+	}
+
+	releaseTo(NULL, strings, EWELBORN_ALLOCATION_ARRAY);
+}
+
+void ewelborn_dynamicArray_sortStrings(ewelborn_dynamicArray* dynamicArray)
+{
+	sortStringPointers(dynamicArray->array, (size_t)dynamicArray->elements);
+}
+
+bool ewelborn_typedArray_sortViews(ewelborn_typedArray* typedArray)
+{
+	if (typedArray->elementSize != sizeof(ewelborn_stringView)) { return false; }
+	ewelborn_stringView* views = typedArray->data;
+	size_t count = (size_t)typedArray->elements;
+
+	struct sortString* strings = count > 1 ? allocateFrom(NULL, sizeof(struct sortString) * count, EWELBORN_ALLOCATION_ARRAY) : NULL;
+	if (strings == NULL) {
+		sortViewsByComparison(views, count);
+		return true;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		strings[i] = (struct sortString){ views[i].data, (size_t)views[i].length, NULL };
+	}
+	sortStringEntries(strings, count);
+	for (size_t i = 0; i < count; i++) {
+		views[i] = (ewelborn_stringView){ strings[i].data, (int)strings[i].length };
+	}
+
+	releaseTo(NULL, strings, EWELBORN_ALLOCATION_ARRAY);
+	return true;
+}
+
+struct sortTask {
+	void** elements;
+	size_t count;
+	int(*compare)(const void* a, const void* b); // Null for estrings
+};
+
+static void sortTaskRun(void* parameter)
+{
+	struct sortTask* task = parameter;
+	if (task->compare == NULL) {
+		sortStringPointers(task->elements, task->count);
+	}
+	else {
+		struct sortComparison comparison = { task->compare };
+		sortPointers(task->elements, task->count, &comparison);
+	}
+}
+
+struct mergeTask {
+	void** left;
+	size_t leftCount;
+	void** right;
+	size_t rightCount;
+	void** destination;
+	int(*compare)(const void* a, const void* b);
+};
+
+static void mergeTaskRun(void* parameter)
+{
+	struct mergeTask* task = parameter;
+	void** left = task->left;
+	void** leftEnd = left + task->leftCount;
+	void** right = task->right;
+	void** rightEnd = right + task->rightCount;
+	void** destination = task->destination;
+
+	// Ties go to the left run
+	while (left < leftEnd && right < rightEnd) {
+		if (task->compare(right, left) < 0) { *destination++ = *right++; }
+		else { *destination++ = *left++; }
+	}
+	memcpy(destination, left, sizeof(void*) * (size_t)(leftEnd - left));
+	destination += leftEnd - left;
+	memcpy(destination, right, sizeof(void*) * (size_t)(rightEnd - right));
+}
+
+// Returns how many of the first n elements of the merge of left and right
+// come from left, by binary searching for the split where everything taken
+// from both runs comes before everything left behind.
+static size_t mergeSplit(void** left, size_t leftCount, void** right, size_t rightCount, size_t n, int(*compare)(const void* a, const void* b))
+{
+	size_t low = n > rightCount ? n - rightCount : 0;
+	size_t high = n < leftCount ? n : leftCount;
+	while (low < high) {
+		size_t i = low + (high - low) / 2;
+		size_t j = n - i;
+		if (compare(&left[i], &right[j - 1]) <= 0) { low = i + 1; }
+		else { high = i; }
+	}
+	return low;
+}
+
+// Sorts the array by splitting it into one run per thread, sorting the runs
+// in parallel, and then merging pairs of runs together until there's only
+// one left. Each merge is split into pieces (using mergeSplit), so that every
+// round of merging still uses every thread.
+static void sortPointersParallel(ewelborn_dynamicArray* dynamicArray, int(*compare)(const void* a, const void* b), int threadCount)
+{
+	size_t count = (size_t)dynamicArray->elements;
+	threadCount = pickThreadCount(threadCount, count, PARALLEL_MINIMUM_SORT_ELEMENTS);
+
+	void** scratch = NULL;
+	struct sortTask* sortTasks = NULL;
+	struct mergeTask* mergeTasks = NULL;
+	size_t* runStarts = NULL;
+	if (threadCount > 1) {
+		scratch = allocateFrom(NULL, sizeof(void*) * count, EWELBORN_ALLOCATION_ARRAY);
+		sortTasks = allocateFrom(NULL, sizeof(struct sortTask) * threadCount, EWELBORN_ALLOCATION_THREADING);
+		mergeTasks = allocateFrom(NULL, sizeof(struct mergeTask) * threadCount, EWELBORN_ALLOCATION_THREADING);
+		runStarts = allocateFrom(NULL, sizeof(size_t) * (threadCount + 1), EWELBORN_ALLOCATION_THREADING);
+	}
+	if (scratch == NULL || sortTasks == NULL || mergeTasks == NULL || runStarts == NULL) {
+		struct sortTask task = { dynamicArray->array, count, compare };
+		sortTaskRun(&task);
+		goto CLEAN_UP;
+	}
+
+	for (int i = 0; i <= threadCount; i++) {
+		runStarts[i] = count * (size_t)i / (size_t)threadCount;
+	}
+	for (int i = 0; i < threadCount; i++) {
+		sortTasks[i] = (struct sortTask){ dynamicArray->array + runStarts[i], runStarts[i + 1] - runStarts[i], compare };
+	}
+	runTasksInParallel(sortTasks, sizeof(struct sortTask), threadCount, sortTaskRun);
+
+	if (compare == NULL) { compare = compareStringElements; }
+	void** from = dynamicArray->array;
+	void** to = scratch;
+	int runs = threadCount;
+	while (runs > 1) {
+		int merges = (runs + 1) / 2;
+		int piecesPerMerge = threadCount / merges;
+		int taskCount = 0;
+		for (int m = 0; m < merges; m++) {
+			// An odd run out is merged with an empty run, which just copies it
+			size_t start = runStarts[2 * m];
+			size_t middle = 2 * m + 1 < runs ? runStarts[2 * m + 1] : runStarts[runs];
+			size_t end = 2 * m + 1 < runs ? runStarts[2 * m + 2] : runStarts[runs];
+			void** left = from + start;
+			void** right = from + middle;
+			size_t leftCount = middle - start;
+			size_t rightCount = end - middle;
+
+			size_t previousLeft = 0;
+			size_t previousOutput = 0;
+			for (int piece = 1; piece <= piecesPerMerge; piece++) {
+				size_t output = (end - start) * (size_t)piece / (size_t)piecesPerMerge;
+				size_t splitLeft = mergeSplit(left, leftCount, right, rightCount, output, compare);
+				mergeTasks[taskCount++] = (struct mergeTask){
+					left + previousLeft, splitLeft - previousLeft,
+					right + (previousOutput - previousLeft), (output - splitLeft) - (previousOutput - previousLeft),
+					to + start + previousOutput, compare
+				};
+				previousLeft = splitLeft;
+				previousOutput = output;
+			}
+		}
+		runTasksInParallel(mergeTasks, sizeof(struct mergeTask), taskCount, mergeTaskRun);
+
+		for (int m = 0; m < merges; m++) {
+			runStarts[m] = runStarts[2 * m];
+		}
+		runStarts[merges] = count;
+		runs = merges;
+		void** swap = from;
+		from = to;
+		to = swap;
+	}
+	if (from != dynamicArray->array) {
+		memcpy(dynamicArray->array, from, sizeof(void*) * count);
+	}
+
+CLEAN_UP:
+	releaseTo(NULL, scratch, EWELBORN_ALLOCATION_ARRAY);
+	releaseTo(NULL, sortTasks, EWELBORN_ALLOCATION_THREADING);
+	releaseTo(NULL, mergeTasks, EWELBORN_ALLOCATION_THREADING);
+	releaseTo(NULL, runStarts, EWELBORN_ALLOCATION_THREADING);
+}
+
+void ewelborn_dynamicArray_sortParallel(ewelborn_dynamicArray* dynamicArray, int(*compare)(const void* a, const void* b), int threadCount)
+{
+	sortPointersParallel(dynamicArray, compare, threadCount);
+}
+
+void ewelborn_dynamicArray_sortStringsParallel(ewelborn_dynamicArray* dynamicArray, int threadCount)
+{
+	sortPointersParallel(dynamicArray, NULL, threadCount);
+}
+
+// Scalar implementations, which every other implementation falls back to
+// for whatever is left over at the end of the buffer.
+
+static size_t findCharScalar(const char* buffer, size_t length, char c)
+{
+	for (size_t i = 0; i < length; i++) {
+		if (buffer[i] == c) { return i; }
+	}
+	return length;
+}
+
+static size_t findAnyOfScalar(const char* buffer, size_t length, const char* set, int setLength)
+{
+	// Look up each character in a table instead of comparing it against
+	// every character in the set.
+	bool inSet[256] = { false };
+	for (int i = 0; i < setLength; i++) { inSet[(unsigned char)set[i]] = true; }
+
+	for (size_t i = 0; i < length; i++) {
+		if (inSet[(unsigned char)buffer[i]]) { return i; }
+	}
+	return length;
+}
+
+static uint64_t maskAnyOfScalar(const char* buffer, int length, const char* set, int setLength)
+{
+	uint64_t mask = 0;
+	for (int i = 0; i < length; i++) {
+		bool found = false;
+		for (int j = 0; j < setLength; j++) { found |= buffer[i] == set[j]; }
+		mask |= (uint64_t)found << i;
+	}
+	return mask;
+}
+
+static size_t findPairScalar(const char* buffer, size_t length, char first, char last, size_t distance)
+{
+	for (size_t i = 0; i + distance < length; i++) {
+		if (buffer[i] == first && buffer[i + distance] == last) { return i; }
+	}
+	return length;
+}
+
+static size_t skipWhitespaceLeftScalar(const char* buffer, size_t length)
+{
+	size_t i = 0;
+	while (i < length && (buffer[i] == ' ' || buffer[i] == '\t')) { i++; }
+	return i;
+}
+
+static size_t skipWhitespaceRightScalar(const char* buffer, size_t length)
+{
+	while (length > 0 && (buffer[length - 1] == ' ' || buffer[length - 1] == '\t')) { length--; }
+	return length;
+}
+
+static size_t countCharScalar(const char* buffer, size_t length, char c)
+{
+	size_t count = 0;
+	for (size_t i = 0; i < length; i++) {
+		count += buffer[i] == c;
+	}
+	return count;
+}
+
+#ifdef EWELBORN_X86
+
+// The SIMD implementations are compiled for their instruction sets one
+// function at a time, so the rest of the library doesn't need any special
+// compiler flags, and will still run on CPUs that don't support them.
+#ifdef __GNUC__
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+// Returns the position of the lowest set bit in a non-zero mask.
+static int countTrailingZeros(unsigned int mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return (int)index;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+// Returns the position of the highest set bit in a non-zero mask.
+static int highestSetBit(unsigned int mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse(&index, mask);
+	return (int)index;
+#else
+	return 31 - __builtin_clz(mask);
+#endif
+}
+
+// SSE2 checks 16 characters at a time. Each comparison gives back a mask with
+// one bit per character, and the position of the first (or last) set bit in
+// the mask is the position of the match.
+
+TARGET_SSE2 static size_t findCharSSE2(const char* buffer, size_t length, char c)
+{
+	const __m128i needle = _mm_set1_epi8(c);
+	size_t i = 0;
+	for (; i + 16 <= length; i += 16) {
+		__m128i chunk = _mm_loadu_si128((const __m128i*)(buffer + i));
+		unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+		if (mask != 0) { return i + countTrailingZeros(mask); }
+	}
+	return i + findCharScalar(buffer + i, length - i, c);
+}
+
+// Sets that are larger than this are checked with the scalar lookup table,
+// since comparing against each character in the set stops being worth it.
+#define MAX_SIMD_SET_LENGTH 16
+
+TARGET_SSE2 static size_t findAnyOfSSE2(const char* buffer, size_t length, const char* set, int setLength)
+{
+	if (setLength > MAX_SIMD_SET_LENGTH) { return findAnyOfScalar(buffer, length, set, setLength); }
+
+	__m128i needles[MAX_SIMD_SET_LENGTH];
+	for (int j = 0; j < setLength; j++) { needles[j] = _mm_set1_epi8(set[j]); }
+
+	size_t i = 0;
+	for (; i + 16 <= length; i += 16) {
+		__m128i chunk = _mm_loadu_si128((const __m128i*)(buffer + i));
+		__m128i matches = _mm_setzero_si128();
+		for (int j = 0; j < setLength; j++) {
+			matches = _mm_or_si128(matches, _mm_cmpeq_epi8(chunk, needles[j]));
+		}
+		unsigned int mask = (unsigned int)_mm_movemask_epi8(matches);
+		if (mask != 0) { return i + countTrailingZeros(mask); }
+	}
+	return i + findAnyOfScalar(buffer + i, length - i, set, setLength);
+}
+
+TARGET_SSE2 static uint64_t maskAnyOfSSE2(const char* buffer, int length, const char* set, int setLength)
+{
+	__m128i needles[MAX_SIMD_SET_LENGTH];
+	for (int j = 0; j < setLength; j++) { needles[j] = _mm_set1_epi8(set[j]); }
+
+	uint64_t mask = 0;
+	int i = 0;
+	for (; i + 16 <= length; i += 16) {
+		__m128i chunk = _mm_loadu_si128((const __m128i*)(buffer + i));
+		__m128i matches = _mm_setzero_si128();
+		for (int j = 0; j < setLength; j++) {
+			matches = _mm_or_si128(matches, _mm_cmpeq_epi8(chunk, needles[j]));
+		}
+		mask |= (uint64_t)(unsigned int)_mm_movemask_epi8(matches) << i;
+	}
+	if (i < length) { mask |= maskAnyOfScalar(buffer + i, length - i, set, setLength) << i; }
+	return mask;
+}
+
+// Compares two blocks at once, one for the first character and one for the
+// last, so that only the positions where both line up are left in the mask.
+TARGET_SSE2 static size_t findPairSSE2(const char* buffer, size_t length, char first, char last, size_t distance)
+{
+	const __m128i firsts = _mm_set1_epi8(first);
+	const __m128i lasts = _mm_set1_epi8(last);
+	size_t i = 0;
+	for (; distance < length && i + 16 <= length - distance; i += 16) {
+		__m128i firstChunk = _mm_loadu_si128((const __m128i*)(buffer + i));
+		__m128i lastChunk = _mm_loadu_si128((const __m128i*)(buffer + i + distance));
+		unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(
+			_mm_cmpeq_epi8(firstChunk, firsts), _mm_cmpeq_epi8(lastChunk, lasts)));
+		if (mask != 0) { return i + countTrailingZeros(mask); }
+	}
+	return i + findPairScalar(buffer + i, length - i, first, last, distance);
+}
+
+// Returns a mask of which of the 16 characters are *not* whitespace or tabs.
+TARGET_SSE2 static unsigned int nonWhitespaceMaskSSE2(const char* buffer)
+{
+	__m128i chunk = _mm_loadu_si128((const __m128i*)buffer);
+	__m128i whitespace = _mm_or_si128(
+		_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')),
+		_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')));
+	return ~(unsigned int)_mm_movemask_epi8(whitespace) & 0xFFFF;
+}
+
+TARGET_SSE2 static size_t skipWhitespaceLeftSSE2(const char* buffer, size_t length)
+{
+	size_t i = 0;
+	for (; i + 16 <= length; i += 16) {
+		unsigned int mask = nonWhitespaceMaskSSE2(buffer + i);
+		if (mask != 0) { return i + countTrailingZeros(mask); }
+	}
+	return i + skipWhitespaceLeftScalar(buffer + i, length - i);
+}
+
+TARGET_SSE2 static size_t skipWhitespaceRightSSE2(const char* buffer, size_t length)
+{
+	for (; length >= 16; length -= 16) {
+		unsigned int mask = nonWhitespaceMaskSSE2(buffer + length - 16);
+		if (mask != 0) { return length - 16 + highestSetBit(mask) + 1; }
+	}
+	return skipWhitespaceRightScalar(buffer, length);
+}
+
+TARGET_SSE2 static size_t countCharSSE2(const char* buffer, size_t length, char c)
+{
+	const __m128i needle = _mm_set1_epi8(c);
+	uint64_t count = 0;
+	size_t i = 0;
+	while (i + 16 <= length) {
+		// Each match is -1, so subtracting the comparison counts matches in
+		// each byte. A byte can only count up to 255 before it overflows, so
+		// every 255 chunks the bytes are summed up and the counts are reset.
+		__m128i counts = _mm_setzero_si128();
+		for (int chunks = 0; chunks < 255 && i + 16 <= length; chunks++, i += 16) {
+			__m128i chunk = _mm_loadu_si128((const __m128i*)(buffer + i));
+			counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(chunk, needle));
+		}
+		uint64_t sums[2];
+		_mm_storeu_si128((__m128i*)sums, _mm_sad_epu8(counts, _mm_setzero_si128()));
+		count += sums[0] + sums[1];
+	}
+	return (size_t)count + countCharScalar(buffer + i, length - i, c);
+}
+
+// AVX2 checks 32 characters at a time, and hands whatever is left over
+// to the SSE2 implementation, which AVX2 CPUs always support. The upper
+// halves of the AVX registers are cleared first, since running SSE2 code
+// while they're in use can cost hundreds of cycles on some CPUs, which is
+// more than the whole search takes for short buffers.
+
+TARGET_AVX2 static size_t findCharAVX2(const char* buffer, size_t length, char c)
+{
+	const __m256i needle = _mm256_set1_epi8(c);
+	size_t i = 0;
+	for (; i + 32 <= length; i += 32) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i*)(buffer + i));
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle));
+		if (mask != 0) { return i + countTrailingZeros(mask); }
+	}
+	_mm256_zeroupper();
+	return i + findCharSSE2(buffer + i, length - i, c);
+}
+
+TARGET_AVX2 static size_t findAnyOfAVX2(const char* buffer, size_t length, const char* set, int setLength)
+{
+	if (setLength > MAX_SIMD_SET_LENGTH) { return findAnyOfScalar(buffer, length, set, setLength); }
+
+	__m256i needles[MAX_SIMD_SET_LENGTH];
+	for (int j = 0; j < setLength; j++) { needles[j] = _mm256_set1_epi8(set[j]); }
+
+	size_t i = 0;
+	for (; i + 32 <= length; i += 32) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i*)(buffer + i));
+		__m256i matches = _mm256_setzero_si256();
+		for (int j = 0; j < setLength; j++) {
+			matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(chunk, needles[j]));
+		}
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(matches);
+		if (mask != 0) { return i + countTrailingZeros(mask); }
+	}
+	_mm256_zeroupper();
+	return i + findAnyOfSSE2(buffer + i, length - i, set, setLength);
+}
+
+TARGET_AVX2 static uint64_t maskAnyOfAVX2(const char* buffer, int length, const char* set, int setLength)
+{
+	__m256i needles[MAX_SIMD_SET_LENGTH];
+	for (int j = 0; j < setLength; j++) { needles[j] = _mm256_set1_epi8(set[j]); }
+
+	uint64_t mask = 0;
+	int i = 0;
+	for (; i + 32 <= length; i += 32) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i*)(buffer + i));
+		__m256i matches = _mm256_setzero_si256();
+		for (int j = 0; j < setLength; j++) {
+			matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(chunk, needles[j]));
+		}
+		mask |= (uint64_t)(unsigned int)_mm256_movemask_epi8(matches) << i;
+	}
+	_mm256_zeroupper();
+	if (i < length) { mask |= maskAnyOfSSE2(buffer + i, length - i, set, setLength) << i; }
+	return mask;
+}
+
+TARGET_AVX2 static size_t findPairAVX2(const char* buffer, size_t length, char first, char last, size_t distance)
+{
+	const __m256i firsts = _mm256_set1_epi8(first);
+	const __m256i lasts = _mm256_set1_epi8(last);
+	size_t i = 0;
+	for (; distance < length && i + 32 <= length - distance; i += 32) {
+		__m256i firstChunk = _mm256_loadu_si256((const __m256i*)(buffer + i));
+		__m256i lastChunk = _mm256_loadu_si256((const __m256i*)(buffer + i + distance));
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(
+			_mm256_cmpeq_epi8(firstChunk, firsts), _mm256_cmpeq_epi8(lastChunk, lasts)));
+		if (mask != 0) { return i + countTrailingZeros(mask); }
+	}
+	_mm256_zeroupper();
+	return i + findPairSSE2(buffer + i, length - i, first, last, distance);
+}
+
+// Returns a mask of which of the 32 characters are *not* whitespace or tabs.
+TARGET_AVX2 static unsigned int nonWhitespaceMaskAVX2(const char* buffer)
+{
+	__m256i chunk = _mm256_loadu_si256((const __m256i*)buffer);
+	__m256i whitespace = _mm256_or_si256(
+		_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')),
+		_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t')));
+	return ~(unsigned int)_mm256_movemask_epi8(whitespace);
+}
+
+TARGET_AVX2 static size_t skipWhitespaceLeftAVX2(const char* buffer, size_t length)
+{
+	size_t i = 0;
+	for (; i + 32 <= length; i += 32) {
+		unsigned int mask = nonWhitespaceMaskAVX2(buffer + i);
+		if (mask != 0) { return i + countTrailingZeros(mask); }
+	}
+	_mm256_zeroupper();
+	return i + skipWhitespaceLeftSSE2(buffer + i, length - i);
+}
+
+TARGET_AVX2 static size_t skipWhitespaceRightAVX2(const char* buffer, size_t length)
+{
+	for (; length >= 32; length -= 32) {
+		unsigned int mask = nonWhitespaceMaskAVX2(buffer + length - 32);
+		if (mask != 0) { return length - 32 + highestSetBit(mask) + 1; }
+	}
+	_mm256_zeroupper();
+	return skipWhitespaceRightSSE2(buffer, length);
+}
+
+TARGET_AVX2 static size_t countCharAVX2(const char* buffer, size_t length, char c)
+{
+	const __m256i needle = _mm256_set1_epi8(c);
+	uint64_t count = 0;
+	size_t i = 0;
+	while (i + 32 <= length) {
+		__m256i counts = _mm256_setzero_si256();
+		for (int chunks = 0; chunks < 255 && i + 32 <= length; chunks++, i += 32) {
+			__m256i chunk = _mm256_loadu_si256((const __m256i*)(buffer + i));
+			counts = _mm256_sub_epi8(counts, _mm256_cmpeq_epi8(chunk, needle));
+		}
+		uint64_t sums[4];
+		_mm256_storeu_si256((__m256i*)sums, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+		count += sums[0] + sums[1] + sums[2] + sums[3];
+	}
+	_mm256_zeroupper();
+	return (size_t)count + countCharSSE2(buffer + i, length - i, c);
+}
+
+// Runs the CPUID instruction for the given leaf and subleaf.
+static void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int registers[4])
+{
+#ifdef _MSC_VER
+	__cpuidex((int*)registers, (int)leaf, (int)subleaf);
+#else
+	__cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+static bool cpuSupportsSSE2()
+{
+	unsigned int registers[4];
+	cpuid(0, 0, registers);
+	if (registers[0] < 1) { return false; }
+	cpuid(1, 0, registers);
+	return (registers[3] & (1u << 26)) != 0;
+}
+
+static bool cpuSupportsAVX2()
+{
+	unsigned int registers[4];
+	cpuid(0, 0, registers);
+	unsigned int maxLeaf = registers[0];
+	if (maxLeaf < 7) { return false; }
+
+	// The CPU has to support AVX, and the operating system has to save the
+	// AVX registers when switching threads (OSXSAVE + XGETBV), otherwise
+	// AVX2 instructions can't be used even if the CPU supports them.
+	cpuid(1, 0, registers);
+	bool osxsave = (registers[2] & (1u << 27)) != 0;
+	bool avx = (registers[2] & (1u << 28)) != 0;
+	if (!osxsave || !avx) { return false; }
+#ifdef _MSC_VER
+	unsigned long long xcr0 = _xgetbv(0);
+#else
+	unsigned int xcr0Low, xcr0High;
+	__asm__ volatile("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+	unsigned long long xcr0 = ((unsigned long long)xcr0High << 32) | xcr0Low;
+#endif
+	if ((xcr0 & 0x6) != 0x6) { return false; }
+
+	cpuid(7, 0, registers);
+	return (registers[1] & (1u << 5)) != 0;
+}
+
+#endif // EWELBORN_X86
+
+struct scanKernels {
+	size_t(*findChar)(const char*, size_t, char);
+	size_t(*findAnyOf)(const char*, size_t, const char*, int);
+	size_t(*skipWhitespaceLeft)(const char*, size_t);
+	size_t(*skipWhitespaceRight)(const char*, size_t);
+	size_t(*countChar)(const char*, size_t, char);
+	// Finds the first position where buffer[i] == first and buffer[i + distance] == last
+	size_t(*findPair)(const char*, size_t, char, char, size_t);
+	// Returns a mask of which of the (at most 64) characters are in a set of
+	// at most MAX_SIMD_SET_LENGTH characters
+	uint64_t(*maskAnyOf)(const char*, int, const char*, int);
+};
+
+// Indexed by ewelborn_scanImplementation
+static const struct scanKernels scanKernelTable[] = {
+	{ findCharScalar, findAnyOfScalar, skipWhitespaceLeftScalar, skipWhitespaceRightScalar, countCharScalar, findPairScalar, maskAnyOfScalar },
+#ifdef EWELBORN_X86
+	{ findCharSSE2, findAnyOfSSE2, skipWhitespaceLeftSSE2, skipWhitespaceRightSSE2, countCharSSE2, findPairSSE2, maskAnyOfSSE2 },
+	{ findCharAVX2, findAnyOfAVX2, skipWhitespaceLeftAVX2, skipWhitespaceRightAVX2, countCharAVX2, findPairAVX2, maskAnyOfAVX2 },
+#endif
+};
+
+// The implementation (scanKernelTable entry) that the scanning functions use,
+// or -1 until one has been picked. It's picked the first time that it's
+// needed, which can happen on any thread, so it's only ever read and written
+// atomically.
+static volatile long long currentScanImplementation = -1;
+
+bool ewelborn_scan_isSupported(ewelborn_scanImplementation implementation)
+{
+	switch (implementation) {
+	case EWELBORN_SCAN_SCALAR:
+		return true;
+#ifdef EWELBORN_X86
+	case EWELBORN_SCAN_SSE2:
+		return cpuSupportsSSE2();
+	case EWELBORN_SCAN_AVX2:
+		return cpuSupportsSSE2() && cpuSupportsAVX2();
+#endif
+	default:
+		return false;
+	}
+}
+
+// Returns the kernels for the current implementation, and picks the fastest
+// implementation if one hasn't been picked yet.
+static const struct scanKernels* getScanKernels()
+{
+	long long implementation = atomicLoadAcquire64(&currentScanImplementation);
+	if (implementation < 0) {
+		long long fastest = EWELBORN_SCAN_SCALAR;
+		if (ewelborn_scan_isSupported(EWELBORN_SCAN_AVX2)) {
+			fastest = EWELBORN_SCAN_AVX2;
+		} else if (ewelborn_scan_isSupported(EWELBORN_SCAN_SSE2)) {
+			fastest = EWELBORN_SCAN_SSE2;
+		}
+
+		// Another thread may have picked (or set) one in the meantime, in
+		// which case that one is kept
+		implementation = -1;
+		if (atomicCompareExchange64(&currentScanImplementation, &implementation, fastest)) {
+			implementation = fastest;
+		}
+	}
+	return &scanKernelTable[implementation];
+}
+
+ewelborn_scanImplementation ewelborn_scan_getImplementation()
+{
+	return (ewelborn_scanImplementation)(getScanKernels() - scanKernelTable);
+}
+
+bool ewelborn_scan_setImplementation(ewelborn_scanImplementation implementation)
+{
+	if (ewelborn_scan_isSupported(implementation) == false) { return false; }
+	atomicStoreRelease64(&currentScanImplementation, implementation);
+	return true;
+}
+
+size_t ewelborn_scan_findChar(const char* buffer, size_t length, char c)
+{
+	return getScanKernels()->findChar(buffer, length, c);
+}
+
+static size_t scanFindPair(const char* buffer, size_t length, char first, char last, size_t distance)
+{
+	return getScanKernels()->findPair(buffer, length, first, last, distance);
+}
+
+static uint64_t scanMaskAnyOf(const char* buffer, int length, const char* set, int setLength)
+{
+	return getScanKernels()->maskAnyOf(buffer, length, set, setLength);
+}
+
+size_t ewelborn_scan_find(const char* buffer, size_t length, const char* needle, size_t needleLength)
+{
+	struct substringSearch search;
+	substringSearchPrepare(&search, needle, needleLength);
+	return substringSearchFind(&search, buffer, length);
+}
+
+size_t ewelborn_scan_findAnyOf(const char* buffer, size_t length, const char* set, int setLength)
+{
+	// A set of one character is just a findChar
+	if (setLength == 1) { return ewelborn_scan_findChar(buffer, length, set[0]); }
+	if (setLength <= 0) { return length; }
+	return getScanKernels()->findAnyOf(buffer, length, set, setLength);
+}
+
+size_t ewelborn_scan_skipWhitespaceLeft(const char* buffer, size_t length)
+{
+	return getScanKernels()->skipWhitespaceLeft(buffer, length);
+}
+
+size_t ewelborn_scan_skipWhitespaceRight(const char* buffer, size_t length)
+{
+	return getScanKernels()->skipWhitespaceRight(buffer, length);
+}
+
+size_t ewelborn_scan_countChar(const char* buffer, size_t length, char c)
+{
+	return getScanKernels()->countChar(buffer, length, c);
+}
+
+#define THREAD_POOL_STARTING_DEQUE_SIZE 64
+
+struct poolTask {
+	void(*function)(void*);
+	void* argument;
+};
+
+// Every worker's tasks are kept in a ring buffer. The worker takes tasks
+// from the bottom, so it works on whatever it submitted most recently, while
+// other threads steal from the top, where the oldest (and usually largest)
+// tasks are.
+struct poolDeque {
+	struct mutex lock;
+	struct poolTask* tasks;
+	size_t capacity; // Always a power of two
+	size_t top;
+	size_t bottom;
+};
+
+struct poolWorker {
+	ewelborn_threadPool* pool;
+	int index;
+	struct thread thread;
+	struct poolDeque deque;
+};
+
+struct ewelborn_threadPool {
+	struct poolWorker* workers;
+	int workerCount;
+	volatile long pending; // Tasks that have been submitted, but haven't finished
+	volatile long queued; // Tasks that are waiting in a deque
+	volatile long sleepers; // Workers that are waiting for tasks
+	volatile long nextDeque; // Deque that the next task from outside of the pool goes to
+	volatile long stopping;
+	struct mutex lock;
+	struct condition workAvailable;
+	struct condition allDone;
+};
+
+// The worker that's running on the current thread, if any
+static THREAD_LOCAL struct poolWorker* currentWorker = NULL;
+
+static bool poolDequePush(struct poolDeque* deque, struct poolTask task)
+{
+	mutexLock(&deque->lock);
+	if (deque->bottom - deque->top == deque->capacity) {
+		// Unroll the ring buffer into a buffer twice as large
+		size_t capacity = deque->capacity * EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT;
+		struct poolTask* tasks = allocateFrom(NULL, sizeof(struct poolTask) * capacity, EWELBORN_ALLOCATION_THREADING);
+		if (tasks == NULL) {
+			mutexUnlock(&deque->lock);
+			return false;
+		}
+		for (size_t i = deque->top; i != deque->bottom; i++) {
+			tasks[i - deque->top] = deque->tasks[i & (deque->capacity - 1)];
+		}
+		releaseTo(NULL, deque->tasks, EWELBORN_ALLOCATION_THREADING);
+		deque->tasks = tasks;
+		deque->bottom -= deque->top;
+		deque->top = 0;
+		deque->capacity = capacity;
+	}
+	deque->tasks[deque->bottom & (deque->capacity - 1)] = task;
+	deque->bottom++;
+	mutexUnlock(&deque->lock);
+	return true;
+}
+
+static bool poolDequePop(struct poolDeque* deque, struct poolTask* task)
+{
+	mutexLock(&deque->lock);
+	bool found = deque->bottom != deque->top;
+	if (found) {
+		deque->bottom--;
+		*task = deque->tasks[deque->bottom & (deque->capacity - 1)];
+	}
+	mutexUnlock(&deque->lock);
+	return found;
+}
+
+static bool poolDequeSteal(struct poolDeque* deque, struct poolTask* task)
+{
+	mutexLock(&deque->lock);
+	bool found = deque->bottom != deque->top;
+	if (found) {
+		*task = deque->tasks[deque->top & (deque->capacity - 1)];
+		deque->top++;
+	}
+	mutexUnlock(&deque->lock);
+	return found;
+}
+
+// Returns the current thread's worker if it belongs to the given pool
+static struct poolWorker* poolCurrentWorker(ewelborn_threadPool* pool)
+{
+	return currentWorker != NULL && currentWorker->pool == pool ? currentWorker : NULL;
+}
+
+// Takes the next task for the given worker (or for a thread outside of the
+// pool if self is null): first from its own deque, and then from any other
+// worker's deque. Returns true if a task was found, false otherwise.
+static bool poolTakeTask(ewelborn_threadPool* pool, struct poolWorker* self, struct poolTask* task)
+{
+	if (atomicLoad(&pool->queued) == 0) { return false; }
+
+	bool found = self != NULL && poolDequePop(&self->deque, task);
+	int first = self != NULL ? self->index + 1 : 0;
+	for (int i = 0; i < pool->workerCount && found == false; i++) {
+		struct poolWorker* victim = &pool->workers[(first + i) % pool->workerCount];
+		if (victim != self) { found = poolDequeSteal(&victim->deque, task); }
+	}
+
+	if (found) { atomicDecrement(&pool->queued); }
+	return found;
+}
+
+static void poolRunTask(ewelborn_threadPool* pool, struct poolTask* task)
+{
+	task->function(task->argument);
+	if (atomicDecrement(&pool->pending) == 0) {
+		mutexLock(&pool->lock);
+		conditionBroadcast(&pool->allDone);
+		mutexUnlock(&pool->lock);
+	}
+}
+
+static void poolWorkerRun(void* parameter)
+{
+	struct poolWorker* self = parameter;
+	ewelborn_threadPool* pool = self->pool;
+	currentWorker = self;
+
+	while (true) {
+		struct poolTask task;
+		if (poolTakeTask(pool, self, &task)) {
+			poolRunTask(pool, &task);
+			continue;
+		}
+
+		// Sleep until there's more work. Submitting a task bumps queued before
+		// checking for sleepers, and sleeping bumps sleepers before checking
+		// queued, so a task can't be submitted without waking anyone up.
+		mutexLock(&pool->lock);
+		atomicIncrement(&pool->sleepers);
+		while (atomicLoad(&pool->queued) == 0 && atomicLoad(&pool->stopping) == 0) {
+			conditionWait(&pool->workAvailable, &pool->lock);
+		}
+		atomicDecrement(&pool->sleepers);
+		bool stop = atomicLoad(&pool->queued) == 0 && atomicLoad(&pool->stopping) != 0;
+		mutexUnlock(&pool->lock);
+		if (stop) { break; }
+	}
+
+	currentWorker = NULL;
+}
+
+// Stops the first workerCount workers, which have all been started, and frees
+// the thread pool.
+static void poolStopAndFree(ewelborn_threadPool* pool, int workerCount)
+{
+	mutexLock(&pool->lock);
+	atomicStore(&pool->stopping, 1);
+	conditionBroadcast(&pool->workAvailable);
+	mutexUnlock(&pool->lock);
+
+	for (int i = 0; i < workerCount; i++) {
+		threadJoin(&pool->workers[i].thread);
+	}
+	for (int i = 0; i < pool->workerCount; i++) {
+		mutexFree(&pool->workers[i].deque.lock);
+		releaseTo(NULL, pool->workers[i].deque.tasks, EWELBORN_ALLOCATION_THREADING);
+	}
+	conditionFree(&pool->allDone);
+	conditionFree(&pool->workAvailable);
+	mutexFree(&pool->lock);
+	releaseTo(NULL, pool->workers, EWELBORN_ALLOCATION_THREADING);
+	releaseTo(NULL, pool, EWELBORN_ALLOCATION_THREADING);
+}
+
+ewelborn_threadPool* ewelborn_threadPool_initialize(int threadCount)
+{
+	if (threadCount <= 0) { threadCount = ewelborn_getProcessorCount(); }
+
+	ewelborn_threadPool* pool = allocateFrom(NULL, sizeof(ewelborn_threadPool), EWELBORN_ALLOCATION_THREADING);
+	if (pool == NULL) { return NULL; }
+	memset(pool, 0, sizeof(ewelborn_threadPool));
+	pool->workers = allocateFrom(NULL, sizeof(struct poolWorker) * threadCount, EWELBORN_ALLOCATION_THREADING);
+	if (pool->workers == NULL) { goto CLEAN_UP_AND_CRASH; }
+	memset(pool->workers, 0, sizeof(struct poolWorker) * threadCount);
+	if (mutexInitialize(&pool->lock) == false) { goto CLEAN_UP_AND_CRASH; }
+	if (conditionInitialize(&pool->workAvailable) == false) {
+		mutexFree(&pool->lock);
+		goto CLEAN_UP_AND_CRASH;
+	}
+	if (conditionInitialize(&pool->allDone) == false) {
+		conditionFree(&pool->workAvailable);
+		mutexFree(&pool->lock);
+		goto CLEAN_UP_AND_CRASH;
+	}
+
+	// Set up every deque before any worker starts, since workers steal from
+	// each other right away.
+	for (int i = 0; i < threadCount; i++) {
+		struct poolWorker* worker = &pool->workers[i];
+		worker->pool = pool;
+		worker->index = i;
+		worker->deque.capacity = THREAD_POOL_STARTING_DEQUE_SIZE;
+		worker->deque.tasks = allocateFrom(NULL, sizeof(struct poolTask) * worker->deque.capacity, EWELBORN_ALLOCATION_THREADING);
+		if (worker->deque.tasks == NULL || mutexInitialize(&worker->deque.lock) == false) {
+			releaseTo(NULL, worker->deque.tasks, EWELBORN_ALLOCATION_THREADING);
+			worker->deque.tasks = NULL;
+			pool->workerCount = i;
+			poolStopAndFree(pool, 0);
+			return NULL;
+		}
+		pool->workerCount = i + 1;
+	}
+
+	// Pick the scanning kernels now, instead of on every worker at once
+	ewelborn_scan_getImplementation();
+
+	for (int i = 0; i < threadCount; i++) {
+		if (threadStart(&pool->workers[i].thread, poolWorkerRun, &pool->workers[i]) == false) {
+			poolStopAndFree(pool, i);
+			return NULL;
+		}
+	}
+
+	return pool;
+
+CLEAN_UP_AND_CRASH:
+	releaseTo(NULL, pool->workers, EWELBORN_ALLOCATION_THREADING);
+	releaseTo(NULL, pool, EWELBORN_ALLOCATION_THREADING);
+	return NULL;
+}
+
+int ewelborn_threadPool_getThreadCount(ewelborn_threadPool* pool)
+{
+	return pool->workerCount;
+}
+
+bool ewelborn_threadPool_submit(ewelborn_threadPool* pool, void(*function)(void*), void* argument)
+{
+	struct poolTask task = { function, argument };
+
+	// Workers keep their own tasks, so they can work on them while they're
+	// still in the cache. Everyone else spreads their tasks between workers.
+	struct poolWorker* self = poolCurrentWorker(pool);
+	struct poolWorker* target = self != NULL ? self :
+		&pool->workers[(unsigned long)atomicIncrement(&pool->nextDeque) % pool->workerCount];
+
+	atomicIncrement(&pool->pending);
+	if (poolDequePush(&target->deque, task) == false) {
+		atomicDecrement(&pool->pending);
+		return false;
+	}
+	atomicIncrement(&pool->queued);
+
+	if (atomicLoad(&pool->sleepers) > 0) {
+		mutexLock(&pool->lock);
+		conditionSignal(&pool->workAvailable);
+		mutexUnlock(&pool->lock);
+	}
+	return true;
+}
+
+void ewelborn_threadPool_wait(ewelborn_threadPool* pool)
+{
+	struct poolWorker* self = poolCurrentWorker(pool);
+	while (atomicLoad(&pool->pending) > 0) {
+		// Help out instead of sitting idle
+		struct poolTask task;
+		if (poolTakeTask(pool, self, &task)) {
+			poolRunTask(pool, &task);
+			continue;
+		}
+
+		// Everything left is already running, so wait for it to finish
+		mutexLock(&pool->lock);
+		if (atomicLoad(&pool->pending) > 0 && atomicLoad(&pool->queued) == 0) {
+			conditionWait(&pool->allDone, &pool->lock);
+		}
+		mutexUnlock(&pool->lock);
+	}
+}
+
+struct parallelForCall {
+	ewelborn_threadPool* pool;
+	void(*function)(void*, size_t, size_t);
+	void* context;
+	size_t grainSize;
+	volatile long outstanding; // Pieces of the range that have been split off, but haven't finished
+};
+
+struct parallelForPiece {
+	struct parallelForCall* call;
+	size_t start;
+	size_t end;
+};
+
+static void parallelForPieceRun(void* parameter);
+
+// Runs the range, splitting the upper half off for other threads to take for
+// as long as the range is larger than the grain size, and the pool doesn't
+// already have a task queued for every worker.
+static void parallelForRun(struct parallelForCall* call, size_t start, size_t end)
+{
+	ewelborn_threadPool* pool = call->pool;
+	while (end - start > call->grainSize && atomicLoad(&pool->queued) < pool->workerCount) {
+		size_t middle = start + (end - start) / 2;
+		struct parallelForPiece* piece = allocateFrom(NULL, sizeof(struct parallelForPiece), EWELBORN_ALLOCATION_THREADING);
+		if (piece == NULL) { break; }
+		piece->call = call;
+		piece->start = middle;
+		piece->end = end;
+
+		atomicIncrement(&call->outstanding);
+		if (ewelborn_threadPool_submit(pool, parallelForPieceRun, piece) == false) {
+			atomicDecrement(&call->outstanding);
+			releaseTo(NULL, piece, EWELBORN_ALLOCATION_THREADING);
+			break;
+		}
+		end = middle;
+	}
+
+	call->function(call->context, start, end);
+}
+
+static void parallelForPieceRun(void* parameter)
+{
+	struct parallelForPiece* piece = parameter;
+	struct parallelForCall* call = piece->call;
+	size_t start = piece->start;
+	size_t end = piece->end;
+	releaseTo(NULL, piece, EWELBORN_ALLOCATION_THREADING);
+
+	parallelForRun(call, start, end);
+	// The call may end as soon as this is decremented, so it can't be used
+	// after this.
+	atomicDecrement(&call->outstanding);
+}
+
+void ewelborn_threadPool_parallelFor(ewelborn_threadPool* pool, size_t start, size_t end, size_t grainSize,
+	void(*function)(void* context, size_t rangeStart, size_t rangeEnd), void* context)
+{
+	if (end <= start) { return; }
+
+	// Without a grain size, aim for several pieces per worker, so that
+	// workers that finish early have something left to steal.
+	if (grainSize == 0) { grainSize = (end - start) / ((size_t)pool->workerCount * 8); }
+	if (grainSize == 0) { grainSize = 1; }
+
+	struct parallelForCall call = { pool, function, context, grainSize, 0 };
+	parallelForRun(&call, start, end);
+
+	// Help with the pieces that were split off until all of them are done.
+	// This runs other tasks too, but it never waits on them.
+	struct poolWorker* self = poolCurrentWorker(pool);
+	while (atomicLoad(&call.outstanding) > 0) {
+		struct poolTask task;
+		if (poolTakeTask(pool, self, &task)) {
+			poolRunTask(pool, &task);
+		}
+		else {
+			threadYield();
+		}
+	}
+}
+
+struct parallelTraverseCall {
+	void** elements;
+	void(*f)(void*);
+	void*(*map)(void*);
+	void** results;
+};
+
+static void parallelTraverseRange(void* context, size_t start, size_t end)
+{
+	struct parallelTraverseCall* call = context;
+	for (size_t i = start; i < end; i++) {
+		call->f(call->elements[i]);
+	}
+}
+
+static void parallelMapRange(void* context, size_t start, size_t end)
+{
+	struct parallelTraverseCall* call = context;
+	for (size_t i = start; i < end; i++) {
+		call->results[i] = call->map(call->elements[i]);
+	}
+}
+
+void ewelborn_threadPool_parallelTraverse(ewelborn_threadPool* pool, ewelborn_dynamicArray* dynamicArray, void(*f)(void*))
+{
+	struct parallelTraverseCall call = { dynamicArray->array, f, NULL, NULL };
+	ewelborn_threadPool_parallelFor(pool, 0, dynamicArray->elements, 0, parallelTraverseRange, &call);
+}
+
+ewelborn_dynamicArray* ewelborn_threadPool_parallelMap(ewelborn_threadPool* pool, ewelborn_dynamicArray* dynamicArray, void*(*f)(void*))
+{
+	ewelborn_dynamicArray* results = ewelborn_dynamicArray_initialize();
+	if (results == NULL) { return NULL; }
+	if (dynamicArrayReserve(results, dynamicArray->elements) == false) {
+		ewelborn_dynamicArray_free(results);
+		return NULL;
+	}
+
+	struct parallelTraverseCall call = { dynamicArray->array, NULL, f, results->array };
+	ewelborn_threadPool_parallelFor(pool, 0, dynamicArray->elements, 0, parallelMapRange, &call);
+	results->elements = dynamicArray->elements;
+	return results;
+}
+
+void ewelborn_threadPool_free(ewelborn_threadPool* pool)
+{
+	ewelborn_threadPool_wait(pool);
+	poolStopAndFree(pool, pool->workerCount);
+}
+
+#define RING_BUFFER_CACHE_LINE_SIZE 64
+// How many times a waiting thread checks the ring buffer before it goes to
+// sleep (with EWELBORN_RING_BUFFER_BLOCK)
+#define RING_BUFFER_SPIN_LIMIT 1024
+// How many times a spinning thread checks the ring buffer between yields,
+// so that it doesn't starve the thread that it's waiting for
+#define RING_BUFFER_SPINS_PER_YIELD 64
+
+// A slot in a multi-producer multi-consumer ring buffer. The sequence number
+// says whose turn it is: a producer may fill the slot for position pos once
+// sequence == pos, and a consumer may empty it once sequence == pos + 1.
+struct ringBufferCell {
+	volatile long long sequence;
+	void* element;
+};
+
+// The producers' and consumers' counters live on separate cache lines, so
+// that pushing doesn't keep taking the cache line away from the consumers,
+// and vice versa.
+struct ewelborn_ringBuffer {
+	ewelborn_ringBufferKind kind;
+	long long capacity;
+	long long mask;
+	void** elements; // Used by SPSC ring buffers
+	struct ringBufferCell* cells; // Used by MPMC ring buffers
+	char producerPadding[RING_BUFFER_CACHE_LINE_SIZE];
+	volatile long long tail; // Position of the next element to be pushed
+	long long cachedHead; // Last head that the producer saw (SPSC)
+	char consumerPadding[RING_BUFFER_CACHE_LINE_SIZE];
+	volatile long long head; // Position of the next element to be popped
+	long long cachedTail; // Last tail that the consumer saw (SPSC)
+	char waitingPadding[RING_BUFFER_CACHE_LINE_SIZE];
+	volatile long closed;
+	volatile long sleepers; // Threads that are waiting on changed
+	struct mutex lock;
+	struct condition changed;
+};
+
+// Pushes up to count elements without waiting. Returns the number of
+// elements that were pushed.
+static int ringBufferTryPush(ewelborn_ringBuffer* ringBuffer, void** elements, int count)
+{
+	if (ringBuffer->kind == EWELBORN_RING_BUFFER_SPSC) {
+		// Only look at the consumer's cache line when the ring buffer looks full
+		long long tail = atomicLoadRelaxed64(&ringBuffer->tail);
+		long long room = ringBuffer->capacity - (tail - ringBuffer->cachedHead);
+		if (room < count) {
+			ringBuffer->cachedHead = atomicLoadAcquire64(&ringBuffer->head);
+			room = ringBuffer->capacity - (tail - ringBuffer->cachedHead);
+		}
+		int pushed = room < count ? (int)room : count;
+		for (int i = 0; i < pushed; i++) {
+			ringBuffer->elements[(tail + i) & ringBuffer->mask] = elements[i];
+		}
+		if (pushed > 0) { atomicStoreRelease64(&ringBuffer->tail, tail + pushed); }
+		return pushed;
+	}
+
+	long long position = atomicLoadRelaxed64(&ringBuffer->tail);
+	while (true) {
+		struct ringBufferCell* cell = &ringBuffer->cells[position & ringBuffer->mask];
+		long long difference = atomicLoadAcquire64(&cell->sequence) - position;
+		if (difference < 0) {
+			// The consumers haven't emptied this slot yet
+			return 0;
+		} else if (difference > 0) {
+			// Another producer took this position
+			position = atomicLoadRelaxed64(&ringBuffer->tail);
+			continue;
+		}
+
+		// Claim as many empty slots in a row as we need with a single swap
+		int claimed = 1;
+		while (claimed < count &&
+			atomicLoadAcquire64(&ringBuffer->cells[(position + claimed) & ringBuffer->mask].sequence) == position + claimed) {
+			claimed++;
+		}
+		if (atomicCompareExchange64(&ringBuffer->tail, &position, position + claimed) == false) { continue; }
+
+		for (int i = 0; i < claimed; i++) {
+			cell = &ringBuffer->cells[(position + i) & ringBuffer->mask];
+			cell->element = elements[i];
+			atomicStoreRelease64(&cell->sequence, position + i + 1);
+		}
+		return claimed;
+	}
+}
+
+// Pops up to maxCount elements without waiting. Returns the number of
+// elements that were popped.
+static int ringBufferTryPop(ewelborn_ringBuffer* ringBuffer, void** elements, int maxCount)
+{
+	if (ringBuffer->kind == EWELBORN_RING_BUFFER_SPSC) {
+		long long head = atomicLoadRelaxed64(&ringBuffer->head);
+		long long available = ringBuffer->cachedTail - head;
+		if (available < maxCount) {
+			ringBuffer->cachedTail = atomicLoadAcquire64(&ringBuffer->tail);
+			available = ringBuffer->cachedTail - head;
+		}
+		int popped = available < maxCount ? (int)available : maxCount;
+		for (int i = 0; i < popped; i++) {
+			elements[i] = ringBuffer->elements[(head + i) & ringBuffer->mask];
+		}
+		if (popped > 0) { atomicStoreRelease64(&ringBuffer->head, head + popped); }
+		return popped;
+	}
+
+	long long position = atomicLoadRelaxed64(&ringBuffer->head);
+	while (true) {
+		struct ringBufferCell* cell = &ringBuffer->cells[position & ringBuffer->mask];
+		long long difference = atomicLoadAcquire64(&cell->sequence) - (position + 1);
+		if (difference < 0) {
+			// The producers haven't filled this slot yet
+			return 0;
+		} else if (difference > 0) {
+			// Another consumer took this position
+			position = atomicLoadRelaxed64(&ringBuffer->head);
+			continue;
+		}
+
+		int claimed = 1;
+		while (claimed < maxCount &&
+			atomicLoadAcquire64(&ringBuffer->cells[(position + claimed) & ringBuffer->mask].sequence) == position + claimed + 1) {
+			claimed++;
+		}
+		if (atomicCompareExchange64(&ringBuffer->head, &position, position + claimed) == false) { continue; }
+
+		for (int i = 0; i < claimed; i++) {
+			cell = &ringBuffer->cells[(position + i) & ringBuffer->mask];
+			elements[i] = cell->element;
+			// Hand the slot to the producers on the next lap around the ring
+			atomicStoreRelease64(&cell->sequence, position + i + ringBuffer->capacity);
+		}
+		return claimed;
+	}
+}
+
+// Returns true if there's room to push (or something to pop), going by the
+// counters. An MPMC ring buffer can look ready for a moment before the slot
+// is, while another thread is between claiming the slot and filling it.
+static bool ringBufferLooksReady(ewelborn_ringBuffer* ringBuffer, bool pushing)
+{
+	long long size = atomicLoadAcquire64(&ringBuffer->tail) - atomicLoadAcquire64(&ringBuffer->head);
+	return pushing ? size < ringBuffer->capacity : size > 0;
+}
+
+// Wakes up any thread that's sleeping on the ring buffer. Every push or pop
+// makes its change before checking for sleepers, and sleeping bumps sleepers
+// before checking the ring buffer, so nobody sleeps through a change.
+static void ringBufferNotify(ewelborn_ringBuffer* ringBuffer)
+{
+	atomicFence();
+	if (atomicLoad(&ringBuffer->sleepers) > 0) {
+		mutexLock(&ringBuffer->lock);
+		conditionBroadcast(&ringBuffer->changed);
+		mutexUnlock(&ringBuffer->lock);
+	}
+}
+
+// Waits a little while for the ring buffer to change, after a push found it
+// full or a pop found it empty. spins counts how long the caller has been
+// waiting so far.
+static void ringBufferWait(ewelborn_ringBuffer* ringBuffer, bool pushing, ewelborn_ringBufferWait wait, int* spins)
+{
+	(*spins)++;
+	if (wait == EWELBORN_RING_BUFFER_SPIN || *spins < RING_BUFFER_SPIN_LIMIT) {
+		if (*spins % RING_BUFFER_SPINS_PER_YIELD == 0) {
+			threadYield();
+		} else {
+			cpuRelax();
+		}
+		return;
+	}
+
+	mutexLock(&ringBuffer->lock);
+	atomicIncrement(&ringBuffer->sleepers);
+	bool ready = atomicLoad(&ringBuffer->closed) != 0 || ringBufferLooksReady(ringBuffer, pushing);
+	if (ready == false) { conditionWait(&ringBuffer->changed, &ringBuffer->lock); }
+	atomicDecrement(&ringBuffer->sleepers);
+	mutexUnlock(&ringBuffer->lock);
+
+	// Let the thread that's filling (or emptying) the slot finish
+	if (ready) { threadYield(); }
+}
+
+ewelborn_ringBuffer* ewelborn_ringBuffer_initialize(size_t capacity, ewelborn_ringBufferKind kind)
+{
+	if (capacity > ((size_t)1 << 30)) { return NULL; }
+	size_t roundedCapacity = 2;
+	while (roundedCapacity < capacity) { roundedCapacity *= 2; }
+
+	ewelborn_ringBuffer* ringBuffer = allocateFrom(NULL, sizeof(ewelborn_ringBuffer), EWELBORN_ALLOCATION_THREADING);
+	if (ringBuffer == NULL) { return NULL; }
+	memset(ringBuffer, 0, sizeof(ewelborn_ringBuffer));
+	ringBuffer->kind = kind;
+	ringBuffer->capacity = (long long)roundedCapacity;
+	ringBuffer->mask = (long long)roundedCapacity - 1;
+
+	if (kind == EWELBORN_RING_BUFFER_SPSC) {
+		ringBuffer->elements = allocateFrom(NULL, sizeof(void*) * roundedCapacity, EWELBORN_ALLOCATION_THREADING);
+		if (ringBuffer->elements == NULL) { goto CLEAN_UP_AND_CRASH; }
+	} else {
+		ringBuffer->cells = allocateFrom(NULL, sizeof(struct ringBufferCell) * roundedCapacity, EWELBORN_ALLOCATION_THREADING);
+		if (ringBuffer->cells == NULL) { goto CLEAN_UP_AND_CRASH; }
+		for (size_t i = 0; i < roundedCapacity; i++) {
+			ringBuffer->cells[i].sequence = (long long)i;
+			ringBuffer->cells[i].element = NULL;
+		}
+	}
+
+	if (mutexInitialize(&ringBuffer->lock) == false) { goto CLEAN_UP_AND_CRASH; }
+	if (conditionInitialize(&ringBuffer->changed) == false) {
+		mutexFree(&ringBuffer->lock);
+		goto CLEAN_UP_AND_CRASH;
+	}
+	return ringBuffer;
+
+CLEAN_UP_AND_CRASH:
+	releaseTo(NULL, ringBuffer->elements, EWELBORN_ALLOCATION_THREADING);
+	releaseTo(NULL, ringBuffer->cells, EWELBORN_ALLOCATION_THREADING);
+	releaseTo(NULL, ringBuffer, EWELBORN_ALLOCATION_THREADING);
+	return NULL;
+}
+
+bool ewelborn_ringBuffer_push(ewelborn_ringBuffer* ringBuffer, void* element, ewelborn_ringBufferWait wait)
+{
+	return ewelborn_ringBuffer_pushMany(ringBuffer, &element, 1, wait) == 1;
+}
+
+int ewelborn_ringBuffer_pushMany(ewelborn_ringBuffer* ringBuffer, void** elements, int count, ewelborn_ringBufferWait wait)
+{
+	int pushed = 0;
+	int spins = 0;
+	while (pushed < count && atomicLoad(&ringBuffer->closed) == 0) {
+		int justPushed = ringBufferTryPush(ringBuffer, elements + pushed, count - pushed);
+		if (justPushed > 0) {
+			pushed += justPushed;
+			spins = 0;
+			ringBufferNotify(ringBuffer);
+		} else if (wait == EWELBORN_RING_BUFFER_TRY) {
+			break;
+		} else {
+			ringBufferWait(ringBuffer, true, wait, &spins);
+		}
+	}
+	return pushed;
+}
+
+bool ewelborn_ringBuffer_pop(ewelborn_ringBuffer* ringBuffer, void** element, ewelborn_ringBufferWait wait)
+{
+	return ewelborn_ringBuffer_popMany(ringBuffer, element, 1, wait) == 1;
+}
+
+int ewelborn_ringBuffer_popMany(ewelborn_ringBuffer* ringBuffer, void** elements, int maxCount, ewelborn_ringBufferWait wait)
+{
+	if (maxCount <= 0) { return 0; }
+
+	int spins = 0;
+	while (true) {
+		// Check for closing first, so that anything pushed before the ring
+		// buffer was closed still gets popped
+		bool closed = atomicLoad(&ringBuffer->closed) != 0;
+		int popped = ringBufferTryPop(ringBuffer, elements, maxCount);
+		if (popped > 0) {
+			ringBufferNotify(ringBuffer);
+			return popped;
+		}
+		if (closed || wait == EWELBORN_RING_BUFFER_TRY) { return 0; }
+		ringBufferWait(ringBuffer, false, wait, &spins);
+	}
+}
+
+void ewelborn_ringBuffer_close(ewelborn_ringBuffer* ringBuffer)
+{
+	mutexLock(&ringBuffer->lock);
+	atomicStore(&ringBuffer->closed, 1);
+	conditionBroadcast(&ringBuffer->changed);
+	mutexUnlock(&ringBuffer->lock);
+}
+
+size_t ewelborn_ringBuffer_size(ewelborn_ringBuffer* ringBuffer)
+{
+	// Read head first, so that the size can't come out negative
+	long long head = atomicLoadAcquire64(&ringBuffer->head);
+	long long size = atomicLoadAcquire64(&ringBuffer->tail) - head;
+	if (size < 0) { return 0; }
+	return size > ringBuffer->capacity ? (size_t)ringBuffer->capacity : (size_t)size;
+}
+
+void ewelborn_ringBuffer_free(ewelborn_ringBuffer* ringBuffer)
+{
+	if (ringBuffer == NULL) { return; }
+	mutexFree(&ringBuffer->lock);
+	conditionFree(&ringBuffer->changed);
+	releaseTo(NULL, ringBuffer->elements, EWELBORN_ALLOCATION_THREADING);
+	releaseTo(NULL, ringBuffer->cells, EWELBORN_ALLOCATION_THREADING);
+	releaseTo(NULL, ringBuffer, EWELBORN_ALLOCATION_THREADING);
+}
+
+// Opens a file the same way that fopen does. MSVC insists on fopen_s, which
+// most other C libraries don't provide. Returns the file if successful,
+// returns null otherwise.
+static FILE* openFile(const char* path, const char* mode)
+{
+#ifdef _MSC_VER
+	FILE* file = NULL;
+	return fopen_s(&file, path, mode) == 0 ? file : NULL;
+#else
+	return fopen(path, mode);
+#endif
+}
+
+ewelborn_mappedFile* ewelborn_mappedFile_open(ewelborn_string* filePath)
+{
+	return ewelborn_mappedFile_openParallel(filePath, 1);
+}
+
+ewelborn_mappedFile* ewelborn_mappedFile_openParallel(ewelborn_string* filePath, int threadCount)
+{
+	ewelborn_mappedFile* file = allocateFrom(NULL, sizeof(ewelborn_mappedFile), EWELBORN_ALLOCATION_FILE);
+	if (file == NULL) { return NULL; }
+	file->data = NULL;
+	file->size = 0;
+	file->lines = NULL;
+	file->lineCount = 0;
+
+#ifdef _WIN32
+	HANDLE fileHandle = CreateFileA(filePath->cstring, GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (fileHandle == INVALID_HANDLE_VALUE) { goto CLEAN_UP_AND_CRASH; }
+
+	LARGE_INTEGER fileSize;
+	if (GetFileType(fileHandle) != FILE_TYPE_DISK || GetFileSizeEx(fileHandle, &fileSize) == 0 ||
+		(unsigned long long)fileSize.QuadPart > (size_t)-1) {
+		CloseHandle(fileHandle);
+		goto CLEAN_UP_AND_CRASH;
+	}
+	file->size = (size_t)fileSize.QuadPart;
+
+	// Empty files can't be mapped, but they still have one (empty) line.
+	if (file->size > 0) {
+		HANDLE mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mappingHandle != NULL) {
+			file->data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+			// The view keeps the mapping alive, so the handles can be closed now.
+			CloseHandle(mappingHandle);
+		}
+		if (file->data == NULL) {
+			CloseHandle(fileHandle);
+			goto CLEAN_UP_AND_CRASH;
+		}
+	}
+	CloseHandle(fileHandle);
+#else
+	int fileDescriptor = open(filePath->cstring, O_RDONLY);
+	if (fileDescriptor < 0) { goto CLEAN_UP_AND_CRASH; }
+
+	struct stat fileStatus;
+	if (fstat(fileDescriptor, &fileStatus) != 0 || !S_ISREG(fileStatus.st_mode) ||
+		(unsigned long long)fileStatus.st_size > (size_t)-1) {
+		close(fileDescriptor);
+		goto CLEAN_UP_AND_CRASH;
+	}
+	file->size = (size_t)fileStatus.st_size;
+
+	// Empty files can't be mapped, but they still have one (empty) line.
+	if (file->size > 0) {
+		void* data = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		if (data == MAP_FAILED) {
+			close(fileDescriptor);
+			goto CLEAN_UP_AND_CRASH;
+		}
+		file->data = data;
+		madvise(file->data, file->size, MADV_SEQUENTIAL);
+	}
+	// The mapping stays valid after the file is closed.
+	close(fileDescriptor);
+#endif
+
+#ifdef _WIN32
+	// The file is mapped in binary mode, so remove the carriage returns
+	// that text mode would have removed for us.
+	bool stripCarriageReturns = true;
+#else
+	bool stripCarriageReturns = false;
+#endif
+	if (indexLinesParallel(file->data, file->size, '\n', stripCarriageReturns, threadCount,
+		&file->lines, &file->lineCount) == false) {
+		ewelborn_mappedFile_free(file);
+		return NULL;
+	}
+
+	return file;
+
+CLEAN_UP_AND_CRASH:
+	releaseTo(NULL, file, EWELBORN_ALLOCATION_FILE);
+	return NULL;
+}
+
+char* ewelborn_mappedFile_getLine(ewelborn_mappedFile* file, size_t n, size_t* length)
+{
+	if (n >= file->lineCount) { return NULL; }
+	*length = file->lines[n].length;
+	// Empty files have no mapping, so point their only line at an empty string
+	return file->data != NULL ? file->data + file->lines[n].offset : "";
+}
+
+ewelborn_stringView ewelborn_mappedFile_getLineView(ewelborn_mappedFile* file, size_t n)
+{
+	size_t length = 0;
+	char* line = ewelborn_mappedFile_getLine(file, n, &length);
+	if (line == NULL || length > INT_MAX) { return ewelborn_stringView_fromBuffer("", 0); }
+	return ewelborn_stringView_fromBuffer(line, (int)length);
+}
+
+void ewelborn_mappedFile_free(ewelborn_mappedFile* file)
+{
+	if (file->data != NULL) {
+#ifdef _WIN32
+		UnmapViewOfFile(file->data);
+#else
+		munmap(file->data, file->size);
+#endif
+	}
+	releaseTo(NULL, file->lines, EWELBORN_ALLOCATION_STRING);
+	releaseTo(NULL, file, EWELBORN_ALLOCATION_FILE);
+}
+
+// Copies every line of the mapped file into its own estring.
+static ewelborn_dynamicArray* readLinesFromMappedFile(ewelborn_mappedFile* file, ewelborn_arena* arena)
+{
+	ewelborn_dynamicArray* lines = ewelborn_dynamicArray_initializeInArena(arena);
+	if (lines == NULL) { return NULL; }
+	if (arena == NULL) { lines->freeElement = freeStringElement; }
+	if (file->lineCount > INT_MAX || dynamicArrayReserve(lines, (int)file->lineCount) == false) {
+		ewelborn_dynamicArray_free(lines);
+		return NULL;
+	}
+
+	for (size_t i = 0; i < file->lineCount; i++) {
+		// Lines that are too long for an estring can't be read
+		size_t length;
+		char* line = ewelborn_mappedFile_getLine(file, i, &length);
+		ewelborn_string* lineString = length > INT_MAX ? NULL :
+			ewelborn_stringView_toStringInArena(ewelborn_stringView_fromBuffer(line, (int)length), arena);
+		if (lineString == NULL) {
+			ewelborn_dynamicArray_free(lines);
+			return NULL;
+		}
+		ewelborn_dynamicArray_push(lines, lineString);
+	}
+
+	return lines;
+}
+
+ewelborn_dynamicArray* ewelborn_readLinesFromFile(ewelborn_string* filePath)
+{
+	return ewelborn_readLinesFromFileInArena(filePath, NULL);
+}
+
+ewelborn_dynamicArray* ewelborn_readLinesFromFileInArena(ewelborn_string* filePath, ewelborn_arena* arena)
+{
+	// Fast path: map the whole file and copy the lines straight out of it.
+	ewelborn_mappedFile* mappedFile = ewelborn_mappedFile_open(filePath);
+	if (mappedFile != NULL) {
+		ewelborn_dynamicArray* lines = readLinesFromMappedFile(mappedFile, arena);
+		ewelborn_mappedFile_free(mappedFile);
+		return lines;
+	}
+
+	// Slow path for anything that can't be mapped, such as pipes.
+	FILE* inputFile = openFile(filePath->cstring, "r");
+	if (inputFile == NULL) {
+		return NULL;
+	}
+
+	// Set up the buffer for holding all of the lines read
+	ewelborn_string* inputString = ewelborn_string_initializeEmpty();
+	if (inputString == NULL) {
+		fclose(inputFile);
+		return NULL;
+	}
+
+	// Read all of the characters from the file into an estring, a block
+	// at a time.
+	char block[4096];
+	size_t bytesRead;
+	while ((bytesRead = fread(block, 1, sizeof(block), inputFile)) > 0) {
+		if (ewelborn_string_appendN(inputString, block, (int)bytesRead) == false) {
+			ewelborn_string_free(inputString);
+			fclose(inputFile);
+			return NULL;
+		}
+	}
+	fclose(inputFile);
+
+	// Split the characters on newlines (\n) so we get each line
+	// as its own string.
+	ewelborn_dynamicArray* lines = ewelborn_string_splitInArena(inputString, '\n', arena);
+	ewelborn_string_free(inputString);
+	return lines;
+}
+
+ewelborn_lineReader* ewelborn_lineReader_open(ewelborn_string* filePath)
+{
+	return ewelborn_lineReader_openWithBlockSize(filePath, EWELBORN_LINE_READER_BLOCK_SIZE);
+}
+
+ewelborn_lineReader* ewelborn_lineReader_openWithBlockSize(ewelborn_string* filePath, size_t blockSize)
+{
+	if (blockSize == 0) { return NULL; }
+
+	ewelborn_lineReader* reader = allocateFrom(NULL, sizeof(ewelborn_lineReader), EWELBORN_ALLOCATION_FILE);
+	if (reader == NULL) { goto CLEAN_UP_AND_CRASH; }
+	memset(reader, 0, sizeof(ewelborn_lineReader));
+
+	// Binary mode, so the blocks are exactly what's in the file
+	reader->file = openFile(filePath->cstring, "rb");
+	if (reader->file == NULL) { goto CLEAN_UP_AND_CRASH; }
+	// We're already reading in large blocks, so stdio's buffer would only
+	// add another copy.
+	setvbuf(reader->file, NULL, _IONBF, 0);
+
+	reader->bufferSize = blockSize;
+	reader->buffer = allocateFrom(NULL, reader->bufferSize, EWELBORN_ALLOCATION_FILE);
+	if (reader->buffer == NULL) { goto CLEAN_UP_AND_CRASH; }
+
+	return reader;
+
+CLEAN_UP_AND_CRASH:
+	if (reader != NULL) {
+		if (reader->file != NULL) { fclose(reader->file); }
+		releaseTo(NULL, reader, EWELBORN_ALLOCATION_FILE);
+	}
+	return NULL;
 }
 
-bool ewelborn_dynamicArray_push(ewelborn_dynamicArray* dynamicArray, void* element)
+// Reads the next block of the file into the buffer, after any characters
+// that haven't been returned yet. Returns false if the buffer couldn't be
+// made larger.
+static bool lineReaderFill(ewelborn_lineReader* reader)
 {
-	if (dynamicArray->elements >= dynamicArray->maxElements) {
-		dynamicArray->maxElements *= EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT;
-		void** newArray = realloc(dynamicArray->array, sizeof(void*) * dynamicArray->maxElements);
-		if (newArray == NULL) { return false; }
-		dynamicArray->array = newArray;
+	// Move the unfinished line to the front of the buffer to make room
+	if (reader->start > 0) {
+		memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+		reader->end -= reader->start;
+		reader->start = 0;
 	}
 
-	dynamicArray->array[dynamicArray->elements++] = element;
+	// The line is longer than the entire buffer, so the buffer has to grow
+	if (reader->end == reader->bufferSize) {
+		if (reader->bufferSize > ((size_t)-1) / EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT) { return false; }
+		size_t bufferSize = reader->bufferSize * EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT;
+		char* buffer = reallocateFrom(NULL, reader->buffer, reader->bufferSize, bufferSize, EWELBORN_ALLOCATION_FILE);
+		if (buffer == NULL) { return false; }
+		reader->buffer = buffer;
+		reader->bufferSize = bufferSize;
+	}
+
+	size_t bytesRead = fread(reader->buffer + reader->end, 1, reader->bufferSize - reader->end, reader->file);
+	reader->end += bytesRead;
+	if (bytesRead == 0) {
+		reader->endOfFile = true;
+		if (ferror(reader->file)) { reader->failed = true; }
+	}
 	return true;
 }
 
-void ewelborn_dynamicArray_free(ewelborn_dynamicArray* dynamicArray)
+bool ewelborn_lineReader_nextView(ewelborn_lineReader* reader, ewelborn_stringView* line)
 {
-	for (int i = 0; i < dynamicArray->elements; i++) {
-		free(dynamicArray->array[i]);
+	if (reader->finished) { return false; }
+
+	while (true) {
+		// Only search the characters that haven't been searched before, so
+		// long lines that span several blocks aren't scanned over and over.
+		size_t searchFrom = reader->start + reader->scanned;
+		size_t end = searchFrom + ewelborn_scan_findChar(reader->buffer + searchFrom, reader->end - searchFrom, '\n');
+		bool foundNewline = end < reader->end;
+
+		if (foundNewline || reader->endOfFile) {
+			size_t length = end - reader->start;
+#ifdef _WIN32
+			// The file is read in binary mode, so remove the carriage return
+			// that text mode would have removed for us.
+			if (foundNewline && length > 0 && reader->buffer[end - 1] == '\r') { length--; }
+#endif
+			if (length > INT_MAX) {
+				reader->failed = true;
+				reader->finished = true;
+				return false;
+			}
+
+			*line = ewelborn_stringView_fromBuffer(reader->buffer + reader->start, (int)length);
+			reader->scanned = 0;
+			if (foundNewline) {
+				reader->start = end + 1;
+			}
+			else {
+				// A file always ends with a line, even if it's empty
+				reader->start = end;
+				reader->finished = true;
+			}
+			return true;
+		}
+
+		reader->scanned = reader->end - reader->start;
+		if (lineReaderFill(reader) == false || reader->failed) {
+			reader->failed = true;
+			reader->finished = true;
+			return false;
+		}
 	}
-	free(dynamicArray->array);
-	free(dynamicArray);
 }
 
-void ewelborn_dynamicArray_traverse(ewelborn_dynamicArray* dynamicArray, void(*f)(void*))
+bool ewelborn_lineReader_next(ewelborn_lineReader* reader, ewelborn_string* line)
 {
-	for (int i = 0; i < dynamicArray->elements; i++) {
-		f(dynamicArray->array[i]);
+	ewelborn_stringView view;
+	if (ewelborn_lineReader_nextView(reader, &view) == false) { return false; }
+
+	ewelborn_string_deleteRight(line, line->length);
+	if (ewelborn_string_appendView(line, view) == false) {
+		reader->failed = true;
+		return false;
 	}
+	return true;
 }
 
-ewelborn_linkedList* ewelborn_linkedList_initializeEmpty()
+void ewelborn_lineReader_free(ewelborn_lineReader* reader)
 {
-	ewelborn_linkedList* list = malloc(sizeof(ewelborn_linkedList));
-	if (list == NULL) { return NULL; }
-	list->element = NULL;
-	list->next = NULL;
-	return list;
+	fclose(reader->file);
+	releaseTo(NULL, reader->buffer, EWELBORN_ALLOCATION_FILE);
+	releaseTo(NULL, reader, EWELBORN_ALLOCATION_FILE);
 }
 
-bool ewelborn_linkedList_insert(ewelborn_linkedList* list, void* newElement)
+ewelborn_csvOptions ewelborn_csvReader_defaultOptions()
 {
-	ewelborn_linkedList* newList = ewelborn_linkedList_initializeEmpty();
-	if (newList == NULL) { return false; }
-	newList->element = newElement;
+	ewelborn_csvOptions options;
+	options.delimiter = ',';
+	options.quote = '"';
+	options.hasHeader = true;
+	options.inferenceRows = EWELBORN_CSV_DEFAULT_INFERENCE_ROWS;
+	return options;
+}
 
-	if (list->next == NULL) {
-		list->next = newList;
-	}
-	else {
-		newList->next = list->next;
-		list->next = newList;
-	}
+// What csvScanRecord returns when it can't return a field count
+#define CSV_NEED_MORE -2
+#define CSV_MALFORMED -1
 
+// Adds a field to the end of the reader's fields. Returns false if there
+// wasn't enough memory.
+static bool csvPushField(ewelborn_csvReader* reader, int count, const char* data, size_t length, bool escaped)
+{
+	if (count == reader->maxFields) {
+		int maxFields = reader->maxFields * EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT;
+		ewelborn_csvField* fields = reallocateFrom(NULL, reader->fields, sizeof(ewelborn_csvField) * reader->maxFields,
+			sizeof(ewelborn_csvField) * maxFields, EWELBORN_ALLOCATION_FILE);
+		if (fields == NULL) { return false; }
+		reader->fields = fields;
+		reader->maxFields = maxFields;
+	}
+	reader->fields[count].text = ewelborn_stringView_fromBuffer(data, (int)length);
+	reader->fields[count].escaped = escaped;
 	return true;
 }
 
-bool ewelborn_linkedList_pushToBack(ewelborn_linkedList* list, void* newElement)
+// Finds the fields of the record at the start of the buffer. Returns the
+// number of fields, and stores the length of the record (including its
+// newline) in consumed. If the record might continue past the end of the
+// buffer, returns CSV_NEED_MORE, unless atEnd is true (there's nothing else
+// in the file). Returns CSV_MALFORMED if the record isn't valid CSV.
+static int csvScanRecord(ewelborn_csvReader* reader, const char* p, const char* end, bool atEnd, size_t* consumed)
 {
-	while (list->next) { list = list->next; }
-	ewelborn_linkedList_insert(list, newElement);
-}
+	const char* start = p;
+	const char delimiter = reader->options.delimiter;
+	const char quote = reader->options.quote;
+	const char stops[2] = { delimiter, '\n' };
+	int count = 0;
 
-void ewelborn_linkedList_traverse(ewelborn_linkedList* list, void(*f)(void*))
-{
 	while (true) {
-		f(list->element);
-		if (list->next) {
-			list = list->next;
+		const char* data;
+		size_t length;
+		bool escaped = false;
+
+		if (p < end && *p == quote) {
+			// Jump from quote to quote until one isn't doubled
+			const char* q = p + 1;
+			while (true) {
+				const char* closing = memchr(q, quote, end - q);
+				if (closing == NULL) { return atEnd ? CSV_MALFORMED : CSV_NEED_MORE; }
+				if (closing + 1 == end && atEnd == false) { return CSV_NEED_MORE; }
+				if (closing + 1 < end && closing[1] == quote) {
+					escaped = true;
+					q = closing + 2;
+					continue;
+				}
+				data = p + 1;
+				length = closing - data;
+				p = closing + 1;
+				break;
+			}
+			if (p < end && *p == '\r') {
+				if (p + 1 == end && atEnd == false) { return CSV_NEED_MORE; }
+				if (p + 1 < end && p[1] != '\n') { return CSV_MALFORMED; }
+				p++;
+			}
+			if (p < end && *p != delimiter && *p != '\n') { return CSV_MALFORMED; }
 		}
 		else {
-			break;
+			// Most fields are short enough that setting up a vectorized
+			// search would take longer than just looking at them.
+			size_t available = end - p;
+			length = 0;
+			while (length < available && length < 32 && p[length] != delimiter && p[length] != '\n') { length++; }
+			if (length == 32) { length += ewelborn_scan_findAnyOf(p + 32, available - 32, stops, 2); }
+			if (p + length == end && atEnd == false) { return CSV_NEED_MORE; }
+			data = p;
+			p += length;
+			if (p < end && *p == '\n' && length > 0 && data[length - 1] == '\r') { length--; }
+		}
+
+		if (length > INT_MAX || csvPushField(reader, count, data, length, escaped) == false) { return CSV_MALFORMED; }
+		count++;
+
+		if (p == end) {
+			*consumed = p - start;
+			return count;
+		}
+		p++;
+		if (p[-1] == '\n') {
+			*consumed = p - start;
+			return count;
 		}
 	}
 }
 
-ewelborn_linkedList* ewelborn_linkedList_reverse(ewelborn_linkedList* list)
+// Reads the next record that isn't a blank line into the reader's fields.
+// Returns the number of fields, 0 once there are no records left, or -1 if
+// the record couldn't be read.
+static int csvReadRecord(ewelborn_csvReader* reader)
 {
-	ewelborn_linkedList* previousList = NULL;
+	ewelborn_lineReader* input = reader->input;
 	while (true) {
-		//printf("v. %s\n", list->element);
-		ewelborn_linkedList* nextList = NULL;
-		if (list->next != NULL) {
-			nextList = list->next;
-		}
-		if (previousList == NULL) {
-			// We were the head of the list.. now we're the tail
-			list->next = NULL;
-		}
-		else {
-			list->next = previousList;
-		}
-		previousList = list;
-		if (nextList != NULL) {
-			list = nextList;
-		}
-		else {
-			//printf("ret. %s\n", list->element);
-			return list;
+		if (input->start == input->end && input->endOfFile) { return 0; }
+
+		size_t consumed;
+		int count = csvScanRecord(reader, input->buffer + input->start, input->buffer + input->end, input->endOfFile, &consumed);
+		if (count == CSV_NEED_MORE) {
+			// The record is scanned again from the start once there's more of it
+			if (lineReaderFill(input) == false || input->failed) { return -1; }
+			continue;
 		}
+		if (count == CSV_MALFORMED) { return -1; }
+
+		input->start += consumed;
+		reader->records++;
+		if (count == 1 && reader->fields[0].text.length == 0 && consumed <= 2) { continue; }
+		return count;
 	}
 }
 
-bool ewelborn_string_pushChar(ewelborn_string* eString, char c)
+// Copies the field's characters into the reader's arena, turning doubled
+// quotes back into single quotes. Returns false if there wasn't enough memory.
+static bool csvCopyField(ewelborn_csvReader* reader, ewelborn_csvField* field, ewelborn_stringView* copy)
 {
-	// Add 1 to length to include null terminator
-	if (eString->length + 1 >= eString->maxLength) {
-		eString->maxLength *= EWELBORN_DYNAMIC_ARRAY_EXPANSION_CONSTANT;
-		char* newString = realloc(eString->cstring, sizeof(char) * eString->maxLength);
-		if (newString == NULL) { return false; }
-		eString->cstring = newString;
+	if (field->text.length == 0) {
+		*copy = ewelborn_stringView_fromBuffer("", 0);
+		return true;
 	}
+	char* characters = ewelborn_arena_allocate(reader->strings, field->text.length);
+	if (characters == NULL) { return false; }
 
-	eString->cstring[eString->length++] = c;
-	eString->cstring[eString->length] = '\0';
+	int length = 0;
+	if (field->escaped) {
+		for (int i = 0; i < field->text.length; i++) {
+			characters[length++] = field->text.data[i];
+			if (field->text.data[i] == reader->options.quote) { i++; }
+		}
+	}
+	else {
+		memcpy(characters, field->text.data, field->text.length);
+		length = field->text.length;
+	}
+	*copy = ewelborn_stringView_fromBuffer(characters, length);
 	return true;
 }
 
-char ewelborn_string_getChar(ewelborn_string* eString, int n)
+// Turns every value in an integer column into a double
+static void csvPromoteToDouble(ewelborn_csvColumn* column)
 {
-	if (n < 0 || n >= eString->length) {
-		return '\0';
-	}
-	else {
-		return eString->cstring[n];
+	for (int i = 0; i < column->values->elements; i++) {
+		double value = (double)EWELBORN_TYPED_ARRAY_AT(column->values, int64_t, i);
+		memcpy(ewelborn_typedArray_get(column->values, i), &value, sizeof(value));
 	}
+	column->type = EWELBORN_CSV_DOUBLE;
 }
 
-ewelborn_string* ewelborn_string_initializeEmpty()
+// Adds the field to the end of the column, promoting the column to doubles
+// if it has to. Returns false if the field doesn't fit the column's type, or
+// there wasn't enough memory.
+static bool csvStoreField(ewelborn_csvReader* reader, ewelborn_csvColumn* column, ewelborn_csvField* field)
 {
-	ewelborn_string* eString = malloc(sizeof(ewelborn_string));
-	if (eString == NULL) { return NULL; }
-	eString->length = 0;
-	eString->maxLength = EWELBORN_DYNAMIC_ARRAY_STARTING_SIZE;
-	eString->cstring = malloc(sizeof(char) * eString->maxLength);
-	if (eString->cstring == NULL) {
-		free(eString);
-		return NULL;
+	if (column->type == EWELBORN_CSV_STRING) {
+		ewelborn_stringView copy;
+		return csvCopyField(reader, field, &copy) && ewelborn_typedArray_push(column->values, &copy);
 	}
-	eString->cstring[0] = '\0';
-	return eString;
+	// Doubled quotes never show up in a number
+	if (field->escaped) { return false; }
+
+	if (column->type == EWELBORN_CSV_INT64) {
+		int64_t value;
+		if (ewelborn_stringView_parseInt64(field->text, &value) == EWELBORN_PARSE_SUCCESS) {
+			return ewelborn_typedArray_push(column->values, &value);
+		}
+		csvPromoteToDouble(column);
+	}
+
+	double value = NAN;
+	if (trimNumber(field->text).length > 0) {
+		ewelborn_parseResult result = ewelborn_stringView_parseDouble(field->text, &value);
+		if (result != EWELBORN_PARSE_SUCCESS && result != EWELBORN_PARSE_OVERFLOW) { return false; }
+	}
+	return ewelborn_typedArray_push(column->values, &value);
 }
 
-bool ewelborn_string_appendCString(ewelborn_string* estring, char* cstring)
+// Adds the record in the reader's fields to the end of the columns. Returns
+// false if the record doesn't fit the columns.
+static bool csvStoreRecord(ewelborn_csvReader* reader, int fieldCount)
 {
-	// TODO: Replace with a function that can calculate all of the
-	// memory requirements at once, instead of using pushChar that may
-	// resize the dynamic array multiple times during the for loop.
-	for (int i = 0; cstring[i] != '\0'; i++) {
-		if (ewelborn_string_pushChar(estring, cstring[i]) == false) { return false; }
+	if (fieldCount > reader->columnCount) { return false; }
+	ewelborn_csvField empty = { { "", 0 }, false };
+	for (int i = 0; i < reader->columnCount; i++) {
+		ewelborn_csvField* field = i < fieldCount ? &reader->fields[i] : &empty;
+		if (csvStoreField(reader, &reader->columns[i], field) == false) { return false; }
 	}
-
+	reader->rowCount++;
 	return true;
 }
 
-bool ewelborn_string_append(ewelborn_string* estring, ewelborn_string* appendString)
+// Works out a column's type from some of its fields, which have already
+// been copied (without any doubled quotes).
+static ewelborn_csvColumnType csvInferType(ewelborn_typedArray* samples)
 {
-	return ewelborn_string_appendCString(estring, appendString->cstring);
+	bool integers = true;
+	bool numbers = true;
+	bool anything = false;
+	for (int i = 0; i < samples->elements && numbers; i++) {
+		ewelborn_stringView sample = EWELBORN_TYPED_ARRAY_AT(samples, ewelborn_stringView, i);
+		if (trimNumber(sample).length == 0) {
+			// Integers can't be empty, but doubles can be NaN
+			integers = false;
+			continue;
+		}
+		anything = true;
+		int64_t integer;
+		double number;
+		if (integers && ewelborn_stringView_parseInt64(sample, &integer) == EWELBORN_PARSE_SUCCESS) { continue; }
+		integers = false;
+		ewelborn_parseResult result = ewelborn_stringView_parseDouble(sample, &number);
+		numbers = result == EWELBORN_PARSE_SUCCESS || result == EWELBORN_PARSE_OVERFLOW;
+	}
+	// A column of nothing but empty fields could be anything, so keep the text
+	if (anything == false || numbers == false) { return EWELBORN_CSV_STRING; }
+	return integers ? EWELBORN_CSV_INT64 : EWELBORN_CSV_DOUBLE;
 }
 
-ewelborn_string* ewelborn_string_initializeWithCString(char* cstring)
+ewelborn_csvReader* ewelborn_csvReader_open(ewelborn_string* filePath, ewelborn_csvOptions options)
 {
-	ewelborn_string* estring = ewelborn_string_initializeEmpty();
-	if (estring == NULL) { return NULL; }
+	ewelborn_typedArray** samples = NULL;
+	ewelborn_arena* sampleStrings = NULL;
+	int sampleRows = 0;
 
-	if (ewelborn_string_appendCString(estring, cstring) == false) { return NULL; }
+	ewelborn_csvReader* reader = allocateFrom(NULL, sizeof(ewelborn_csvReader), EWELBORN_ALLOCATION_FILE);
+	if (reader == NULL) { return NULL; }
+	memset(reader, 0, sizeof(ewelborn_csvReader));
+	reader->options = options;
 
-	return estring;
-}
+	reader->input = ewelborn_lineReader_open(filePath);
+	if (reader->input == NULL) { goto CLEAN_UP_AND_CRASH; }
+	reader->strings = ewelborn_arena_initialize(0);
+	if (reader->strings == NULL) { goto CLEAN_UP_AND_CRASH; }
+	reader->maxFields = 16;
+	reader->fields = allocateFrom(NULL, sizeof(ewelborn_csvField) * reader->maxFields, EWELBORN_ALLOCATION_FILE);
+	if (reader->fields == NULL) { goto CLEAN_UP_AND_CRASH; }
 
-char* ewelborn_string_getCString(ewelborn_string* eString)
-{
-	return eString->cstring;
-}
+	int fieldCount = csvReadRecord(reader);
+	if (fieldCount < 0) { goto CLEAN_UP_AND_CRASH; }
+	reader->columnCount = fieldCount;
+	reader->columns = allocateFrom(NULL, sizeof(ewelborn_csvColumn) * (fieldCount > 0 ? fieldCount : 1), EWELBORN_ALLOCATION_FILE);
+	if (reader->columns == NULL) { goto CLEAN_UP_AND_CRASH; }
+	memset(reader->columns, 0, sizeof(ewelborn_csvColumn) * reader->columnCount);
+	for (int i = 0; i < reader->columnCount; i++) {
+		reader->columns[i].name = ewelborn_stringView_fromBuffer("", 0);
+		if (options.hasHeader && csvCopyField(reader, &reader->fields[i], &reader->columns[i].name) == false) { goto CLEAN_UP_AND_CRASH; }
+	}
 
-void ewelborn_string_free(ewelborn_string* eString) {
-	free(eString->cstring);
-	free(eString);
-}
+	// Copy the first rows, so their types can be worked out before any of
+	// them are stored. The first record is a row too if there's no header.
+	sampleStrings = ewelborn_arena_initialize(0);
+	samples = allocateFrom(NULL, sizeof(ewelborn_typedArray*) * (reader->columnCount > 0 ? reader->columnCount : 1), EWELBORN_ALLOCATION_FILE);
+	if (sampleStrings == NULL || samples == NULL) { goto CLEAN_UP_AND_CRASH; }
+	memset(samples, 0, sizeof(ewelborn_typedArray*) * reader->columnCount);
+	for (int i = 0; i < reader->columnCount; i++) {
+		samples[i] = EWELBORN_TYPED_ARRAY_INITIALIZE(ewelborn_stringView);
+		if (samples[i] == NULL) { goto CLEAN_UP_AND_CRASH; }
+	}
 
-ewelborn_string* ewelborn_string_clone(ewelborn_string* estring)
-{
-	ewelborn_string* clonedString = malloc(sizeof(ewelborn_string));
-	if (clonedString == NULL) { return NULL; }
-	clonedString->length = estring->length;
-	clonedString->maxLength = estring->maxLength;
-	clonedString->cstring = malloc(sizeof(char) * clonedString->maxLength);
-	if (clonedString->cstring == NULL) {
-		free(clonedString);
-		return NULL;
+	ewelborn_arena* rowStrings = reader->strings;
+	reader->strings = sampleStrings;
+	bool haveRecord = options.hasHeader == false && fieldCount > 0;
+	while (sampleRows < options.inferenceRows || haveRecord) {
+		if (haveRecord == false) {
+			fieldCount = csvReadRecord(reader);
+			if (fieldCount == 0) { break; }
+		}
+		haveRecord = false;
+		if (fieldCount < 0 || fieldCount > reader->columnCount) {
+			reader->strings = rowStrings;
+			goto CLEAN_UP_AND_CRASH;
+		}
+		for (int i = 0; i < reader->columnCount; i++) {
+			ewelborn_stringView copy = ewelborn_stringView_fromBuffer("", 0);
+			if ((i < fieldCount && csvCopyField(reader, &reader->fields[i], &copy) == false)
+				|| ewelborn_typedArray_push(samples[i], &copy) == false) {
+				reader->strings = rowStrings;
+				goto CLEAN_UP_AND_CRASH;
+			}
+		}
+		sampleRows++;
 	}
+	reader->strings = rowStrings;
+	reader->rowStrings = ewelborn_arena_mark(reader->strings);
 
-	// Copy the cstring from given estring
-	memcpy(clonedString->cstring, estring->cstring, estring->length + 1);
+	for (int i = 0; i < reader->columnCount; i++) {
+		ewelborn_csvColumn* column = &reader->columns[i];
+		column->type = csvInferType(samples[i]);
+		column->values = ewelborn_typedArray_initialize(column->type == EWELBORN_CSV_STRING ? sizeof(ewelborn_stringView)
+			: column->type == EWELBORN_CSV_INT64 ? sizeof(int64_t) : sizeof(double));
+		if (column->values == NULL || ewelborn_typedArray_reserve(column->values, sampleRows) == false) { goto CLEAN_UP_AND_CRASH; }
+	}
+	for (int row = 0; row < sampleRows; row++) {
+		for (int i = 0; i < reader->columnCount; i++) {
+			ewelborn_csvField field = { EWELBORN_TYPED_ARRAY_AT(samples[i], ewelborn_stringView, row), false };
+			if (csvStoreField(reader, &reader->columns[i], &field) == false) { goto CLEAN_UP_AND_CRASH; }
+		}
+		reader->rowCount++;
+	}
 
-	return clonedString;
+	for (int i = 0; i < reader->columnCount; i++) {
+		ewelborn_typedArray_free(samples[i]);
+	}
+	releaseTo(NULL, samples, EWELBORN_ALLOCATION_FILE);
+	ewelborn_arena_free(sampleStrings);
+	return reader;
+
+CLEAN_UP_AND_CRASH:
+	if (samples != NULL) {
+		for (int i = 0; i < reader->columnCount; i++) {
+			if (samples[i] != NULL) { ewelborn_typedArray_free(samples[i]); }
+		}
+		releaseTo(NULL, samples, EWELBORN_ALLOCATION_FILE);
+	}
+	if (sampleStrings != NULL) { ewelborn_arena_free(sampleStrings); }
+	ewelborn_csvReader_free(reader);
+	return NULL;
 }
 
-void ewelborn_string_deleteLeft(ewelborn_string* estring, int n)
+int ewelborn_csvReader_readRows(ewelborn_csvReader* reader, int maxRows)
 {
-	if (n <= 0) { return; }
-	if (n > estring->length) { n = estring->length; }
-	for (int i = 0; i < estring->length; i++) {
-		estring->cstring[i] = (i + n) >= (estring->length) ? '\0' : estring->cstring[i + n];
+	if (reader->failed) { return -1; }
+
+	int rowsRead = 0;
+	while (rowsRead < maxRows) {
+		int fieldCount = csvReadRecord(reader);
+		if (fieldCount == 0) { break; }
+		if (fieldCount < 0 || csvStoreRecord(reader, fieldCount) == false) {
+			// Take back whatever part of the record was already stored
+			for (int i = 0; i < reader->columnCount; i++) {
+				ewelborn_typedArray* values = reader->columns[i].values;
+				if (values->elements > reader->rowCount) { values->elements = reader->rowCount; }
+			}
+			reader->failed = true;
+			reader->errorRecord = reader->records + (fieldCount < 0 ? 1 : 0);
+			return -1;
+		}
+		rowsRead++;
 	}
+	return rowsRead;
 }
 
-void ewelborn_string_deleteRight(ewelborn_string* estring, int n)
+bool ewelborn_csvReader_readAll(ewelborn_csvReader* reader)
 {
-	if (n <= 0) { return; }
-	if (n > estring->length) { n = estring->length; }
-	// We don't actually need to delete anything, we can simply reduce
-	// the length of the estring and add the null terminator in.
-	estring->length -= n;
-	estring->cstring[estring->length] = '\0';
+	int rowsRead;
+	while ((rowsRead = ewelborn_csvReader_readRows(reader, INT_MAX)) > 0) {}
+	return rowsRead == 0;
 }
 
-void ewelborn_string_trimLeft(ewelborn_string* estring)
+void ewelborn_csvReader_clearRows(ewelborn_csvReader* reader)
 {
-	int shiftLeftBy = 0;
-
-	// Start from the beginning of the string, and keep counting until
-	// we encounter a character that isn't ' ' or '\t'. No other end condition
-	// necessary: if the entire string is filled with whitespaces or tabs, then
-	// the null terminator at the end will stop the loop.
-	for (; estring->cstring[shiftLeftBy] == ' ' || estring->cstring[shiftLeftBy] == '\t'; shiftLeftBy++) {}
-
-	ewelborn_string_deleteLeft(estring, shiftLeftBy);
+	for (int i = 0; i < reader->columnCount; i++) {
+		ewelborn_typedArray_clear(reader->columns[i].values);
+	}
+	ewelborn_arena_resetToMark(reader->strings, reader->rowStrings);
+	reader->rowCount = 0;
 }
 
-void ewelborn_string_trimRight(ewelborn_string* estring)
+void ewelborn_csvReader_free(ewelborn_csvReader* reader)
 {
-	int shiftRightBy = 0;
-
-	// Start from the end of the string, and keep counting until
-	// we encounter a character that isn't ' ' or '\t', or when
-	// shiftRightBy is equal to the length of the entire string,
-	// i.e. the string is composed entirely of whitespaces or tabs.
-	for (;
-		estring->length - 1 - shiftRightBy == -1 ||
-		estring->cstring[estring->length - 1 - shiftRightBy] == ' ' ||
-		estring->cstring[estring->length - 1 - shiftRightBy] == '\t';
-		shiftRightBy++) {
+	if (reader->columns != NULL) {
+		for (int i = 0; i < reader->columnCount; i++) {
+			if (reader->columns[i].values != NULL) { ewelborn_typedArray_free(reader->columns[i].values); }
+		}
+		releaseTo(NULL, reader->columns, EWELBORN_ALLOCATION_FILE);
 	}
-
-	ewelborn_string_deleteRight(estring, shiftRightBy);
+	if (reader->fields != NULL) { releaseTo(NULL, reader->fields, EWELBORN_ALLOCATION_FILE); }
+	if (reader->strings != NULL) { ewelborn_arena_free(reader->strings); }
+	if (reader->input != NULL) { ewelborn_lineReader_free(reader->input); }
+	releaseTo(NULL, reader, EWELBORN_ALLOCATION_FILE);
 }
 
-void ewelborn_string_trim(ewelborn_string* estring)
+ewelborn_csvReader* ewelborn_readCSVFromFile(ewelborn_string* filePath, ewelborn_csvOptions options)
 {
-	ewelborn_string_trimLeft(estring);
-	ewelborn_string_trimRight(estring);
+	ewelborn_csvReader* reader = ewelborn_csvReader_open(filePath, options);
+	if (reader == NULL) { return NULL; }
+	if (ewelborn_csvReader_readAll(reader) == false) {
+		ewelborn_csvReader_free(reader);
+		return NULL;
+	}
+	return reader;
 }
 
-int ewelborn_string_findChar(ewelborn_string* estring, char c, int offset)
+ewelborn_dynamicArray* ewelborn_readLinesFromFileParallel(ewelborn_string* filePath, int threadCount)
 {
-	if (offset < 0 || offset >= estring->length) { return -1; }
-
-	for (int i = offset; i < estring->length; i++) {
-		if (estring->cstring[i] == c) { return i; }
+	ewelborn_mappedFile* mappedFile = ewelborn_mappedFile_openParallel(filePath, threadCount);
+	if (mappedFile == NULL) {
+		// Files that can't be mapped (ex. pipes) can only be read in order
+		return ewelborn_readLinesFromFile(filePath);
 	}
 
-	return -1;
+	// Empty files have no mapping, but their only line still needs a buffer
+	const char* data = mappedFile->data != NULL ? mappedFile->data : "";
+	ewelborn_dynamicArray* lines = copyLinesParallel(data, mappedFile->lines, mappedFile->lineCount, threadCount);
+	ewelborn_mappedFile_free(mappedFile);
+	return lines;
 }
 
-void ewelborn_string_slice(ewelborn_string* estring, int start, int end)
+bool ewelborn_writeStringToFile(ewelborn_string* filePath, ewelborn_string* content)
 {
-	ewelborn_string_deleteRight(estring, estring->length - end);
-	ewelborn_string_deleteLeft(estring, start);
+	FILE* outputFile = openFile(filePath->cstring, "w");
+	if (outputFile == NULL) {
+		return false;
+	}
+
+	// fputs returns EOF if it fails, and any other number if it succeeds
+	bool succeeded = fputs(content->cstring, outputFile) != EOF;
+	if (fclose(outputFile) != 0) { succeeded = false; }
+	return succeeded;
 }
 
-ewelborn_dynamicArray* ewelborn_string_split(ewelborn_string* estring, char c)
+// Pieces of memory to be written one after another by writeVectors. Batches
+// are at most WRITE_VECTOR_COUNT pieces long, which every platform's writev
+// accepts.
+#define WRITE_VECTOR_COUNT 1024
+struct writeVector {
+	const char* data;
+	size_t length;
+};
+
+// Writes every vector to the file, in order. Returns true if successful,
+// false otherwise.
+static bool writeVectors(ewelborn_fileWriter* writer, struct writeVector* vectors, int count)
 {
-	ewelborn_dynamicArray* results = ewelborn_dynamicArray_initialize();
-	if (results == NULL) { return NULL; }
+#ifdef _WIN32
+	// Windows can only gather writes into unbuffered, page aligned files, so
+	// the vectors are written one at a time instead.
+	for (int i = 0; i < count; i++) {
+		const char* data = vectors[i].data;
+		size_t remaining = vectors[i].length;
+		while (remaining > 0) {
+			DWORD toWrite = remaining > 0x40000000 ? 0x40000000 : (DWORD)remaining;
+			DWORD written = 0;
+			if (WriteFile(writer->handle, data, toWrite, &written, NULL) == FALSE) { return false; }
+			data += written;
+			remaining -= written;
+		}
+	}
+	return true;
+#else
+	struct iovec iovecs[WRITE_VECTOR_COUNT];
+	for (int i = 0; i < count; i++) {
+		iovecs[i].iov_base = (void*)vectors[i].data;
+		iovecs[i].iov_len = vectors[i].length;
+	}
 
-	// Keep attempting to find the character in the estring. If we find
-	// the character, then slice the estring from offset to i (not inclusive)
-	// and store the slice in the array. If we do not find the character,
-	// then take whatever's left of the string and store it in the array.
-	int offset = 0;
-	while (true) {
-		int i = ewelborn_string_findChar(estring, c, offset);
-		if (i >= 0) {
-			ewelborn_string* slice = ewelborn_string_clone(estring);
-			ewelborn_string_slice(slice, offset, i);
-			ewelborn_dynamicArray_push(results, slice);
-			//printf("slice slice [%d,%d): %s\n", offset, i, ewelborn_string_getCString(slice));
-			offset = i + 1;
+	int first = 0;
+	while (first < count) {
+		ssize_t written = writev(writer->fileDescriptor, iovecs + first, count - first);
+		if (written < 0) {
+			if (errno == EINTR) { continue; }
+			return false;
 		}
-		else {
-			break;
+
+		// The write may have stopped partway through a vector
+		while (first < count && (size_t)written >= iovecs[first].iov_len) {
+			written -= iovecs[first].iov_len;
+			first++;
+		}
+		if (first < count) {
+			iovecs[first].iov_base = (char*)iovecs[first].iov_base + written;
+			iovecs[first].iov_len -= written;
 		}
 	}
-	ewelborn_string* finalSlice = ewelborn_string_clone(estring);
-	ewelborn_string_deleteLeft(finalSlice, offset);
-	ewelborn_dynamicArray_push(results, finalSlice);
-	//printf("final slice: %s\n", ewelborn_string_getCString(finalSlice));
+	return true;
+#endif
+}
 
-	return results;
+// Writes whatever is in the buffer to the file. Returns true if successful,
+// false otherwise.
+static bool fileWriterFlushBuffer(ewelborn_fileWriter* writer)
+{
+	if (writer->used == 0) { return true; }
+	struct writeVector vector = { writer->buffer, writer->used };
+	writer->used = 0;
+	if (writeVectors(writer, &vector, 1) == false) { writer->failed = true; }
+	return writer->failed == false;
 }
 
-void ewelborn_string_deleteChar(ewelborn_string* estring, int n)
+// Asks the operating system to push the file out to the disk.
+static bool fileWriterSync(ewelborn_fileWriter* writer)
 {
-	if (n < 0 || n >= estring->length) {
-		return;
-	}
+#ifdef _WIN32
+	return FlushFileBuffers(writer->handle) != FALSE;
+#else
+	return fsync(writer->fileDescriptor) == 0;
+#endif
+}
 
-	// Anything to the left of the nth position can be left alone,
-	// but anything to the right needs to be shifted 1 position to the left
-	for (int i = n; i < estring->length - 1; i++) {
-		estring->cstring[i] = estring->cstring[i + 1];
-	}
+ewelborn_fileWriter* ewelborn_fileWriter_open(ewelborn_string* filePath, ewelborn_syncPolicy syncPolicy)
+{
+	return ewelborn_fileWriter_openWithBufferSize(filePath, EWELBORN_FILE_WRITER_BUFFER_SIZE, syncPolicy);
 }
 
-bool ewelborn_string_consumeChar(ewelborn_string* eString, char c, int n)
+ewelborn_fileWriter* ewelborn_fileWriter_openWithBufferSize(ewelborn_string* filePath, size_t bufferSize, ewelborn_syncPolicy syncPolicy)
 {
-	if (n < 0 || n >= eString->length) {
-		return false;
-	}
+	if (bufferSize == 0) { return NULL; }
 
-	if (eString->cstring[n] == c) {
-		ewelborn_string_deleteChar(eString, n);
+	ewelborn_fileWriter* writer = allocateFrom(NULL, sizeof(ewelborn_fileWriter), EWELBORN_ALLOCATION_FILE);
+	if (writer == NULL) { return NULL; }
+	writer->bufferSize = bufferSize;
+	writer->used = 0;
+	writer->syncPolicy = syncPolicy;
+	writer->failed = false;
+	writer->buffer = allocateFrom(NULL, bufferSize, EWELBORN_ALLOCATION_FILE);
+	if (writer->buffer == NULL) { goto CLEAN_UP_AND_CRASH; }
+
+#ifdef _WIN32
+	writer->handle = CreateFileA(filePath->cstring, GENERIC_WRITE, 0, NULL,
+		CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (writer->handle == INVALID_HANDLE_VALUE) { goto CLEAN_UP_AND_CRASH; }
+#else
+	writer->fileDescriptor = open(filePath->cstring, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (writer->fileDescriptor < 0) { goto CLEAN_UP_AND_CRASH; }
+#endif
+
+	return writer;
+
+CLEAN_UP_AND_CRASH:
+	releaseTo(NULL, writer->buffer, EWELBORN_ALLOCATION_FILE);
+	releaseTo(NULL, writer, EWELBORN_ALLOCATION_FILE);
+	return NULL;
+}
+
+bool ewelborn_fileWriter_writeBuffer(ewelborn_fileWriter* writer, const char* buffer, size_t length)
+{
+	if (length <= writer->bufferSize - writer->used) {
+		memcpy(writer->buffer + writer->used, buffer, length);
+		writer->used += length;
 		return true;
 	}
-	else {
-		return false;
+
+	// Anything that can fit in an empty buffer is still worth buffering
+	if (length < writer->bufferSize) {
+		if (fileWriterFlushBuffer(writer) == false) { return false; }
+		memcpy(writer->buffer, buffer, length);
+		writer->used = length;
+		return true;
 	}
+
+	// Anything larger is written straight from where it is, right after the buffer
+	struct writeVector vectors[2] = { { writer->buffer, writer->used }, { buffer, length } };
+	writer->used = 0;
+	if (writeVectors(writer, vectors, 2) == false) { writer->failed = true; }
+	return writer->failed == false;
 }
 
-bool ewelborn_string_sprintf(ewelborn_string* estring, ...)
+bool ewelborn_fileWriter_writeString(ewelborn_fileWriter* writer, ewelborn_string* estring)
 {
-	va_list args;
-	va_start(args, estring);
-
-	// Thank you! https://stackoverflow.com/questions/3919995/determining-sprintf-buffer-size-whats-the-standard
-	int len = vsnprintf(NULL, 0, estring->cstring, args);
-	char* buffer = malloc(len + 1);
-	if (buffer == NULL) { return false; }
-	if (vsprintf_s(buffer, len + 1, estring->cstring, args) < 0) {
-		goto CLEAN_UP_AND_CRASH;
-	}
+	return ewelborn_fileWriter_writeBuffer(writer, estring->cstring, estring->length);
+}
 
-	// Free the original cstring and replace it with the new one
-	free(estring->cstring);
-	estring->cstring = buffer;
-	estring->length = len;
-	estring->maxLength = len + 1;
-	return true;
+bool ewelborn_fileWriter_writeView(ewelborn_fileWriter* writer, ewelborn_stringView view)
+{
+	return ewelborn_fileWriter_writeBuffer(writer, view.data, view.length);
+}
 
-CLEAN_UP_AND_CRASH:
-	free(buffer);
-	return false;
+bool ewelborn_fileWriter_writeLine(ewelborn_fileWriter* writer, ewelborn_string* estring)
+{
+	return ewelborn_fileWriter_writeBuffer(writer, estring->cstring, estring->length) &&
+		ewelborn_fileWriter_writeBuffer(writer, "\n", 1);
 }
 
-ewelborn_dynamicArray* ewelborn_readLinesFromFile(ewelborn_string* filePath)
+bool ewelborn_fileWriter_writeAll(ewelborn_fileWriter* writer, ewelborn_dynamicArray* estrings, bool addNewlines)
 {
-	FILE* inputFile;
-	errno_t err = fopen_s(&inputFile, filePath->cstring, "r");
-	if (err != 0 || inputFile == NULL) {
-		return NULL;
-	}
+	size_t newlineLength = addNewlines ? 1 : 0;
+	int i = 0;
+	while (i < estrings->elements) {
+		ewelborn_string* estring = estrings->array[i];
+		if (estring->length + newlineLength <= writer->bufferSize - writer->used) {
+			memcpy(writer->buffer + writer->used, estring->cstring, estring->length);
+			writer->used += estring->length;
+			if (addNewlines) { writer->buffer[writer->used++] = '\n'; }
+			i++;
+			continue;
+		}
 
-	// Set up the buffer for holding all of the lines read
-	ewelborn_string* inputString = ewelborn_string_initializeEmpty();
-	if (inputString == NULL) { return NULL; }
+		// The buffer is full, so write it along with as many of the remaining
+		// estrings as fit in one batch, straight from the estrings themselves.
+		struct writeVector vectors[WRITE_VECTOR_COUNT];
+		int count = 0;
+		vectors[count].data = writer->buffer;
+		vectors[count++].length = writer->used;
+		while (i < estrings->elements && count + 2 <= WRITE_VECTOR_COUNT) {
+			estring = estrings->array[i++];
+			vectors[count].data = estring->cstring;
+			vectors[count++].length = estring->length;
+			if (addNewlines) {
+				vectors[count].data = "\n";
+				vectors[count++].length = 1;
+			}
+		}
 
-	// Read all of the characters from the file into an estring
-	char c;
-	while ((c = fgetc(inputFile)) != EOF) {
-		ewelborn_string_pushChar(inputString, c);
+		writer->used = 0;
+		if (writeVectors(writer, vectors, count) == false) {
+			writer->failed = true;
+			return false;
+		}
 	}
 
-	// Split the characters on newlines (\n) so we get each line
-	// as its own string.
-	return ewelborn_string_split(inputString, '\n');
+	return writer->failed == false;
 }
 
-bool ewelborn_writeStringToFile(ewelborn_string* filePath, ewelborn_string* content)
+bool ewelborn_fileWriter_flush(ewelborn_fileWriter* writer)
 {
-	FILE* outputFile;
-	errno_t err = fopen_s(&outputFile, filePath->cstring, "w");
-	if (err != 0 || outputFile == NULL) {
-		return false;
+	if (fileWriterFlushBuffer(writer) == false) { return false; }
+	if (writer->syncPolicy == EWELBORN_SYNC_ON_FLUSH && fileWriterSync(writer) == false) {
+		writer->failed = true;
 	}
+	return writer->failed == false;
+}
 
-	if (fputs(content->cstring, outputFile) != 0) {
-		return false;
+bool ewelborn_fileWriter_close(ewelborn_fileWriter* writer)
+{
+	fileWriterFlushBuffer(writer);
+	if (writer->syncPolicy != EWELBORN_SYNC_NEVER && fileWriterSync(writer) == false) {
+		writer->failed = true;
 	}
 
-	return true;
+#ifdef _WIN32
+	if (CloseHandle(writer->handle) == FALSE) { writer->failed = true; }
+#else
+	if (close(writer->fileDescriptor) != 0) { writer->failed = true; }
+#endif
+
+	bool succeeded = writer->failed == false;
+	releaseTo(NULL, writer->buffer, EWELBORN_ALLOCATION_FILE);
+	releaseTo(NULL, writer, EWELBORN_ALLOCATION_FILE);
+	return succeeded;
 }
@@ -27,6 +27,180 @@
 #include <stdbool.h>
 #include <string.h>
 #include <stdarg.h>
+#include <limits.h>
+#include <stdint.h>
+
+// *** MEMORY
+
+// Every allocation is tagged with what it's for, so that allocators can keep
+// track of where their memory goes. Allocators are free to ignore it.
+enum ewelborn_allocationCategory {
+	EWELBORN_ALLOCATION_OTHER,
+	EWELBORN_ALLOCATION_STRING,
+	EWELBORN_ALLOCATION_ARRAY,
+	EWELBORN_ALLOCATION_LIST,
+	EWELBORN_ALLOCATION_HASH_MAP,
+	EWELBORN_ALLOCATION_FILE, // File I/O buffers, mapped files, etc.
+	EWELBORN_ALLOCATION_THREADING,
+	EWELBORN_ALLOCATION_CATEGORY_COUNT
+} typedef ewelborn_allocationCategory;
+
+// ewelborn_allocators decide where the library's memory comes from. Every
+// function is given the allocator's context as its first argument.
+//
+// There is always a global allocator (which uses malloc, realloc, and free
+// unless it's changed), and the datastructures that have an
+// *_initializeWithAllocator function can be given an allocator of their own,
+// which they'll keep using for as long as they live.
+struct ewelborn_allocator {
+	// Works the same way as malloc.
+	void* (*allocate)(void* context, size_t size, ewelborn_allocationCategory category);
+	// Works the same way as realloc, but is also told how many bytes were
+	// allocated before. Must handle a null pointer.
+	void* (*reallocate)(void* context, void* pointer, size_t oldSize, size_t newSize, ewelborn_allocationCategory category);
+	// Works the same way as free. Must handle a null pointer.
+	void (*release)(void* context, void* pointer, ewelborn_allocationCategory category);
+	void* context;
+} typedef ewelborn_allocator;
+
+// Returns the allocator that uses malloc, realloc, and free.
+ewelborn_allocator* ewelborn_getHeapAllocator();
+
+// Returns the global allocator.
+ewelborn_allocator* ewelborn_getAllocator();
+
+// Makes the given allocator (or the heap allocator, if allocator is null) the
+// global allocator. The allocator must stay alive for as long as it's in use.
+// WARNING! Anything that was created without an allocator of its own will be
+// freed through whichever allocator is global at the time, so this should be
+// called once at startup, before anything else is created, and never from
+// several threads at once.
+void ewelborn_setAllocator(ewelborn_allocator* allocator);
+
+// These functions allocate, reallocate, and release memory through the given
+// allocator (or the global allocator, if allocator is null). This is handy for
+// elements that are handed to a datastructure which will free them later,
+// such as the elements of a dynamicArray.
+void* ewelborn_allocator_allocate(ewelborn_allocator* allocator, size_t size, ewelborn_allocationCategory category);
+void* ewelborn_allocator_reallocate(ewelborn_allocator* allocator, void* pointer, size_t oldSize, size_t newSize, ewelborn_allocationCategory category);
+void ewelborn_allocator_release(ewelborn_allocator* allocator, void* pointer, ewelborn_allocationCategory category);
+
+// Allocation statistics for an allocator, or for one category of allocations.
+struct ewelborn_allocationStats {
+	long long allocations; // Number of allocations, not counting reallocations
+	long long reallocations;
+	long long releases;
+	long long liveBytes; // Bytes that have been allocated but not released yet
+	long long peakBytes; // The most bytes that have ever been live at once
+} typedef ewelborn_allocationStats;
+
+// ewelborn_statsAllocators pass every allocation through to another allocator,
+// and count them along the way, both in total and for each category. This is
+// useful for finding out how much memory a program really uses, and where it
+// goes, so that containers can be sized (or given an arena) accordingly.
+//
+// Counting is thread safe. Each allocation carries a small header that
+// remembers its size and category, so memory that was allocated through the
+// stats allocator must be released through it as well.
+struct ewelborn_statsAllocator {
+	ewelborn_allocator allocator; // Hand this to anything that takes an allocator
+	ewelborn_allocator* backing; // Where the memory really comes from
+	ewelborn_allocationStats total;
+	ewelborn_allocationStats categories[EWELBORN_ALLOCATION_CATEGORY_COUNT];
+} typedef ewelborn_statsAllocator;
+
+// Attempts to create a stats allocator that gets its memory from the given
+// allocator (or the heap allocator, if backing is null). Returns the stats
+// allocator if successful, returns null otherwise.
+ewelborn_statsAllocator* ewelborn_statsAllocator_initialize(ewelborn_allocator* backing);
+
+// Returns the statistics for every allocation made through the stats allocator.
+ewelborn_allocationStats ewelborn_statsAllocator_getTotal(ewelborn_statsAllocator* stats);
+
+// Returns the statistics for the allocations in the given category.
+ewelborn_allocationStats ewelborn_statsAllocator_getCategory(ewelborn_statsAllocator* stats, ewelborn_allocationCategory category);
+
+// Zeroes the allocation, reallocation, and release counts, and starts the peak
+// over from the bytes that are live right now.
+void ewelborn_statsAllocator_resetCounts(ewelborn_statsAllocator* stats);
+
+// Writes a table of the statistics, one row per category, to the given file.
+void ewelborn_statsAllocator_print(ewelborn_statsAllocator* stats, FILE* file);
+
+// This function will free the stats allocator. Memory that is still live is
+// left alone, and must not be released through the stats allocator afterwards.
+void ewelborn_statsAllocator_free(ewelborn_statsAllocator* stats);
+
+// ewelborn_arenas (also known as regions) hand out memory by bumping a
+// pointer through large chunks of memory, which makes allocating from them
+// much cheaper than malloc. Nothing allocated from an arena is freed on its
+// own, instead, everything in the arena is released at once by resetting it.
+// This makes arenas a good fit for data that all dies at the same time, such
+// as all of the estrings that come from parsing a file.
+//
+// When a chunk runs out of room, a new chunk is chained onto it. Chunks are
+// kept around when the arena is reset, so that they can be reused.
+#define EWELBORN_ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+#define EWELBORN_ARENA_ALIGNMENT 16
+struct ewelborn_arenaChunk {
+	struct ewelborn_arenaChunk* next;
+	size_t size; // Number of bytes that the chunk can hold
+	size_t used; // Number of bytes that have been handed out
+} typedef ewelborn_arenaChunk;
+
+struct ewelborn_arena {
+	ewelborn_arenaChunk* first;
+	ewelborn_arenaChunk* current; // The chunk that is being allocated from
+	size_t chunkSize;
+	// Allocates from the arena, for anything that takes an allocator. Releasing
+	// memory through it does nothing, as usual for an arena.
+	ewelborn_allocator allocator;
+	ewelborn_allocator* backing; // Where the arena's chunks come from
+} typedef ewelborn_arena;
+
+// A position in an arena that can be returned to later, which will release
+// everything that was allocated after the mark was taken.
+struct ewelborn_arenaMark {
+	ewelborn_arenaChunk* chunk;
+	size_t used;
+} typedef ewelborn_arenaMark;
+
+// Attempts to create an arena that allocates chunks of the given size (or
+// EWELBORN_ARENA_DEFAULT_CHUNK_SIZE if chunkSize is 0). Returns the arena if
+// successful, returns null otherwise.
+ewelborn_arena* ewelborn_arena_initialize(size_t chunkSize);
+
+// This function works the same way as ewelborn_arena_initialize, but the
+// arena and its chunks are allocated through the given allocator (or the
+// global allocator, if backing is null).
+ewelborn_arena* ewelborn_arena_initializeWithAllocator(size_t chunkSize, ewelborn_allocator* backing);
+
+// Attempts to allocate size bytes from the arena. The memory is aligned to
+// EWELBORN_ARENA_ALIGNMENT bytes, and is *not* cleared. Allocations that are
+// larger than the chunk size get a chunk of their own. Returns a pointer to
+// the memory if successful, returns null otherwise.
+void* ewelborn_arena_allocate(ewelborn_arena* arena, size_t size);
+
+// Attempts to resize an allocation from the arena to newSize bytes. If the
+// allocation is the most recent one in the arena, it will be resized in
+// place, otherwise, it will be copied to a new allocation. Returns a pointer
+// to the memory if successful, returns null otherwise (the original
+// allocation is left alone).
+void* ewelborn_arena_reallocate(ewelborn_arena* arena, void* pointer, size_t oldSize, size_t newSize);
+
+// Returns a mark of the arena's current position.
+ewelborn_arenaMark ewelborn_arena_mark(ewelborn_arena* arena);
+
+// Releases everything that was allocated from the arena since the mark was taken.
+void ewelborn_arena_resetToMark(ewelborn_arena* arena, ewelborn_arenaMark mark);
+
+// Releases everything that was allocated from the arena. The arena keeps
+// its chunks so that they can be reused.
+void ewelborn_arena_reset(ewelborn_arena* arena);
+
+// This function will free all memory allocated to a given arena, including
+// everything that was allocated from it.
+void ewelborn_arena_free(ewelborn_arena* arena);
 
 // *** DATASTRUCTURES
 
@@ -39,12 +213,27 @@ struct ewelborn_dynamicArray {
 	void** array;
 	int elements; // Number of elements in the array
 	int maxElements; // Maximum number of elements given current array allocation
+	ewelborn_allocator* allocator; // Where the array's memory comes from
+	// Called on every element by ewelborn_dynamicArray_free. This is free by
+	// default, since elements are usually malloc'd by the caller, and null
+	// keeps the elements. Arrays in an arena default to null.
+	void(*freeElement)(void* element);
 } typedef ewelborn_dynamicArray;
 
 // Attempts to create a dynamic array. If the creation is successful, then
 // the dynamic array will be returned - otherwise, it will return null.
 ewelborn_dynamicArray* ewelborn_dynamicArray_initialize();
 
+// Attempts to create a dynamic array inside of the given arena (or on the heap
+// if arena is null). The array will grow inside of the arena as well.
+// Returns the dynamic array if successful, returns null otherwise.
+ewelborn_dynamicArray* ewelborn_dynamicArray_initializeInArena(ewelborn_arena* arena);
+
+// Attempts to create a dynamic array whose memory comes from the given
+// allocator (or the global allocator, if allocator is null). Returns the
+// dynamic array if successful, returns null otherwise.
+ewelborn_dynamicArray* ewelborn_dynamicArray_initializeWithAllocator(ewelborn_allocator* allocator);
+
 // Attempts to insert an element (given by a pointer) at the end of
 // the dynamic array, which will be resized if the array isn't large enough.
 // Returns true if the insertion is successful, returns false otherwise.
@@ -53,12 +242,113 @@ bool ewelborn_dynamicArray_push(ewelborn_dynamicArray* dynamicArray, void* eleme
 // This function will free all memory allocated to a given dynamicArray.
 // WARNING! This will attempt to free all element pointers in the dynamicArray,
 // if you want to keep your elements, then copy them to a safe place!
+// Every element is passed to the dynamicArray's freeElement function, which
+// is free unless it's been changed (arrays of estrings made by this library,
+// such as the ones from ewelborn_string_split, free their estrings properly).
+// Arrays in an arena don't free their elements unless freeElement is set.
+// The dynamicArray's own memory is released through its allocator, or left
+// for the arena to release when the arena is reset.
 void ewelborn_dynamicArray_free(ewelborn_dynamicArray* dynamicArray);
 
 // This function will iterate over every element in the given dynamic array
 // and will call the given function on the element.
 void ewelborn_dynamicArray_traverse(ewelborn_dynamicArray* dynamicArray, void(*f)(void*));
 
+// This function works the same way as ewelborn_dynamicArray_traverse, but the
+// elements are split between threadCount threads (or one thread per processor
+// if threadCount <= 0), which each call the given function on their share of
+// the elements. The function must be safe to call from several threads at
+// once, and elements are *not* visited in order. This function returns once
+// every element has been visited.
+void ewelborn_dynamicArray_traverseParallel(ewelborn_dynamicArray* dynamicArray, void(*f)(void*), int threadCount);
+
+// ewelborn_typedArrays are dynamic arrays that store their elements directly
+// inside of the array, instead of storing pointers to them. All of the
+// elements must be the same size, which is given when the array is created.
+// This makes them a much better fit than ewelborn_dynamicArray for numbers
+// and small structs, since pushing an element doesn't need its own malloc,
+// and the elements sit next to each other in memory.
+//
+// Elements can be reached directly with EWELBORN_TYPED_ARRAY_AT, ex.
+//	ewelborn_typedArray* numbers = EWELBORN_TYPED_ARRAY_INITIALIZE(int);
+//	EWELBORN_TYPED_ARRAY_PUSH(numbers, int, 5);
+//	EWELBORN_TYPED_ARRAY_AT(numbers, int, 0) += 1;
+struct ewelborn_typedArray {
+	void* data;
+	size_t elementSize; // Size of each element in bytes
+	int elements; // Number of elements in the array
+	int maxElements; // Maximum number of elements given current array allocation
+	ewelborn_allocator* allocator; // Where the array's memory comes from
+} typedef ewelborn_typedArray;
+
+#define EWELBORN_TYPED_ARRAY_INITIALIZE(type) ewelborn_typedArray_initialize(sizeof(type))
+#define EWELBORN_TYPED_ARRAY_DATA(typedArray, type) ((type*)(typedArray)->data)
+#define EWELBORN_TYPED_ARRAY_AT(typedArray, type, n) (((type*)(typedArray)->data)[n])
+#define EWELBORN_TYPED_ARRAY_PUSH(typedArray, type, value) ewelborn_typedArray_push((typedArray), &(type){ value })
+
+// Attempts to create a typed array for elements that are elementSize bytes
+// large. Returns the typed array if successful, returns null otherwise.
+ewelborn_typedArray* ewelborn_typedArray_initialize(size_t elementSize);
+
+// Attempts to create a typed array inside of the given arena (or on the heap
+// if arena is null). The array will grow inside of the arena as well.
+// Returns the typed array if successful, returns null otherwise.
+ewelborn_typedArray* ewelborn_typedArray_initializeInArena(size_t elementSize, ewelborn_arena* arena);
+
+// Attempts to create a typed array whose memory comes from the given
+// allocator (or the global allocator, if allocator is null). Returns the
+// typed array if successful, returns null otherwise.
+ewelborn_typedArray* ewelborn_typedArray_initializeWithAllocator(size_t elementSize, ewelborn_allocator* allocator);
+
+// Returns a pointer to the nth element in the typed array, or null if n is
+// greater than or equal to the number of elements, or less than 0. The
+// pointer is only valid until the array is resized.
+void* ewelborn_typedArray_get(ewelborn_typedArray* typedArray, int n);
+
+// Attempts to copy an element (given by a pointer) to the end of the typed
+// array, which will be resized if the array isn't large enough. The element
+// may be one of the typed array's own. Returns true if successful, false
+// otherwise.
+bool ewelborn_typedArray_push(ewelborn_typedArray* typedArray, const void* element);
+
+// Attempts to copy count elements from the given buffer to the end of the
+// typed array, resizing the array at most once. The buffer may be part of
+// the typed array itself. Returns true if successful, false otherwise.
+bool ewelborn_typedArray_appendMany(ewelborn_typedArray* typedArray, const void* elements, int count);
+
+// Removes the last element of the typed array, and copies it into element
+// unless element is null. Returns true if successful, or false if the
+// array is empty.
+bool ewelborn_typedArray_pop(ewelborn_typedArray* typedArray, void* element);
+
+// Attempts to copy an element (given by a pointer) into the nth position of
+// the typed array, moving every element after it one position to the right.
+// n may be equal to the number of elements, in which case this is the same
+// as a push, and the element may be one of the typed array's own. Returns
+// true if successful, false otherwise.
+bool ewelborn_typedArray_insert(ewelborn_typedArray* typedArray, int n, const void* element);
+
+// Removes the nth element of the typed array, moving every element after it
+// one position to the left. Returns true if successful, or false if n is
+// greater than or equal to the number of elements, or less than 0.
+bool ewelborn_typedArray_remove(ewelborn_typedArray* typedArray, int n);
+
+// Removes every element from the typed array, without freeing any memory.
+void ewelborn_typedArray_clear(ewelborn_typedArray* typedArray);
+
+// Attempts to grow the typed array so that it can hold at least n elements
+// without being resized. Returns true if successful, false otherwise.
+bool ewelborn_typedArray_reserve(ewelborn_typedArray* typedArray, int n);
+
+// Attempts to shrink the typed array's memory so that it only has room for
+// the elements that it already has. Returns true if successful, false otherwise.
+bool ewelborn_typedArray_shrinkToFit(ewelborn_typedArray* typedArray);
+
+// This function will free all memory allocated to a given typed array. If the
+// typed array was allocated from an arena, then this does nothing, as the
+// array is released when the arena is reset.
+void ewelborn_typedArray_free(ewelborn_typedArray* typedArray);
+
 struct ewelborn_linkedList {
 	void* element;
 	struct ewelborn_linkedList* next;
@@ -76,6 +366,8 @@ bool ewelborn_linkedList_insert(ewelborn_linkedList* list, void* newElement);
 
 // This function will attempt to insert an element at the end of the
 // given linked list. Returns true if successful, returns false otherwise.
+// This has to walk the whole list to find the end, so if you need to push
+// to the back often, look at ewelborn_list instead.
 bool ewelborn_linkedList_pushToBack(ewelborn_linkedList* list, void* newElement);
 
 // This function will iterate over every element in the given linked list
@@ -86,6 +378,359 @@ void ewelborn_linkedList_traverse(ewelborn_linkedList* list, void(*f)(void*));
 // return the new head of the list
 ewelborn_linkedList* ewelborn_linkedList_reverse(ewelborn_linkedList* list);
 
+// ewelborn_nodePools hand out fixed-size nodes from large slabs of memory,
+// instead of allocating every node separately. Nodes from the same slab sit
+// next to each other in memory, and released nodes are reused before any
+// new slabs are allocated.
+#define EWELBORN_NODE_POOL_DEFAULT_NODES_PER_SLAB 256
+struct ewelborn_nodePool {
+	size_t nodeSize;
+	int nodesPerSlab;
+	void* freeNodes; // Released nodes, linked together through their first bytes
+	void* slabs; // Every slab, linked together through their first bytes
+	char* unusedNodes; // Nodes in the newest slab that have never been handed out
+	int unusedNodeCount;
+	ewelborn_allocator* allocator; // Where the slabs come from
+} typedef ewelborn_nodePool;
+
+// Attempts to create a node pool for nodes that are nodeSize bytes large,
+// allocating nodesPerSlab nodes at a time (or
+// EWELBORN_NODE_POOL_DEFAULT_NODES_PER_SLAB if nodesPerSlab is 0). Returns the
+// node pool if successful, returns null otherwise.
+ewelborn_nodePool* ewelborn_nodePool_initialize(size_t nodeSize, int nodesPerSlab);
+
+// This function works the same way as ewelborn_nodePool_initialize, but the
+// pool and its slabs are allocated through the given allocator (or the global
+// allocator, if allocator is null). Lists that use the pool are allocated
+// through it as well.
+ewelborn_nodePool* ewelborn_nodePool_initializeWithAllocator(size_t nodeSize, int nodesPerSlab, ewelborn_allocator* allocator);
+
+// Attempts to take a node from the pool. Returns the node if successful,
+// returns null otherwise.
+void* ewelborn_nodePool_allocate(ewelborn_nodePool* pool);
+
+// Gives a node back to the pool so that it can be reused.
+void ewelborn_nodePool_release(ewelborn_nodePool* pool, void* node);
+
+// This function will free all memory allocated to a given node pool,
+// including every node that was taken from it.
+void ewelborn_nodePool_free(ewelborn_nodePool* pool);
+
+// ewelborn_lists are doubly linked lists that keep track of their head, tail
+// and size, so pushing and popping at either end is O(1), and so is splicing
+// two lists together. Nodes come from a node pool, so building a list doesn't
+// malloc once per element.
+struct ewelborn_listNode {
+	void* element;
+	struct ewelborn_listNode* next;
+	struct ewelborn_listNode* previous;
+} typedef ewelborn_listNode;
+
+struct ewelborn_list {
+	ewelborn_listNode* head;
+	ewelborn_listNode* tail;
+	int size;
+	ewelborn_nodePool* pool;
+	bool ownsPool; // True if the pool was created for this list alone
+} typedef ewelborn_list;
+
+// Attempts to create an empty list with a node pool of its own. Returns the
+// list if successful, returns null otherwise.
+ewelborn_list* ewelborn_list_initialize();
+
+// Attempts to create an empty list that takes its nodes from the given pool,
+// which can be shared between lists. Lists can only be spliced together if
+// they share a pool. The pool's nodes must be at least
+// sizeof(ewelborn_listNode) bytes large. Returns the list if successful,
+// returns null otherwise.
+ewelborn_list* ewelborn_list_initializeWithPool(ewelborn_nodePool* pool);
+
+// Attempts to insert an element at the front of the list. Returns true if
+// successful, false otherwise.
+bool ewelborn_list_pushToFront(ewelborn_list* list, void* element);
+
+// Attempts to insert an element at the back of the list. Returns true if
+// successful, false otherwise.
+bool ewelborn_list_pushToBack(ewelborn_list* list, void* element);
+
+// Removes the element at the front of the list and returns it, or returns
+// null if the list is empty.
+void* ewelborn_list_popFront(ewelborn_list* list);
+
+// Removes the element at the back of the list and returns it, or returns
+// null if the list is empty.
+void* ewelborn_list_popBack(ewelborn_list* list);
+
+// Returns the element at the front of the list, or null if the list is empty.
+void* ewelborn_list_peekFront(ewelborn_list* list);
+
+// Returns the element at the back of the list, or null if the list is empty.
+void* ewelborn_list_peekBack(ewelborn_list* list);
+
+// Moves every element of the other list to the back of the given list,
+// leaving the other list empty. Returns true if successful, or false if the
+// lists don't share a node pool.
+bool ewelborn_list_splice(ewelborn_list* list, ewelborn_list* other);
+
+// This function will iterate over every element in the given list, from
+// front to back, and will call the given function on the element.
+void ewelborn_list_traverse(ewelborn_list* list, void(*f)(void*));
+
+// This function will free all memory allocated to a given list.
+// WARNING! This will attempt to free all element pointers in the list,
+// if you want to keep your elements, then copy them to a safe place!
+// The elements are freed with free, since they're the caller's, while the
+// nodes go back to the list's node pool.
+void ewelborn_list_free(ewelborn_list* list);
+
+// ewelborn_unrolledLists are linked lists that store several elements in
+// each node instead of one, which means far fewer nodes to chase through
+// memory when traversing the list. Pushing and popping at either end is O(1).
+#define EWELBORN_UNROLLED_LIST_NODE_CAPACITY 16
+struct ewelborn_unrolledListNode {
+	struct ewelborn_unrolledListNode* next;
+	struct ewelborn_unrolledListNode* previous;
+	int start; // Position of the first element in use
+	int count; // Number of elements in use, starting from start
+	void* elements[EWELBORN_UNROLLED_LIST_NODE_CAPACITY];
+} typedef ewelborn_unrolledListNode;
+
+struct ewelborn_unrolledList {
+	ewelborn_unrolledListNode* head;
+	ewelborn_unrolledListNode* tail;
+	int size; // Number of elements, not nodes
+	ewelborn_nodePool* pool;
+	bool ownsPool; // True if the pool was created for this list alone
+} typedef ewelborn_unrolledList;
+
+// Attempts to create an empty unrolled list with a node pool of its own.
+// Returns the list if successful, returns null otherwise.
+ewelborn_unrolledList* ewelborn_unrolledList_initialize();
+
+// Attempts to create an empty unrolled list that takes its nodes from the
+// given pool, which can be shared between lists. The pool's nodes must be at
+// least sizeof(ewelborn_unrolledListNode) bytes large. Returns the list if
+// successful, returns null otherwise.
+ewelborn_unrolledList* ewelborn_unrolledList_initializeWithPool(ewelborn_nodePool* pool);
+
+// Attempts to insert an element at the front of the list. Returns true if
+// successful, false otherwise.
+bool ewelborn_unrolledList_pushToFront(ewelborn_unrolledList* list, void* element);
+
+// Attempts to insert an element at the back of the list. Returns true if
+// successful, false otherwise.
+bool ewelborn_unrolledList_pushToBack(ewelborn_unrolledList* list, void* element);
+
+// Removes the element at the front of the list and returns it, or returns
+// null if the list is empty.
+void* ewelborn_unrolledList_popFront(ewelborn_unrolledList* list);
+
+// Removes the element at the back of the list and returns it, or returns
+// null if the list is empty.
+void* ewelborn_unrolledList_popBack(ewelborn_unrolledList* list);
+
+// Returns the element at the front of the list, or null if the list is empty.
+void* ewelborn_unrolledList_peekFront(ewelborn_unrolledList* list);
+
+// Returns the element at the back of the list, or null if the list is empty.
+void* ewelborn_unrolledList_peekBack(ewelborn_unrolledList* list);
+
+// Moves every element of the other list to the back of the given list,
+// leaving the other list empty. Returns true if successful, or false if the
+// lists don't share a node pool.
+bool ewelborn_unrolledList_splice(ewelborn_unrolledList* list, ewelborn_unrolledList* other);
+
+// This function will iterate over every element in the given list, from
+// front to back, and will call the given function on the element.
+void ewelborn_unrolledList_traverse(ewelborn_unrolledList* list, void(*f)(void*));
+
+// This function will free all memory allocated to a given unrolled list.
+// WARNING! This will attempt to free all element pointers in the list,
+// if you want to keep your elements, then copy them to a safe place!
+// The elements are freed with free, since they're the caller's, while the
+// nodes go back to the list's node pool.
+void ewelborn_unrolledList_free(ewelborn_unrolledList* list);
+
+// ewelborn_priorityQueues are min-heaps: popping always returns the element
+// with the smallest priority. The heap is a 4-ary heap stored in one array,
+// with each priority stored next to its element, so finding the smallest
+// child only reads four neighbouring entries instead of chasing pointers,
+// and the heap is half as tall as a binary heap. Elements with equal
+// priorities are popped in no particular order.
+struct ewelborn_priorityQueueEntry {
+	double priority;
+	void* element;
+} typedef ewelborn_priorityQueueEntry;
+
+struct ewelborn_priorityQueue {
+	ewelborn_priorityQueueEntry* entries; // In heap order, entries[0] is the smallest
+	int size; // Number of entries in the queue
+	int maxSize; // Maximum number of entries given current allocation
+	ewelborn_allocator* allocator; // Where the queue's memory comes from
+} typedef ewelborn_priorityQueue;
+
+// Attempts to create an empty priority queue. Returns the queue if
+// successful, returns null otherwise.
+ewelborn_priorityQueue* ewelborn_priorityQueue_initialize();
+
+// Attempts to create an empty priority queue whose memory comes from the
+// given allocator (or the global allocator, if allocator is null). Returns
+// the queue if successful, returns null otherwise.
+ewelborn_priorityQueue* ewelborn_priorityQueue_initializeWithAllocator(ewelborn_allocator* allocator);
+
+// Attempts to create a priority queue holding a copy of the given entries.
+// The heap is built in O(n) time, instead of the O(n log n) it would take to
+// push them one at a time. Returns the queue if successful, returns null
+// otherwise.
+ewelborn_priorityQueue* ewelborn_priorityQueue_initializeFromEntries(const ewelborn_priorityQueueEntry* entries, int count);
+
+// Attempts to insert an element with the given priority. Returns true if
+// successful, false otherwise.
+bool ewelborn_priorityQueue_push(ewelborn_priorityQueue* queue, void* element, double priority);
+
+// Attempts to insert count entries at once, resizing the queue at most once.
+// When there are more new entries than old ones, the heap is rebuilt in
+// O(n) time instead of inserting them one at a time. Returns true if
+// successful, or false (without inserting any of them) otherwise.
+bool ewelborn_priorityQueue_pushMany(ewelborn_priorityQueue* queue, const ewelborn_priorityQueueEntry* entries, int count);
+
+// Removes the element with the smallest priority, and stores it in element
+// and its priority in priority, unless they are null. Returns true if
+// successful, or false if the queue is empty.
+bool ewelborn_priorityQueue_pop(ewelborn_priorityQueue* queue, void** element, double* priority);
+
+// Works the same way as ewelborn_priorityQueue_pop, but leaves the element
+// in the queue.
+bool ewelborn_priorityQueue_peek(ewelborn_priorityQueue* queue, void** element, double* priority);
+
+// Removes every element from the queue, without freeing any memory.
+void ewelborn_priorityQueue_clear(ewelborn_priorityQueue* queue);
+
+// This function will free all memory allocated to a given priority queue.
+// The elements in the queue are *not* freed.
+void ewelborn_priorityQueue_free(ewelborn_priorityQueue* queue);
+
+// ewelborn_indexedPriorityQueues work the same way as priority queues, but
+// the elements are handles from 0 to capacity - 1 (ex. the nodes of a graph),
+// and the queue keeps track of where each handle is in the heap. This means
+// that a handle's priority can be changed while it's in the queue, which is
+// what Dijkstra's algorithm and A* need, without pushing the handle a second
+// time. Each handle can be in the queue at most once.
+struct ewelborn_indexedPriorityQueueEntry {
+	double priority;
+	int handle;
+} typedef ewelborn_indexedPriorityQueueEntry;
+
+struct ewelborn_indexedPriorityQueue {
+	ewelborn_indexedPriorityQueueEntry* entries; // In heap order, entries[0] is the smallest
+	int* positions; // Where each handle is in entries, or -1 if it isn't in the queue
+	int size; // Number of handles in the queue
+	int capacity; // Handles go from 0 to capacity - 1
+	ewelborn_allocator* allocator; // Where the queue's memory comes from
+} typedef ewelborn_indexedPriorityQueue;
+
+// Attempts to create an empty indexed priority queue for handles from 0 to
+// capacity - 1. Returns the queue if successful, returns null otherwise.
+ewelborn_indexedPriorityQueue* ewelborn_indexedPriorityQueue_initialize(int capacity);
+
+// Attempts to create an empty indexed priority queue whose memory comes from
+// the given allocator (or the global allocator, if allocator is null).
+// Returns the queue if successful, returns null otherwise.
+ewelborn_indexedPriorityQueue* ewelborn_indexedPriorityQueue_initializeWithAllocator(int capacity, ewelborn_allocator* allocator);
+
+// Attempts to insert a handle with the given priority. Returns true if
+// successful, or false if the handle is out of range or already in the queue.
+bool ewelborn_indexedPriorityQueue_push(ewelborn_indexedPriorityQueue* queue, int handle, double priority);
+
+// Lowers the priority of a handle that is in the queue. Returns true if
+// successful, or false if the handle isn't in the queue, or priority isn't
+// lower than its current priority.
+// Ex. relaxing an edge in Dijkstra's algorithm
+//	if (ewelborn_indexedPriorityQueue_contains(queue, v) == false) {
+//		ewelborn_indexedPriorityQueue_push(queue, v, distance);
+//	}
+//	else {
+//		ewelborn_indexedPriorityQueue_decreasePriority(queue, v, distance);
+//	}
+bool ewelborn_indexedPriorityQueue_decreasePriority(ewelborn_indexedPriorityQueue* queue, int handle, double priority);
+
+// Sets the priority of a handle, whether that's higher or lower than its
+// current priority, and inserts the handle if it isn't in the queue. Returns
+// true if successful, or false if the handle is out of range.
+bool ewelborn_indexedPriorityQueue_update(ewelborn_indexedPriorityQueue* queue, int handle, double priority);
+
+// Removes the handle with the smallest priority, and stores it in handle and
+// its priority in priority, unless they are null. Returns true if
+// successful, or false if the queue is empty.
+bool ewelborn_indexedPriorityQueue_pop(ewelborn_indexedPriorityQueue* queue, int* handle, double* priority);
+
+// Works the same way as ewelborn_indexedPriorityQueue_pop, but leaves the
+// handle in the queue.
+bool ewelborn_indexedPriorityQueue_peek(ewelborn_indexedPriorityQueue* queue, int* handle, double* priority);
+
+// Removes a handle from the queue. Returns true if successful, or false if
+// the handle isn't in the queue.
+bool ewelborn_indexedPriorityQueue_remove(ewelborn_indexedPriorityQueue* queue, int handle);
+
+// Returns true if the handle is in the queue, false otherwise.
+bool ewelborn_indexedPriorityQueue_contains(ewelborn_indexedPriorityQueue* queue, int handle);
+
+// Stores the priority of a handle in priority. Returns true if successful,
+// or false if the handle isn't in the queue.
+bool ewelborn_indexedPriorityQueue_getPriority(ewelborn_indexedPriorityQueue* queue, int handle, double* priority);
+
+// Removes every handle from the queue, without freeing any memory.
+void ewelborn_indexedPriorityQueue_clear(ewelborn_indexedPriorityQueue* queue);
+
+// This function will free all memory allocated to a given indexed priority queue.
+void ewelborn_indexedPriorityQueue_free(ewelborn_indexedPriorityQueue* queue);
+
+// ewelborn_radixHeaps are priority queues for integer keys that never go
+// below the last key that was popped, which is always true of the distances
+// in Dijkstra's algorithm with integer edge weights. Keys are sorted into
+// 65 buckets by the highest bit where they differ from the last key popped,
+// and each key moves to a lower bucket at most 64 times, so pushing is O(1)
+// and popping is O(log C) amortized (where C is the largest key), with no
+// comparisons between keys most of the time.
+struct ewelborn_radixHeapEntry {
+	uint64_t key;
+	void* element;
+} typedef ewelborn_radixHeapEntry;
+
+struct ewelborn_radixHeap {
+	ewelborn_typedArray* buckets[65]; // Bucket 0 only holds keys equal to last
+	uint64_t last; // The last key popped, no key smaller than this can be pushed
+	int size; // Number of entries in the heap
+	ewelborn_allocator* allocator; // Where the heap's memory comes from
+} typedef ewelborn_radixHeap;
+
+// Attempts to create an empty radix heap. Returns the heap if successful,
+// returns null otherwise.
+ewelborn_radixHeap* ewelborn_radixHeap_initialize();
+
+// Attempts to create an empty radix heap whose memory (including its
+// buckets) comes from the given allocator (or the global allocator, if
+// allocator is null). Returns the heap if successful, returns null otherwise.
+ewelborn_radixHeap* ewelborn_radixHeap_initializeWithAllocator(ewelborn_allocator* allocator);
+
+// Attempts to insert an element with the given key. Returns true if
+// successful, or false if the key is smaller than the last key popped, or
+// memory couldn't be allocated.
+bool ewelborn_radixHeap_push(ewelborn_radixHeap* heap, void* element, uint64_t key);
+
+// Removes an element with the smallest key, and stores it in element and its
+// key in key, unless they are null. Returns true if successful, or false if
+// the heap is empty.
+bool ewelborn_radixHeap_pop(ewelborn_radixHeap* heap, void** element, uint64_t* key);
+
+// Works the same way as ewelborn_radixHeap_pop, but leaves the element in
+// the heap.
+bool ewelborn_radixHeap_peek(ewelborn_radixHeap* heap, void** element, uint64_t* key);
+
+// This function will free all memory allocated to a given radix heap. The
+// elements in the heap are *not* freed.
+void ewelborn_radixHeap_free(ewelborn_radixHeap* heap);
+
 // *** STRING MANIPULATION
 
 // ewelborn_strings, or Estrings, are wrappers for Cstrings that provide
@@ -97,14 +742,28 @@ ewelborn_linkedList* ewelborn_linkedList_reverse(ewelborn_linkedList* list);
 //			backing cstring is not directly manipulated.
 //	4.	Estrings have functions that provide common string manipulation,
 //			such as 
+//
+// Short estrings (less than EWELBORN_STRING_INLINE_SIZE characters) are
+// stored directly inside of the estring, so they don't need a second
+// allocation for their characters. They move to their own memory as soon as
+// they grow too long. Since cstring may point inside of the estring itself,
+// estrings should never be copied by value, use ewelborn_string_clone instead.
+#define EWELBORN_STRING_INLINE_SIZE 16
 struct ewelborn_string {
 	// This is a dynamic array, but we don't want to use the generic
 	// ewelborn_dynamicArray implementation because that implementation
 	// has pointer elements, which is way too much overhead compared to
 	// char elements.
-	char* cstring;
+	//
+	// Deleting characters from the front doesn't move the rest of them,
+	// instead, cstring moves forward past the deleted characters. They're
+	// moved back to the start of the buffer later, once the room is needed.
+	char* cstring; // Points at inlineBuffer (+ start) while the estring is short
 	int length; // Not including the null terminator
-	int maxLength; // Including the null terminator
+	int maxLength; // Room from cstring onwards, including the null terminator
+	int start; // Number of deleted characters in front of cstring
+	ewelborn_allocator* allocator; // Where the estring's memory comes from
+	char inlineBuffer[EWELBORN_STRING_INLINE_SIZE];
 } typedef ewelborn_string;
 
 // Attempts to insert a character at the end of the string while retaining
@@ -121,21 +780,54 @@ char ewelborn_string_getChar(ewelborn_string* eString, int n);
 // null otherwise.
 ewelborn_string* ewelborn_string_initializeEmpty();
 
+// Attempts to create an empty estring inside of the given arena (or on the
+// heap if arena is null). The estring will grow inside of the arena as well.
+// Returns the estring if successful, returns null otherwise.
+ewelborn_string* ewelborn_string_initializeInArena(ewelborn_arena* arena);
+
+// Attempts to create an empty estring whose memory comes from the given
+// allocator (or the global allocator, if allocator is null). Returns the
+// estring if successful, returns null otherwise.
+ewelborn_string* ewelborn_string_initializeWithAllocator(ewelborn_allocator* allocator);
+
+// This function will make sure that the estring has room for at least length
+// characters (not including the null terminator), so that appending up to
+// that many characters won't need to resize the estring. Returns true if
+// successful, false otherwise.
+bool ewelborn_string_reserve(ewelborn_string* estring, int length);
+
+// This function will attempt to append the first length characters of the
+// buffer to the end of a given estring. The buffer may contain null
+// characters, which makes this useful for binary data. Returns true if
+// successful, false otherwise (the estring is left unmodified).
+bool ewelborn_string_appendN(ewelborn_string* estring, const char* buffer, int length);
+
 // This function will attempt to append a given cstring to the end of
-// a given estring. Returns true if successful, false otherwise. This
-// function is *not* guaranteed to keep the estring unmodified if unsuccessful.
+// a given estring. Returns true if successful, false otherwise (the estring
+// is left unmodified).
 bool ewelborn_string_appendCString(ewelborn_string* estring, char* cstring);
 
 // This function will attempt to append the appendString estring to the end of
 // the given estring. Returns true if successful, false otherwise.
 bool ewelborn_string_append(ewelborn_string* estring, ewelborn_string* appendString);
 
+// This function will attempt to append every estring in the dynamic array
+// to the end of the given estring, in order, resizing the estring at most
+// once. Returns true if successful, false otherwise (the estring is left
+// unmodified).
+bool ewelborn_string_appendMany(ewelborn_string* estring, ewelborn_dynamicArray* appendStrings);
+
 // Attempts to create an estring with a given cstring value. If the user
 // wants to initialize an estring with another estring, they should look
 // at ewelborn_string_clone() instead. Returns the estring if successful,
 // returns null otherwise.
 ewelborn_string* ewelborn_string_initializeWithCString(char* cstring);
 
+// Attempts to create an estring with a given cstring value inside of the
+// given arena (or on the heap if arena is null). Returns the estring if
+// successful, returns null otherwise.
+ewelborn_string* ewelborn_string_initializeWithCStringInArena(char* cstring, ewelborn_arena* arena);
+
 // As of writing, estrings are backed with dynamic arrays, but this
 // may not always be true. This function is guaranteed to return a
 // character array (cstring) that represents the given estring,
@@ -143,14 +835,17 @@ ewelborn_string* ewelborn_string_initializeWithCString(char* cstring);
 // TODO: Look at memory management on this
 char* ewelborn_string_getCString(ewelborn_string* eString);
 
-// This function will free all memory allocated to a given estring.
+// This function will free all memory allocated to a given estring. If the
+// estring was allocated from an arena, then this does nothing, as the
+// estring is released when the arena is reset.
 void ewelborn_string_free(ewelborn_string* eString);
 
 // Given a pre-existing estring, this function will create a new
 // estring that is identical to the given estring. This is useful
 // for performing string manipulation, as you may wish to keep an
-// unedited copy of the string. Returns an estring if successful,
-// returns null otherwise.
+// unedited copy of the string. The clone is allocated through the same
+// allocator as the given estring. Returns an estring if successful, returns null
+// otherwise.
 ewelborn_string* ewelborn_string_clone(ewelborn_string* estring);
 
 // This function will move each character in the estring n places
@@ -174,6 +869,8 @@ ewelborn_string* ewelborn_string_clone(ewelborn_string* estring);
 // This function will delete the first n characters of the estring.
 // If n <= 0 then this function will do nothing. If n is greater than
 // the estring's length, then n will be truncated to the estring's length.
+// This takes O(1) time on average, so parsers can consume an estring from
+// the front one token at a time.
 void ewelborn_string_deleteLeft(ewelborn_string* estring, int n);
 
 // This function will delete the last n characters of the estring.
@@ -216,14 +913,27 @@ void ewelborn_string_slice(ewelborn_string* estring, int start, int end);
 //	{"Hi", " hello", " how are you?"}
 ewelborn_dynamicArray* ewelborn_string_split(ewelborn_string* estring, char c);
 
+// This function works the same way as ewelborn_string_split, but the dynamic
+// array and all of the estrings in it are allocated from the given arena, so
+// they can all be released at once by resetting the arena.
+ewelborn_dynamicArray* ewelborn_string_splitInArena(ewelborn_string* estring, char c, ewelborn_arena* arena);
+
+// This function works the same way as ewelborn_string_split, but the estring
+// is cut into chunks that end on a c, and each chunk is split on its own
+// thread (threadCount threads, or one per processor if threadCount <= 0).
+// The fields are returned in the same order that ewelborn_string_split
+// returns them. Short estrings use fewer threads, since starting a thread
+// costs more than splitting a short estring.
+ewelborn_dynamicArray* ewelborn_string_splitParallel(ewelborn_string* estring, char c, int threadCount);
+
 // This function will delete the nth character in the estring. If n is
 // greater than or equal to the estring's length, or n is less than 0,
-// then nothing will happen.
+// then nothing will happen. Whichever side of the nth character is shorter
+// is moved to fill the gap, so deleting the first character takes O(1) time.
 void ewelborn_string_deleteChar(ewelborn_string* estring, int n);
 
 // If the nth character in the estring is equal to c, then the nth character
-// will be deleted, and the string will be moved and resized to fill the gap
-// if necessary. If the nth character is *not* equal to c, then nothing happens.
+// will be deleted (see ewelborn_string_deleteChar). If the nth character is *not* equal to c, then nothing happens.
 // The function returns true if the nth character is consumed, false otherwise.
 // The function returns false if n is greater than or equal to the estring's length,
 // or less than 0.
@@ -238,18 +948,1056 @@ bool ewelborn_string_consumeChar(ewelborn_string* eString, char c, int n);
 // if successful, false otherwise.
 bool ewelborn_string_sprintf(ewelborn_string* estring, ...);
 
+// This function will append the result that printf would give for the format
+// and arguments to the end of the estring. Short text is formatted into a
+// buffer on the stack, so nothing is allocated unless the estring has to
+// grow. The format and arguments may point into the estring itself, ex.
+// appendf(estring, "%s", estring->cstring) doubles the estring. Returns true
+// if successful, false otherwise (the estring is left unmodified). Ex.
+//	ewelborn_string_appendf(estring1{"Name: "}, "%s, Age: %d", "Ethan", 21)
+// estring1 will now be "Name: Ethan, Age: 21".
+bool ewelborn_string_appendf(ewelborn_string* estring, const char* format, ...);
+
+// ewelborn_stringViews are read-only windows into characters that belong to
+// something else, such as an estring or a mapped file. Views never allocate
+// or copy anything, which makes them much cheaper than estrings when the
+// characters only need to be read. Because of this, a view is only valid
+// for as long as the characters it points to are left unmodified, and it
+// is *not* null terminated.
+//
+// Views are small, so they are passed around by value instead of by pointer.
+struct ewelborn_stringView {
+	const char* data;
+	int length;
+} typedef ewelborn_stringView;
+
+// Returns a view of the entire given estring.
+ewelborn_stringView ewelborn_stringView_fromString(ewelborn_string* estring);
+
+// Returns a view of the entire given cstring.
+ewelborn_stringView ewelborn_stringView_fromCString(const char* cstring);
+
+// Returns a view of the first length characters in the given buffer.
+ewelborn_stringView ewelborn_stringView_fromBuffer(const char* buffer, int length);
+
+// Attempts to create an estring that holds a copy of the characters in the
+// view. Returns the estring if successful, returns null otherwise.
+ewelborn_string* ewelborn_stringView_toString(ewelborn_stringView view);
+
+// Attempts to create an estring that holds a copy of the characters in the
+// view inside of the given arena (or on the heap if arena is null). Returns
+// the estring if successful, returns null otherwise.
+ewelborn_string* ewelborn_stringView_toStringInArena(ewelborn_stringView view, ewelborn_arena* arena);
+
+// Returns the nth character in the view, or \0 if n is greater than
+// or equal to the view's length, or less than 0.
+char ewelborn_stringView_getChar(ewelborn_stringView view, int n);
+
+// This function works the same way as ewelborn_string_findChar, but
+// searches a view instead.
+int ewelborn_stringView_findChar(ewelborn_stringView view, char c, int offset);
+
+// These functions work the same way as ewelborn_string_find,
+// ewelborn_string_findAll, and ewelborn_string_count, but search a view instead.
+int ewelborn_stringView_find(ewelborn_stringView view, ewelborn_stringView needle, int offset);
+ewelborn_typedArray* ewelborn_stringView_findAll(ewelborn_stringView view, ewelborn_stringView needle);
+int ewelborn_stringView_count(ewelborn_stringView view, ewelborn_stringView needle);
+
+// Returns a view of the characters within the start and end (not inclusive)
+// boundaries of the given view. Both boundaries are truncated to fit the view.
+// Ex. slice("Hello, world!",2,4) will return "ll"
+ewelborn_stringView ewelborn_stringView_slice(ewelborn_stringView view, int start, int end);
+
+// Returns the given view without any whitespace ' ' or tabs '\t' that
+// precede it.
+ewelborn_stringView ewelborn_stringView_trimLeft(ewelborn_stringView view);
+
+// Returns the given view without any whitespace ' ' or tabs '\t' that
+// follow it.
+ewelborn_stringView ewelborn_stringView_trimRight(ewelborn_stringView view);
+
+// Returns the given view without any whitespace ' ' or tabs '\t' that
+// precede or follow it.
+ewelborn_stringView ewelborn_stringView_trim(ewelborn_stringView view);
+
+// Compares two views character by character, the same way strcmp does.
+// Returns a negative number if a comes before b, 0 if they are equal,
+// and a positive number if a comes after b.
+int ewelborn_stringView_compare(ewelborn_stringView a, ewelborn_stringView b);
+
+// Returns true if both views contain the same characters, false otherwise.
+bool ewelborn_stringView_equals(ewelborn_stringView a, ewelborn_stringView b);
+
+// This function will take the next field from the front of the remaining
+// view, where fields are separated by the character c, and store it in
+// field. remaining is moved past the field, so that calling this function
+// in a loop will return every field in the view, the same way that
+// ewelborn_string_split would. Returns true if a field was found, false
+// once there are no fields left. Ex.
+//	ewelborn_stringView remaining = ewelborn_stringView_fromCString("a,b,c");
+//	ewelborn_stringView field;
+//	while (ewelborn_stringView_splitNext(&remaining, ',', &field)) { ... }
+bool ewelborn_stringView_splitNext(ewelborn_stringView* remaining, char c, ewelborn_stringView* field);
+
+// This function will split a given view on a certain character, and store
+// up to maxFields of the resulting views in fields. Returns the total number
+// of fields in the view, which may be more than maxFields, in which case
+// only the first maxFields fields are stored.
+int ewelborn_stringView_split(ewelborn_stringView view, char c, ewelborn_stringView* fields, int maxFields);
+
+// ewelborn_tokenizers walk through an estring or a view, handing out one
+// token at a time as a view, without allocating anything. Tokens are
+// separated by any character in a set of delimiters, which is kept as a
+// 256-bit lookup table, so larger sets don't cost any more than small ones.
+// Ex.
+//	ewelborn_tokenizer tokenizer = ewelborn_tokenizer_fromString(line, " \t,", EWELBORN_TOKENIZE_SKIP_EMPTY);
+//	ewelborn_stringView token;
+//	while (ewelborn_tokenizer_next(&tokenizer, &token)) { ... }
+//
+// By default, tokenizers work the same way as ewelborn_stringView_splitNext,
+// so "a,,b," gives back "a", "", "b", and "". The flags below change that,
+// and can be combined with |.
+enum ewelborn_tokenizerFlags {
+	EWELBORN_TOKENIZE_DEFAULT = 0,
+	// A run of delimiters between two tokens only separates them once, so
+	// "a,,b," gives back "a", "b", and "" (the estring still ends on a delimiter).
+	EWELBORN_TOKENIZE_COLLAPSE_DELIMITERS = 1,
+	// Empty tokens are never given back, so "a,,b," gives back "a" and "b".
+	EWELBORN_TOKENIZE_SKIP_EMPTY = 2,
+	// Delimiters between quote characters don't separate tokens, so
+	// 'a,"b,c"' gives back "a" and "b,c". Tokens that are quoted from start
+	// to end are given back without their quotes, but any doubled quotes
+	// inside of them ("" for a quote) are left as they are, since the token
+	// is only a view.
+	EWELBORN_TOKENIZE_QUOTES = 4
+} typedef ewelborn_tokenizerFlags;
+
+struct ewelborn_tokenizer {
+	ewelborn_stringView remaining; // What hasn't been tokenized yet, data is null once it's finished
+	uint64_t delimiters[4]; // Bit c is set if the character c is a delimiter
+	char delimiterList[16]; // The delimiters themselves, if there are few enough to fit
+	int delimiterCount;
+	int flags;
+	char quote; // The quote character for EWELBORN_TOKENIZE_QUOTES, '"' unless it's changed
+	const char* block; // The last 64 characters that were checked for delimiters...
+	uint64_t blockMask; // ...and bit i is set if block[i] is one
+} typedef ewelborn_tokenizer;
+
+// Returns a tokenizer for the given view, which splits it on every character
+// in the null terminated delimiters string, using the given flags.
+ewelborn_tokenizer ewelborn_tokenizer_fromView(ewelborn_stringView view, const char* delimiters, int flags);
+
+// Returns a tokenizer for the given estring. The estring must not be modified
+// while the tokenizer is in use.
+ewelborn_tokenizer ewelborn_tokenizer_fromString(ewelborn_string* estring, const char* delimiters, int flags);
+
+// This function will store the next token in token, and move the tokenizer
+// past it. Returns true if a token was found, false once there are no
+// tokens left.
+bool ewelborn_tokenizer_next(ewelborn_tokenizer* tokenizer, ewelborn_stringView* token);
+
+// This function will attempt to append the view's characters to the end of
+// the given estring. Returns true if successful, false otherwise.
+bool ewelborn_string_appendView(ewelborn_string* estring, ewelborn_stringView view);
+
+// This function will attempt to append count views to the end of the given
+// estring, in order, resizing the estring at most once. The views may point
+// into the estring itself. Returns true if successful, false otherwise (the
+// estring is left unmodified).
+bool ewelborn_string_appendViews(ewelborn_string* estring, const ewelborn_stringView* views, int count);
+
+// This function works the same way as ewelborn_string_findChar, but finds
+// the first place that the needle appears in the estring instead, starting
+// from offset. An empty needle is found right at offset. The search takes
+// linear time, even for needles like "aaab" in estrings like "aaaaaaaa...".
+// Ex. find("one two two", "two", 5) will return 8
+int ewelborn_string_find(ewelborn_string* estring, ewelborn_stringView needle, int offset);
+
+// Attempts to find every place that the needle appears in the estring, from
+// left to right, without the matches overlapping (so "aa" appears twice in
+// "aaaaa", at 0 and 2). Returns a typed array of the int positions if
+// successful, returns null otherwise. Empty needles never match.
+ewelborn_typedArray* ewelborn_string_findAll(ewelborn_string* estring, ewelborn_stringView needle);
+
+// Returns the number of times that the needle appears in the estring, without
+// the matches overlapping. Empty needles never match.
+int ewelborn_string_count(ewelborn_string* estring, ewelborn_stringView needle);
+
+// This function will replace every place that the needle appears in the
+// estring (as found by ewelborn_string_findAll) with the replacement. The
+// new length is worked out before anything is copied, so the estring is
+// resized at most once, and not at all if the replacement isn't longer than
+// the needle. The needle and replacement may be views of the estring itself.
+// Returns true if successful, false otherwise (the estring is left unmodified).
+// Ex. replaceAll("a, b, c", ", ", ";") will modify the estring to be "a;b;c"
+bool ewelborn_string_replaceAll(ewelborn_string* estring, ewelborn_stringView needle, ewelborn_stringView replacement);
+
+// *** HASHING
+
+// Returns a fast, non-cryptographic 64-bit hash of the given bytes, based
+// on wyhash. Different seeds give unrelated hashes for the same bytes.
+// This is *not* safe for anything security related.
+uint64_t ewelborn_hash(const void* data, size_t length, uint64_t seed);
+
+// Returns the hash of the estring's characters (see ewelborn_hash).
+uint64_t ewelborn_string_hash(ewelborn_string* estring);
+
+// Returns the hash of the view's characters (see ewelborn_hash). A view
+// and an estring with the same characters have the same hash.
+uint64_t ewelborn_stringView_hash(ewelborn_stringView view);
+
+// ewelborn_hashMaps map string keys to pointer values. They use open
+// addressing with Robin Hood probing, so every entry lives in one flat
+// array and lookups only look at a few neighboring entries. The hash of
+// every key is stored next to it, so keys never have to be hashed again
+// when the map grows, and most mismatches are caught without comparing
+// any characters.
+//
+// The map keeps its own copy of every key inside of an arena, so keys can
+// be inserted straight from views of a larger buffer. The values are not
+// managed by the map, and are never freed by it.
+#define EWELBORN_HASH_MAP_STARTING_SIZE 16
+struct ewelborn_hashMapEntry {
+	uint64_t hash;
+	const char* key; // Null terminated copy of the key, owned by the map
+	int keyLength;
+	int distance; // 1 + how far the entry is from its ideal slot, or 0 if the slot is empty
+	void* value;
+} typedef ewelborn_hashMapEntry;
+
+struct ewelborn_hashMap {
+	ewelborn_hashMapEntry* entries;
+	size_t capacity; // Number of entries, always a power of two
+	size_t size; // Number of entries in use
+	ewelborn_arena* keys; // Where the copies of the keys are stored
+	ewelborn_allocator* allocator; // Where the entries and the key arena come from
+} typedef ewelborn_hashMap;
+
+// Attempts to create an empty hash map. Returns the hash map if successful,
+// returns null otherwise.
+ewelborn_hashMap* ewelborn_hashMap_initialize();
+
+// Attempts to create an empty hash map whose memory comes from the given
+// allocator (or the global allocator, if allocator is null). Returns the hash
+// map if successful, returns null otherwise.
+ewelborn_hashMap* ewelborn_hashMap_initializeWithAllocator(ewelborn_allocator* allocator);
+
+// Attempts to map the given key to the given value. If the key is already
+// in the map, its value will be replaced. Returns true if successful, false
+// otherwise.
+bool ewelborn_hashMap_insert(ewelborn_hashMap* map, ewelborn_string* key, void* value);
+
+// This function works the same way as ewelborn_hashMap_insert, but takes
+// the key as a view.
+bool ewelborn_hashMap_insertView(ewelborn_hashMap* map, ewelborn_stringView key, void* value);
+
+// Returns a pointer to the value that the given key maps to, or null if
+// the key isn't in the map. The value can be changed through the pointer,
+// but the pointer is only valid until the next insert or erase.
+void** ewelborn_hashMap_find(ewelborn_hashMap* map, ewelborn_string* key);
+
+// This function works the same way as ewelborn_hashMap_find, but takes
+// the key as a view.
+void** ewelborn_hashMap_findView(ewelborn_hashMap* map, ewelborn_stringView key);
+
+// Attempts to remove the given key from the map. Returns true if the key
+// was removed, or false if the key isn't in the map. The memory used by the
+// map's copy of the key is only released when the map is cleared or freed.
+bool ewelborn_hashMap_erase(ewelborn_hashMap* map, ewelborn_string* key);
+
+// This function works the same way as ewelborn_hashMap_erase, but takes
+// the key as a view.
+bool ewelborn_hashMap_eraseView(ewelborn_hashMap* map, ewelborn_stringView key);
+
+// Attempts to grow the map so that it can hold at least count keys without
+// growing again. Returns true if successful, false otherwise.
+bool ewelborn_hashMap_reserve(ewelborn_hashMap* map, size_t count);
+
+// Iterates over the map one entry at a time, in no particular order. Set
+// iterator to 0 to start from the beginning. Each call stores the next key
+// and its value in key and value (either may be null), and returns true,
+// or returns false once every entry has been visited. The map must not be
+// changed while it's being iterated over, other than changing values. Ex.
+//	size_t iterator = 0;
+//	while (ewelborn_hashMap_next(map, &iterator, &key, &value)) { ... }
+bool ewelborn_hashMap_next(ewelborn_hashMap* map, size_t* iterator, ewelborn_stringView* key, void** value);
+
+// Removes every key from the map.
+void ewelborn_hashMap_clear(ewelborn_hashMap* map);
+
+// This function will free all memory allocated to a given hash map. The
+// values in the map are *not* freed.
+void ewelborn_hashMap_free(ewelborn_hashMap* map);
+
+// ewelborn_stringPools intern strings: every distinct string is stored only
+// once, in an arena, and is given an ID, starting from 0 and counting up. A
+// string always gets the same ID from the same pool, so checking if two
+// interned strings are equal is just comparing their IDs (or their data
+// pointers, which never move), and data that repeats the same few strings
+// millions of times only stores each of them once. The hash of every string
+// is kept next to it, and is the same as ewelborn_stringView_hash.
+struct ewelborn_internedString {
+	const char* data; // Null terminated copy, owned by the pool, never moves
+	int length;
+	uint64_t hash;
+} typedef ewelborn_internedString;
+
+struct ewelborn_stringPool {
+	ewelborn_internedString* strings; // Indexed by ID
+	int count; // Number of distinct strings, the next ID to be given out
+	int maxCount; // Maximum number of strings given current allocation
+	uint64_t* slots; // Top 32 bits of the hash, then ID + 1, or 0 if empty
+	size_t capacity; // Number of slots, always a power of two
+	ewelborn_arena* arena; // Where the strings' characters are stored
+	char* block; // The block of the arena that characters are being packed into
+	size_t blockRemaining; // Bytes left in block
+	ewelborn_allocator* allocator; // Where the pool's arrays and arena come from
+} typedef ewelborn_stringPool;
+
+// Attempts to create an empty string pool. Returns the pool if successful,
+// returns null otherwise.
+ewelborn_stringPool* ewelborn_stringPool_initialize();
+
+// Attempts to create an empty string pool whose memory comes from the given
+// allocator (or the global allocator, if allocator is null). Returns the
+// pool if successful, returns null otherwise.
+ewelborn_stringPool* ewelborn_stringPool_initializeWithAllocator(ewelborn_allocator* allocator);
+
+// Attempts to intern the view's characters, copying them into the pool if
+// they aren't there already. Returns the string's ID if successful, returns
+// -1 otherwise.
+int ewelborn_stringPool_internView(ewelborn_stringPool* pool, ewelborn_stringView view);
+
+// This function works the same way as ewelborn_stringPool_internView, but
+// takes an estring.
+int ewelborn_stringPool_intern(ewelborn_stringPool* pool, ewelborn_string* estring);
+
+// Attempts to intern every estring in a dynamic array of estrings (ex. the
+// result of ewelborn_string_split), and pushes their IDs, in the same order,
+// onto the end of ids, which must be a typed array of int. Returns true if
+// successful, or false if ids isn't a typed array of int or memory couldn't
+// be allocated, in which case some of the IDs may have been pushed.
+bool ewelborn_stringPool_internAll(ewelborn_stringPool* pool, ewelborn_dynamicArray* estrings, ewelborn_typedArray* ids);
+
+// Works the same way as ewelborn_stringPool_internAll, but interns every
+// field of the view, where fields are separated by the character c (the same
+// fields that ewelborn_stringView_splitNext gives), without creating an
+// estring for any of them.
+bool ewelborn_stringPool_internSplit(ewelborn_stringPool* pool, ewelborn_stringView view, char c, ewelborn_typedArray* ids);
+
+// Returns the ID of the view's characters if they have been interned, or -1
+// if they haven't. Never adds anything to the pool.
+int ewelborn_stringPool_find(ewelborn_stringPool* pool, ewelborn_stringView view);
+
+// Returns a view of the string with the given ID, or an empty view with null
+// data if the ID isn't in the pool. The view's data is null terminated, and
+// stays valid until the pool is cleared or freed.
+ewelborn_stringView ewelborn_stringPool_get(ewelborn_stringPool* pool, int id);
+
+// Returns the hash of the string with the given ID without hashing it again,
+// or 0 if the ID isn't in the pool.
+uint64_t ewelborn_stringPool_hash(ewelborn_stringPool* pool, int id);
+
+// Removes every string from the pool, so IDs start from 0 again.
+void ewelborn_stringPool_clear(ewelborn_stringPool* pool);
+
+// This function will free all memory allocated to a given string pool.
+void ewelborn_stringPool_free(ewelborn_stringPool* pool);
+
+// *** NUMBER PARSING
+
+// These functions turn text into numbers straight from views, estrings, and
+// buffers, so fields don't have to be copied into null terminated strings
+// for atoi or strtod first. Integers are parsed 8 digits at a time, and
+// doubles are parsed with the Eisel-Lemire algorithm, which gives the
+// closest double to the text (the same as a correct strtod) without
+// needing arbitrary precision math in all but the rarest cases.
+enum ewelborn_parseResult {
+	EWELBORN_PARSE_SUCCESS,
+	EWELBORN_PARSE_INVALID, // Not a number, or there was more text after the number
+	EWELBORN_PARSE_OVERFLOW, // Too large (or small) for the type, and the closest value was stored
+	EWELBORN_PARSE_OUT_OF_MEMORY // Only from the bulk functions, when the array couldn't grow
+} typedef ewelborn_parseResult;
+
+// Attempts to parse the whole view as a base 10 integer, with an optional
+// sign. Spaces and tabs around the number are ignored, but anything else
+// makes the view invalid. If successful, stores the number in value and
+// returns EWELBORN_PARSE_SUCCESS. If the number doesn't fit, stores
+// INT64_MAX or INT64_MIN in value and returns EWELBORN_PARSE_OVERFLOW.
+// Returns EWELBORN_PARSE_INVALID otherwise, without modifying value.
+// Ex. parseInt64("  -1234 ") will store -1234
+ewelborn_parseResult ewelborn_stringView_parseInt64(ewelborn_stringView view, int64_t* value);
+
+// Attempts to parse the whole view as a double, in the same format that
+// strtod accepts in the "C" locale (except for hexadecimal floats), so
+// "1", "-2.5", ".5", "1e-7", "inf", and "nan" are all valid. Spaces and
+// tabs around the number are ignored. If successful, stores the closest
+// double in value and returns EWELBORN_PARSE_SUCCESS. If the number is too
+// large for a double, stores HUGE_VAL (with the number's sign) in value and
+// returns EWELBORN_PARSE_OVERFLOW. Returns EWELBORN_PARSE_INVALID otherwise,
+// without modifying value.
+ewelborn_parseResult ewelborn_stringView_parseDouble(ewelborn_stringView view, double* value);
+
+// Works the same way as ewelborn_stringView_parseInt64, on the whole estring.
+ewelborn_parseResult ewelborn_string_parseInt64(ewelborn_string* estring, int64_t* value);
+
+// Works the same way as ewelborn_stringView_parseDouble, on the whole estring.
+ewelborn_parseResult ewelborn_string_parseDouble(ewelborn_string* estring, double* value);
+
+// Attempts to parse every integer in the buffer, and push them onto the end
+// of numbers, which must be a typed array of int64_t (otherwise, returns
+// EWELBORN_PARSE_INVALID without parsing anything). The integers can be
+// separated by any mix of spaces, tabs, newlines, and commas. Returns
+// EWELBORN_PARSE_SUCCESS if every integer was parsed. Otherwise, returns
+// why parsing stopped, and if errorOffset isn't null, stores where in the
+// buffer it stopped. The integers before that point are kept in numbers.
+// Ex.
+//	ewelborn_typedArray* numbers = EWELBORN_TYPED_ARRAY_INITIALIZE(int64_t);
+//	ewelborn_parseIntsFromBuffer(file->data, file->size, numbers, NULL);
+ewelborn_parseResult ewelborn_parseIntsFromBuffer(const char* buffer, size_t length, ewelborn_typedArray* numbers, size_t* errorOffset);
+
+// Works the same way as ewelborn_parseIntsFromBuffer, but for doubles, so
+// numbers must be a typed array of double.
+ewelborn_parseResult ewelborn_parseDoublesFromBuffer(const char* buffer, size_t length, ewelborn_typedArray* numbers, size_t* errorOffset);
+
+// *** NUMBER FORMATTING
+
+// These functions append numbers to estrings without going through printf,
+// which has to parse its format string every time it's called. Integers are
+// written two digits at a time, and doubles are written with the fewest
+// digits that read back as the same double.
+
+// This function will attempt to append value to the end of the estring in
+// base 10. Returns true if successful, false otherwise (the estring is left
+// unmodified).
+bool ewelborn_string_appendInt(ewelborn_string* estring, int64_t value);
+
+// Works the same way as ewelborn_string_appendInt, for unsigned integers.
+bool ewelborn_string_appendUInt(ewelborn_string* estring, uint64_t value);
+
+// This function will attempt to append the shortest text that
+// ewelborn_stringView_parseDouble (or strtod) reads back as exactly the same
+// double, picking the closest one if there's a tie. Numbers from 1e-6 up to
+// 1e21 are written without an exponent, and the rest with one, the same way
+// JavaScript writes numbers. Infinity and NaN are written as "inf", "-inf",
+// and "nan". Returns true if successful, false otherwise (the estring is left
+// unmodified). Ex. 0.1 is written as "0.1", 1.5e300 as "1.5e+300", and
+// 100.0 as "100"
+bool ewelborn_string_appendDouble(ewelborn_string* estring, double value);
+
+// *** SORTING
+
+// Calling a comparison function for every comparison (like qsort does) is
+// usually what makes sorting slow, so EWELBORN_DEFINE_SORT writes a whole
+// introsort for one type, with lessThan pasted directly into it so that the
+// compiler can inline it. The sort is a quicksort (median of three) that
+// switches to heapsort if it recurses too deeply, so it never takes more
+// than O(n log n) time, and to insertion sort for small ranges. It is not
+// stable. lessThan(a, b) is given two elements (not pointers to them), and
+// must return true if a comes before b. Ex.
+//	#define PRICE_LESS_THAN(a, b) ((a).price < (b).price)
+//	EWELBORN_DEFINE_SORT(sortItems, struct item, PRICE_LESS_THAN)
+//	...
+//	sortItems(EWELBORN_TYPED_ARRAY_DATA(items, struct item), items->elements);
+//
+// EWELBORN_DEFINE_SORT_WITH_CONTEXT works the same way, but the sort takes
+// one more argument, void* sortContext, which lessThan can use.
+#define EWELBORN_DEFINE_SORT(name, type, lessThan) \
+	EWELBORN_DEFINE_SORT_WITH_CONTEXT(name##_withContext, type, lessThan) \
+	static void name(type* elements, size_t count) { name##_withContext(elements, count, NULL); }
+
+#define EWELBORN_DEFINE_SORT_WITH_CONTEXT(name, type, lessThan) \
+	static void name##_insertionSort(type* elements, size_t count, void* sortContext) \
+	{ \
+		(void)sortContext; \
+		for (size_t i = 1; i < count; i++) { \
+			type element = elements[i]; \
+			size_t j = i; \
+			for (; j > 0 && (lessThan(element, elements[j - 1])); j--) { elements[j] = elements[j - 1]; } \
+			elements[j] = element; \
+		} \
+	} \
+	static void name##_siftDown(type* elements, size_t root, size_t count, void* sortContext) \
+	{ \
+		(void)sortContext; \
+		type element = elements[root]; \
+		for (size_t child = 2 * root + 1; child < count; child = 2 * root + 1) { \
+			if (child + 1 < count && (lessThan(elements[child], elements[child + 1]))) { child++; } \
+			if (!(lessThan(element, elements[child]))) { break; } \
+			elements[root] = elements[child]; \
+			root = child; \
+		} \
+		elements[root] = element; \
+	} \
+	static void name(type* elements, size_t count, void* sortContext) \
+	{ \
+		int depthLimit = 0; \
+		for (size_t n = count; n > 1; n >>= 1) { depthLimit += 2; } \
+		while (count > 16) { \
+			if (depthLimit-- == 0) { \
+				for (size_t i = count / 2; i-- > 0;) { name##_siftDown(elements, i, count, sortContext); } \
+				for (size_t i = count - 1; i > 0; i--) { \
+					type top = elements[0]; elements[0] = elements[i]; elements[i] = top; \
+					name##_siftDown(elements, 0, i, sortContext); \
+				} \
+				return; \
+			} \
+			/* Order the first, middle, and last elements, then use the median */ \
+			/* as the pivot. The largest ends up last, which stops the scan */ \
+			/* from the left without needing a bounds check. */ \
+			type swap; \
+			size_t middle = count / 2; \
+			if (lessThan(elements[middle], elements[0])) { swap = elements[middle]; elements[middle] = elements[0]; elements[0] = swap; } \
+			if (lessThan(elements[count - 1], elements[middle])) { \
+				swap = elements[count - 1]; elements[count - 1] = elements[middle]; elements[middle] = swap; \
+				if (lessThan(elements[middle], elements[0])) { swap = elements[middle]; elements[middle] = elements[0]; elements[0] = swap; } \
+			} \
+			swap = elements[middle]; elements[middle] = elements[0]; elements[0] = swap; \
+			type pivot = elements[0]; \
+			size_t i = 0, j = count; \
+			for (;;) { \
+				do { i++; } while (lessThan(elements[i], pivot)); \
+				do { j--; } while (lessThan(pivot, elements[j])); \
+				if (i >= j) { break; } \
+				swap = elements[i]; elements[i] = elements[j]; elements[j] = swap; \
+			} \
+			elements[0] = elements[j]; elements[j] = pivot; \
+			/* Recurse into the smaller side, and loop on the larger side, */ \
+			/* so the stack never gets deeper than log2(count) */ \
+			if (j < count - j - 1) { \
+				name(elements, j, sortContext); \
+				elements += j + 1; count -= j + 1; \
+			} \
+			else { \
+				name(elements + j + 1, count - j - 1, sortContext); \
+				count = j; \
+			} \
+		} \
+		name##_insertionSort(elements, count, sortContext); \
+	}
+
+// Sorts the dynamic array with the given comparison function, which returns
+// a negative number if a comes before b, 0 if they are equal, and a positive
+// number if a comes after b. Like qsort, compare is given pointers to the
+// elements (so a and b are really void**), which means the same comparison
+// function works for both. The sort is not stable.
+void ewelborn_dynamicArray_sort(ewelborn_dynamicArray* dynamicArray, int(*compare)(const void* a, const void* b));
+
+// Works the same way as ewelborn_dynamicArray_sort, but splits the array
+// between threadCount threads (or one thread per processor, if threadCount
+// <= 0), which each sort their own part, and then merges the parts together
+// in parallel. Small arrays are sorted on the calling thread. compare must
+// be safe to call from several threads at once.
+void ewelborn_dynamicArray_sortParallel(ewelborn_dynamicArray* dynamicArray, int(*compare)(const void* a, const void* b), int threadCount);
+
+// Sorts a dynamic array of estrings, the same way ewelborn_stringView_compare
+// orders them. Large arrays are sorted with an MSD radix sort, which looks at
+// each character of each estring about once instead of comparing whole
+// estrings over and over, and uses each estring's length instead of
+// searching for its null terminator.
+void ewelborn_dynamicArray_sortStrings(ewelborn_dynamicArray* dynamicArray);
+
+// Works the same way as ewelborn_dynamicArray_sortStrings, but splits the
+// work between threadCount threads, like ewelborn_dynamicArray_sortParallel.
+void ewelborn_dynamicArray_sortStringsParallel(ewelborn_dynamicArray* dynamicArray, int threadCount);
+
+// Sorts the typed array with the given comparison function, which is given
+// pointers to the elements (the same as qsort). The sort is not stable.
+void ewelborn_typedArray_sort(ewelborn_typedArray* typedArray, int(*compare)(const void* a, const void* b));
+
+// Sorts a typed array of ewelborn_stringViews, the same way as
+// ewelborn_dynamicArray_sortStrings. Returns true if successful, or false
+// (without changing the array) if the array's elements aren't views.
+bool ewelborn_typedArray_sortViews(ewelborn_typedArray* typedArray);
+
+// Sort typed arrays of int32_t, int64_t, or double from smallest to largest.
+// Large arrays are sorted with an LSD radix sort, which takes O(n) time, and
+// skips any byte that is the same in every number. NaNs with their sign bit
+// set are sorted before every other double, and the rest of the NaNs after
+// every other double. Returns true if successful, or false (without
+// changing the array) if the array's elements aren't the right size.
+bool ewelborn_typedArray_sortInt32(ewelborn_typedArray* typedArray);
+bool ewelborn_typedArray_sortInt64(ewelborn_typedArray* typedArray);
+bool ewelborn_typedArray_sortDouble(ewelborn_typedArray* typedArray);
+
+// *** CHARACTER SCANNING
+
+// These functions search through buffers of characters, and are what the
+// string functions (findChar, trim, split, etc.) are built on. Each one has
+// a scalar implementation as well as SSE2 and AVX2 implementations, and the
+// fastest implementation that the CPU supports is picked automatically the
+// first time any of them are called.
+enum ewelborn_scanImplementation {
+	EWELBORN_SCAN_SCALAR,
+	EWELBORN_SCAN_SSE2,
+	EWELBORN_SCAN_AVX2
+} typedef ewelborn_scanImplementation;
+
+// Returns true if the given implementation can run on this CPU, false otherwise.
+bool ewelborn_scan_isSupported(ewelborn_scanImplementation implementation);
+
+// Returns the implementation that the scanning functions are currently using.
+ewelborn_scanImplementation ewelborn_scan_getImplementation();
+
+// Forces the scanning functions to use the given implementation, which is
+// mostly useful for testing and benchmarking. Returns true if successful, or
+// false if the implementation isn't supported by this CPU.
+bool ewelborn_scan_setImplementation(ewelborn_scanImplementation implementation);
+
+// Returns the position of the first c in the buffer, or length if the
+// buffer doesn't contain c.
+size_t ewelborn_scan_findChar(const char* buffer, size_t length, char c);
+
+// Returns the position of the first place that the needle appears in the
+// buffer, or length if it doesn't appear at all (an empty needle appears at
+// 0). Needles that are one character long use findChar. Longer ones are
+// found with the current implementation's pair kernel, which looks for
+// places where both the first and last characters of the needle line up,
+// and only compares the rest of the needle there. If that keeps finding
+// places that don't match, the search switches to the Two-Way algorithm, so
+// that it never takes more than linear time.
+size_t ewelborn_scan_find(const char* buffer, size_t length, const char* needle, size_t needleLength);
+
+// Returns the position of the first character in the buffer that is also
+// in the set of setLength characters, or length if there isn't one.
+// Ex. findAnyOf("a;b,c",5,",;\t",3) will return 1
+size_t ewelborn_scan_findAnyOf(const char* buffer, size_t length, const char* set, int setLength);
+
+// Returns the position of the first character in the buffer that isn't
+// whitespace ' ' or a tab '\t', or length if the buffer is all whitespace.
+size_t ewelborn_scan_skipWhitespaceLeft(const char* buffer, size_t length);
+
+// Returns the length of the buffer once all of the whitespace ' ' and
+// tabs '\t' at the end of it are removed, or 0 if the buffer is all whitespace.
+size_t ewelborn_scan_skipWhitespaceRight(const char* buffer, size_t length);
+
+// Returns the number of times that c appears in the buffer.
+size_t ewelborn_scan_countChar(const char* buffer, size_t length, char c);
+
+// *** THREADING
+
+// Returns the number of processors that threads can run on. The parallel
+// functions start this many threads when they're given a thread count of
+// 0 or less.
+int ewelborn_getProcessorCount();
+
+// ewelborn_threadPools keep a set of worker threads running, so that work
+// can be handed to them without starting a new thread every time. Every
+// worker has its own queue of tasks, and a worker that runs out of tasks
+// steals them from the other workers, which keeps every worker busy even
+// when some tasks take much longer than others.
+//
+// The thread pool's internals depend on the platform, so they're private.
+struct ewelborn_threadPool typedef ewelborn_threadPool;
+
+// Attempts to create a thread pool with threadCount worker threads, or one
+// per processor if threadCount <= 0. Returns the thread pool if successful,
+// returns null otherwise.
+ewelborn_threadPool* ewelborn_threadPool_initialize(int threadCount);
+
+// Returns the number of worker threads in the thread pool.
+int ewelborn_threadPool_getThreadCount(ewelborn_threadPool* pool);
+
+// This function will queue up a task that calls function(argument) on one
+// of the worker threads. Tasks may submit more tasks. Returns true if
+// successful, false otherwise.
+bool ewelborn_threadPool_submit(ewelborn_threadPool* pool, void(*function)(void*), void* argument);
+
+// This function will wait until every task that has been submitted to the
+// thread pool has finished, running tasks on the calling thread in the
+// meantime. This must not be called from inside of a task.
+void ewelborn_threadPool_wait(ewelborn_threadPool* pool);
+
+// This function will call function(context, rangeStart, rangeEnd) on pieces of
+// the range [start, end) until the whole range has been covered, with the
+// pieces running on the worker threads and the calling thread. The range is
+// split in half whenever a worker could use more work, down to pieces of
+// grainSize, or a size picked from the range and the number of workers if
+// grainSize is 0. Returns once the whole range has been covered. Unlike
+// ewelborn_threadPool_wait, this can be called from inside of a task.
+void ewelborn_threadPool_parallelFor(ewelborn_threadPool* pool, size_t start, size_t end, size_t grainSize,
+	void(*function)(void* context, size_t rangeStart, size_t rangeEnd), void* context);
+
+// This function works the same way as ewelborn_dynamicArray_traverse, but the
+// elements are visited by the thread pool (see ewelborn_threadPool_parallelFor).
+// The function must be safe to call from several threads at once.
+void ewelborn_threadPool_parallelTraverse(ewelborn_threadPool* pool, ewelborn_dynamicArray* dynamicArray, void(*f)(void*));
+
+// This function will call the given function on every element in the dynamic
+// array using the thread pool, and returns a new dynamic array of whatever the
+// function returned for each element, in the same order. Returns null if
+// unsuccessful.
+ewelborn_dynamicArray* ewelborn_threadPool_parallelMap(ewelborn_threadPool* pool, ewelborn_dynamicArray* dynamicArray, void*(*f)(void*));
+
+// This function will wait for every submitted task to finish (see
+// ewelborn_threadPool_wait), stop the worker threads, and free all memory
+// allocated to the given thread pool.
+void ewelborn_threadPool_free(ewelborn_threadPool* pool);
+
+// ewelborn_ringBuffers pass elements from one thread to another through a
+// fixed-size ring, without taking a lock. A single-producer single-consumer
+// ring buffer may only be pushed to by one thread and popped from by one
+// thread at a time, which makes it a little faster than a multi-producer
+// multi-consumer ring buffer, which any number of threads may push to and
+// pop from at once.
+//
+// The ring buffer's internals depend on the platform, so they're private.
+struct ewelborn_ringBuffer typedef ewelborn_ringBuffer;
+
+enum ewelborn_ringBufferKind {
+	EWELBORN_RING_BUFFER_SPSC,
+	EWELBORN_RING_BUFFER_MPMC
+} typedef ewelborn_ringBufferKind;
+
+// What to do when a ring buffer is full (on push) or empty (on pop): give up
+// right away, spin until the ring buffer is ready, or spin for a little while
+// and then sleep until the ring buffer is ready.
+enum ewelborn_ringBufferWait {
+	EWELBORN_RING_BUFFER_TRY,
+	EWELBORN_RING_BUFFER_SPIN,
+	EWELBORN_RING_BUFFER_BLOCK
+} typedef ewelborn_ringBufferWait;
+
+// Attempts to create a ring buffer that can hold at least capacity elements
+// (rounded up to a power of 2). Returns the ring buffer if successful,
+// returns null otherwise.
+ewelborn_ringBuffer* ewelborn_ringBuffer_initialize(size_t capacity, ewelborn_ringBufferKind kind);
+
+// Attempts to push an element onto the ring buffer, waiting for room if the
+// ring buffer is full. Returns true if successful, returns false if the ring
+// buffer is full (with EWELBORN_RING_BUFFER_TRY) or has been closed.
+bool ewelborn_ringBuffer_push(ewelborn_ringBuffer* ringBuffer, void* element, ewelborn_ringBufferWait wait);
+
+// This function will push count elements onto the ring buffer in order,
+// taking as many slots at once as it can. Returns the number of elements
+// that were pushed, which is only less than count with
+// EWELBORN_RING_BUFFER_TRY or if the ring buffer has been closed.
+int ewelborn_ringBuffer_pushMany(ewelborn_ringBuffer* ringBuffer, void** elements, int count, ewelborn_ringBufferWait wait);
+
+// Attempts to pop the oldest element off of the ring buffer, waiting for one
+// if the ring buffer is empty. Returns true if successful, returns false if
+// the ring buffer is empty (with EWELBORN_RING_BUFFER_TRY) or has been closed
+// and emptied.
+bool ewelborn_ringBuffer_pop(ewelborn_ringBuffer* ringBuffer, void** element, ewelborn_ringBufferWait wait);
+
+// This function will pop up to maxCount elements off of the ring buffer into
+// elements, waiting until there's at least one. Returns the number of
+// elements that were popped, which is 0 if the ring buffer is empty (with
+// EWELBORN_RING_BUFFER_TRY) or has been closed and emptied.
+int ewelborn_ringBuffer_popMany(ewelborn_ringBuffer* ringBuffer, void** elements, int maxCount, ewelborn_ringBufferWait wait);
+
+// This function will close the ring buffer: pushes fail from now on, and
+// pops fail once the elements that are left have been popped. Every thread
+// that's waiting on the ring buffer is woken up.
+// WARNING! On an MPMC ring buffer, a push that happens at the same time as
+// the close can return true, and still never be popped, because consumers
+// may have already seen the ring buffer as closed and empty. Stop the
+// producers before closing it if every element has to be popped.
+void ewelborn_ringBuffer_close(ewelborn_ringBuffer* ringBuffer);
+
+// Returns the number of elements in the ring buffer. This may already be out
+// of date if other threads are using the ring buffer.
+size_t ewelborn_ringBuffer_size(ewelborn_ringBuffer* ringBuffer);
+
+// This function will free all memory allocated to the given ring buffer, but
+// not the elements inside of it. No other thread may be using the ring buffer.
+void ewelborn_ringBuffer_free(ewelborn_ringBuffer* ringBuffer);
+
 // *** FILE MANIPULATION
 
+// A single line inside of a buffer, such as a memory-mapped file. The line
+// starts offset bytes into the buffer and is length characters long, not
+// including the newline.
+struct ewelborn_line {
+	size_t offset;
+	size_t length;
+} typedef ewelborn_line;
+
+// ewelborn_mappedFiles map an entire file into memory and index all of its
+// lines in a single scan, without copying the file or allocating anything
+// per line. Lines are split on newlines (\n) the same way that
+// ewelborn_readLinesFromFile splits them, so a file ending in a newline
+// will end in an empty line.
+//
+// The lines point directly into the mapping, so they are *not* null
+// terminated, and they are only valid until the mapped file is freed.
+struct ewelborn_mappedFile {
+	char* data; // Contents of the file, or null if the file is empty
+	size_t size; // Size of the file in bytes
+	ewelborn_line* lines;
+	size_t lineCount;
+} typedef ewelborn_mappedFile;
+
+// This function will attempt to memory-map the file at the given file path
+// and index its lines. Returns the mapped file if successful, returns null
+// otherwise (ex. the file doesn't exist, or it can't be mapped, such as a pipe).
+ewelborn_mappedFile* ewelborn_mappedFile_open(ewelborn_string* filePath);
+
+// This function works the same way as ewelborn_mappedFile_open, but the file
+// is cut into chunks that end on a newline, and each chunk's lines are
+// indexed on their own thread (threadCount threads, or one per processor if
+// threadCount <= 0). The lines are merged back together in order, so the
+// mapped file is identical to one from ewelborn_mappedFile_open.
+ewelborn_mappedFile* ewelborn_mappedFile_openParallel(ewelborn_string* filePath, int threadCount);
+
+// Returns a pointer to the start of the nth line in the mapped file, and
+// stores the length of the line in length. Returns null if n is greater than
+// or equal to the number of lines in the file. The returned line is
+// *not* null terminated.
+char* ewelborn_mappedFile_getLine(ewelborn_mappedFile* file, size_t n, size_t* length);
+
+// Returns a view of the nth line in the mapped file, or an empty view
+// if n is greater than or equal to the number of lines in the file, or if
+// the line is too long for a view (more than INT_MAX characters).
+ewelborn_stringView ewelborn_mappedFile_getLineView(ewelborn_mappedFile* file, size_t n);
+
+// This function will unmap the file and free all memory allocated to the
+// given mapped file. Any lines taken from the file are no longer valid.
+void ewelborn_mappedFile_free(ewelborn_mappedFile* file);
+
 // This function will attempt to open the file at the given file path and
 // read it. If successful, the function will return a dynamic array of
 // estring pointers that are the individual lines in the file. Otherwise,
-// the function will return null.
+// the function will return null, which includes files with a line that's
+// too long for an estring (more than INT_MAX characters).
+//
+// The file is memory-mapped when possible (see ewelborn_mappedFile_open),
+// otherwise it will be read a block at a time.
 ewelborn_dynamicArray* ewelborn_readLinesFromFile(ewelborn_string* filePath);
 
+// This function works the same way as ewelborn_readLinesFromFile, but the
+// dynamic array and all of the lines in it are allocated from the given arena,
+// so they can all be released at once by resetting the arena.
+ewelborn_dynamicArray* ewelborn_readLinesFromFileInArena(ewelborn_string* filePath, ewelborn_arena* arena);
+
+// This function works the same way as ewelborn_readLinesFromFile, but the
+// file's lines are found (see ewelborn_mappedFile_openParallel) and copied
+// into estrings using threadCount threads, or one per processor if
+// threadCount <= 0.
+ewelborn_dynamicArray* ewelborn_readLinesFromFileParallel(ewelborn_string* filePath, int threadCount);
+
+// ewelborn_lineReaders read a file one line at a time, so they can read files
+// that are much larger than the available memory. The file is read in large
+// blocks into a single reusable buffer, which only grows if a line is longer
+// than a block, so the memory used stays the same no matter how large the
+// file is. Lines are split on newlines (\n) the same way that
+// ewelborn_readLinesFromFile splits them.
+#define EWELBORN_LINE_READER_BLOCK_SIZE (1024 * 1024)
+struct ewelborn_lineReader {
+	FILE* file;
+	char* buffer;
+	size_t bufferSize;
+	size_t start; // Start of the characters in the buffer that haven't been returned yet
+	size_t scanned; // Characters after start that are known to not be a newline
+	size_t end; // End of the characters read into the buffer
+	bool endOfFile;
+	bool finished; // True once the last line has been returned
+	bool failed; // True if reading stopped early because of an error
+} typedef ewelborn_lineReader;
+
+// Attempts to open the file at the given file path for reading line by line.
+// Returns the line reader if successful, returns null otherwise.
+ewelborn_lineReader* ewelborn_lineReader_open(ewelborn_string* filePath);
+
+// This function works the same way as ewelborn_lineReader_open, but the file
+// is read blockSize bytes at a time instead of EWELBORN_LINE_READER_BLOCK_SIZE.
+ewelborn_lineReader* ewelborn_lineReader_openWithBlockSize(ewelborn_string* filePath, size_t blockSize);
+
+// This function will read the next line in the file and store a view of it in
+// line. The view points into the reader's buffer, so it is only valid until
+// the next line is read. Returns true if a line was read, false once there are
+// no lines left (or reading failed, in which case failed will be set).
+bool ewelborn_lineReader_nextView(ewelborn_lineReader* reader, ewelborn_stringView* line);
+
+// This function works the same way as ewelborn_lineReader_nextView, but
+// replaces the contents of the given estring with the line instead. Reusing
+// the same estring for every line avoids allocating anything per line.
+bool ewelborn_lineReader_next(ewelborn_lineReader* reader, ewelborn_string* line);
+
+// This function will close the file and free all memory allocated to the
+// given line reader.
+void ewelborn_lineReader_free(ewelborn_lineReader* reader);
+
+// ewelborn_csvReaders read CSV files into columns instead of rows: every
+// column's values are stored next to each other in one typed array, as
+// int64_t, double, or ewelborn_stringView, so working through a column
+// only touches that column's memory. The characters of string values are
+// all kept in one arena, instead of one estring per field.
+//
+// The file is read a block at a time (with an ewelborn_lineReader), so
+// large files can be read a batch of rows at a time, with
+// ewelborn_csvReader_readRows and ewelborn_csvReader_clearRows.
+//
+// Fields are separated by the delimiter and records by newlines (\n or
+// \r\n). Fields that start with the quote character can hold delimiters,
+// newlines, and quotes (written twice, "" for "), the same as RFC 4180.
+// Blank lines are skipped. Records with fewer fields than there are
+// columns are padded with empty fields, but records with more fields are
+// an error.
+//
+// Each column's type is worked out from the first few rows: integers if
+// every field is an integer, doubles if every field is a number (with empty
+// fields as NaN), and strings otherwise. If an integer column later runs
+// into a double, an empty field, or an integer too large for an int64_t,
+// the whole column is turned into doubles. A field that isn't a number in
+// a number column is an error.
+// Ex.
+//	ewelborn_csvReader* reader = ewelborn_readCSVFromFile(filePath, ewelborn_csvReader_defaultOptions());
+//	double* prices = EWELBORN_TYPED_ARRAY_DATA(reader->columns[2].values, double);
+#define EWELBORN_CSV_DEFAULT_INFERENCE_ROWS 1000
+enum ewelborn_csvColumnType {
+	EWELBORN_CSV_INT64, // values holds int64_t
+	EWELBORN_CSV_DOUBLE, // values holds double
+	EWELBORN_CSV_STRING // values holds ewelborn_stringView, with the characters in the reader's arena
+} typedef ewelborn_csvColumnType;
+
+struct ewelborn_csvColumn {
+	ewelborn_stringView name; // From the header, or empty if the file doesn't have one
+	ewelborn_csvColumnType type;
+	ewelborn_typedArray* values;
+} typedef ewelborn_csvColumn;
+
+struct ewelborn_csvOptions {
+	char delimiter; // ',' by default
+	char quote; // '"' by default
+	bool hasHeader; // True if the first record holds the column names, true by default
+	int inferenceRows; // How many rows the column types are worked out from
+} typedef ewelborn_csvOptions;
+
+// One field of the record that is being read, pointing into the reader's
+// buffer. Escaped fields still have their doubled quotes in them.
+struct ewelborn_csvField {
+	ewelborn_stringView text;
+	bool escaped;
+} typedef ewelborn_csvField;
+
+struct ewelborn_csvReader {
+	ewelborn_csvColumn* columns;
+	int columnCount;
+	int rowCount; // Rows in the columns right now
+	ewelborn_arena* strings; // Holds the column names and every string value
+	ewelborn_arenaMark rowStrings; // Where the string values start in the arena
+	ewelborn_csvOptions options;
+	ewelborn_lineReader* input;
+	ewelborn_csvField* fields;
+	int maxFields;
+	size_t records; // Records read from the file so far, including the header
+	bool failed; // True once a record couldn't be read
+	size_t errorRecord; // If failed, the record (counting from 1) that couldn't be read
+} typedef ewelborn_csvReader;
+
+// Returns the default options: comma separated, double quoted, with a
+// header, and the types worked out from EWELBORN_CSV_DEFAULT_INFERENCE_ROWS rows.
+ewelborn_csvOptions ewelborn_csvReader_defaultOptions();
+
+// Attempts to open the CSV file at the given file path, read its header,
+// and read the first options.inferenceRows rows to work out the type of
+// each column. Those rows are kept in the columns. Returns the reader if
+// successful, returns null otherwise (ex. the file doesn't exist, or one of
+// the first rows couldn't be read).
+ewelborn_csvReader* ewelborn_csvReader_open(ewelborn_string* filePath, ewelborn_csvOptions options);
+
+// This function will read up to maxRows more rows, and add them to the end
+// of the columns. Returns the number of rows read, which is 0 once the whole
+// file has been read. Returns -1 if a record couldn't be read (and failed
+// will be set), in which case the rows before it are kept.
+int ewelborn_csvReader_readRows(ewelborn_csvReader* reader, int maxRows);
+
+// This function will read every row that hasn't been read yet. Returns true
+// if successful, false otherwise.
+bool ewelborn_csvReader_readAll(ewelborn_csvReader* reader);
+
+// This function will remove every row from the columns, and release the
+// memory used by their strings, but keep the column names and types. Any
+// views of string values are no longer valid.
+void ewelborn_csvReader_clearRows(ewelborn_csvReader* reader);
+
+// This function will close the file and free all memory allocated to the
+// given CSV reader, including every column.
+void ewelborn_csvReader_free(ewelborn_csvReader* reader);
+
+// This function will attempt to open and read the entire CSV file at the
+// given file path. Returns the reader, with every row in its columns, if
+// successful, returns null otherwise.
+ewelborn_csvReader* ewelborn_readCSVFromFile(ewelborn_string* filePath, ewelborn_csvOptions options);
+
 // This function will attempt to open the file at the given file path and
 // write the content string to it. If the file has not been created, then
 // this function will create it. This function returns true if the write
 // is successful, false otherwise.
 bool ewelborn_writeStringToFile(ewelborn_string* filePath, ewelborn_string* content);
 
+// When an ewelborn_fileWriter asks the operating system to push everything
+// that has been written so far out to the disk (fsync), which is slow but
+// makes sure that the data survives a crash.
+enum ewelborn_syncPolicy {
+	EWELBORN_SYNC_NEVER,
+	EWELBORN_SYNC_ON_CLOSE,
+	EWELBORN_SYNC_ON_FLUSH
+} typedef ewelborn_syncPolicy;
+
+// ewelborn_fileWriters collect everything written to them in a large buffer,
+// and only write to the file once the buffer is full, so writing many small
+// pieces costs a handful of writes instead of one per piece. Pieces that are
+// too large for the buffer are handed to the operating system directly
+// (with writev where it's available) instead of being copied.
+//
+// The file is written in binary mode, so newlines are *not* turned into
+// \r\n on Windows.
+#define EWELBORN_FILE_WRITER_BUFFER_SIZE (1024 * 1024)
+struct ewelborn_fileWriter {
+#ifdef _WIN32
+	void* handle;
+#else
+	int fileDescriptor;
+#endif
+	char* buffer;
+	size_t bufferSize;
+	size_t used; // Characters in the buffer that haven't been written yet
+	ewelborn_syncPolicy syncPolicy;
+	bool failed; // True once any write has failed
+} typedef ewelborn_fileWriter;
+
+// Attempts to create (or empty) the file at the given file path and open it
+// for writing. Returns the file writer if successful, returns null otherwise.
+ewelborn_fileWriter* ewelborn_fileWriter_open(ewelborn_string* filePath, ewelborn_syncPolicy syncPolicy);
+
+// This function works the same way as ewelborn_fileWriter_open, but the
+// buffer holds bufferSize characters instead of EWELBORN_FILE_WRITER_BUFFER_SIZE.
+ewelborn_fileWriter* ewelborn_fileWriter_openWithBufferSize(ewelborn_string* filePath, size_t bufferSize, ewelborn_syncPolicy syncPolicy);
+
+// This function will write the first length characters of the buffer to the
+// file. Returns true if successful, false otherwise.
+bool ewelborn_fileWriter_writeBuffer(ewelborn_fileWriter* writer, const char* buffer, size_t length);
+
+// This function will write the estring to the file. Returns true if
+// successful, false otherwise.
+bool ewelborn_fileWriter_writeString(ewelborn_fileWriter* writer, ewelborn_string* estring);
+
+// This function will write the view's characters to the file. Returns true
+// if successful, false otherwise.
+bool ewelborn_fileWriter_writeView(ewelborn_fileWriter* writer, ewelborn_stringView view);
+
+// This function will write the estring to the file, followed by a newline
+// (\n). Returns true if successful, false otherwise.
+bool ewelborn_fileWriter_writeLine(ewelborn_fileWriter* writer, ewelborn_string* estring);
+
+// This function will write every estring in the dynamic array to the file,
+// in order, each followed by a newline (\n) if addNewlines is true. Whenever
+// the buffer fills up, the buffer and as many of the remaining estrings as
+// possible are written with a single writev, without copying them. Returns
+// true if successful, false otherwise.
+bool ewelborn_fileWriter_writeAll(ewelborn_fileWriter* writer, ewelborn_dynamicArray* estrings, bool addNewlines);
+
+// This function will write everything in the buffer to the file, and sync
+// the file if the sync policy is EWELBORN_SYNC_ON_FLUSH. Returns true if
+// successful, false otherwise.
+bool ewelborn_fileWriter_flush(ewelborn_fileWriter* writer);
+
+// This function will flush the writer, sync the file unless the sync policy
+// is EWELBORN_SYNC_NEVER, close the file, and free all memory allocated to
+// the given file writer. Returns true if everything written to the writer
+// made it to the file, false otherwise.
+bool ewelborn_fileWriter_close(ewelborn_fileWriter* writer);
+
 #endif // End of header guard clause
\ No newline at end of file
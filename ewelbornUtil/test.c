@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <assert.h>
+#include <math.h>
 #include "ewelbornUtil.h"
 
 /*
@@ -17,6 +18,2077 @@ void test_helloWorld()
 	assert(success == true);
 }
 
+void test_readLinesFromFile()
+{
+	ewelborn_string* filePath = ewelborn_string_initializeWithCString("test_lines.txt");
+	ewelborn_string* content = ewelborn_string_initializeWithCString("first line\n\nthird line\nlast");
+	bool written = ewelborn_writeStringToFile(filePath, content);
+	assert(written);
+	ewelborn_string_free(content);
+
+	ewelborn_mappedFile* mappedFile = ewelborn_mappedFile_open(filePath);
+	assert(mappedFile != NULL);
+	assert(mappedFile->lineCount == 4);
+	size_t length;
+	char* line = ewelborn_mappedFile_getLine(mappedFile, 2, &length);
+	assert(length == 10 && strncmp(line, "third line", length) == 0);
+	char* lineAfterEnd = ewelborn_mappedFile_getLine(mappedFile, 4, &length);
+	assert(lineAfterEnd == NULL);
+	ewelborn_mappedFile_free(mappedFile);
+
+	ewelborn_dynamicArray* lines = ewelborn_readLinesFromFile(filePath);
+	assert(lines != NULL && lines->elements == 4);
+	assert(strcmp(ewelborn_string_getCString(lines->array[0]), "first line") == 0);
+	assert(strcmp(ewelborn_string_getCString(lines->array[1]), "") == 0);
+	assert(strcmp(ewelborn_string_getCString(lines->array[3]), "last") == 0);
+
+	// A tiny block size makes lines cross block boundaries and outgrow the buffer
+	char* expectedLines[] = { "first line", "", "third line", "last" };
+	ewelborn_lineReader* reader = ewelborn_lineReader_openWithBlockSize(filePath, 4);
+	assert(reader != NULL);
+	ewelborn_string* readLine = ewelborn_string_initializeEmpty();
+	int lineCount = 0;
+	while (ewelborn_lineReader_next(reader, readLine)) {
+		assert(lineCount < 4 && strcmp(ewelborn_string_getCString(readLine), expectedLines[lineCount]) == 0);
+		lineCount++;
+	}
+	assert(lineCount == 4 && reader->failed == false);
+	ewelborn_lineReader_free(reader);
+	ewelborn_string_free(readLine);
+
+	ewelborn_dynamicArray_free(lines);
+	ewelborn_string_free(filePath);
+	remove("test_lines.txt");
+}
+
+void test_stringView()
+{
+	ewelborn_string* estring = ewelborn_string_initializeWithCString("  name,, age ,");
+	ewelborn_stringView view = ewelborn_stringView_fromString(estring);
+
+	ewelborn_stringView fields[8];
+	int fieldCount = ewelborn_stringView_split(view, ',', fields, 8);
+	assert(fieldCount == 4);
+	assert(ewelborn_stringView_equals(ewelborn_stringView_trim(fields[0]), ewelborn_stringView_fromCString("name")));
+	assert(fields[1].length == 0 && fields[3].length == 0);
+	assert(ewelborn_stringView_compare(ewelborn_stringView_trim(fields[2]), ewelborn_stringView_fromCString("agf")) < 0);
+	assert(ewelborn_stringView_compare(ewelborn_stringView_fromCString("ab"), ewelborn_stringView_fromCString("a")) > 0);
+	fieldCount = ewelborn_stringView_split(view, ',', fields, 1);
+	assert(fieldCount == 4);
+	assert(ewelborn_stringView_findChar(view, 'a', 3) == 3 && ewelborn_stringView_findChar(view, 'a', 4) == 9);
+	assert(ewelborn_stringView_slice(view, 2, 6).length == 4);
+
+	ewelborn_string* copy = ewelborn_stringView_toString(ewelborn_stringView_slice(view, 2, 6));
+	assert(strcmp(ewelborn_string_getCString(copy), "name") == 0);
+	ewelborn_string_free(copy);
+
+	ewelborn_dynamicArray* split = ewelborn_string_split(estring, ',');
+	assert(split->elements == 4);
+	assert(strcmp(ewelborn_string_getCString(split->array[2]), " age ") == 0);
+	ewelborn_dynamicArray_free(split);
+	ewelborn_string_free(estring);
+}
+
+void test_scanImplementations()
+{
+	// Every implementation should give exactly the same results as the scalar
+	// implementation, including at every possible alignment and length.
+	char buffer[300];
+	const char alphabet[] = "  \t\tab,;xyz";
+	srand(1234);
+	for (int i = 0; i < (int)sizeof(buffer); i++) {
+		buffer[i] = alphabet[rand() % (sizeof(alphabet) - 1)];
+	}
+	// A long run of whitespace to make sure the vectorized trims cross chunks
+	memset(buffer + 100, ' ', 80);
+
+	ewelborn_scanImplementation originalImplementation = ewelborn_scan_getImplementation();
+	for (int implementation = EWELBORN_SCAN_SSE2; implementation <= EWELBORN_SCAN_AVX2; implementation++) {
+		if (ewelborn_scan_isSupported(implementation) == false) { continue; }
+
+		for (int start = 0; start < 40; start++) {
+			for (int length = 0; start + length <= (int)sizeof(buffer); length += 7) {
+				const char* b = buffer + start;
+				size_t expected[6];
+				ewelborn_scan_setImplementation(EWELBORN_SCAN_SCALAR);
+				expected[0] = ewelborn_scan_findChar(b, length, 'z');
+				expected[1] = ewelborn_scan_findAnyOf(b, length, ",;", 2);
+				expected[2] = ewelborn_scan_findAnyOf(b, length, "yz\t", 3);
+				expected[3] = ewelborn_scan_skipWhitespaceLeft(b + 100 - start, length < 100 ? length : 100);
+				expected[4] = ewelborn_scan_skipWhitespaceRight(b, length < 180 - start ? length : 180 - start);
+				expected[5] = ewelborn_scan_countChar(b, length, 'a');
+
+				ewelborn_scan_setImplementation(implementation);
+				assert(ewelborn_scan_findChar(b, length, 'z') == expected[0]);
+				assert(ewelborn_scan_findAnyOf(b, length, ",;", 2) == expected[1]);
+				assert(ewelborn_scan_findAnyOf(b, length, "yz\t", 3) == expected[2]);
+				assert(ewelborn_scan_skipWhitespaceLeft(b + 100 - start, length < 100 ? length : 100) == expected[3]);
+				assert(ewelborn_scan_skipWhitespaceRight(b, length < 180 - start ? length : 180 - start) == expected[4]);
+				assert(ewelborn_scan_countChar(b, length, 'a') == expected[5]);
+			}
+		}
+	}
+	ewelborn_scan_setImplementation(originalImplementation);
+
+	// countChar has to keep counting correctly past 255 chunks
+	char* large = malloc(100000);
+	memset(large, 'a', 100000);
+	assert(ewelborn_scan_countChar(large, 100000, 'a') == 100000);
+	free(large);
+
+	ewelborn_string* estring = ewelborn_string_initializeWithCString("\t  \t                      trim me\t \t                                     ");
+	ewelborn_string_trim(estring);
+	assert(strcmp(ewelborn_string_getCString(estring), "trim me") == 0 && estring->length == 7);
+	ewelborn_string_free(estring);
+}
+
+void test_arena()
+{
+	ewelborn_arena* arena = ewelborn_arena_initialize(256);
+	assert(arena != NULL);
+
+	// Allocations are aligned, and ones larger than a chunk still work
+	char* a = ewelborn_arena_allocate(arena, 10);
+	char* b = ewelborn_arena_allocate(arena, 1000);
+	assert(((size_t)a % EWELBORN_ARENA_ALIGNMENT) == 0 && ((size_t)b % EWELBORN_ARENA_ALIGNMENT) == 0);
+	memset(b, 'x', 1000);
+
+	// The most recent allocation grows in place
+	char* c = ewelborn_arena_allocate(arena, 16);
+	void* reallocation = ewelborn_arena_reallocate(arena, c, 16, 32);
+	assert(reallocation == c);
+
+	// Everything after a mark is released by going back to it
+	ewelborn_arenaMark mark = ewelborn_arena_mark(arena);
+	char* d = ewelborn_arena_allocate(arena, 16);
+	ewelborn_arena_resetToMark(arena, mark);
+	void* allocation = ewelborn_arena_allocate(arena, 16);
+	assert(allocation == d);
+
+	// Estrings grow inside of the arena
+	ewelborn_string* estring = ewelborn_string_initializeWithCStringInArena("a,bb,,ccc", arena);
+	for (int i = 0; i < 100; i++) { ewelborn_string_pushChar(estring, 'd'); }
+	assert(estring->length == 109 && estring->allocator == &arena->allocator);
+
+	ewelborn_dynamicArray* fields = ewelborn_string_splitInArena(estring, ',', arena);
+	assert(fields->elements == 4 && fields->allocator == &arena->allocator);
+	assert(strcmp(ewelborn_string_getCString(fields->array[1]), "bb") == 0);
+	assert(((ewelborn_string*)fields->array[3])->length == 103);
+
+	// Freeing arena datastructures does nothing, the reset releases them
+	ewelborn_dynamicArray_free(fields);
+	ewelborn_string_free(estring);
+	ewelborn_arena_reset(arena);
+	assert(arena->current == arena->first && arena->first->used == 0);
+
+	ewelborn_arena_free(arena);
+}
+
+void test_typedArray()
+{
+	ewelborn_typedArray* numbers = EWELBORN_TYPED_ARRAY_INITIALIZE(int);
+	for (int i = 0; i < 100; i++) {
+		bool pushed = EWELBORN_TYPED_ARRAY_PUSH(numbers, int, i);
+		assert(pushed);
+	}
+	assert(numbers->elements == 100 && EWELBORN_TYPED_ARRAY_AT(numbers, int, 42) == 42);
+
+	int more[3] = { 100, 101, 102 };
+	bool appended = ewelborn_typedArray_appendMany(numbers, more, 3);
+	assert(appended);
+	assert(numbers->elements == 103 && EWELBORN_TYPED_ARRAY_AT(numbers, int, 102) == 102);
+
+	int popped;
+	bool wasPopped = ewelborn_typedArray_pop(numbers, &popped);
+	assert(wasPopped && popped == 102);
+
+	int inserted = -1;
+	bool wasInserted = ewelborn_typedArray_insert(numbers, 0, &inserted);
+	assert(wasInserted);
+	assert(EWELBORN_TYPED_ARRAY_AT(numbers, int, 0) == -1 && EWELBORN_TYPED_ARRAY_AT(numbers, int, 1) == 0);
+	bool removed = ewelborn_typedArray_remove(numbers, 0);
+	assert(removed);
+	removed = ewelborn_typedArray_remove(numbers, 1000);
+	assert(removed == false);
+	assert(*(int*)ewelborn_typedArray_get(numbers, 10) == 10);
+	assert(ewelborn_typedArray_get(numbers, 102) == NULL);
+
+	bool shrunk = ewelborn_typedArray_shrinkToFit(numbers);
+	assert(shrunk && numbers->maxElements == 102);
+	bool reserved = ewelborn_typedArray_reserve(numbers, 1000);
+	assert(reserved && numbers->maxElements == 1000);
+
+	long long sum = 0;
+	int* data = EWELBORN_TYPED_ARRAY_DATA(numbers, int);
+	for (int i = 0; i < numbers->elements; i++) { sum += data[i]; }
+	assert(sum == 101 * 102 / 2);
+
+	// Elements can come from the typed array itself, even when adding them
+	// makes the array grow
+	shrunk = ewelborn_typedArray_shrinkToFit(numbers);
+	assert(shrunk);
+	bool pushed = ewelborn_typedArray_push(numbers, ewelborn_typedArray_get(numbers, 5));
+	assert(pushed);
+	assert(numbers->elements == 103 && EWELBORN_TYPED_ARRAY_AT(numbers, int, 102) == 5);
+	shrunk = ewelborn_typedArray_shrinkToFit(numbers);
+	assert(shrunk);
+	wasInserted = ewelborn_typedArray_insert(numbers, 0, ewelborn_typedArray_get(numbers, 7));
+	assert(wasInserted);
+	assert(EWELBORN_TYPED_ARRAY_AT(numbers, int, 0) == 7 && EWELBORN_TYPED_ARRAY_AT(numbers, int, 8) == 7);
+	shrunk = ewelborn_typedArray_shrinkToFit(numbers);
+	assert(shrunk);
+	appended = ewelborn_typedArray_appendMany(numbers, numbers->data, numbers->elements);
+	assert(appended);
+	assert(numbers->elements == 208);
+	for (int i = 0; i < 104; i++) {
+		assert(EWELBORN_TYPED_ARRAY_AT(numbers, int, i) == EWELBORN_TYPED_ARRAY_AT(numbers, int, i + 104));
+	}
+
+	ewelborn_typedArray_free(numbers);
+}
+
+void test_hashMap()
+{
+	ewelborn_hashMap* map = ewelborn_hashMap_initialize();
+	char key[32];
+
+	// Enough keys to make the map grow several times
+	for (int i = 0; i < 10000; i++) {
+		snprintf(key, sizeof(key), "key%d", i);
+		bool inserted = ewelborn_hashMap_insertView(map, ewelborn_stringView_fromCString(key), (void*)(size_t)i);
+		assert(inserted);
+	}
+	assert(map->size == 10000);
+
+	ewelborn_string* estring = ewelborn_string_initializeWithCString("key1234");
+	void** value = ewelborn_hashMap_find(map, estring);
+	assert(value != NULL && (size_t)*value == 1234);
+	assert(ewelborn_string_hash(estring) == ewelborn_stringView_hash(ewelborn_stringView_fromCString("key1234")));
+
+	// Inserting an existing key replaces its value
+	bool inserted = ewelborn_hashMap_insert(map, estring, (void*)(size_t)1);
+	assert(inserted);
+	assert(map->size == 10000 && (size_t)*ewelborn_hashMap_find(map, estring) == 1);
+
+	// Erase every even key, and make sure the odd keys survive the shifting
+	for (int i = 0; i < 10000; i += 2) {
+		snprintf(key, sizeof(key), "key%d", i);
+		bool erased = ewelborn_hashMap_eraseView(map, ewelborn_stringView_fromCString(key));
+		assert(erased);
+	}
+	assert(map->size == 5000);
+	bool erased = ewelborn_hashMap_erase(map, estring);
+	assert(erased == false);
+	for (int i = 0; i < 10000; i++) {
+		snprintf(key, sizeof(key), "key%d", i);
+		value = ewelborn_hashMap_findView(map, ewelborn_stringView_fromCString(key));
+		assert((value != NULL) == (i % 2 == 1));
+	}
+
+	size_t iterator = 0;
+	size_t visited = 0;
+	ewelborn_stringView iteratedKey;
+	while (ewelborn_hashMap_next(map, &iterator, &iteratedKey, NULL)) {
+		assert(iteratedKey.length >= 4 && iteratedKey.data[iteratedKey.length] == '\0');
+		visited++;
+	}
+	assert(visited == 5000);
+
+	bool reserved = ewelborn_hashMap_reserve(map, 100000);
+	assert(reserved && map->capacity >= 100000);
+	ewelborn_hashMap_clear(map);
+	assert(map->size == 0 && ewelborn_hashMap_findView(map, ewelborn_stringView_fromCString("key1")) == NULL);
+
+	ewelborn_string_free(estring);
+	ewelborn_hashMap_free(map);
+}
+
+// Adds the element (a pointer to an int) to the running hash in listSum, which depends on the order of the elements
+static unsigned long long listSum = 0;
+static void addToListSum(void* element)
+{
+	listSum = listSum * 3 + *(int*)element;
+}
+
+void test_list()
+{
+	int values[100];
+	for (int i = 0; i < 100; i++) { values[i] = i; }
+
+	ewelborn_nodePool* pool = ewelborn_nodePool_initialize(sizeof(ewelborn_listNode), 8);
+	ewelborn_list* front = ewelborn_list_initializeWithPool(pool);
+	ewelborn_list* back = ewelborn_list_initializeWithPool(pool);
+	for (int i = 0; i < 50; i++) {
+		bool pushed = ewelborn_list_pushToBack(back, &values[50 + i]);
+		assert(pushed);
+		pushed = ewelborn_list_pushToFront(front, &values[49 - i]);
+		assert(pushed);
+	}
+	assert(*(int*)ewelborn_list_peekFront(front) == 0 && *(int*)ewelborn_list_peekBack(front) == 49);
+
+	bool spliced = ewelborn_list_splice(front, back);
+	assert(spliced);
+	assert(front->size == 100 && back->size == 0 && back->head == NULL);
+	void* poppedElement = ewelborn_list_popBack(front);
+	assert(*(int*)poppedElement == 99);
+	poppedElement = ewelborn_list_popFront(front);
+	assert(*(int*)poppedElement == 0);
+	assert(front->size == 98);
+
+	// The popped nodes are reused before the pool grows
+	void* slabs = pool->slabs;
+	ewelborn_list_pushToBack(front, &values[99]);
+	ewelborn_list_pushToFront(front, &values[0]);
+	assert(pool->slabs == slabs);
+
+	// Lists that don't share a pool can't be spliced
+	ewelborn_list* separate = ewelborn_list_initialize();
+	spliced = ewelborn_list_splice(front, separate);
+	assert(spliced == false);
+
+	ewelborn_unrolledList* unrolled = ewelborn_unrolledList_initialize();
+	for (int i = 0; i < 50; i++) {
+		bool pushed = ewelborn_unrolledList_pushToBack(unrolled, &values[50 + i]);
+		assert(pushed);
+		pushed = ewelborn_unrolledList_pushToFront(unrolled, &values[49 - i]);
+		assert(pushed);
+	}
+	assert(unrolled->size == 100);
+
+	// Both lists hold 0..99 in order, so they should traverse the same way
+	listSum = 0;
+	ewelborn_list_traverse(front, addToListSum);
+	unsigned long long expectedSum = listSum;
+	listSum = 0;
+	ewelborn_unrolledList_traverse(unrolled, addToListSum);
+	assert(listSum == expectedSum);
+
+	for (int i = 0; i < 30; i++) {
+		poppedElement = ewelborn_unrolledList_popFront(unrolled);
+		assert(*(int*)poppedElement == i);
+		poppedElement = ewelborn_unrolledList_popBack(unrolled);
+		assert(*(int*)poppedElement == 99 - i);
+	}
+	assert(unrolled->size == 40 && *(int*)ewelborn_unrolledList_peekFront(unrolled) == 30);
+	while (unrolled->size > 0) { ewelborn_unrolledList_popBack(unrolled); }
+	assert(unrolled->head == NULL && unrolled->tail == NULL);
+	poppedElement = ewelborn_unrolledList_popFront(unrolled);
+	assert(poppedElement == NULL);
+
+	// The elements belong to the values array, so they must not be freed
+	while (front->size > 0) { ewelborn_list_popFront(front); }
+	ewelborn_list_free(front);
+	ewelborn_list_free(back);
+	ewelborn_list_free(separate);
+	ewelborn_unrolledList_free(unrolled);
+	ewelborn_nodePool_free(pool);
+}
+
+void test_smallString()
+{
+	// Short estrings live inside of the estring itself
+	ewelborn_string* estring = ewelborn_string_initializeWithCString("short");
+	assert(estring->cstring == estring->inlineBuffer);
+
+	ewelborn_string* clone = ewelborn_string_clone(estring);
+	assert(clone->cstring == clone->inlineBuffer && strcmp(ewelborn_string_getCString(clone), "short") == 0);
+
+	// and move out once they grow too long for it
+	ewelborn_string_appendCString(estring, " string that has grown");
+	assert(estring->cstring != estring->inlineBuffer);
+	assert(strcmp(ewelborn_string_getCString(estring), "short string that has grown") == 0);
+
+	ewelborn_string* longClone = ewelborn_string_clone(estring);
+	assert(longClone->cstring != estring->cstring && strcmp(longClone->cstring, estring->cstring) == 0);
+
+	ewelborn_string_free(estring);
+	ewelborn_string_free(clone);
+	ewelborn_string_free(longClone);
+}
+
+void test_stringAppend()
+{
+	ewelborn_string* estring = ewelborn_string_initializeEmpty();
+	bool wasReserved = ewelborn_string_reserve(estring, 100);
+	assert(wasReserved && estring->maxLength >= 101);
+	char* reserved = estring->cstring;
+
+	// Appending within the reserved room doesn't move the characters
+	bool appended = ewelborn_string_appendCString(estring, "Hello");
+	assert(appended);
+	appended = ewelborn_string_appendView(estring, ewelborn_stringView_fromCString(", world!"));
+	assert(appended);
+	assert(estring->cstring == reserved && strcmp(estring->cstring, "Hello, world!") == 0);
+
+	// Binary data keeps its null characters
+	appended = ewelborn_string_appendN(estring, "a\0b", 3);
+	assert(appended);
+	assert(estring->length == 16 && memcmp(estring->cstring + 13, "a\0b", 4) == 0);
+	ewelborn_string_deleteRight(estring, 3);
+
+	// Appending an estring to itself
+	appended = ewelborn_string_append(estring, estring);
+	assert(appended);
+	assert(strcmp(estring->cstring, "Hello, world!Hello, world!") == 0);
+
+	ewelborn_string* a = ewelborn_string_initializeWithCString("one ");
+	ewelborn_string* b = ewelborn_string_initializeWithCString("two ");
+	ewelborn_dynamicArray* parts = ewelborn_dynamicArray_initialize();
+	ewelborn_dynamicArray_push(parts, a);
+	ewelborn_dynamicArray_push(parts, b);
+	ewelborn_dynamicArray_push(parts, a);
+	appended = ewelborn_string_appendMany(a, parts);
+	assert(appended);
+	assert(strcmp(a->cstring, "one one two one ") == 0 && a->length == 16);
+
+	// Views that point into the estring being appended to
+	ewelborn_stringView views[3] = {
+		ewelborn_stringView_slice(ewelborn_stringView_fromString(b), 0, 3),
+		ewelborn_stringView_fromCString(" and "),
+		ewelborn_stringView_slice(ewelborn_stringView_fromString(b), 0, 3),
+	};
+	appended = ewelborn_string_appendViews(b, views, 3);
+	assert(appended);
+	assert(strcmp(b->cstring, "two two and two") == 0);
+
+	free(parts->array);
+	free(parts);
+	ewelborn_string_free(a);
+	ewelborn_string_free(b);
+	ewelborn_string_free(estring);
+}
+
+static void doubleInt(void* element)
+{
+	*(int*)element *= 2;
+}
+
+void test_parallel()
+{
+	assert(ewelborn_getProcessorCount() >= 1);
+
+	// Large enough to be cut into several chunks, with empty lines and a
+	// trailing delimiter that the chunks need to agree on.
+	ewelborn_string* estring = ewelborn_string_initializeEmpty();
+	char line[32];
+	for (int i = 0; i < 200000; i++) {
+		snprintf(line, sizeof(line), i % 7 == 0 ? "\n" : "line %d\n", i);
+		ewelborn_string_appendCString(estring, line);
+	}
+
+	ewelborn_dynamicArray* expected = ewelborn_string_split(estring, '\n');
+	ewelborn_dynamicArray* fields = ewelborn_string_splitParallel(estring, '\n', 4);
+	assert(fields != NULL && fields->elements == expected->elements);
+	for (int i = 0; i < fields->elements; i++) {
+		assert(strcmp(ewelborn_string_getCString(fields->array[i]), ewelborn_string_getCString(expected->array[i])) == 0);
+	}
+
+	ewelborn_string* filePath = ewelborn_string_initializeWithCString("test_parallel.txt");
+	ewelborn_fileWriter* writer = ewelborn_fileWriter_open(filePath, EWELBORN_SYNC_NEVER);
+	assert(writer != NULL);
+	ewelborn_fileWriter_writeView(writer, ewelborn_stringView_fromCString("no newline at the end"));
+	ewelborn_fileWriter_writeString(writer, estring);
+	ewelborn_fileWriter_writeView(writer, ewelborn_stringView_fromCString("no newline at the end"));
+	bool closed = ewelborn_fileWriter_close(writer);
+	assert(closed);
+
+	ewelborn_mappedFile* serialFile = ewelborn_mappedFile_open(filePath);
+	ewelborn_mappedFile* parallelFile = ewelborn_mappedFile_openParallel(filePath, 8);
+	assert(serialFile != NULL && parallelFile != NULL);
+	assert(serialFile->lineCount == parallelFile->lineCount);
+	for (size_t i = 0; i < serialFile->lineCount; i++) {
+		assert(serialFile->lines[i].offset == parallelFile->lines[i].offset);
+		assert(serialFile->lines[i].length == parallelFile->lines[i].length);
+	}
+	ewelborn_mappedFile_free(serialFile);
+	ewelborn_mappedFile_free(parallelFile);
+
+	ewelborn_dynamicArray* lines = ewelborn_readLinesFromFileParallel(filePath, 0);
+	assert(lines != NULL && lines->elements == expected->elements);
+	assert(strcmp(ewelborn_string_getCString(lines->array[lines->elements - 1]), "no newline at the end") == 0);
+
+	ewelborn_dynamicArray* numbers = ewelborn_dynamicArray_initialize();
+	for (int i = 0; i < 1000; i++) {
+		int* number = malloc(sizeof(int));
+		*number = i;
+		ewelborn_dynamicArray_push(numbers, number);
+	}
+	ewelborn_dynamicArray_traverseParallel(numbers, doubleInt, 4);
+	for (int i = 0; i < 1000; i++) {
+		assert(*(int*)numbers->array[i] == i * 2);
+	}
+
+	ewelborn_dynamicArray_free(numbers);
+	ewelborn_dynamicArray_free(lines);
+	ewelborn_dynamicArray_free(fields);
+	ewelborn_dynamicArray_free(expected);
+	ewelborn_string_free(filePath);
+	ewelborn_string_free(estring);
+	remove("test_parallel.txt");
+}
+
+struct threadPoolVisits {
+	ewelborn_threadPool* pool;
+	int* visits;
+	int count;
+};
+
+static void visitRange(void* context, size_t start, size_t end)
+{
+	// Every index belongs to exactly one range, so no two threads touch
+	// the same visit count.
+	struct threadPoolVisits* visits = context;
+	for (size_t i = start; i < end; i++) {
+		visits->visits[i]++;
+	}
+}
+
+static void visitNested(void* argument)
+{
+	// Tasks can submit more tasks, and run parallelFor themselves
+	struct threadPoolVisits* visits = argument;
+	ewelborn_threadPool_parallelFor(visits->pool, 0, visits->count, 16, visitRange, visits);
+}
+
+static void* squareInt(void* element)
+{
+	int* square = malloc(sizeof(int));
+	*square = *(int*)element * *(int*)element;
+	return square;
+}
+
+void test_threadPool()
+{
+	ewelborn_threadPool* pool = ewelborn_threadPool_initialize(4);
+	assert(pool != NULL && ewelborn_threadPool_getThreadCount(pool) == 4);
+
+	struct threadPoolVisits visits = { pool, calloc(100000, sizeof(int)), 100000 };
+	ewelborn_threadPool_parallelFor(pool, 0, visits.count, 0, visitRange, &visits);
+	for (int i = 0; i < visits.count; i++) {
+		assert(visits.visits[i] == 1);
+	}
+	free(visits.visits);
+
+	struct threadPoolVisits nested[50];
+	for (int i = 0; i < 50; i++) {
+		nested[i].pool = pool;
+		nested[i].visits = calloc(1000, sizeof(int));
+		nested[i].count = 1000;
+		bool submitted = ewelborn_threadPool_submit(pool, visitNested, &nested[i]);
+		assert(submitted);
+	}
+	ewelborn_threadPool_wait(pool);
+	for (int i = 0; i < 50; i++) {
+		for (int j = 0; j < 1000; j++) {
+			assert(nested[i].visits[j] == 1);
+		}
+		free(nested[i].visits);
+	}
+
+	ewelborn_dynamicArray* numbers = ewelborn_dynamicArray_initialize();
+	for (int i = 0; i < 1000; i++) {
+		int* number = malloc(sizeof(int));
+		*number = i;
+		ewelborn_dynamicArray_push(numbers, number);
+	}
+	ewelborn_dynamicArray* squares = ewelborn_threadPool_parallelMap(pool, numbers, squareInt);
+	assert(squares != NULL && squares->elements == 1000);
+	ewelborn_threadPool_parallelTraverse(pool, numbers, doubleInt);
+	for (int i = 0; i < 1000; i++) {
+		assert(*(int*)squares->array[i] == i * i && *(int*)numbers->array[i] == i * 2);
+	}
+
+	ewelborn_threadPool_free(pool);
+	ewelborn_dynamicArray_free(numbers);
+	ewelborn_dynamicArray_free(squares);
+}
+
+static void freeString(void* element)
+{
+	ewelborn_string_free(element);
+}
+
+void test_fileWriter()
+{
+	ewelborn_string* filePath = ewelborn_string_initializeWithCString("test_writer.txt");
+	ewelborn_dynamicArray* lines = ewelborn_dynamicArray_initialize();
+	lines->freeElement = freeString;
+	for (int i = 0; i < 3000; i++) {
+		char line[64];
+		snprintf(line, sizeof(line), i % 5 == 0 ? "a much longer line number %d" : "line %d", i);
+		ewelborn_dynamicArray_push(lines, ewelborn_string_initializeWithCString(line));
+	}
+
+	// A tiny buffer, so that the estrings overflow it and are written directly
+	ewelborn_fileWriter* writer = ewelborn_fileWriter_openWithBufferSize(filePath, 64, EWELBORN_SYNC_ON_CLOSE);
+	assert(writer != NULL);
+	bool written = ewelborn_fileWriter_writeView(writer, ewelborn_stringView_fromCString("header, "));
+	assert(written);
+	written = ewelborn_fileWriter_writeLine(writer, filePath);
+	assert(written);
+	written = ewelborn_fileWriter_writeAll(writer, lines, true);
+	assert(written);
+	written = ewelborn_fileWriter_writeString(writer, lines->array[1]);
+	assert(written);
+	written = ewelborn_fileWriter_flush(writer);
+	assert(written);
+	bool closed = ewelborn_fileWriter_close(writer);
+	assert(closed);
+
+	ewelborn_dynamicArray* readLines = ewelborn_readLinesFromFile(filePath);
+	assert(readLines != NULL && readLines->elements == 3002);
+	assert(strcmp(ewelborn_string_getCString(readLines->array[0]), "header, test_writer.txt") == 0);
+	for (int i = 0; i < 3000; i++) {
+		assert(strcmp(ewelborn_string_getCString(readLines->array[i + 1]), ewelborn_string_getCString(lines->array[i])) == 0);
+	}
+	assert(strcmp(ewelborn_string_getCString(readLines->array[3001]), "line 1") == 0);
+
+	ewelborn_string* content = ewelborn_string_initializeWithCString("replaced");
+	written = ewelborn_writeStringToFile(filePath, content);
+	assert(written);
+	ewelborn_mappedFile* file = ewelborn_mappedFile_open(filePath);
+	assert(file != NULL && file->size == 8);
+	ewelborn_mappedFile_free(file);
+
+	ewelborn_dynamicArray_free(readLines);
+	ewelborn_dynamicArray_free(lines);
+	ewelborn_string_free(content);
+	ewelborn_string_free(filePath);
+	remove("test_writer.txt");
+}
+
+void test_allocator()
+{
+	ewelborn_statsAllocator* stats = ewelborn_statsAllocator_initialize(NULL);
+	assert(stats != NULL);
+
+	// Datastructures keep using the allocator they were created with
+	ewelborn_string* estring = ewelborn_string_initializeWithAllocator(&stats->allocator);
+	for (int i = 0; i < 100; i++) { ewelborn_string_pushChar(estring, 'a'); }
+	ewelborn_allocationStats strings = ewelborn_statsAllocator_getCategory(stats, EWELBORN_ALLOCATION_STRING);
+	assert(strings.allocations == 2 && strings.reallocations > 0);
+	assert(strings.liveBytes == (long long)(sizeof(ewelborn_string) + estring->maxLength));
+
+	// Only the array's own memory comes from its allocator. The elements are
+	// still the caller's, and are freed with free.
+	ewelborn_dynamicArray* array = ewelborn_dynamicArray_initializeWithAllocator(&stats->allocator);
+	for (int i = 0; i < 20; i++) {
+		int* element = malloc(sizeof(int));
+		*element = i;
+		ewelborn_dynamicArray_push(array, element);
+	}
+	assert(ewelborn_statsAllocator_getCategory(stats, EWELBORN_ALLOCATION_ARRAY).allocations == 2);
+	assert(ewelborn_statsAllocator_getCategory(stats, EWELBORN_ALLOCATION_OTHER).allocations == 0);
+
+	ewelborn_hashMap* map = ewelborn_hashMap_initializeWithAllocator(&stats->allocator);
+	for (int i = 0; i < 100; i++) {
+		char key[16];
+		snprintf(key, sizeof(key), "key%d", i);
+		ewelborn_hashMap_insertView(map, ewelborn_stringView_fromCString(key), NULL);
+	}
+	assert(ewelborn_statsAllocator_getCategory(stats, EWELBORN_ALLOCATION_HASH_MAP).allocations > 1);
+
+	// The radix heap's buckets come from its allocator too
+	ewelborn_radixHeap* heap = ewelborn_radixHeap_initializeWithAllocator(&stats->allocator);
+	for (int i = 0; i < 100; i++) { ewelborn_radixHeap_push(heap, NULL, (uint64_t)i * 3); }
+	assert(ewelborn_statsAllocator_getCategory(stats, EWELBORN_ALLOCATION_ARRAY).allocations == 2 + 1 + 65 * 2);
+
+	long long peak = ewelborn_statsAllocator_getTotal(stats).peakBytes;
+	ewelborn_string_free(estring);
+	ewelborn_dynamicArray_free(array);
+	ewelborn_hashMap_free(map);
+	ewelborn_radixHeap_free(heap);
+
+	// Everything has been given back, but the peak is remembered
+	ewelborn_allocationStats total = ewelborn_statsAllocator_getTotal(stats);
+	assert(total.liveBytes == 0 && total.allocations == total.releases);
+	assert(total.peakBytes == peak && peak > 0);
+
+	// An arena can sit on top of another allocator, and containers in it
+	// don't release anything on their own, including their elements.
+	ewelborn_arena* arena = ewelborn_arena_initializeWithAllocator(0, &stats->allocator);
+	ewelborn_statsAllocator_resetCounts(stats);
+	ewelborn_dynamicArray* fields = ewelborn_dynamicArray_initializeWithAllocator(&arena->allocator);
+	ewelborn_dynamicArray_push(fields, ewelborn_string_initializeInArena(arena));
+	ewelborn_dynamicArray_push(fields, ewelborn_arena_allocate(arena, 16));
+	ewelborn_dynamicArray_free(fields);
+	assert(ewelborn_statsAllocator_getTotal(stats).allocations == 0);
+	ewelborn_dynamicArray* arenaFields = ewelborn_dynamicArray_initializeInArena(arena);
+	for (int i = 0; i < 100; i++) {
+		ewelborn_dynamicArray_push(arenaFields, ewelborn_string_initializeWithCStringInArena("an arena estring too long to fit inline", arena));
+	}
+	ewelborn_dynamicArray_free(arenaFields);
+	ewelborn_radixHeap* arenaHeap = ewelborn_radixHeap_initializeWithAllocator(&arena->allocator);
+	for (int i = 100; i > 0; i--) { ewelborn_radixHeap_push(arenaHeap, NULL, (uint64_t)i); }
+	uint64_t key;
+	bool popped = ewelborn_radixHeap_pop(arenaHeap, NULL, &key);
+	assert(popped && key == 1);
+	popped = ewelborn_radixHeap_pop(arenaHeap, NULL, &key);
+	assert(popped && key == 2);
+	ewelborn_radixHeap_free(arenaHeap);
+	ewelborn_arena_free(arena);
+	assert(ewelborn_statsAllocator_getTotal(stats).liveBytes == 0);
+
+	// With the stats allocator in place globally, every other allocation is
+	// counted as well.
+	ewelborn_setAllocator(&stats->allocator);
+	ewelborn_string* global = ewelborn_string_initializeWithCString("a string that is too long to fit inline");
+	assert(global->allocator == &stats->allocator);
+	assert(ewelborn_statsAllocator_getTotal(stats).liveBytes > 0);
+	ewelborn_string_free(global);
+
+	// Elements malloc'd by the caller are still freed with free, and split
+	// results give back their estrings through the allocator
+	ewelborn_dynamicArray* globalArray = ewelborn_dynamicArray_initialize();
+	int* element = malloc(sizeof(int));
+	ewelborn_dynamicArray_push(globalArray, element);
+	ewelborn_dynamicArray_free(globalArray);
+	ewelborn_string* line = ewelborn_string_initializeWithCString("a field that is too long to fit inline,b");
+	ewelborn_dynamicArray* splitFields = ewelborn_string_split(line, ',');
+	assert(splitFields->elements == 2);
+	ewelborn_dynamicArray_free(splitFields);
+	ewelborn_string_free(line);
+	ewelborn_setAllocator(NULL);
+	assert(ewelborn_getAllocator() == ewelborn_getHeapAllocator());
+	assert(ewelborn_statsAllocator_getTotal(stats).liveBytes == 0);
+
+	ewelborn_statsAllocator_free(stats);
+}
+
+// Finds the needle the slow way, to check the real search against
+static int naiveFind(const char* haystack, int length, const char* needle, int needleLength, int offset)
+{
+	for (int i = offset; i + needleLength <= length; i++) {
+		if (memcmp(haystack + i, needle, needleLength) == 0) { return i; }
+	}
+	return -1;
+}
+
+void test_substringSearch()
+{
+	ewelborn_string* estring = ewelborn_string_initializeWithCString("one two two three");
+	assert(ewelborn_string_find(estring, ewelborn_stringView_fromCString("two"), 0) == 4);
+	assert(ewelborn_string_find(estring, ewelborn_stringView_fromCString("two"), 5) == 8);
+	assert(ewelborn_string_find(estring, ewelborn_stringView_fromCString("four"), 0) == -1);
+	assert(ewelborn_string_find(estring, ewelborn_stringView_fromCString(""), 3) == 3);
+	assert(ewelborn_string_count(estring, ewelborn_stringView_fromCString("t")) == 3);
+	assert(ewelborn_string_count(estring, ewelborn_stringView_fromCString("")) == 0);
+
+	ewelborn_typedArray* positions = ewelborn_stringView_findAll(ewelborn_stringView_fromCString("aaaaa"), ewelborn_stringView_fromCString("aa"));
+	assert(positions->elements == 2 && EWELBORN_TYPED_ARRAY_AT(positions, int, 1) == 2);
+	ewelborn_typedArray_free(positions);
+
+	// Compare against the slow search with a small alphabet, which makes
+	// lots of partial matches and periodic needles.
+	char haystack[200];
+	char needle[12];
+	srand(1234);
+	for (int round = 0; round < 2000; round++) {
+		int length = rand() % 200;
+		int needleLength = 1 + rand() % 11;
+		for (int i = 0; i < length; i++) { haystack[i] = "ab"[rand() % 2]; }
+		for (int i = 0; i < needleLength; i++) { needle[i] = "ab"[rand() % 2]; }
+		ewelborn_stringView view = ewelborn_stringView_fromBuffer(haystack, length);
+		ewelborn_stringView needleView = ewelborn_stringView_fromBuffer(needle, needleLength);
+		int offset = length > 0 ? rand() % length : 0;
+		assert(ewelborn_stringView_find(view, needleView, offset) == naiveFind(haystack, length, needle, needleLength, offset));
+
+		int count = 0;
+		for (int i = naiveFind(haystack, length, needle, needleLength, 0); i >= 0;
+			i = naiveFind(haystack, length, needle, needleLength, i + needleLength)) {
+			count++;
+		}
+		assert(ewelborn_stringView_count(view, needleView) == count);
+	}
+
+	// Haystacks full of near matches, which are left to Two-Way part way through
+	char* nearHaystack = malloc(4000);
+	for (int round = 0; round < 200; round++) {
+		int length = rand() % 4000;
+		int needleLength = 2 + rand() % 40;
+		for (int i = 0; i < length; i++) { nearHaystack[i] = rand() % 20 == 0 ? 'b' : 'a'; }
+		char longNeedle[42];
+		for (int i = 0; i < needleLength; i++) { longNeedle[i] = rand() % 20 == 0 ? 'b' : 'a'; }
+		int expected = naiveFind(nearHaystack, length, longNeedle, needleLength, 0);
+		size_t found = ewelborn_scan_find(nearHaystack, length, longNeedle, needleLength);
+		assert(found == (expected >= 0 ? (size_t)expected : (size_t)length));
+	}
+	free(nearHaystack);
+
+	// Pathological inputs still finish quickly
+	int bigLength = 1 << 20;
+	char* big = malloc(bigLength);
+	memset(big, 'a', bigLength);
+	char hardNeedle[1000];
+	memset(hardNeedle, 'a', sizeof(hardNeedle));
+	hardNeedle[sizeof(hardNeedle) - 1] = 'b';
+	assert(ewelborn_scan_find(big, bigLength, hardNeedle, sizeof(hardNeedle)) == (size_t)bigLength);
+	hardNeedle[0] = 'b';
+	hardNeedle[sizeof(hardNeedle) - 1] = 'a';
+	assert(ewelborn_scan_find(big, bigLength, hardNeedle, sizeof(hardNeedle)) == (size_t)bigLength);
+	big[bigLength - 1000] = 'b';
+	assert(ewelborn_scan_find(big, bigLength, hardNeedle, sizeof(hardNeedle)) == (size_t)(bigLength - 1000));
+	memset(hardNeedle, 'a', sizeof(hardNeedle));
+	hardNeedle[500] = 'b';
+	assert(ewelborn_scan_find(big, bigLength, hardNeedle, sizeof(hardNeedle)) == (size_t)(bigLength - 1500));
+	free(big);
+
+	// Replacements that shrink, grow, move inline, and that come from the
+	// estring itself.
+	bool replaced = ewelborn_string_replaceAll(estring, ewelborn_stringView_fromCString("two"), ewelborn_stringView_fromCString("2"));
+	assert(replaced);
+	assert(strcmp(estring->cstring, "one 2 2 three") == 0 && estring->length == 13);
+	replaced = ewelborn_string_replaceAll(estring, ewelborn_stringView_fromCString(" "), ewelborn_stringView_fromCString(", and "));
+	assert(replaced);
+	assert(strcmp(estring->cstring, "one, and 2, and 2, and three") == 0);
+	replaced = ewelborn_string_replaceAll(estring, ewelborn_stringView_fromCString(", and "), ewelborn_stringView_fromCString(""));
+	assert(replaced);
+	assert(strcmp(estring->cstring, "one22three") == 0 && estring->length == 10);
+	replaced = ewelborn_string_replaceAll(estring, ewelborn_stringView_fromBuffer(estring->cstring + 3, 1), ewelborn_stringView_fromBuffer(estring->cstring, 3));
+	assert(replaced);
+	assert(strcmp(estring->cstring, "oneoneonethree") == 0);
+	replaced = ewelborn_string_replaceAll(estring, ewelborn_stringView_fromCString("missing"), ewelborn_stringView_fromCString("x"));
+	assert(replaced);
+	assert(estring->length == 14);
+	ewelborn_string_free(estring);
+}
+
+void test_frontDeletion()
+{
+	ewelborn_string* estring = ewelborn_string_initializeWithCString("Hello, world! This is long enough for the heap.");
+	ewelborn_string_deleteLeft(estring, 7);
+	assert(strcmp(estring->cstring, "world! This is long enough for the heap.") == 0 && estring->length == 40);
+	ewelborn_string_deleteChar(estring, 1);
+	assert(strcmp(estring->cstring, "wrld! This is long enough for the heap.") == 0 && estring->length == 39);
+	ewelborn_string_deleteChar(estring, 37);
+	assert(strcmp(estring->cstring, "wrld! This is long enough for the hea.") == 0 && estring->length == 38);
+	bool wasConsumed = ewelborn_string_consumeChar(estring, 'w', 0);
+	assert(wasConsumed);
+	wasConsumed = ewelborn_string_consumeChar(estring, 'w', 0);
+	assert(wasConsumed == false);
+	ewelborn_string_slice(estring, 5, 9);
+	assert(strcmp(estring->cstring, "This") == 0 && estring->length == 4);
+
+	// Appending reuses the room in front before growing the buffer
+	int room = estring->maxLength + estring->start;
+	char* buffer = estring->cstring - estring->start;
+	bool appended = ewelborn_string_appendCString(estring, " is the end of the string, padded out");
+	assert(appended);
+	assert(strcmp(estring->cstring, "This is the end of the string, padded out") == 0);
+	assert(estring->cstring == buffer && estring->start == 0 && estring->maxLength == room);
+
+	// Deleting everything starts the estring over at the front
+	ewelborn_string_deleteLeft(estring, 1000);
+	assert(estring->length == 0 && estring->start == 0 && estring->cstring[0] == '\0');
+	ewelborn_string_free(estring);
+
+	// Inline estrings work the same way
+	estring = ewelborn_string_initializeWithCString("  short");
+	ewelborn_string_trimLeft(estring);
+	assert(strcmp(estring->cstring, "short") == 0 && estring->length == 5);
+	appended = ewelborn_string_appendCString(estring, " but longer");
+	assert(appended);
+	assert(strcmp(estring->cstring, "short but longer") == 0);
+	ewelborn_string_free(estring);
+
+	// Consuming a large estring from the front one character at a time has
+	// to be linear, or this would take minutes.
+	int length = 8 * 1024 * 1024;
+	char* text = malloc(length + 1);
+	for (int i = 0; i < length; i++) { text[i] = i % 2 == 0 ? 'a' : 'b'; }
+	text[length] = '\0';
+	estring = ewelborn_string_initializeWithCString(text);
+	free(text);
+	int consumed = 0;
+	while (ewelborn_string_consumeChar(estring, 'a', 0) || ewelborn_string_consumeChar(estring, 'b', 0)) {
+		consumed++;
+		// Check the characters that are left, every so often
+		if (consumed % 1000003 == 0) {
+			assert(estring->length == length - consumed);
+			assert(estring->cstring[0] == (consumed % 2 == 0 ? 'a' : 'b'));
+			assert(estring->cstring[estring->length] == '\0');
+		}
+	}
+	assert(consumed == length && estring->length == 0);
+	ewelborn_string_free(estring);
+}
+
+// Runs a tokenizer to the end, and checks every token against expected
+static void checkTokens(ewelborn_tokenizer tokenizer, const char** expected, int expectedCount)
+{
+	ewelborn_stringView token;
+	int count = 0;
+	while (ewelborn_tokenizer_next(&tokenizer, &token)) {
+		assert(count < expectedCount);
+		assert(token.length == (int)strlen(expected[count]));
+		assert(memcmp(token.data, expected[count], token.length) == 0);
+		count++;
+	}
+	assert(count == expectedCount);
+	// Finished tokenizers stay finished
+	bool hasToken = ewelborn_tokenizer_next(&tokenizer, &token);
+	assert(hasToken == false);
+}
+
+void test_tokenizer()
+{
+	ewelborn_string* estring = ewelborn_string_initializeWithCString("a,,b, c,");
+
+	const char* plain[] = { "a", "", "b", " c", "" };
+	checkTokens(ewelborn_tokenizer_fromString(estring, ",", EWELBORN_TOKENIZE_DEFAULT), plain, 5);
+
+	const char* spaces[] = { "a", "", "b", "", "c", "" };
+	checkTokens(ewelborn_tokenizer_fromString(estring, ", ", EWELBORN_TOKENIZE_DEFAULT), spaces, 6);
+
+	const char* collapsed[] = { "a", "b", "c", "" };
+	checkTokens(ewelborn_tokenizer_fromString(estring, ", ", EWELBORN_TOKENIZE_COLLAPSE_DELIMITERS), collapsed, 4);
+
+	const char* skipped[] = { "a", "b", "c" };
+	checkTokens(ewelborn_tokenizer_fromString(estring, ", ", EWELBORN_TOKENIZE_SKIP_EMPTY), skipped, 3);
+	checkTokens(ewelborn_tokenizer_fromString(estring, ", ", EWELBORN_TOKENIZE_SKIP_EMPTY | EWELBORN_TOKENIZE_COLLAPSE_DELIMITERS), skipped, 3);
+
+	// Leading delimiters still give an empty token when they're collapsed
+	const char* leading[] = { "", "x", "y" };
+	checkTokens(ewelborn_tokenizer_fromView(ewelborn_stringView_fromCString(";;x;;;y"), ";", EWELBORN_TOKENIZE_COLLAPSE_DELIMITERS), leading, 3);
+
+	// An empty view has one empty token, unless empties are skipped
+	const char* empty[] = { "" };
+	checkTokens(ewelborn_tokenizer_fromView(ewelborn_stringView_fromCString(""), ",", EWELBORN_TOKENIZE_DEFAULT), empty, 1);
+	checkTokens(ewelborn_tokenizer_fromView(ewelborn_stringView_fromCString(""), ",", EWELBORN_TOKENIZE_SKIP_EMPTY), NULL, 0);
+	checkTokens(ewelborn_tokenizer_fromView(ewelborn_stringView_fromCString(",,,"), ",", EWELBORN_TOKENIZE_SKIP_EMPTY), NULL, 0);
+
+	// No delimiters at all gives back the whole view
+	const char* whole[] = { "a,b" };
+	checkTokens(ewelborn_tokenizer_fromView(ewelborn_stringView_fromCString("a,b"), "", EWELBORN_TOKENIZE_DEFAULT), whole, 1);
+
+	// Quoted sections
+	ewelborn_stringView quotedLine = ewelborn_stringView_fromCString("1,\"two, three\",\"say \"\"hi\"\"\",x\"y,z\"w,\"\"");
+	const char* quoted[] = { "1", "two, three", "say \"\"hi\"\"", "x\"y,z\"w", "" };
+	checkTokens(ewelborn_tokenizer_fromView(quotedLine, ",", EWELBORN_TOKENIZE_QUOTES), quoted, 5);
+	const char* unquoted[] = { "1", "\"two", " three\"", "\"say \"\"hi\"\"\"", "x\"y", "z\"w", "\"\"" };
+	checkTokens(ewelborn_tokenizer_fromView(quotedLine, ",", EWELBORN_TOKENIZE_DEFAULT), unquoted, 7);
+
+	// Other quote characters, and characters outside of ASCII as delimiters
+	ewelborn_tokenizer tokenizer = ewelborn_tokenizer_fromView(ewelborn_stringView_fromCString("'a b' c\xff" "d"), " \xff", EWELBORN_TOKENIZE_QUOTES);
+	tokenizer.quote = '\'';
+	const char* custom[] = { "a b", "c", "d" };
+	checkTokens(tokenizer, custom, 3);
+
+	// Long text, so that delimiters are found across many blocks, with sets
+	// small enough for SIMD and too large for it, on every implementation
+	char text[1000];
+	for (int i = 0; i < (int)sizeof(text); i++) {
+		text[i] = rand() % 5 == 0 ? ",; \t"[rand() % 4] : 'a' + rand() % 26;
+	}
+	ewelborn_stringView textView = { text, sizeof(text) };
+	const char* sets[] = { ",", ",; ", ",; \tabcdefghijklmnopq" };
+	ewelborn_scanImplementation originalImplementation = ewelborn_scan_getImplementation();
+	for (int implementation = EWELBORN_SCAN_SCALAR; implementation <= EWELBORN_SCAN_AVX2; implementation++) {
+		if (ewelborn_scan_isSupported(implementation) == false) { continue; }
+		ewelborn_scan_setImplementation(implementation);
+		for (int s = 0; s < 3; s++) {
+			tokenizer = ewelborn_tokenizer_fromView(textView, sets[s], EWELBORN_TOKENIZE_DEFAULT);
+			ewelborn_stringView token;
+			int position = 0;
+			while (ewelborn_tokenizer_next(&tokenizer, &token)) {
+				int expectedLength = 0;
+				while (position + expectedLength < (int)sizeof(text) && strchr(sets[s], text[position + expectedLength]) == NULL) {
+					expectedLength++;
+				}
+				assert(token.data == text + position && token.length == expectedLength);
+				position += expectedLength + 1;
+			}
+			assert(position == (int)sizeof(text) + 1);
+		}
+	}
+	ewelborn_scan_setImplementation(originalImplementation);
+
+	ewelborn_string_free(estring);
+}
+
+void test_numberParsing()
+{
+	int64_t i = 0;
+	ewelborn_parseResult parseResult = ewelborn_stringView_parseInt64(ewelborn_stringView_fromCString("0"), &i);
+	assert(parseResult == EWELBORN_PARSE_SUCCESS && i == 0);
+	parseResult = ewelborn_stringView_parseInt64(ewelborn_stringView_fromCString("  -1234 "), &i);
+	assert(parseResult == EWELBORN_PARSE_SUCCESS && i == -1234);
+	parseResult = ewelborn_stringView_parseInt64(ewelborn_stringView_fromCString("+0000000000000000000000042"), &i);
+	assert(parseResult == EWELBORN_PARSE_SUCCESS && i == 42);
+	parseResult = ewelborn_stringView_parseInt64(ewelborn_stringView_fromCString("123456789012345678"), &i);
+	assert(parseResult == EWELBORN_PARSE_SUCCESS && i == 123456789012345678LL);
+	parseResult = ewelborn_stringView_parseInt64(ewelborn_stringView_fromCString("9223372036854775807"), &i);
+	assert(parseResult == EWELBORN_PARSE_SUCCESS && i == INT64_MAX);
+	parseResult = ewelborn_stringView_parseInt64(ewelborn_stringView_fromCString("-9223372036854775808"), &i);
+	assert(parseResult == EWELBORN_PARSE_SUCCESS && i == INT64_MIN);
+	parseResult = ewelborn_stringView_parseInt64(ewelborn_stringView_fromCString("9223372036854775808"), &i);
+	assert(parseResult == EWELBORN_PARSE_OVERFLOW && i == INT64_MAX);
+	parseResult = ewelborn_stringView_parseInt64(ewelborn_stringView_fromCString("-99999999999999999999999"), &i);
+	assert(parseResult == EWELBORN_PARSE_OVERFLOW && i == INT64_MIN);
+	// Invalid views leave the value alone
+	i = 7;
+	const char* invalidInts[] = { "", " ", "-", "12a", "1 2", "1.5", "0x10", "--1" };
+	for (int n = 0; n < 8; n++) {
+		parseResult = ewelborn_stringView_parseInt64(ewelborn_stringView_fromCString(invalidInts[n]), &i);
+		assert(parseResult == EWELBORN_PARSE_INVALID);
+	}
+	assert(i == 7);
+
+	ewelborn_string* estring = ewelborn_string_initializeWithCString("31415926535");
+	parseResult = ewelborn_string_parseInt64(estring, &i);
+	assert(parseResult == EWELBORN_PARSE_SUCCESS && i == 31415926535LL);
+
+	// Doubles have to come out exactly the same as strtod
+	const char* doubles[] = {
+		"0", "-0", "1", "-2.5", ".5", "5.", "1e10", "1E-7", "+3.14159", "0.1", "0.3",
+		"123456789012345678901234567890", "0.000000000000000000000000000001234",
+		"9007199254740993", "2.2250738585072011e-308", "4.9406564584124654e-324",
+		"2.4703282292062328e-324", "1.7976931348623157e308", "1e-400",
+		"1.00000000000000011102230246251565404236316680908203125",
+		"1.00000000000000011102230246251565404236316680908203124"
+	};
+	for (int n = 0; n < (int)(sizeof(doubles) / sizeof(doubles[0])); n++) {
+		double d = 0;
+		double expected = strtod(doubles[n], NULL);
+		parseResult = ewelborn_stringView_parseDouble(ewelborn_stringView_fromCString(doubles[n]), &d);
+		assert(parseResult == EWELBORN_PARSE_SUCCESS);
+		assert(memcmp(&d, &expected, sizeof(d)) == 0);
+	}
+	// And for every double printed with full precision
+	srand(19);
+	for (int n = 0; n < 100000; n++) {
+		uint64_t bits = ((uint64_t)rand() << 48) ^ ((uint64_t)rand() << 32) ^ ((uint64_t)rand() << 16) ^ (uint64_t)rand();
+		double original;
+		memcpy(&original, &bits, sizeof(original));
+		if (isnan(original) || isinf(original)) { continue; }
+		char text[64];
+		snprintf(text, sizeof(text), "%.17g", original);
+		double d;
+		parseResult = ewelborn_stringView_parseDouble(ewelborn_stringView_fromCString(text), &d);
+		assert(parseResult == EWELBORN_PARSE_SUCCESS);
+		assert(memcmp(&d, &original, sizeof(d)) == 0);
+	}
+
+	double d = 0;
+	parseResult = ewelborn_stringView_parseDouble(ewelborn_stringView_fromCString("-inf"), &d);
+	assert(parseResult == EWELBORN_PARSE_SUCCESS && isinf(d) && d < 0);
+	parseResult = ewelborn_stringView_parseDouble(ewelborn_stringView_fromCString("Infinity"), &d);
+	assert(parseResult == EWELBORN_PARSE_SUCCESS && isinf(d) && d > 0);
+	parseResult = ewelborn_stringView_parseDouble(ewelborn_stringView_fromCString("NaN"), &d);
+	assert(parseResult == EWELBORN_PARSE_SUCCESS && isnan(d));
+	parseResult = ewelborn_stringView_parseDouble(ewelborn_stringView_fromCString("1e309"), &d);
+	assert(parseResult == EWELBORN_PARSE_OVERFLOW && d == HUGE_VAL);
+	parseResult = ewelborn_stringView_parseDouble(ewelborn_stringView_fromCString("-1e309"), &d);
+	assert(parseResult == EWELBORN_PARSE_OVERFLOW && d == -HUGE_VAL);
+	d = 7;
+	const char* invalidDoubles[] = { "", ".", "-", "e5", "1e", "1.2.3", "infinit", "nope", "1,5" };
+	for (int n = 0; n < 9; n++) {
+		parseResult = ewelborn_stringView_parseDouble(ewelborn_stringView_fromCString(invalidDoubles[n]), &d);
+		assert(parseResult == EWELBORN_PARSE_INVALID);
+	}
+	assert(d == 7);
+
+	parseResult = ewelborn_string_parseDouble(estring, &d);
+	assert(parseResult == EWELBORN_PARSE_SUCCESS && d == 31415926535.0);
+	ewelborn_string_free(estring);
+
+	// Bulk parsing, with enough numbers to go through several batches
+	ewelborn_string* buffer = ewelborn_string_initializeWithCString("");
+	for (int n = 0; n < 1000; n++) {
+		bool appended = ewelborn_string_appendCString(buffer, n % 3 == 0 ? "\r\n" : n % 3 == 1 ? ", " : "\t");
+		assert(appended);
+		char number[32];
+		snprintf(number, sizeof(number), "%lld", (long long)(n - 500) * 1000003);
+		appended = ewelborn_string_appendCString(buffer, number);
+		assert(appended);
+	}
+	bool appended = ewelborn_string_appendCString(buffer, " \n");
+	assert(appended);
+	ewelborn_typedArray* ints = EWELBORN_TYPED_ARRAY_INITIALIZE(int64_t);
+	parseResult = ewelborn_parseIntsFromBuffer(buffer->cstring, buffer->length, ints, NULL);
+	assert(parseResult == EWELBORN_PARSE_SUCCESS);
+	assert(ints->elements == 1000);
+	for (int n = 0; n < 1000; n++) {
+		assert(EWELBORN_TYPED_ARRAY_AT(ints, int64_t, n) == (int64_t)(n - 500) * 1000003);
+	}
+
+	ewelborn_typedArray* doublesArray = EWELBORN_TYPED_ARRAY_INITIALIZE(double);
+	parseResult = ewelborn_parseDoublesFromBuffer(buffer->cstring, buffer->length, doublesArray, NULL);
+	assert(parseResult == EWELBORN_PARSE_SUCCESS);
+	assert(doublesArray->elements == 1000 && EWELBORN_TYPED_ARRAY_AT(doublesArray, double, 999) == 499.0 * 1000003);
+
+	// Errors stop parsing, and say where
+	ewelborn_typedArray_clear(ints);
+	size_t errorOffset = 0;
+	parseResult = ewelborn_parseIntsFromBuffer("1, 2, 3x, 4", 11, ints, &errorOffset);
+	assert(parseResult == EWELBORN_PARSE_INVALID);
+	assert(errorOffset == 7 && ints->elements == 2);
+	parseResult = ewelborn_parseIntsFromBuffer("", 0, ints, &errorOffset);
+	assert(parseResult == EWELBORN_PARSE_SUCCESS && ints->elements == 2);
+	parseResult = ewelborn_parseIntsFromBuffer("5 99999999999999999999", 22, ints, &errorOffset);
+	assert(parseResult == EWELBORN_PARSE_OVERFLOW);
+	assert(errorOffset == 2 && ints->elements == 3);
+	// The array's elements have to be the right size
+	ewelborn_typedArray* smallInts = EWELBORN_TYPED_ARRAY_INITIALIZE(int);
+	parseResult = ewelborn_parseIntsFromBuffer("1", 1, smallInts, NULL);
+	assert(parseResult == EWELBORN_PARSE_INVALID && smallInts->elements == 0);
+	ewelborn_typedArray_free(smallInts);
+
+	ewelborn_typedArray_free(ints);
+	ewelborn_typedArray_free(doublesArray);
+	ewelborn_string_free(buffer);
+}
+
+void test_csvReader()
+{
+	ewelborn_string* filePath = ewelborn_string_initializeWithCString("test_csv.csv");
+	ewelborn_string* content = ewelborn_string_initializeWithCString(
+		"id,price,name,note\r\n"
+		"1,2.5,apple,\"sweet, red\"\r\n"
+		"2,3,\"banana \"\"split\"\"\",\"two\nlines\"\n"
+		"\n"
+		"3,-1e3,cherry\n"
+		"40000000000,,\"\",the last note is long enough to be searched with SIMD");
+	bool written = ewelborn_writeStringToFile(filePath, content);
+	assert(written);
+
+	ewelborn_csvReader* reader = ewelborn_readCSVFromFile(filePath, ewelborn_csvReader_defaultOptions());
+	assert(reader != NULL && reader->columnCount == 4 && reader->rowCount == 4);
+	assert(ewelborn_stringView_equals(reader->columns[0].name, ewelborn_stringView_fromCString("id")));
+	assert(ewelborn_stringView_equals(reader->columns[3].name, ewelborn_stringView_fromCString("note")));
+
+	assert(reader->columns[0].type == EWELBORN_CSV_INT64);
+	int64_t* ids = EWELBORN_TYPED_ARRAY_DATA(reader->columns[0].values, int64_t);
+	assert(ids[0] == 1 && ids[1] == 2 && ids[2] == 3 && ids[3] == 40000000000LL);
+
+	// An empty field makes the column doubles, with NaN for the empty field
+	assert(reader->columns[1].type == EWELBORN_CSV_DOUBLE);
+	double* prices = EWELBORN_TYPED_ARRAY_DATA(reader->columns[1].values, double);
+	assert(prices[0] == 2.5 && prices[1] == 3 && prices[2] == -1000 && isnan(prices[3]));
+
+	assert(reader->columns[2].type == EWELBORN_CSV_STRING && reader->columns[3].type == EWELBORN_CSV_STRING);
+	const char* names[] = { "apple", "banana \"split\"", "cherry", "" };
+	const char* notes[] = { "sweet, red", "two\nlines", "", "the last note is long enough to be searched with SIMD" };
+	for (int i = 0; i < 4; i++) {
+		assert(ewelborn_stringView_equals(EWELBORN_TYPED_ARRAY_AT(reader->columns[2].values, ewelborn_stringView, i), ewelborn_stringView_fromCString(names[i])));
+		assert(ewelborn_stringView_equals(EWELBORN_TYPED_ARRAY_AT(reader->columns[3].values, ewelborn_stringView, i), ewelborn_stringView_fromCString(notes[i])));
+	}
+	ewelborn_csvReader_free(reader);
+
+	// Integer columns are promoted to doubles when a double shows up after
+	// the types have been worked out, and the values read so far are kept
+	ewelborn_string_free(content);
+	content = ewelborn_string_initializeWithCString("5;6\n7;8\n9.5;10\n");
+	written = ewelborn_writeStringToFile(filePath, content);
+	assert(written);
+	ewelborn_csvOptions options = ewelborn_csvReader_defaultOptions();
+	options.delimiter = ';';
+	options.hasHeader = false;
+	options.inferenceRows = 1;
+	reader = ewelborn_csvReader_open(filePath, options);
+	assert(reader != NULL && reader->rowCount == 1 && reader->columns[0].type == EWELBORN_CSV_INT64);
+	assert(reader->columns[0].name.length == 0);
+	int rowsRead = ewelborn_csvReader_readRows(reader, 1);
+	assert(rowsRead == 1 && reader->columns[0].type == EWELBORN_CSV_INT64);
+	rowsRead = ewelborn_csvReader_readRows(reader, 10);
+	assert(rowsRead == 1 && reader->columns[0].type == EWELBORN_CSV_DOUBLE);
+	assert(EWELBORN_TYPED_ARRAY_AT(reader->columns[0].values, double, 0) == 5);
+	assert(EWELBORN_TYPED_ARRAY_AT(reader->columns[0].values, double, 2) == 9.5);
+	assert(reader->columns[1].type == EWELBORN_CSV_INT64 && EWELBORN_TYPED_ARRAY_AT(reader->columns[1].values, int64_t, 2) == 10);
+	rowsRead = ewelborn_csvReader_readRows(reader, 10);
+	assert(rowsRead == 0);
+	ewelborn_csvReader_free(reader);
+
+	// Text in a number column, too many fields, and unfinished quotes are errors
+	char* invalid[] = { "a\n1\nx\n", "a,b\n1,2\n1,2,3\n", "a\n1\n\"open\n" };
+	for (int i = 0; i < 3; i++) {
+		ewelborn_string_free(content);
+		content = ewelborn_string_initializeWithCString(invalid[i]);
+		written = ewelborn_writeStringToFile(filePath, content);
+		assert(written);
+		options = ewelborn_csvReader_defaultOptions();
+		options.inferenceRows = 1;
+		reader = ewelborn_csvReader_open(filePath, options);
+		assert(reader != NULL);
+		bool readAll = ewelborn_csvReader_readAll(reader);
+		assert(readAll == false && reader->failed);
+		assert(reader->errorRecord == 3 && reader->rowCount == 1);
+		for (int c = 0; c < reader->columnCount; c++) {
+			assert(reader->columns[c].values->elements == reader->rowCount);
+		}
+		ewelborn_csvReader_free(reader);
+	}
+	ewelborn_csvReader* csvReader = ewelborn_readCSVFromFile(filePath, ewelborn_csvReader_defaultOptions());
+	assert(csvReader == NULL);
+
+	// A file much larger than the reader's buffer, with quoted fields that
+	// go across the edges of the blocks, read a batch at a time
+	ewelborn_string_free(content);
+	content = ewelborn_string_initializeWithCString("n,text\n");
+	int rows = 100000;
+	for (int i = 0; i < rows; i++) {
+		char row[64];
+		snprintf(row, sizeof(row), "%d,\"row %d,\n\"\"quoted\"\"\"\n", i, i);
+		bool appended = ewelborn_string_appendCString(content, row);
+		assert(appended);
+	}
+	assert(content->length > EWELBORN_LINE_READER_BLOCK_SIZE);
+	written = ewelborn_writeStringToFile(filePath, content);
+	assert(written);
+	reader = ewelborn_csvReader_open(filePath, ewelborn_csvReader_defaultOptions());
+	assert(reader != NULL);
+	int total = 0;
+	do {
+		for (int i = 0; i < reader->rowCount; i++) {
+			int n = total + i;
+			assert(EWELBORN_TYPED_ARRAY_AT(reader->columns[0].values, int64_t, i) == n);
+			char expected[64];
+			snprintf(expected, sizeof(expected), "row %d,\n\"quoted\"", n);
+			assert(ewelborn_stringView_equals(EWELBORN_TYPED_ARRAY_AT(reader->columns[1].values, ewelborn_stringView, i), ewelborn_stringView_fromCString(expected)));
+		}
+		total += reader->rowCount;
+		ewelborn_csvReader_clearRows(reader);
+	} while (ewelborn_csvReader_readRows(reader, 5000) > 0);
+	assert(total == rows && reader->failed == false);
+	ewelborn_csvReader_free(reader);
+
+	remove("test_csv.csv");
+	ewelborn_string_free(content);
+	ewelborn_string_free(filePath);
+}
+
+struct sortItem {
+	int key;
+	int value;
+};
+
+#define ITEM_LESS_THAN(a, b) ((a).key < (b).key)
+EWELBORN_DEFINE_SORT(sortItems, struct sortItem, ITEM_LESS_THAN)
+
+static int compareInt64(const void* a, const void* b)
+{
+	int64_t x = *(const int64_t*)a;
+	int64_t y = *(const int64_t*)b;
+	return (x > y) - (x < y);
+}
+
+static int compareIntPointers(const void* a, const void* b)
+{
+	int x = **(int* const*)a;
+	int y = **(int* const*)b;
+	return (x > y) - (x < y);
+}
+
+static int compareTriples(const void* a, const void* b)
+{
+	return ((const int*)a)[0] - ((const int*)b)[0];
+}
+
+static int compareStringPointers(const void* a, const void* b)
+{
+	return ewelborn_stringView_compare(ewelborn_stringView_fromString((ewelborn_string*)a), ewelborn_stringView_fromString((ewelborn_string*)b));
+}
+
+// Creates count random estrings from a small alphabet, so that a lot of them
+// share long prefixes
+static ewelborn_dynamicArray* createRandomStrings(int count)
+{
+	ewelborn_dynamicArray* strings = ewelborn_dynamicArray_initialize();
+	for (int i = 0; i < count; i++) {
+		ewelborn_string* estring = ewelborn_string_initializeEmpty();
+		int length = rand() % 40;
+		if (i % 3 == 0) {
+			bool appended = ewelborn_string_appendCString(estring, "shared/prefix/");
+			assert(appended);
+		}
+		for (int j = 0; j < length; j++) {
+			bool pushed = ewelborn_string_pushChar(estring, "ab\xff\x01z"[rand() % 5]);
+			assert(pushed);
+		}
+		bool pushed = ewelborn_dynamicArray_push(strings, estring);
+		assert(pushed);
+	}
+	return strings;
+}
+
+static void checkStringsSorted(ewelborn_dynamicArray* strings, int count)
+{
+	assert(strings->elements == count);
+	for (int i = 1; i < count; i++) {
+		assert(compareStringPointers(strings->array[i - 1], strings->array[i]) <= 0);
+	}
+}
+
+void test_sort()
+{
+	srand(1234);
+
+	// Integers, both small enough for introsort and large enough for radix
+	// sort, checked against qsort
+	int sizes[] = { 0, 1, 2, 17, 255, 256, 10000 };
+	for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+		int count = sizes[s];
+		ewelborn_typedArray* numbers = EWELBORN_TYPED_ARRAY_INITIALIZE(int64_t);
+		ewelborn_typedArray* smallNumbers = EWELBORN_TYPED_ARRAY_INITIALIZE(int32_t);
+		for (int i = 0; i < count; i++) {
+			int64_t n = ((int64_t)rand() << 32) ^ ((int64_t)rand() << 8) ^ rand();
+			if (i % 4 == 0) { n = -n; }
+			if (i % 7 == 0) { n = rand() % 10; }
+			if (i == 1) { n = INT64_MIN; }
+			if (i == 2) { n = INT64_MAX; }
+			EWELBORN_TYPED_ARRAY_PUSH(numbers, int64_t, n);
+			EWELBORN_TYPED_ARRAY_PUSH(smallNumbers, int32_t, (int32_t)n);
+		}
+		int64_t* expected = malloc(sizeof(int64_t) * (count + 1));
+		memcpy(expected, numbers->data, sizeof(int64_t) * count);
+		qsort(expected, count, sizeof(int64_t), compareInt64);
+
+		bool sorted = ewelborn_typedArray_sortInt64(numbers);
+		assert(sorted);
+		assert(numbers->elements == count);
+		assert(count == 0 || memcmp(numbers->data, expected, sizeof(int64_t) * count) == 0);
+
+		sorted = ewelborn_typedArray_sortInt32(smallNumbers);
+		assert(sorted);
+		for (int i = 1; i < count; i++) {
+			assert(EWELBORN_TYPED_ARRAY_AT(smallNumbers, int32_t, i - 1) <= EWELBORN_TYPED_ARRAY_AT(smallNumbers, int32_t, i));
+		}
+
+		// The comparison sort gets the same answer
+		for (int i = 0; i < count / 2; i++) {
+			int64_t swap = EWELBORN_TYPED_ARRAY_AT(numbers, int64_t, i);
+			EWELBORN_TYPED_ARRAY_AT(numbers, int64_t, i) = EWELBORN_TYPED_ARRAY_AT(numbers, int64_t, count - 1 - i);
+			EWELBORN_TYPED_ARRAY_AT(numbers, int64_t, count - 1 - i) = swap;
+		}
+		ewelborn_typedArray_sort(numbers, compareInt64);
+		assert(count == 0 || memcmp(numbers->data, expected, sizeof(int64_t) * count) == 0);
+
+		free(expected);
+		ewelborn_typedArray_free(numbers);
+		ewelborn_typedArray_free(smallNumbers);
+	}
+
+	// Only the bytes that differ need a pass, but small numbers still sort
+	ewelborn_typedArray* numbers = EWELBORN_TYPED_ARRAY_INITIALIZE(int64_t);
+	for (int i = 0; i < 5000; i++) { EWELBORN_TYPED_ARRAY_PUSH(numbers, int64_t, (i * 7919) % 5000); }
+	bool sorted = ewelborn_typedArray_sortInt64(numbers);
+	assert(sorted);
+	for (int i = 0; i < 5000; i++) { assert(EWELBORN_TYPED_ARRAY_AT(numbers, int64_t, i) == i); }
+	sorted = ewelborn_typedArray_sortInt32(numbers);
+	assert(sorted == false);
+	sorted = ewelborn_typedArray_sortViews(numbers);
+	assert(sorted == false);
+	ewelborn_typedArray_free(numbers);
+
+	// Doubles, including both zeros, infinities, and NaN
+	ewelborn_typedArray* doubles = EWELBORN_TYPED_ARRAY_INITIALIZE(double);
+	for (int i = 0; i < 1000; i++) {
+		EWELBORN_TYPED_ARRAY_PUSH(doubles, double, (rand() - RAND_MAX / 2) / 3.0);
+	}
+	EWELBORN_TYPED_ARRAY_PUSH(doubles, double, NAN);
+	EWELBORN_TYPED_ARRAY_PUSH(doubles, double, INFINITY);
+	EWELBORN_TYPED_ARRAY_PUSH(doubles, double, -INFINITY);
+	EWELBORN_TYPED_ARRAY_PUSH(doubles, double, 0.0);
+	EWELBORN_TYPED_ARRAY_PUSH(doubles, double, -0.0);
+	EWELBORN_TYPED_ARRAY_PUSH(doubles, double, 1e-310);
+	sorted = ewelborn_typedArray_sortDouble(doubles);
+	assert(sorted);
+	int doubleCount = doubles->elements;
+	assert(EWELBORN_TYPED_ARRAY_AT(doubles, double, 0) == -INFINITY);
+	assert(isnan(EWELBORN_TYPED_ARRAY_AT(doubles, double, doubleCount - 1)));
+	assert(EWELBORN_TYPED_ARRAY_AT(doubles, double, doubleCount - 2) == INFINITY);
+	for (int i = 1; i < doubleCount - 1; i++) {
+		double previous = EWELBORN_TYPED_ARRAY_AT(doubles, double, i - 1);
+		double current = EWELBORN_TYPED_ARRAY_AT(doubles, double, i);
+		assert(previous <= current);
+		if (current == 0.0 && previous == 0.0) { assert(signbit(previous) && !signbit(current)); }
+	}
+	ewelborn_typedArray_free(doubles);
+
+	// Elements that are an odd size, and elements sorted by an inlined
+	// comparison from EWELBORN_DEFINE_SORT
+	ewelborn_typedArray* triples = ewelborn_typedArray_initialize(sizeof(int) * 3);
+	struct sortItem items[500];
+	for (int i = 0; i < 500; i++) {
+		int triple[3] = { (i * 37) % 500, i, -i };
+		bool pushed = ewelborn_typedArray_push(triples, triple);
+		assert(pushed);
+		items[i] = (struct sortItem){ (i * 37) % 500, i };
+	}
+	ewelborn_typedArray_sort(triples, compareTriples);
+	sortItems(items, 500);
+	for (int i = 0; i < 500; i++) {
+		int* triple = ewelborn_typedArray_get(triples, i);
+		assert(triple[0] == i && triple[1] == -triple[2]);
+		assert(items[i].key == i && (items[i].value * 37) % 500 == i);
+	}
+	ewelborn_typedArray_free(triples);
+
+	// Introsort falls back to heapsort on input that's hard for quicksort,
+	// and handles runs of equal keys
+	struct sortItem manyItems[4096];
+	for (int i = 0; i < 4096; i++) { manyItems[i] = (struct sortItem){ i % 2 == 0 ? i : 4096 - i, i }; }
+	sortItems(manyItems, 4096);
+	for (int i = 1; i < 4096; i++) { assert(manyItems[i - 1].key <= manyItems[i].key); }
+	for (int i = 0; i < 4096; i++) { manyItems[i] = (struct sortItem){ i % 3, i }; }
+	sortItems(manyItems, 4096);
+	for (int i = 1; i < 4096; i++) { assert(manyItems[i - 1].key <= manyItems[i].key); }
+
+	// Dynamic arrays with a comparison function, sorted in parallel too
+	ewelborn_dynamicArray* pointers = ewelborn_dynamicArray_initialize();
+	ewelborn_dynamicArray* parallelPointers = ewelborn_dynamicArray_initialize();
+	long long sum = 0;
+	for (int i = 0; i < 100000; i++) {
+		int* n = malloc(sizeof(int));
+		*n = rand() % 1000;
+		sum += *n;
+		bool pushed = ewelborn_dynamicArray_push(pointers, n);
+		assert(pushed);
+		pushed = ewelborn_dynamicArray_push(parallelPointers, n);
+		assert(pushed);
+	}
+	// The same comparison function works with qsort
+	void** qsorted = malloc(sizeof(void*) * 100000);
+	memcpy(qsorted, pointers->array, sizeof(void*) * 100000);
+	qsort(qsorted, 100000, sizeof(void*), compareIntPointers);
+	ewelborn_dynamicArray_sort(pointers, compareIntPointers);
+	ewelborn_dynamicArray_sortParallel(parallelPointers, compareIntPointers, 5);
+	long long parallelSum = 0;
+	for (int i = 0; i < 100000; i++) {
+		assert(*(int*)pointers->array[i] == *(int*)parallelPointers->array[i]);
+		assert(*(int*)pointers->array[i] == *(int*)qsorted[i]);
+		parallelSum += *(int*)parallelPointers->array[i];
+	}
+	assert(parallelSum == sum);
+	for (int i = 1; i < 100000; i++) { assert(*(int*)pointers->array[i - 1] <= *(int*)pointers->array[i]); }
+	free(qsorted);
+	ewelborn_dynamicArray_free(pointers);
+	free(parallelPointers->array);
+	free(parallelPointers);
+
+	// Estrings, with the radix sort and the parallel merge sort
+	ewelborn_dynamicArray* strings = createRandomStrings(20000);
+	ewelborn_dynamicArray_sortStrings(strings);
+	checkStringsSorted(strings, 20000);
+	ewelborn_dynamicArray_sortStrings(strings);
+	checkStringsSorted(strings, 20000);
+	ewelborn_dynamicArray* parallelStrings = createRandomStrings(70000);
+	ewelborn_dynamicArray_sortStringsParallel(parallelStrings, 3);
+	checkStringsSorted(parallelStrings, 70000);
+
+	// Views of the same estrings, in a random order
+	ewelborn_typedArray* views = EWELBORN_TYPED_ARRAY_INITIALIZE(ewelborn_stringView);
+	for (int i = 0; i < parallelStrings->elements; i++) {
+		ewelborn_stringView view = ewelborn_stringView_fromString(parallelStrings->array[(i * 7919) % parallelStrings->elements]);
+		bool pushed = ewelborn_typedArray_push(views, &view);
+		assert(pushed);
+	}
+	sorted = ewelborn_typedArray_sortViews(views);
+	assert(sorted);
+	for (int i = 0; i < views->elements; i++) {
+		assert(ewelborn_stringView_equals(EWELBORN_TYPED_ARRAY_AT(views, ewelborn_stringView, i), ewelborn_stringView_fromString(parallelStrings->array[i])));
+	}
+	ewelborn_typedArray_free(views);
+
+	for (int i = 0; i < strings->elements; i++) { ewelborn_string_free(strings->array[i]); }
+	for (int i = 0; i < parallelStrings->elements; i++) { ewelborn_string_free(parallelStrings->array[i]); }
+	free(strings->array);
+	free(strings);
+	free(parallelStrings->array);
+	free(parallelStrings);
+}
+
+static int compareDoubleValues(const void* a, const void* b)
+{
+	double x = *(const double*)a;
+	double y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+void test_priorityQueue()
+{
+	srand(99);
+
+	// Popping gives back every priority in order, and the element that was
+	// pushed with it
+	ewelborn_priorityQueue* queue = ewelborn_priorityQueue_initialize();
+	double priorities[3000];
+	for (int i = 0; i < 3000; i++) {
+		priorities[i] = (double)(rand() % 500);
+		bool pushed = ewelborn_priorityQueue_push(queue, &priorities[i], priorities[i]);
+		assert(pushed);
+	}
+	assert(queue->size == 3000);
+	double sorted[3000];
+	memcpy(sorted, priorities, sizeof(sorted));
+	qsort(sorted, 3000, sizeof(double), compareDoubleValues);
+	void* element;
+	double priority;
+	bool peeked = ewelborn_priorityQueue_peek(queue, &element, &priority);
+	assert(peeked && priority == sorted[0]);
+	for (int i = 0; i < 3000; i++) {
+		bool wasPopped = ewelborn_priorityQueue_pop(queue, &element, &priority);
+		assert(wasPopped);
+		assert(priority == sorted[i] && *(double*)element == priority);
+	}
+	bool wasPopped = ewelborn_priorityQueue_pop(queue, &element, &priority);
+	assert(wasPopped == false);
+	peeked = ewelborn_priorityQueue_peek(queue, NULL, NULL);
+	assert(peeked == false);
+
+	// Bulk pushes, both small enough to sift up and large enough to rebuild
+	// the heap, and heaps built straight from an array
+	ewelborn_priorityQueueEntry entries[1000];
+	for (int i = 0; i < 1000; i++) {
+		entries[i] = (ewelborn_priorityQueueEntry){ (double)((i * 7919) % 1000), NULL };
+	}
+	bool pushed = ewelborn_priorityQueue_pushMany(queue, entries, 1000);
+	assert(pushed);
+	pushed = ewelborn_priorityQueue_pushMany(queue, entries, 10);
+	assert(pushed);
+	assert(queue->size == 1010);
+	double previous = -1;
+	for (int i = 0; i < 1010; i++) {
+		wasPopped = ewelborn_priorityQueue_pop(queue, NULL, &priority);
+		assert(wasPopped);
+		assert(priority >= previous);
+		previous = priority;
+	}
+	ewelborn_priorityQueue_free(queue);
+
+	queue = ewelborn_priorityQueue_initializeFromEntries(entries, 1000);
+	assert(queue != NULL && queue->size == 1000);
+	for (int i = 0; i < 1000; i++) {
+		wasPopped = ewelborn_priorityQueue_pop(queue, NULL, &priority);
+		assert(wasPopped && priority == i);
+	}
+	ewelborn_priorityQueue_clear(queue);
+	ewelborn_priorityQueue_free(queue);
+
+	// The indexed queue, checked against the priorities kept on the side
+	// through random pushes, updates, decreases, and removals
+	int capacity = 200;
+	ewelborn_indexedPriorityQueue* indexed = ewelborn_indexedPriorityQueue_initialize(capacity);
+	double expected[200];
+	bool queued[200] = { false };
+	int queuedCount = 0;
+	pushed = ewelborn_indexedPriorityQueue_push(indexed, -1, 0);
+	assert(pushed == false);
+	pushed = ewelborn_indexedPriorityQueue_push(indexed, capacity, 0);
+	assert(pushed == false);
+	for (int step = 0; step < 20000; step++) {
+		int handle = rand() % capacity;
+		double value = (double)(rand() % 1000);
+		bool changed;
+		switch (rand() % 5) {
+		case 0:
+			changed = ewelborn_indexedPriorityQueue_push(indexed, handle, value);
+			assert(changed == !queued[handle]);
+			if (queued[handle] == false) { queued[handle] = true; expected[handle] = value; queuedCount++; }
+			break;
+		case 1:
+			changed = ewelborn_indexedPriorityQueue_decreasePriority(indexed, handle, value);
+			assert(changed == (queued[handle] && value < expected[handle]));
+			if (queued[handle] && value < expected[handle]) { expected[handle] = value; }
+			break;
+		case 2:
+			changed = ewelborn_indexedPriorityQueue_update(indexed, handle, value);
+			assert(changed);
+			if (queued[handle] == false) { queued[handle] = true; queuedCount++; }
+			expected[handle] = value;
+			break;
+		case 3:
+			changed = ewelborn_indexedPriorityQueue_remove(indexed, handle);
+			assert(changed == queued[handle]);
+			if (queued[handle]) { queued[handle] = false; queuedCount--; }
+			break;
+		case 4: {
+			int popped;
+			if (ewelborn_indexedPriorityQueue_pop(indexed, &popped, &priority)) {
+				assert(queued[popped] && expected[popped] == priority);
+				for (int i = 0; i < capacity; i++) { assert(queued[i] == false || expected[i] >= priority); }
+				queued[popped] = false;
+				queuedCount--;
+			}
+			else {
+				assert(queuedCount == 0);
+			}
+			break;
+		}
+		}
+		assert(indexed->size == queuedCount);
+		assert(ewelborn_indexedPriorityQueue_contains(indexed, handle) == queued[handle]);
+		if (queued[handle]) {
+			bool hasPriority = ewelborn_indexedPriorityQueue_getPriority(indexed, handle, &priority);
+			assert(hasPriority && priority == expected[handle]);
+		}
+	}
+	ewelborn_indexedPriorityQueue_clear(indexed);
+	assert(indexed->size == 0);
+	peeked = ewelborn_indexedPriorityQueue_peek(indexed, NULL, NULL);
+	assert(peeked == false);
+	for (int i = 0; i < capacity; i++) { assert(ewelborn_indexedPriorityQueue_contains(indexed, i) == false); }
+	ewelborn_indexedPriorityQueue_free(indexed);
+
+	// Dijkstra's algorithm on a grid with integer weights, with the radix
+	// heap, checked against the indexed queue
+	int width = 40;
+	int nodes = width * width;
+	int weights[1600];
+	for (int i = 0; i < nodes; i++) { weights[i] = 1 + rand() % 9; }
+	uint64_t radixDistances[1600];
+	double indexedDistances[1600];
+	for (int i = 0; i < nodes; i++) { radixDistances[i] = UINT64_MAX; indexedDistances[i] = INFINITY; }
+
+	ewelborn_radixHeap* heap = ewelborn_radixHeap_initialize();
+	radixDistances[0] = 0;
+	pushed = ewelborn_radixHeap_push(heap, (void*)(intptr_t)0, 0);
+	assert(pushed);
+	uint64_t key;
+	uint64_t lastKey = 0;
+	while (ewelborn_radixHeap_pop(heap, &element, &key)) {
+		assert(key >= lastKey);
+		lastKey = key;
+		int node = (int)(intptr_t)element;
+		if (key != radixDistances[node]) { continue; }
+		int neighbours[4] = { node - width, node + width, node % width > 0 ? node - 1 : -1, node % width < width - 1 ? node + 1 : -1 };
+		for (int n = 0; n < 4; n++) {
+			int next = neighbours[n];
+			if (next < 0 || next >= nodes) { continue; }
+			uint64_t distance = key + (uint64_t)weights[next];
+			if (distance < radixDistances[next]) {
+				radixDistances[next] = distance;
+				pushed = ewelborn_radixHeap_push(heap, (void*)(intptr_t)next, distance);
+				assert(pushed);
+			}
+		}
+	}
+	assert(heap->size == 0);
+	pushed = ewelborn_radixHeap_push(heap, NULL, lastKey - 1);
+	assert(pushed == false);
+	pushed = ewelborn_radixHeap_push(heap, NULL, lastKey + 100);
+	assert(pushed);
+	pushed = ewelborn_radixHeap_push(heap, NULL, lastKey + 3);
+	assert(pushed);
+	peeked = ewelborn_radixHeap_peek(heap, NULL, &key);
+	assert(peeked && key == lastKey + 3);
+	pushed = ewelborn_radixHeap_push(heap, NULL, lastKey + 1);
+	assert(pushed);
+	wasPopped = ewelborn_radixHeap_pop(heap, NULL, &key);
+	assert(wasPopped && key == lastKey + 1);
+	wasPopped = ewelborn_radixHeap_pop(heap, NULL, &key);
+	assert(wasPopped && key == lastKey + 3);
+	wasPopped = ewelborn_radixHeap_pop(heap, NULL, &key);
+	assert(wasPopped && key == lastKey + 100);
+	ewelborn_radixHeap_free(heap);
+
+	indexed = ewelborn_indexedPriorityQueue_initialize(nodes);
+	indexedDistances[0] = 0;
+	ewelborn_indexedPriorityQueue_push(indexed, 0, 0);
+	int node;
+	while (ewelborn_indexedPriorityQueue_pop(indexed, &node, &priority)) {
+		int neighbours[4] = { node - width, node + width, node % width > 0 ? node - 1 : -1, node % width < width - 1 ? node + 1 : -1 };
+		for (int n = 0; n < 4; n++) {
+			int next = neighbours[n];
+			if (next < 0 || next >= nodes) { continue; }
+			double distance = priority + weights[next];
+			if (distance < indexedDistances[next]) {
+				indexedDistances[next] = distance;
+				ewelborn_indexedPriorityQueue_update(indexed, next, distance);
+			}
+		}
+	}
+	for (int i = 0; i < nodes; i++) { assert((double)radixDistances[i] == indexedDistances[i]); }
+	ewelborn_indexedPriorityQueue_free(indexed);
+}
+
+void test_stringPool()
+{
+	ewelborn_stringPool* pool = ewelborn_stringPool_initialize();
+	assert(pool != NULL && pool->count == 0);
+
+	// The same characters always give the same ID, and the same pointer
+	int hello = ewelborn_stringPool_internView(pool, ewelborn_stringView_fromCString("hello"));
+	int world = ewelborn_stringPool_internView(pool, ewelborn_stringView_fromCString("world"));
+	int empty = ewelborn_stringPool_internView(pool, ewelborn_stringView_fromCString(""));
+	assert(hello == 0 && world == 1 && empty == 2 && pool->count == 3);
+	ewelborn_string* estring = ewelborn_string_initializeWithCString("hello");
+	int id = ewelborn_stringPool_intern(pool, estring);
+	assert(id == hello);
+	id = ewelborn_stringPool_intern(pool, estring);
+	assert(ewelborn_stringPool_get(pool, hello).data == ewelborn_stringPool_get(pool, id).data);
+	assert(strcmp(ewelborn_stringPool_get(pool, world).data, "world") == 0);
+	assert(ewelborn_stringPool_get(pool, empty).length == 0 && ewelborn_stringPool_get(pool, empty).data[0] == '\0');
+	assert(ewelborn_stringPool_get(pool, 3).data == NULL && ewelborn_stringPool_get(pool, -1).data == NULL);
+	assert(ewelborn_stringPool_hash(pool, hello) == ewelborn_string_hash(estring));
+	assert(ewelborn_stringPool_find(pool, ewelborn_stringView_fromCString("world")) == world);
+	assert(ewelborn_stringPool_find(pool, ewelborn_stringView_fromCString("worlds")) == -1);
+	assert(pool->count == 3);
+
+	// Views into the middle of a buffer, with characters after them
+	id = ewelborn_stringPool_internView(pool, ewelborn_stringView_fromBuffer("worldwide", 5));
+	assert(id == world);
+
+	// Enough strings to grow the table several times, and some long enough
+	// to get their own allocation
+	char buffer[3000];
+	for (int i = 0; i < 20000; i++) {
+		snprintf(buffer, sizeof(buffer), "string %d", i);
+		id = ewelborn_stringPool_internView(pool, ewelborn_stringView_fromCString(buffer));
+		assert(id == 3 + i);
+	}
+	memset(buffer, 'x', sizeof(buffer) - 1);
+	buffer[sizeof(buffer) - 1] = '\0';
+	int longId = ewelborn_stringPool_internView(pool, ewelborn_stringView_fromCString(buffer));
+	assert(longId == 20003 && strcmp(ewelborn_stringPool_get(pool, longId).data, buffer) == 0);
+	for (int i = 0; i < 20000; i++) {
+		snprintf(buffer, sizeof(buffer), "string %d", i);
+		assert(ewelborn_stringPool_find(pool, ewelborn_stringView_fromCString(buffer)) == 3 + i);
+		assert(strcmp(ewelborn_stringPool_get(pool, 3 + i).data, buffer) == 0);
+	}
+	assert(pool->count == 20004);
+
+	// Bulk interning, from a split result and straight from a buffer
+	ewelborn_string* line = ewelborn_string_initializeWithCString("GET,200,host,GET,,404,host,GET");
+	ewelborn_dynamicArray* fields = ewelborn_string_split(line, ',');
+	ewelborn_typedArray* ids = EWELBORN_TYPED_ARRAY_INITIALIZE(int);
+	ewelborn_typedArray* splitIds = EWELBORN_TYPED_ARRAY_INITIALIZE(int);
+	ewelborn_stringPool_clear(pool);
+	assert(pool->count == 0 && ewelborn_stringPool_find(pool, ewelborn_stringView_fromCString("hello")) == -1);
+	bool interned = ewelborn_stringPool_internAll(pool, fields, ids);
+	assert(interned);
+	interned = ewelborn_stringPool_internSplit(pool, ewelborn_stringView_fromString(line), ',', splitIds);
+	assert(interned);
+	int expected[] = { 0, 1, 2, 0, 3, 4, 2, 0 };
+	assert(ids->elements == 8 && splitIds->elements == 8 && pool->count == 5);
+	for (int i = 0; i < 8; i++) {
+		assert(EWELBORN_TYPED_ARRAY_AT(ids, int, i) == expected[i]);
+		assert(EWELBORN_TYPED_ARRAY_AT(splitIds, int, i) == expected[i]);
+	}
+	ewelborn_typedArray* wrongIds = EWELBORN_TYPED_ARRAY_INITIALIZE(int64_t);
+	interned = ewelborn_stringPool_internAll(pool, fields, wrongIds);
+	assert(interned == false);
+	interned = ewelborn_stringPool_internSplit(pool, ewelborn_stringView_fromString(line), ',', wrongIds);
+	assert(interned == false);
+
+	// More fields than fit in one batch
+	ewelborn_string* repeated = ewelborn_string_initializeEmpty();
+	for (int i = 0; i < 1000; i++) {
+		snprintf(buffer, sizeof(buffer), "%d\n", i % 37);
+		bool appended = ewelborn_string_appendCString(repeated, buffer);
+		assert(appended);
+	}
+	ewelborn_typedArray_clear(splitIds);
+	interned = ewelborn_stringPool_internSplit(pool, ewelborn_stringView_fromString(repeated), '\n', splitIds);
+	assert(interned);
+	assert(splitIds->elements == 1001);
+	for (int i = 0; i < 1000; i++) {
+		snprintf(buffer, sizeof(buffer), "%d", i % 37);
+		assert(ewelborn_stringView_equals(ewelborn_stringPool_get(pool, EWELBORN_TYPED_ARRAY_AT(splitIds, int, i)), ewelborn_stringView_fromCString(buffer)));
+	}
+	assert(EWELBORN_TYPED_ARRAY_AT(splitIds, int, 1000) == EWELBORN_TYPED_ARRAY_AT(ids, int, 4));
+
+	ewelborn_typedArray_free(ids);
+	ewelborn_typedArray_free(splitIds);
+	ewelborn_typedArray_free(wrongIds);
+	ewelborn_dynamicArray_free(fields);
+	ewelborn_string_free(line);
+	ewelborn_string_free(repeated);
+	ewelborn_string_free(estring);
+	ewelborn_stringPool_free(pool);
+}
+
+#define RING_TEST_ITEMS 100000
+
+struct ringTestSide {
+	ewelborn_ringBuffer* ringBuffer;
+	ewelborn_ringBuffer* finished; // Producers push here when they're done, if it's set
+	intptr_t first; // First item that a producer pushes
+	int count;
+	ewelborn_ringBufferWait wait;
+	long long sum; // What a consumer popped
+	int popped;
+	bool inOrder;
+};
+
+static void ringTestProduce(void* argument)
+{
+	struct ringTestSide* side = argument;
+	void* batch[7];
+	int i = 0;
+	while (i < side->count) {
+		// Mix single pushes in with batches of different sizes
+		int batchCount = i % 3 == 0 ? 1 : 1 + i % 7;
+		if (batchCount > side->count - i) { batchCount = side->count - i; }
+		for (int j = 0; j < batchCount; j++) {
+			batch[j] = (void*)(side->first + i + j);
+		}
+		if (batchCount == 1) {
+			bool pushed = ewelborn_ringBuffer_push(side->ringBuffer, batch[0], side->wait);
+			assert(pushed);
+		} else {
+			int pushedCount = ewelborn_ringBuffer_pushMany(side->ringBuffer, batch, batchCount, side->wait);
+			assert(pushedCount == batchCount);
+		}
+		i += batchCount;
+	}
+
+	if (side->finished != NULL) {
+		bool pushed = ewelborn_ringBuffer_push(side->finished, side, EWELBORN_RING_BUFFER_BLOCK);
+		assert(pushed);
+	} else {
+		ewelborn_ringBuffer_close(side->ringBuffer);
+	}
+}
+
+static void ringTestConsume(void* argument)
+{
+	struct ringTestSide* side = argument;
+	void* batch[16];
+	intptr_t last = 0;
+	side->inOrder = true;
+	while (true) {
+		int popped = ewelborn_ringBuffer_popMany(side->ringBuffer, batch, 1 + side->popped % 16, side->wait);
+		if (popped == 0) { break; }
+		for (int i = 0; i < popped; i++) {
+			intptr_t item = (intptr_t)batch[i];
+			side->inOrder = side->inOrder && item == last + 1;
+			last = item;
+			side->sum += item;
+		}
+		side->popped += popped;
+	}
+}
+
+void test_ringBuffer()
+{
+	ewelborn_ringBufferKind kinds[] = { EWELBORN_RING_BUFFER_SPSC, EWELBORN_RING_BUFFER_MPMC };
+	for (int k = 0; k < 2; k++) {
+		// The capacity is rounded up to 8
+		ewelborn_ringBuffer* ringBuffer = ewelborn_ringBuffer_initialize(5, kinds[k]);
+		assert(ringBuffer != NULL && ewelborn_ringBuffer_size(ringBuffer) == 0);
+		void* element = NULL;
+		void* elements[20];
+		bool wasPopped = ewelborn_ringBuffer_pop(ringBuffer, &element, EWELBORN_RING_BUFFER_TRY);
+		assert(wasPopped == false);
+		int poppedCount = ewelborn_ringBuffer_popMany(ringBuffer, elements, 20, EWELBORN_RING_BUFFER_TRY);
+		assert(poppedCount == 0);
+
+		// Go around the ring several times, so that the positions wrap
+		for (int lap = 0; lap < 5; lap++) {
+			for (intptr_t i = 1; i <= 8; i++) {
+				bool pushed = ewelborn_ringBuffer_push(ringBuffer, (void*)i, EWELBORN_RING_BUFFER_TRY);
+				assert(pushed);
+			}
+			bool pushed = ewelborn_ringBuffer_push(ringBuffer, (void*)9, EWELBORN_RING_BUFFER_TRY);
+			assert(pushed == false);
+			assert(ewelborn_ringBuffer_size(ringBuffer) == 8);
+			for (intptr_t i = 1; i <= 3; i++) {
+				wasPopped = ewelborn_ringBuffer_pop(ringBuffer, &element, EWELBORN_RING_BUFFER_SPIN);
+				assert(wasPopped && element == (void*)i);
+			}
+
+			// Only as many elements as there's room for go in
+			for (intptr_t i = 0; i < 20; i++) { elements[i] = (void*)(i + 9); }
+			int pushedCount = ewelborn_ringBuffer_pushMany(ringBuffer, elements, 20, EWELBORN_RING_BUFFER_TRY);
+			assert(pushedCount == 3);
+			assert(ewelborn_ringBuffer_size(ringBuffer) == 8);
+			poppedCount = ewelborn_ringBuffer_popMany(ringBuffer, elements, 4, EWELBORN_RING_BUFFER_BLOCK);
+			assert(poppedCount == 4);
+			for (intptr_t i = 0; i < 4; i++) { assert(elements[i] == (void*)(i + 4)); }
+			poppedCount = ewelborn_ringBuffer_popMany(ringBuffer, elements, 20, EWELBORN_RING_BUFFER_TRY);
+			assert(poppedCount == 4);
+			for (intptr_t i = 0; i < 4; i++) { assert(elements[i] == (void*)(i + 8)); }
+			wasPopped = ewelborn_ringBuffer_pop(ringBuffer, &element, EWELBORN_RING_BUFFER_TRY);
+			assert(wasPopped == false);
+		}
+
+		// Closing lets the last elements out, but nothing else in
+		bool pushed = ewelborn_ringBuffer_push(ringBuffer, (void*)1, EWELBORN_RING_BUFFER_BLOCK);
+		assert(pushed);
+		pushed = ewelborn_ringBuffer_push(ringBuffer, (void*)2, EWELBORN_RING_BUFFER_BLOCK);
+		assert(pushed);
+		ewelborn_ringBuffer_close(ringBuffer);
+		pushed = ewelborn_ringBuffer_push(ringBuffer, (void*)3, EWELBORN_RING_BUFFER_BLOCK);
+		assert(pushed == false);
+		wasPopped = ewelborn_ringBuffer_pop(ringBuffer, &element, EWELBORN_RING_BUFFER_BLOCK);
+		assert(wasPopped && element == (void*)1);
+		poppedCount = ewelborn_ringBuffer_popMany(ringBuffer, elements, 20, EWELBORN_RING_BUFFER_BLOCK);
+		assert(poppedCount == 1 && elements[0] == (void*)2);
+		wasPopped = ewelborn_ringBuffer_pop(ringBuffer, &element, EWELBORN_RING_BUFFER_BLOCK);
+		assert(wasPopped == false);
+		ewelborn_ringBuffer_free(ringBuffer);
+	}
+
+	ewelborn_threadPool* pool = ewelborn_threadPool_initialize(4);
+	assert(pool != NULL);
+	ewelborn_ringBufferWait waits[] = { EWELBORN_RING_BUFFER_SPIN, EWELBORN_RING_BUFFER_BLOCK };
+	for (int w = 0; w < 2; w++) {
+		// One producer on the pool and the consumer on this thread, which has
+		// to see every item in order
+		ewelborn_ringBuffer* ringBuffer = ewelborn_ringBuffer_initialize(64, EWELBORN_RING_BUFFER_SPSC);
+		struct ringTestSide producer = { ringBuffer, NULL, 1, RING_TEST_ITEMS, waits[w], 0, 0, false };
+		struct ringTestSide consumer = { ringBuffer, NULL, 0, 0, waits[w], 0, 0, false };
+		bool submitted = ewelborn_threadPool_submit(pool, ringTestProduce, &producer);
+		assert(submitted);
+		ringTestConsume(&consumer);
+		ewelborn_threadPool_wait(pool);
+		assert(consumer.inOrder && consumer.popped == RING_TEST_ITEMS);
+		assert(consumer.sum == (long long)RING_TEST_ITEMS * (RING_TEST_ITEMS + 1) / 2);
+		ewelborn_ringBuffer_free(ringBuffer);
+
+		// Two producers and two consumers, which close the ring buffer once
+		// both producers are done. Every item has to come out exactly once.
+		ringBuffer = ewelborn_ringBuffer_initialize(64, EWELBORN_RING_BUFFER_MPMC);
+		ewelborn_ringBuffer* finished = ewelborn_ringBuffer_initialize(2, EWELBORN_RING_BUFFER_MPMC);
+		struct ringTestSide sides[4] = {
+			{ ringBuffer, finished, 1, RING_TEST_ITEMS / 2, waits[w], 0, 0, false },
+			{ ringBuffer, finished, 1 + RING_TEST_ITEMS / 2, RING_TEST_ITEMS / 2, waits[w], 0, 0, false },
+			{ ringBuffer, NULL, 0, 0, waits[w], 0, 0, false },
+			{ ringBuffer, NULL, 0, 0, waits[w], 0, 0, false }
+		};
+		for (int i = 0; i < 4; i++) {
+			submitted = ewelborn_threadPool_submit(pool, i < 2 ? ringTestProduce : ringTestConsume, &sides[i]);
+			assert(submitted);
+		}
+		void* done = NULL;
+		for (int i = 0; i < 2; i++) {
+			bool wasPopped = ewelborn_ringBuffer_pop(finished, &done, EWELBORN_RING_BUFFER_BLOCK);
+			assert(wasPopped);
+		}
+		ewelborn_ringBuffer_close(ringBuffer);
+		ewelborn_threadPool_wait(pool);
+		assert(sides[2].popped + sides[3].popped == RING_TEST_ITEMS);
+		assert(sides[2].sum + sides[3].sum == (long long)RING_TEST_ITEMS * (RING_TEST_ITEMS + 1) / 2);
+		ewelborn_ringBuffer_free(finished);
+		ewelborn_ringBuffer_free(ringBuffer);
+	}
+	ewelborn_threadPool_free(pool);
+}
+
+void test_numberFormatting()
+{
+	// appendf formats onto the end, growing the estring when it has to
+	ewelborn_string* estring = ewelborn_string_initializeWithCString("Name: ");
+	bool appended = ewelborn_string_appendf(estring, "%s, Age: %d", "Ethan", 21);
+	assert(appended);
+	assert(strcmp(estring->cstring, "Name: Ethan, Age: 21") == 0 && estring->length == 20);
+	char expected[4096];
+	strcpy(expected, estring->cstring);
+	for (int i = 0; i < 200; i++) {
+		appended = ewelborn_string_appendf(estring, " %d:%.2f:%s", i, i / 4.0, "x");
+		assert(appended);
+		snprintf(expected + strlen(expected), sizeof(expected) - strlen(expected), " %d:%.2f:%s", i, i / 4.0, "x");
+	}
+	assert(strcmp(estring->cstring, expected) == 0 && estring->length == (int)strlen(expected));
+	appended = ewelborn_string_appendf(estring, "%s", "");
+	assert(appended && estring->length == (int)strlen(expected));
+
+	// The arguments can point into the estring, even when it has to grow
+	ewelborn_string* repeated = ewelborn_string_initializeWithCString("ab");
+	for (int i = 0; i < 10; i++) {
+		appended = ewelborn_string_appendf(repeated, "%s", repeated->cstring);
+		assert(appended);
+	}
+	assert(repeated->length == 2 << 10);
+	for (int i = 0; i < repeated->length; i++) {
+		assert(repeated->cstring[i] == "ab"[i % 2]);
+	}
+	ewelborn_string_free(repeated);
+
+	// sprintf still formats the estring's own characters
+	ewelborn_string* format = ewelborn_string_initializeWithCString("%s has %d characters, %s");
+	bool formatted = ewelborn_string_sprintf(format, "This sentence", 13, "which is long enough to not fit inline");
+	assert(formatted);
+	assert(strcmp(format->cstring, "This sentence has 13 characters, which is long enough to not fit inline") == 0);
+
+	// Integers
+	ewelborn_string_deleteRight(estring, estring->length);
+	int64_t ints[] = { 0, 1, -1, 9, 10, 99, 100, -101, 123456789, INT64_MAX, INT64_MIN };
+	for (int i = 0; i < (int)(sizeof(ints) / sizeof(ints[0])); i++) {
+		char buffer[32];
+		snprintf(buffer, sizeof(buffer), "%lld", (long long)ints[i]);
+		ewelborn_string_deleteRight(estring, estring->length);
+		appended = ewelborn_string_appendInt(estring, ints[i]);
+		assert(appended);
+		assert(strcmp(estring->cstring, buffer) == 0 && estring->length == (int)strlen(buffer));
+	}
+	uint64_t power = 1;
+	for (int i = 0; i < 20; i++) {
+		// Every number of digits, and the numbers on either side of each
+		uint64_t unsignedInts[] = { power - 1, power, power + 1 };
+		for (int j = 0; j < 3; j++) {
+			char buffer[32];
+			snprintf(buffer, sizeof(buffer), "%llu", (unsigned long long)unsignedInts[j]);
+			ewelborn_string_deleteRight(estring, estring->length);
+			appended = ewelborn_string_appendUInt(estring, unsignedInts[j]);
+			assert(appended && strcmp(estring->cstring, buffer) == 0);
+		}
+		if (i < 19) { power *= 10; }
+	}
+	ewelborn_string_deleteRight(estring, estring->length);
+	appended = ewelborn_string_appendUInt(estring, UINT64_MAX);
+	assert(appended && strcmp(estring->cstring, "18446744073709551615") == 0);
+
+	// Doubles come out as short as they can be
+	struct { double value; const char* text; } doubles[] = {
+		{ 0.0, "0" }, { -0.0, "-0" }, { 1.0, "1" }, { -2.5, "-2.5" }, { 0.1, "0.1" }, { 0.3, "0.3" },
+		{ 0.1 + 0.2, "0.30000000000000004" }, { 100.0, "100" }, { 123456.789, "123456.789" },
+		{ 1e20, "100000000000000000000" }, { 1e21, "1e+21" }, { 1.5e300, "1.5e+300" },
+		{ 0.000001, "0.000001" }, { 1e-7, "1e-7" }, { 1.25e-10, "1.25e-10" },
+		{ 5e-324, "5e-324" }, { 2.2250738585072014e-308, "2.2250738585072014e-308" },
+		{ 1.7976931348623157e308, "1.7976931348623157e+308" }, { 9007199254740993.0, "9007199254740992" },
+		{ HUGE_VAL, "inf" }, { -HUGE_VAL, "-inf" }, { NAN, "nan" }
+	};
+	for (int i = 0; i < (int)(sizeof(doubles) / sizeof(doubles[0])); i++) {
+		ewelborn_string_deleteRight(estring, estring->length);
+		appended = ewelborn_string_appendDouble(estring, doubles[i].value);
+		assert(appended);
+		assert(strcmp(estring->cstring, doubles[i].text) == 0);
+	}
+
+	// Random doubles, from every exponent, always read back the same, and
+	// are never longer than printf's shortest round trip
+	unsigned long long state = 88172645463325252ull;
+	for (int i = 0; i < 20000; i++) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		double value;
+		memcpy(&value, &state, sizeof(value));
+		if (isfinite(value) == false) { continue; }
+
+		ewelborn_string_deleteRight(estring, estring->length);
+		appended = ewelborn_string_appendDouble(estring, value);
+		assert(appended);
+		double parsed;
+		ewelborn_parseResult parseResult = ewelborn_string_parseDouble(estring, &parsed);
+		assert(parseResult == EWELBORN_PARSE_SUCCESS);
+		assert(memcmp(&parsed, &value, sizeof(value)) == 0);
+
+		char buffer[64];
+		int precision = 1;
+		for (; precision < 17; precision++) {
+			snprintf(buffer, sizeof(buffer), "%.*e", precision - 1, value);
+			if (strtod(buffer, NULL) == value) { break; }
+		}
+		// Counting from the first non-zero digit to the last one
+		int digits = 0;
+		int significantDigits = 0;
+		const char* p = estring->cstring;
+		while (*p == '-' || *p == '0' || *p == '.') { p++; }
+		for (; *p != '\0' && *p != 'e'; p++) {
+			if (*p == '.') { continue; }
+			digits++;
+			if (*p != '0') { significantDigits = digits; }
+		}
+		assert(significantDigits <= precision);
+	}
+
+	ewelborn_string_free(format);
+	ewelborn_string_free(estring);
+}
+
 int main(void)
 {
 	// Yes, I'm aware that it's ironic to use the tested material
@@ -25,6 +2097,29 @@ int main(void)
 
 	// Add new tests here.
 	ewelborn_dynamicArray_push(tests, &test_helloWorld);
+	ewelborn_dynamicArray_push(tests, &test_readLinesFromFile);
+	ewelborn_dynamicArray_push(tests, &test_stringView);
+	ewelborn_dynamicArray_push(tests, &test_scanImplementations);
+	ewelborn_dynamicArray_push(tests, &test_arena);
+	ewelborn_dynamicArray_push(tests, &test_typedArray);
+	ewelborn_dynamicArray_push(tests, &test_hashMap);
+	ewelborn_dynamicArray_push(tests, &test_list);
+	ewelborn_dynamicArray_push(tests, &test_smallString);
+	ewelborn_dynamicArray_push(tests, &test_stringAppend);
+	ewelborn_dynamicArray_push(tests, &test_parallel);
+	ewelborn_dynamicArray_push(tests, &test_threadPool);
+	ewelborn_dynamicArray_push(tests, &test_fileWriter);
+	ewelborn_dynamicArray_push(tests, &test_allocator);
+	ewelborn_dynamicArray_push(tests, &test_substringSearch);
+	ewelborn_dynamicArray_push(tests, &test_frontDeletion);
+	ewelborn_dynamicArray_push(tests, &test_tokenizer);
+	ewelborn_dynamicArray_push(tests, &test_numberParsing);
+	ewelborn_dynamicArray_push(tests, &test_csvReader);
+	ewelborn_dynamicArray_push(tests, &test_sort);
+	ewelborn_dynamicArray_push(tests, &test_priorityQueue);
+	ewelborn_dynamicArray_push(tests, &test_stringPool);
+	ewelborn_dynamicArray_push(tests, &test_ringBuffer);
+	ewelborn_dynamicArray_push(tests, &test_numberFormatting);
 
 	printf("Running tests..\n");
 